@@ -406,6 +406,11 @@ public class Helper {
             return "ISO8859_1";
         }
 
+        // The Java name; the IANA name UTF-8 is normalized to UTF_8.
+        if (internalName.equals("UTF8")) {
+            return "UTF_8";
+        }
+
         /*
          * Since IANA character encoding names can start with a digit
          * and that some Reader class names that do not match the standard
@@ -0,0 +1,215 @@
+/*
+ *  Copyright (c) 1999 Sun Microsystems, Inc., 901 San Antonio Road,
+ *  Palo Alto, CA 94303, U.S.A.  All Rights Reserved.
+ *
+ *  Sun Microsystems, Inc. has intellectual property rights relating
+ *  to the technology embodied in this software.  In particular, and
+ *  without limitation, these intellectual property rights may include
+ *  one or more U.S. patents, foreign patents, or pending
+ *  applications.  Sun, Sun Microsystems, the Sun logo, Java, KJava,
+ *  and all Sun-based and Java-based marks are trademarks or
+ *  registered trademarks of Sun Microsystems, Inc.  in the United
+ *  States and other countries.
+ *
+ *  This software is distributed under licenses restricting its use,
+ *  copying, distribution, and decompilation.  No part of this
+ *  software may be reproduced in any form by any means without prior
+ *  written authorization of Sun and its licensors, if any.
+ *
+ *  FEDERAL ACQUISITIONS:  Commercial Software -- Government Users
+ *  Subject to Standard License Terms and Conditions
+ */
+
+package com.sun.cldc.i18n.j2me;
+
+import java.io.*;
+import com.sun.cldc.i18n.*;
+
+/**
+ * Reader for UTF-8 encoded input streams.  The bytes are read in
+ * blocks and converted by a native method that copies runs of ASCII
+ * characters in bulk.  Characters above U+FFFF are returned as
+ * surrogate pairs, and each byte of an invalid sequence is returned as
+ * U+FFFD.
+ */
+public class UTF_8_Reader extends StreamReader {
+
+    /** Size of the byte buffer */
+    private static final int BUFFER_SIZE = 256;
+
+    /** Bytes read from the stream */
+    private byte[] buffer = new byte[BUFFER_SIZE];
+
+    /** Index of the first byte in the buffer not yet converted */
+    private int pos;
+
+    /** Number of bytes in the buffer */
+    private int count;
+
+    /** True when the stream has reached its end */
+    private boolean endOfInput;
+
+    /**
+     * Low surrogate of a pair whose high surrogate has been returned
+     * alone, or -1
+     */
+    private int pendingChar = -1;
+
+    /** Room for one surrogate pair */
+    private char[] pair = new char[2];
+
+    /**
+     * Open the reader
+     */
+    public Reader open(InputStream in, String enc)
+        throws UnsupportedEncodingException {
+        pos = 0;
+        count = 0;
+        endOfInput = false;
+        pendingChar = -1;
+        return super.open(in, enc);
+    }
+
+    /**
+     * Read a single character.
+     *
+     * @exception  IOException  If an I/O error occurs
+     */
+    synchronized public int read() throws IOException {
+        if (pendingChar < 0 && pos < count && buffer[pos] >= 0) {
+            return buffer[pos++];
+        }
+        return (read(pair, 0, 1) == -1) ? -1 : pair[0];
+    }
+
+    /**
+     * Read characters into a portion of an array.  Blocks until at least
+     * one character has been read, and goes on while the stream has
+     * bytes available.
+     *
+     * @exception  IOException  If an I/O error occurs
+     */
+    synchronized public int read(char cbuf[], int off, int len) throws IOException {
+        if (off < 0 || len < 0 || off > cbuf.length - len) {
+            throw new IndexOutOfBoundsException();
+        }
+        int end = off + len;
+        int n = off;
+
+        if (n < end && pendingChar >= 0) {
+            cbuf[n++] = (char)pendingChar;
+            pendingChar = -1;
+        }
+
+        while (n < end) {
+            long r = decode(buffer, pos, count, cbuf, n, end, endOfInput);
+            pos = (int)(r >>> 32);
+            n = (int)r;
+            if (n == end) {
+                break;
+            }
+
+            if (n == end - 1 && pos < count) {
+                /* There may be no room for a surrogate pair */
+                r = decode(buffer, pos, count, pair, 0, 2, endOfInput);
+                if ((int)r > 0) {
+                    pos = (int)(r >>> 32);
+                    cbuf[n++] = pair[0];
+                    if ((int)r == 2) {
+                        pendingChar = pair[1];
+                    }
+                    break;
+                }
+            }
+
+            /* The buffer holds at most the start of one character */
+            if (endOfInput || (n > off && in.available() <= 0)) {
+                break;
+            }
+            System.arraycopy(buffer, pos, buffer, 0, count - pos);
+            count -= pos;
+            pos = 0;
+            int bytes = in.read(buffer, count, buffer.length - count);
+            if (bytes == -1) {
+                endOfInput = true;
+            } else {
+                count += bytes;
+            }
+        }
+        return (n == off && len > 0) ? -1 : n - off;
+    }
+
+    /**
+     * Tell whether the stream is ready to be read.
+     */
+    public boolean ready() {
+        return pendingChar >= 0 || pos < count || super.ready();
+    }
+
+    /**
+     * Tell whether this stream supports the mark() operation.  It
+     * doesn't, as bytes are read ahead of the characters returned.
+     */
+    public boolean markSupported() {
+        return false;
+    }
+
+    /**
+     * Mark the present position in the stream.
+     *
+     * @exception  IOException  Always, as marks are not supported
+     */
+    public void mark(int readAheadLimit) throws IOException {
+        throw new IOException("mark() not supported");
+    }
+
+    /**
+     * Reset the stream.
+     *
+     * @exception  IOException  Always, as marks are not supported
+     */
+    public void reset() throws IOException {
+        throw new IOException("reset() not supported");
+    }
+
+    /**
+     * Close the stream.
+     *
+     * @exception  IOException  If an I/O error occurs
+     */
+    public void close() throws IOException {
+        super.close();
+        pos = 0;
+        count = 0;
+        pendingChar = -1;
+    }
+
+    /**
+     * Get the size in chars of an array of bytes
+     */
+    public int sizeOf(byte[] array, int offset, int length) {
+        return charCount(array, offset, length);
+    }
+
+    /**
+     * Decode the bytes from <code>src[srcOff]</code> to
+     * <code>src[srcEnd - 1]</code> into <code>dst</code> from
+     * <code>dst[dstOff]</code>, writing no further than
+     * <code>dst[dstEnd - 1]</code>.  A character cut off by
+     * <code>srcEnd</code> is left alone unless <code>endOfInput</code>
+     * is set.
+     *
+     * @return the index after the last byte used in the high 32 bits,
+     *         and the index after the last char written in the low 32
+     *         bits
+     */
+    private static native long decode(byte[] src, int srcOff, int srcEnd,
+                                      char[] dst, int dstOff, int dstEnd,
+                                      boolean endOfInput);
+
+    /**
+     * Get the number of chars <code>decode</code> makes of all of the
+     * given bytes.
+     */
+    private static native int charCount(byte[] src, int offset, int length);
+}
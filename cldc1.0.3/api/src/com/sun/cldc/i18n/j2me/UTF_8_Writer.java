@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 1999 Sun Microsystems, Inc., 901 San Antonio Road,
+ *  Palo Alto, CA 94303, U.S.A.  All Rights Reserved.
+ *
+ *  Sun Microsystems, Inc. has intellectual property rights relating
+ *  to the technology embodied in this software.  In particular, and
+ *  without limitation, these intellectual property rights may include
+ *  one or more U.S. patents, foreign patents, or pending
+ *  applications.  Sun, Sun Microsystems, the Sun logo, Java, KJava,
+ *  and all Sun-based and Java-based marks are trademarks or
+ *  registered trademarks of Sun Microsystems, Inc.  in the United
+ *  States and other countries.
+ *
+ *  This software is distributed under licenses restricting its use,
+ *  copying, distribution, and decompilation.  No part of this
+ *  software may be reproduced in any form by any means without prior
+ *  written authorization of Sun and its licensors, if any.
+ *
+ *  FEDERAL ACQUISITIONS:  Commercial Software -- Government Users
+ *  Subject to Standard License Terms and Conditions
+ */
+
+package com.sun.cldc.i18n.j2me;
+
+import java.io.*;
+import com.sun.cldc.i18n.*;
+
+/**
+ * Writer for UTF-8 encoded output streams.  The characters are
+ * converted by a native method that copies runs of ASCII characters in
+ * bulk, and written to the stream a block at a time.  Surrogate pairs
+ * are written as one four byte character, and unpaired surrogates as
+ * '?'.
+ */
+public class UTF_8_Writer extends StreamWriter {
+
+    /** Size of the byte buffer; must be at least 4 */
+    private static final int BUFFER_SIZE = 256;
+
+    /** Bytes to be written to the stream */
+    private byte[] buffer = new byte[BUFFER_SIZE];
+
+    /**
+     * High surrogate that ended the last write, whose low surrogate
+     * may start the next one, or -1
+     */
+    private int pendingSurrogate = -1;
+
+    /** Room for one surrogate pair */
+    private char[] pair = new char[2];
+
+    /**
+     * Open the writer
+     */
+    public Writer open(OutputStream out, String enc)
+        throws UnsupportedEncodingException {
+        pendingSurrogate = -1;
+        return super.open(out, enc);
+    }
+
+    /**
+     * Write a portion of an array of characters.
+     *
+     * @param  cbuf  Buffer of characters to be written
+     * @param  off   Offset from which to start reading characters
+     * @param  len   Number of characters to be written
+     *
+     * @exception  IOException  If an I/O error occurs
+     */
+    synchronized public void write(char cbuf[], int off, int len) throws IOException {
+        if (off < 0 || len < 0 || off > cbuf.length - len) {
+            throw new IndexOutOfBoundsException();
+        }
+        int end = off + len;
+        int count = 0;
+
+        if (pendingSurrogate >= 0 && off < end) {
+            pair[0] = (char)pendingSurrogate;
+            pair[1] = cbuf[off];
+            if (pair[1] >= 0xDC00 && pair[1] <= 0xDFFF) {
+                count = (int)encode(pair, 0, 2, buffer, 0, BUFFER_SIZE);
+                off++;
+            } else {
+                buffer[count++] = (byte)'?';
+            }
+            pendingSurrogate = -1;
+        }
+
+        while (off < end) {
+            long r = encode(cbuf, off, end, buffer, count, BUFFER_SIZE);
+            off = (int)(r >>> 32);
+            count = (int)r;
+            if (off < end) {
+                if (BUFFER_SIZE - count >= 4) {
+                    /* Stopped before a high surrogate that ends cbuf */
+                    pendingSurrogate = cbuf[off++];
+                } else {
+                    out.write(buffer, 0, count);
+                    count = 0;
+                }
+            }
+        }
+
+        if (count > 0) {
+            out.write(buffer, 0, count);
+        }
+    }
+
+    /**
+     * Close the writer and the output stream.  A high surrogate whose
+     * low surrogate never came is written as '?'.
+     *
+     * @exception  IOException  If an I/O error occurs
+     */
+    public void close() throws IOException {
+        if (pendingSurrogate >= 0) {
+            pendingSurrogate = -1;
+            out.write('?');
+        }
+        super.close();
+    }
+
+    /**
+     * Get the size in bytes of an array of chars
+     */
+    public int sizeOf(char[] array, int offset, int length) {
+        return byteCount(array, offset, length);
+    }
+
+    /**
+     * Encode the chars from <code>src[srcOff]</code> to
+     * <code>src[srcEnd - 1]</code> into <code>dst</code> from
+     * <code>dst[dstOff]</code>, writing no further than
+     * <code>dst[dstEnd - 1]</code>.  Stops before a high surrogate at
+     * <code>src[srcEnd - 1]</code>.
+     *
+     * @return the index after the last char used in the high 32 bits,
+     *         and the index after the last byte written in the low 32
+     *         bits
+     */
+    private static native long encode(char[] src, int srcOff, int srcEnd,
+                                      byte[] dst, int dstOff, int dstEnd);
+
+    /**
+     * Get the number of bytes <code>encode</code> makes of the given
+     * chars, counting a high surrogate at the end as '?'.
+     */
+    private static native int byteCount(char[] src, int offset, int length);
+}
@@ -250,48 +250,80 @@ abstract public class GeneralBase implements DataInput, DataOutput {
     public static int writeUTF(String str, DataOutput out)
         throws IOException {
 
-        int strlen = str.length();
-        int utflen = 0;
-        char[] charr = new char[strlen];
-        int c, count = 0;
-
-        str.getChars(0, strlen, charr, 0);
-
-        for (int i = 0; i < strlen; i++) {
-            c = charr[i];
-            if ((c >= 0x0001) && (c <= 0x007F)) {
-                utflen++;
-            } else if (c > 0x07FF) {
-                utflen += 3;
-            } else {
-                utflen += 2;
-            }
-        }
+        int utflen = utfLength(str);
 
         if (utflen > 65535)
             throw new UTFDataFormatException();
 
         byte[] bytearr = new byte[utflen+2];
-        bytearr[count++] = (byte) ((utflen >>> 8) & 0xFF);
-        bytearr[count++] = (byte) ((utflen >>> 0) & 0xFF);
-        for (int i = 0; i < strlen; i++) {
-            c = charr[i];
-            if ((c >= 0x0001) && (c <= 0x007F)) {
-                bytearr[count++] = (byte) c;
-            } else if (c > 0x07FF) {
-                bytearr[count++] = (byte) (0xE0 | ((c >> 12) & 0x0F));
-                bytearr[count++] = (byte) (0x80 | ((c >>  6) & 0x3F));
-                bytearr[count++] = (byte) (0x80 | ((c >>  0) & 0x3F));
-            } else {
-                bytearr[count++] = (byte) (0xC0 | ((c >>  6) & 0x1F));
-                bytearr[count++] = (byte) (0x80 | ((c >>  0) & 0x3F));
-            }
-        }
+        bytearr[0] = (byte) ((utflen >>> 8) & 0xFF);
+        bytearr[1] = (byte) ((utflen >>> 0) & 0xFF);
+        encodeUTF(str, bytearr, 2);
         out.write(bytearr);
 
         return utflen + 2;
     }
 
+/******
+ *  public static int writeUTF(String str, DataOutput out)
+ *      throws IOException {
+ *
+ *      int strlen = str.length();
+ *      int utflen = 0;
+ *      char[] charr = new char[strlen];
+ *      int c, count = 0;
+ *
+ *      str.getChars(0, strlen, charr, 0);
+ *
+ *      for (int i = 0; i < strlen; i++) {
+ *          c = charr[i];
+ *          if ((c >= 0x0001) && (c <= 0x007F)) {
+ *              utflen++;
+ *          } else if (c > 0x07FF) {
+ *              utflen += 3;
+ *          } else {
+ *              utflen += 2;
+ *          }
+ *      }
+ *
+ *      if (utflen > 65535)
+ *          throw new UTFDataFormatException();
+ *
+ *      byte[] bytearr = new byte[utflen+2];
+ *      bytearr[count++] = (byte) ((utflen >>> 8) & 0xFF);
+ *      bytearr[count++] = (byte) ((utflen >>> 0) & 0xFF);
+ *      for (int i = 0; i < strlen; i++) {
+ *          c = charr[i];
+ *          if ((c >= 0x0001) && (c <= 0x007F)) {
+ *              bytearr[count++] = (byte) c;
+ *          } else if (c > 0x07FF) {
+ *              bytearr[count++] = (byte) (0xE0 | ((c >> 12) & 0x0F));
+ *              bytearr[count++] = (byte) (0x80 | ((c >>  6) & 0x3F));
+ *              bytearr[count++] = (byte) (0x80 | ((c >>  0) & 0x3F));
+ *          } else {
+ *              bytearr[count++] = (byte) (0xC0 | ((c >>  6) & 0x1F));
+ *              bytearr[count++] = (byte) (0x80 | ((c >>  0) & 0x3F));
+ *          }
+ *      }
+ *      out.write(bytearr);
+ *
+ *      return utflen + 2;
+ *  }
+ ****/
+
+    /**
+     * Returns the number of bytes <code>writeUTF</code> needs for the
+     * characters of a string.
+     */
+    private static native int utfLength(String str);
+
+    /**
+     * Encodes a string in modified UTF-8 into <code>dst</code> from
+     * <code>offset</code>, which must leave room for
+     * <code>utfLength(str)</code> bytes.
+     */
+    private static native void encodeUTF(String str, byte[] dst, int offset);
+
     /**
      * Flushes this data output stream. This forces any buffered output
      * bytes to be written out to the stream.
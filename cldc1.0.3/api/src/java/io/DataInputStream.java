@@ -359,53 +359,79 @@ class DataInputStream extends InputStream implements DataInput {
      */
     public final static String readUTF(DataInput in) throws IOException {
         int utflen = in.readUnsignedShort();
-        StringBuffer str = new StringBuffer(utflen);
         byte bytearr [] = new byte[utflen];
-        int c, char2, char3;
-        int count = 0;
+        char chararr [] = new char[utflen];
 
         in.readFully(bytearr, 0, utflen);
 
-        while (count < utflen) {
-            c = (int) bytearr[count] & 0xff;
-            switch (c >> 4) {
-                case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7:
-                    /* 0xxxxxxx*/
-                    count++;
-                    str.append((char)c);
-                    break;
-                case 12: case 13:
-                    /* 110x xxxx   10xx xxxx*/
-                    count += 2;
-                    if (count > utflen)
-                        throw new UTFDataFormatException();
-                    char2 = (int) bytearr[count-1];
-                    if ((char2 & 0xC0) != 0x80)
-                        throw new UTFDataFormatException();
-                    str.append((char)(((c & 0x1F) << 6) | (char2 & 0x3F)));
-                    break;
-                case 14:
-                    /* 1110 xxxx  10xx xxxx  10xx xxxx */
-                    count += 3;
-                    if (count > utflen)
-                        throw new UTFDataFormatException();
-                    char2 = (int) bytearr[count-2];
-                    char3 = (int) bytearr[count-1];
-                    if (((char2 & 0xC0) != 0x80) || ((char3 & 0xC0) != 0x80))
-                        throw new UTFDataFormatException();
-                    str.append((char)(((c     & 0x0F) << 12) |
-                                      ((char2 & 0x3F) << 6)  |
-                                      ((char3 & 0x3F) << 0)));
-                    break;
-                default:
-                    /* 10xx xxxx,  1111 xxxx */
-                    throw new UTFDataFormatException();
-                }
-        }
         // The number of chars produced may be less than utflen
-        return new String(str);
+        return new String(chararr, 0, decodeUTF(bytearr, utflen, chararr));
     }
 
+/******
+ *  public final static String readUTF(DataInput in) throws IOException {
+ *      int utflen = in.readUnsignedShort();
+ *      StringBuffer str = new StringBuffer(utflen);
+ *      byte bytearr [] = new byte[utflen];
+ *      int c, char2, char3;
+ *      int count = 0;
+ *
+ *      in.readFully(bytearr, 0, utflen);
+ *
+ *      while (count < utflen) {
+ *          c = (int) bytearr[count] & 0xff;
+ *          switch (c >> 4) {
+ *              case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7:
+ *                  // 0xxxxxxx
+ *                  count++;
+ *                  str.append((char)c);
+ *                  break;
+ *              case 12: case 13:
+ *                  // 110x xxxx   10xx xxxx
+ *                  count += 2;
+ *                  if (count > utflen)
+ *                      throw new UTFDataFormatException();
+ *                  char2 = (int) bytearr[count-1];
+ *                  if ((char2 & 0xC0) != 0x80)
+ *                      throw new UTFDataFormatException();
+ *                  str.append((char)(((c & 0x1F) << 6) | (char2 & 0x3F)));
+ *                  break;
+ *              case 14:
+ *                  // 1110 xxxx  10xx xxxx  10xx xxxx
+ *                  count += 3;
+ *                  if (count > utflen)
+ *                      throw new UTFDataFormatException();
+ *                  char2 = (int) bytearr[count-2];
+ *                  char3 = (int) bytearr[count-1];
+ *                  if (((char2 & 0xC0) != 0x80) || ((char3 & 0xC0) != 0x80))
+ *                      throw new UTFDataFormatException();
+ *                  str.append((char)(((c     & 0x0F) << 12) |
+ *                                    ((char2 & 0x3F) << 6)  |
+ *                                    ((char3 & 0x3F) << 0)));
+ *                  break;
+ *              default:
+ *                  // 10xx xxxx,  1111 xxxx
+ *                  throw new UTFDataFormatException();
+ *              }
+ *      }
+ *      // The number of chars produced may be less than utflen
+ *      return new String(str);
+ *  }
+ ****/
+
+    /**
+     * Decodes the modified UTF-8 read by <code>readUTF</code>.
+     *
+     * @param      src      the bytes.
+     * @param      length   the number of bytes.
+     * @param      dst      room for at least <code>length</code> chars.
+     * @return     the number of chars.
+     * @exception  UTFDataFormatException  if the bytes do not represent a
+     *             valid UTF-8 encoding of a Unicode string.
+     */
+    private static native int decodeUTF(byte[] src, int length, char[] dst)
+        throws UTFDataFormatException;
+
     /**
      * Skips over and discards <code>n</code> bytes of data from the
      * input stream. The <code>skip</code> method may, for a variety of
@@ -80,6 +80,9 @@ class String {
     /** The count is the number of characters in the String. */
     private int count;
 
+    /** Cache of the hash code of the String, or 0 if not yet computed. */
+    private int hash;
+
     /**
      * Initializes a newly created <code>String</code> object so that it
      * represents an empty character sequence.
@@ -433,24 +436,27 @@ class String {
      * @exception java.lang.NullPointerException if <code>anotherString</code>
      *          is <code>null</code>.
      */
-    public int compareTo(String anotherString) {
-        int len1 = count;
-        int len2 = anotherString.count;
-        int n = Math.min(len1, len2);
-        char v1[] = value;
-        char v2[] = anotherString.value;
-        int i = offset;
-        int j = anotherString.offset;
-
-        while (n-- != 0) {
-            char c1 = v1[i++];
-            char c2 = v2[j++];
-            if (c1 != c2) {
-                return c1 - c2;
-            }
-        }
-        return len1 - len2;
-    }
+    public native int compareTo(String anotherString);
+/************
+ *  public int compareTo(String anotherString) {
+ *      int len1 = count;
+ *      int len2 = anotherString.count;
+ *      int n = Math.min(len1, len2);
+ *      char v1[] = value;
+ *      char v2[] = anotherString.value;
+ *      int i = offset;
+ *      int j = anotherString.offset;
+ *
+ *      while (n-- != 0) {
+ *          char c1 = v1[i++];
+ *          char c2 = v2[j++];
+ *          if (c1 != c2) {
+ *              return c1 - c2;
+ *          }
+ *      }
+ *      return len1 - len2;
+ *  }
+ ******/
 
     /**
      * Tests if two string regions are equal.
@@ -516,6 +522,9 @@ class String {
             (ooffset > (long)other.count - len)) {
             return false;
         }
+        if (!ignoreCase) {
+            return regionMatches(toffset, other, ooffset, len);
+        }
         while (len-- > 0) {
             char c1 = ta[to++];
             char c2 = pa[po++];
@@ -542,6 +551,13 @@ class String {
         return true;
     }
 
+    /**
+     * Compares two string regions character by character.  The
+     * caller has already checked that both regions are within bounds.
+     */
+    private native boolean regionMatches(int toffset, String other,
+                                         int ooffset, int len);
+
     /**
      * Tests if this string starts with the specified prefix beginning
      * a specified index.
@@ -561,24 +577,27 @@ class String {
      * @exception java.lang.NullPointerException if <code>prefix</code> is
      *          <code>null</code>.
      */
-    public boolean startsWith(String prefix, int toffset) {
-        char ta[] = value;
-        int to = offset + toffset;
-        int tlim = offset + count;
-        char pa[] = prefix.value;
-        int po = prefix.offset;
-        int pc = prefix.count;
-        // Note: toffset might be near -1>>>1.
-        if ((toffset < 0) || (toffset > count - pc)) {
-            return false;
-        }
-        while (--pc >= 0) {
-            if (ta[to++] != pa[po++]) {
-                return false;
-            }
-        }
-        return true;
-    }
+    public native boolean startsWith(String prefix, int toffset);
+/************
+ *  public boolean startsWith(String prefix, int toffset) {
+ *      char ta[] = value;
+ *      int to = offset + toffset;
+ *      int tlim = offset + count;
+ *      char pa[] = prefix.value;
+ *      int po = prefix.offset;
+ *      int pc = prefix.count;
+ *      // Note: toffset might be near -1>>>1.
+ *      if ((toffset < 0) || (toffset > count - pc)) {
+ *          return false;
+ *      }
+ *      while (--pc >= 0) {
+ *          if (ta[to++] != pa[po++]) {
+ *              return false;
+ *          }
+ *      }
+ *      return true;
+ *  }
+ ******/
 
     /**
      * Tests if this string starts with the specified prefix.
@@ -629,17 +648,23 @@ class String {
      *
      * @return  a hash code value for this object.
      */
-    public int hashCode() {
-        int h = 0;
-        int off = offset;
-        char val[] = value;
-        int len = count;
-
-        for (int i = 0; i < len; i++) {
-            h = 31*h + val[off++];
-        }
-        return h;
-    }
+    public native int hashCode();
+/************
+ *  public int hashCode() {
+ *      int h = hash;
+ *      if (h == 0) {
+ *          int off = offset;
+ *          char val[] = value;
+ *          int len = count;
+ *
+ *          for (int i = 0; i < len; i++) {
+ *              h = 31*h + val[off++];
+ *          }
+ *          hash = h;
+ *      }
+ *      return h;
+ *  }
+ ******/
 
     /**
      * Returns the index within this string of the first occurrence of the
@@ -758,17 +783,20 @@ class String {
      *          than or equal to <code>fromIndex</code>, or <code>-1</code>
      *          if the character does not occur before that point.
      */
-    public int lastIndexOf(int ch, int fromIndex) {
-        int min = offset;
-        char v[] = value;
-
-        for (int i = offset + ((fromIndex >= count) ? count - 1 : fromIndex) ; i >= min ; i--) {
-            if (v[i] == ch) {
-                return i - offset;
-            }
-        }
-        return -1;
-    }
+    public native int lastIndexOf(int ch, int fromIndex);
+/************
+ *  public int lastIndexOf(int ch, int fromIndex) {
+ *      int min = offset;
+ *      char v[] = value;
+ *
+ *      for (int i = offset + ((fromIndex >= count) ? count - 1 : fromIndex) ; i >= min ; i--) {
+ *          if (v[i] == ch) {
+ *              return i - offset;
+ *          }
+ *      }
+ *      return -1;
+ *  }
+ ******/
 
     /**
      * Returns the index within this string of the first occurrence of the
@@ -817,54 +845,57 @@ class String {
      * @exception java.lang.NullPointerException if <code>str</code> is
      *          <code>null</code>
      */
-    public int indexOf(String str, int fromIndex) {
-        char v1[] = value;
-        char v2[] = str.value;
-        int max = offset + (count - str.count);
-        if (fromIndex >= count) {
-            if (count == 0 && fromIndex == 0 && str.count == 0) {
-                /* There is an empty string at index 0 in an empty string. */
-                return 0;
-            }
-            /* Note: fromIndex might be near -1>>>1 */
-            return -1;
-        }
-        if (fromIndex < 0) {
-            fromIndex = 0;
-        }
-        if (str.count == 0) {
-            return fromIndex;
-        }
-
-        int strOffset = str.offset;
-        char first  = v2[strOffset];
-        int i = offset + fromIndex;
-
-    startSearchForFirstChar:
-        while (true) {
-
-            /* Look for first character. */
-            while (i <= max && v1[i] != first) {
-                i++;
-            }
-            if (i > max) {
-                return -1;
-            }
-
-            /* Found first character, now look at the rest of v2 */
-            int j = i + 1;
-            int end = j + str.count - 1;
-            int k = strOffset + 1;
-            while (j < end) {
-                if (v1[j++] != v2[k++]) {
-                    i++;
-                    /* Look for str's first char again. */
-                    continue startSearchForFirstChar;
-                }
-            }
-            return i - offset;  /* Found whole string. */
-        }
-    }
+    public native int indexOf(String str, int fromIndex);
+/************
+ *  public int indexOf(String str, int fromIndex) {
+ *      char v1[] = value;
+ *      char v2[] = str.value;
+ *      int max = offset + (count - str.count);
+ *      if (fromIndex >= count) {
+ *          if (count == 0 && fromIndex == 0 && str.count == 0) {
+ *              // There is an empty string at index 0 in an empty string.
+ *              return 0;
+ *          }
+ *          // Note: fromIndex might be near -1>>>1
+ *          return -1;
+ *      }
+ *      if (fromIndex < 0) {
+ *          fromIndex = 0;
+ *      }
+ *      if (str.count == 0) {
+ *          return fromIndex;
+ *      }
+ *
+ *      int strOffset = str.offset;
+ *      char first  = v2[strOffset];
+ *      int i = offset + fromIndex;
+ *
+ *  startSearchForFirstChar:
+ *      while (true) {
+ *
+ *          // Look for first character.
+ *          while (i <= max && v1[i] != first) {
+ *              i++;
+ *          }
+ *          if (i > max) {
+ *              return -1;
+ *          }
+ *
+ *          // Found first character, now look at the rest of v2
+ *          int j = i + 1;
+ *          int end = j + str.count - 1;
+ *          int k = strOffset + 1;
+ *          while (j < end) {
+ *              if (v1[j++] != v2[k++]) {
+ *                  i++;
+ *                  // Look for str's first char again.
+ *                  continue startSearchForFirstChar;
+ *              }
+ *          }
+ *          return i - offset;  // Found whole string.
+ *      }
+ *  }
+ ******/
 
     /**
      * Returns a new string that is a substring of this string. The
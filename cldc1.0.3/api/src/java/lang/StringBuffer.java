@@ -229,34 +229,37 @@ public final class StringBuffer {
      *               <code>newLength</code> argument is negative.
      * @see        java.lang.StringBuffer#length()
      */
-    public synchronized void setLength(int newLength) {
-        if (newLength < 0) {
-            throw new StringIndexOutOfBoundsException(newLength);
-        }
-        
-        if (newLength > value.length) {
-            expandCapacity(newLength);
-        }
-
-        if (count < newLength) {
-            if (shared) copy();
-            for (; count < newLength; count++) {
-                value[count] = '\0';
-            }
-        } else {
-            count = newLength;
-            if (shared) {
-                if (newLength > 0) {
-                    copy();
-                } else {
-                    // If newLength is zero, assume the StringBuffer is being
-                    // stripped for reuse; Make new buffer of default size
-                    value = new char[16];
-                    shared = false;
-                }
-            }
-        }
-    }
+    public native synchronized void setLength(int newLength);
+/*****
+ *  public synchronized void setLength(int newLength) {
+ *      if (newLength < 0) {
+ *          throw new StringIndexOutOfBoundsException(newLength);
+ *      }
+ *      
+ *      if (newLength > value.length) {
+ *          expandCapacity(newLength);
+ *      }
+ *
+ *      if (count < newLength) {
+ *          if (shared) copy();
+ *          for (; count < newLength; count++) {
+ *              value[count] = '\0';
+ *          }
+ *      } else {
+ *          count = newLength;
+ *          if (shared) {
+ *              if (newLength > 0) {
+ *                  copy();
+ *              } else {
+ *                  // If newLength is zero, assume the StringBuffer is being
+ *                  // stripped for reuse; Make new buffer of default size
+ *                  value = new char[16];
+ *                  shared = false;
+ *              }
+ *          }
+ *      }
+ *  }
+ *****/
 
     /**
      * The specified character of the sequence currently represented by 
@@ -419,15 +422,18 @@ public final class StringBuffer {
      * @param   str   the characters to be appended.
      * @return  a reference to this <code>StringBuffer</code> object.
      */
-    public synchronized StringBuffer append(char str[]) {
-        int len = str.length;
-        int newcount = count + len;
-        if (newcount > value.length)
-            expandCapacity(newcount);
-        System.arraycopy(str, 0, value, count, len);
-        count = newcount;
-        return this;
-    }
+    public native synchronized StringBuffer append(char str[]);
+/*****
+ *  public synchronized StringBuffer append(char str[]) {
+ *      int len = str.length;
+ *      int newcount = count + len;
+ *      if (newcount > value.length)
+ *          expandCapacity(newcount);
+ *      System.arraycopy(str, 0, value, count, len);
+ *      count = newcount;
+ *      return this;
+ *  }
+ *****/
 
     /**
      * Appends the string representation of a subarray of the 
@@ -448,14 +454,18 @@ public final class StringBuffer {
      * @param   len      the number of characters to append.
      * @return  a reference to this <code>StringBuffer</code> object.
      */
-    public synchronized StringBuffer append(char str[], int offset, int len) {
-        int newcount = count + len;
-        if (newcount > value.length)
-            expandCapacity(newcount);
-        System.arraycopy(str, offset, value, count, len);
-        count = newcount;
-        return this;
-    }
+    public native synchronized StringBuffer append(char str[], int offset,
+                                                  int len);
+/*****
+ *  public synchronized StringBuffer append(char str[], int offset, int len) {
+ *      int newcount = count + len;
+ *      if (newcount > value.length)
+ *          expandCapacity(newcount);
+ *      System.arraycopy(str, offset, value, count, len);
+ *      count = newcount;
+ *      return this;
+ *  }
+ *****/
 
     /**
      * Appends the string representation of the <code>boolean</code> 
@@ -489,13 +499,16 @@ public final class StringBuffer {
      * @param   c   a <code>char</code>.
      * @return  a reference to this <code>StringBuffer</code> object.
      */
-    public synchronized StringBuffer append(char c) {
-        int newcount = count + 1;
-        if (newcount > value.length)
-            expandCapacity(newcount);
-        value[count++] = c;
-        return this;
-    }
+    public native synchronized StringBuffer append(char c);
+/*****
+ *  public synchronized StringBuffer append(char c) {
+ *      int newcount = count + 1;
+ *      if (newcount > value.length)
+ *          expandCapacity(newcount);
+ *      value[count++] = c;
+ *      return this;
+ *  }
+ *****/
 
     /**
      * Appends the string representation of the <code>int</code> 
@@ -510,7 +523,7 @@ public final class StringBuffer {
      * @see     java.lang.String#valueOf(int)
      * @see     java.lang.StringBuffer#append(java.lang.String)
      */
-    public native StringBuffer append(int i);
+    public native synchronized StringBuffer append(int i);
 /******        
  *  public StringBuffer append(int i) {
  *      return append(String.valueOf(i));
@@ -531,6 +544,10 @@ public final class StringBuffer {
      * @see     java.lang.StringBuffer#append(java.lang.String)
      */
     public StringBuffer append(long l) {
+        if (l == (int)l) {
+            /* Most longs are small enough for the native append(int) */
+            return append((int)l);
+        }
         return append(String.valueOf(l));
     }
 
@@ -646,25 +663,28 @@ public final class StringBuffer {
      * @exception  StringIndexOutOfBoundsException  if the offset is invalid.
      * @see        java.lang.StringBuffer#length()
      */
-    public synchronized StringBuffer insert(int offset, String str) {
-        if ((offset < 0) || (offset > count)) {
-            throw new StringIndexOutOfBoundsException();
-        }
-
-        if (str == null) {
-            str = String.valueOf(str);
-        }
-        int len = str.length();
-        int newcount = count + len;
-        if (newcount > value.length)
-            expandCapacity(newcount);
-        else if (shared)
-            copy();
-        System.arraycopy(value, offset, value, offset + len, count - offset);
-        str.getChars(0, len, value, offset);
-        count = newcount;
-        return this;
-    }
+    public native synchronized StringBuffer insert(int offset, String str);
+/*****
+ *  public synchronized StringBuffer insert(int offset, String str) {
+ *      if ((offset < 0) || (offset > count)) {
+ *          throw new StringIndexOutOfBoundsException();
+ *      }
+ *
+ *      if (str == null) {
+ *          str = String.valueOf(str);
+ *      }
+ *      int len = str.length();
+ *      int newcount = count + len;
+ *      if (newcount > value.length)
+ *          expandCapacity(newcount);
+ *      else if (shared)
+ *          copy();
+ *      System.arraycopy(value, offset, value, offset + len, count - offset);
+ *      str.getChars(0, len, value, offset);
+ *      count = newcount;
+ *      return this;
+ *  }
+ *****/
 
     /**
      * Inserts the string representation of the <code>char</code> array 
@@ -752,17 +772,20 @@ public final class StringBuffer {
      * @exception  IndexOutOfBoundsException  if the offset is invalid.
      * @see        java.lang.StringBuffer#length()
      */
-    public synchronized StringBuffer insert(int offset, char c) {
-        int newcount = count + 1;
-        if (newcount > value.length)
-            expandCapacity(newcount);
-        else if (shared)
-            copy();
-        System.arraycopy(value, offset, value, offset + 1, count - offset);
-        value[offset] = c;
-        count = newcount;
-        return this;
-    }
+    public native synchronized StringBuffer insert(int offset, char c);
+/*****
+ *  public synchronized StringBuffer insert(int offset, char c) {
+ *      int newcount = count + 1;
+ *      if (newcount > value.length)
+ *          expandCapacity(newcount);
+ *      else if (shared)
+ *          copy();
+ *      System.arraycopy(value, offset, value, offset + 1, count - offset);
+ *      value[offset] = c;
+ *      count = newcount;
+ *      return this;
+ *  }
+ *****/
 
     /**
      * Inserts the string representation of the second <code>int</code> 
@@ -0,0 +1,538 @@
+/*
+ * Copyright 1995-2001 by Sun Microsystems, Inc.,
+ * 901 San Antonio Road, Palo Alto, California, 94303, U.S.A.
+ * All rights reserved.
+ *
+ * This software is the confidential and proprietary information
+ * of Sun Microsystems, Inc. ("Confidential Information").  You
+ * shall not disclose such Confidential Information and shall use
+ * it only in accordance with the terms of the license agreement
+ * you entered into with Sun.
+ */
+
+package java.util;
+
+import java.io.*;
+
+/**
+ * This class implements a hashtable, which maps keys to values. Any
+ * non-<code>null</code> object can be used as a key or as a value.
+ * <p>
+ * To successfully store and retrieve objects from a hashtable, the
+ * objects used as keys must implement the <code>hashCode</code>
+ * method and the <code>equals</code> method.
+ *
+ * <p>
+ * An instance of <code>Hashtable</code> has two parameters that
+ * affect its efficiency: its <i>capacity</i> and its <i>load
+ * factor</i>. The load factor should be between 0.0 and 1.0. When
+ * the number of entries in the hashtable exceeds the product of the
+ * load factor and the current capacity, the capacity is increased by
+ * calling the <code>rehash</code> method. Larger load factors use
+ * memory more efficiently, at the expense of larger expected time
+ * per lookup.
+ * <p>
+ * If many entries are to be made into a <code>Hashtable</code>,
+ * creating it with a sufficiently large capacity may allow the
+ * entries to be inserted more efficiently than letting it perform
+ * automatic rehashing as needed to grow the table.
+ * <p>
+ * This example creates a hashtable of numbers. It uses the names of
+ * the numbers as keys:
+ * <p><blockquote><pre>
+ *     Hashtable numbers = new Hashtable();
+ *     numbers.put("one", new Integer(1));
+ *     numbers.put("two", new Integer(2));
+ *     numbers.put("three", new Integer(3));
+ * </pre></blockquote>
+ * <p>
+ * To retrieve a number, use the following code:
+ * <p><blockquote><pre>
+ *     Integer n = (Integer)numbers.get("two");
+ *     if (n != null) {
+ *         System.out.println("two = " + n);
+ *     }
+ * </pre></blockquote>
+ * <p>
+ * Note: To conserve space, the CLDC implementation 
+ * is based on JDK 1.1.8, not JDK 1.3.
+ * <p>
+ * This version of the class does not allocate an entry object per
+ * mapping.  It keeps the keys, the values and the hash codes of the
+ * keys in three parallel arrays and resolves collisions by linear
+ * probing.  Lookups of <code>String</code> and <code>Integer</code>
+ * keys are done by a native method.  It is used instead of the
+ * chained version when the class library is built with
+ * <code>OPEN_HASHTABLE=true</code>.
+ *
+ * @author  Arthur van Hoff
+ * @version 1.42, 07/01/98 (CLDC 1.0, Spring 2000)
+ * @see     java.lang.Object#equals(java.lang.Object)
+ * @see     java.lang.Object#hashCode()
+ * @see     java.util.Hashtable#rehash()
+ * @since   JDK1.0
+ */
+public
+class Hashtable {
+
+    /**
+     * The keys of the hash table.  A slot that has never been used
+     * holds <code>null</code>; a slot whose mapping has been removed
+     * holds <code>DELETED</code>, so that probing continues past it.
+     */
+    private transient Object keys[];
+
+    /**
+     * The values of the hash table, in the slots of their keys.
+     */
+    private transient Object values[];
+
+    /**
+     * The hash codes of the keys, in the slots of their keys.
+     */
+    private transient int hashes[];
+
+    /**
+     * The total number of entries in the hash table.
+     */
+    private transient int count;
+
+    /**
+     * The number of slots that are not <code>null</code>, that is
+     * the entries plus the removed slots.
+     */
+    private transient int used;
+
+    /**
+     * Rehashes the table when the number of used slots exceeds this
+     * threshold.
+     */
+    private int threshold;
+
+    /**
+     * The load factor for the hashtable.
+     */
+    private static final int loadFactorPercent = 75;
+
+    /**
+     * Marks the slot of a removed entry.
+     */
+    static final Object DELETED = new Object();
+
+    /**
+     * Returned by <code>probe</code> when it cannot decide whether
+     * a key is in the table.
+     */
+    private static final int UNDECIDED = 0x80000000;
+
+    /**
+     * Constructs a new, empty hashtable with the specified initial
+     * capacity.
+     *
+     * @param      initialCapacity   the initial capacity of the hashtable.
+     * @exception  IllegalArgumentException  if the initial capacity is less
+     *             than zero
+     * @since      JDK1.0
+     */
+    public Hashtable(int initialCapacity) {
+        if (initialCapacity < 0) {
+            throw new IllegalArgumentException();
+        }
+        if (initialCapacity == 0) {
+            initialCapacity = 1;
+        }
+        keys = new Object[initialCapacity];
+        values = new Object[initialCapacity];
+        hashes = new int[initialCapacity];
+        threshold = (int)((initialCapacity * loadFactorPercent) / 100);
+    }
+
+    /**
+     * Constructs a new, empty hashtable with a default capacity and load
+     * factor.
+     *
+     * @since   JDK1.0
+     */
+    public Hashtable() {
+        this(11);
+    }
+
+    /**
+     * Returns the number of keys in this hashtable.
+     *
+     * @return  the number of keys in this hashtable.
+     * @since   JDK1.0
+     */
+    public int size() {
+        return count;
+    }
+
+    /**
+     * Tests if this hashtable maps no keys to values.
+     *
+     * @return  <code>true</code> if this hashtable maps no keys to values;
+     *          <code>false</code> otherwise.
+     * @since   JDK1.0
+     */
+    public boolean isEmpty() {
+        return count == 0;
+    }
+
+    /**
+     * Returns an enumeration of the keys in this hashtable.
+     *
+     * @return  an enumeration of the keys in this hashtable.
+     * @see     java.util.Enumeration
+     * @see     java.util.Hashtable#elements()
+     * @since   JDK1.0
+     */
+    public synchronized Enumeration keys() {
+        return new HashtableEnumerator(keys, values, true);
+    }
+
+    /**
+     * Returns an enumeration of the values in this hashtable.
+     * Use the Enumeration methods on the returned object to fetch the elements
+     * sequentially.
+     *
+     * @return  an enumeration of the values in this hashtable.
+     * @see     java.util.Enumeration
+     * @see     java.util.Hashtable#keys()
+     * @since   JDK1.0
+     */
+    public synchronized Enumeration elements() {
+        return new HashtableEnumerator(keys, values, false);
+    }
+
+    /**
+     * Tests if some key maps into the specified value in this hashtable.
+     * This operation is more expensive than the <code>containsKey</code>
+     * method.
+     *
+     * @param      value   a value to search for.
+     * @return     <code>true</code> if some key maps to the
+     *             <code>value</code> argument in this hashtable;
+     *             <code>false</code> otherwise.
+     * @exception  NullPointerException  if the value is <code>null</code>.
+     * @see        java.util.Hashtable#containsKey(java.lang.Object)
+     * @since      JDK1.0
+     */
+    public synchronized boolean contains(Object value) {
+        if (value == null) {
+            throw new NullPointerException();
+        }
+
+        /* The value of an unused or removed slot is null */
+        Object vals[] = values;
+        for (int i = vals.length ; i-- > 0 ;) {
+            if (vals[i] != null && vals[i].equals(value)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Tests if the specified object is a key in this hashtable.
+     *
+     * @param   key   possible key.
+     * @return  <code>true</code> if the specified object is a key in this
+     *          hashtable; <code>false</code> otherwise.
+     * @see     java.util.Hashtable#contains(java.lang.Object)
+     * @since   JDK1.0
+     */
+    public synchronized boolean containsKey(Object key) {
+        return locate(key, key.hashCode()) >= 0;
+    }
+
+    /**
+     * Returns the value to which the specified key is mapped in this hashtable.
+     *
+     * @param   key   a key in the hashtable.
+     * @return  the value to which the key is mapped in this hashtable;
+     *          <code>null</code> if the key is not mapped to any value in
+     *          this hashtable.
+     * @see     java.util.Hashtable#put(java.lang.Object, java.lang.Object)
+     * @since   JDK1.0
+     */
+    public synchronized Object get(Object key) {
+        int index = locate(key, key.hashCode());
+        return (index >= 0) ? values[index] : null;
+    }
+
+    /**
+     * Finds the slot of a key.
+     *
+     * @param   key    the key.
+     * @param   hash   the hash code of the key.
+     * @return  the index of the slot holding the key, or, if the key
+     *          is not in the table, <code>-1 - index</code> where
+     *          <code>index</code> is the slot a new entry for the key
+     *          should go into.
+     */
+    private int locate(Object key, int hash) {
+        if (key instanceof String || key instanceof Integer) {
+            int index = probe(keys, hashes, key, hash, DELETED);
+            if (index != UNDECIDED) {
+                return index;
+            }
+        }
+
+        Object tab[] = keys;
+        int length = tab.length;
+        int index = (hash & 0x7FFFFFFF) % length;
+        int free = -1;
+        for (Object k ; (k = tab[index]) != null ; ) {
+            if (k == DELETED) {
+                if (free < 0) {
+                    free = index;
+                }
+            } else if ((hashes[index] == hash) && k.equals(key)) {
+                return index;
+            }
+            if (++index == length) {
+                index = 0;
+            }
+        }
+        return -1 - ((free >= 0) ? free : index);
+    }
+
+    /**
+     * Does what <code>locate</code> does for a <code>String</code> or
+     * <code>Integer</code> key, without calling <code>equals</code>.
+     * Returns <code>UNDECIDED</code> if it finds a key with the same
+     * hash code whose class differs from that of <code>key</code>,
+     * since only that key's <code>equals</code> method can tell
+     * whether the two are equal.
+     */
+    private static native int probe(Object keys[], int hashes[],
+                                    Object key, int hash, Object deleted);
+
+    /**
+     * Rehashes the contents of the hashtable into a hashtable with a
+     * larger capacity. This method is called automatically when the
+     * number of keys in the hashtable exceeds this hashtable's capacity
+     * and load factor.  If most of the used slots belong to removed
+     * entries, the capacity is kept and the removed slots are
+     * reclaimed instead.
+     *
+     * @since   JDK1.0
+     */
+    protected void rehash() {
+        int oldCapacity = keys.length;
+        Object oldKeys[] = keys;
+        Object oldValues[] = values;
+        int oldHashes[] = hashes;
+
+        int newCapacity = (count >= threshold / 2) ? oldCapacity * 2 + 1
+                                                   : oldCapacity;
+        Object newKeys[] = new Object[newCapacity];
+        Object newValues[] = new Object[newCapacity];
+        int newHashes[] = new int[newCapacity];
+
+        threshold = (int)((newCapacity * loadFactorPercent) / 100);
+        keys = newKeys;
+        values = newValues;
+        hashes = newHashes;
+        used = count;
+
+        for (int i = oldCapacity ; i-- > 0 ;) {
+            Object key = oldKeys[i];
+            if (key != null && key != DELETED) {
+                int hash = oldHashes[i];
+                int index = (hash & 0x7FFFFFFF) % newCapacity;
+                while (newKeys[index] != null) {
+                    if (++index == newCapacity) {
+                        index = 0;
+                    }
+                }
+                newKeys[index] = key;
+                newValues[index] = oldValues[i];
+                newHashes[index] = hash;
+            }
+        }
+    }
+
+    /**
+     * Maps the specified <code>key</code> to the specified
+     * <code>value</code> in this hashtable. Neither the key nor the
+     * value can be <code>null</code>.
+     * <p>
+     * The value can be retrieved by calling the <code>get</code> method
+     * with a key that is equal to the original key.
+     *
+     * @param      key     the hashtable key.
+     * @param      value   the value.
+     * @return     the previous value of the specified key in this hashtable,
+     *             or <code>null</code> if it did not have one.
+     * @exception  NullPointerException  if the key or value is
+     *               <code>null</code>.
+     * @see     java.lang.Object#equals(java.lang.Object)
+     * @see     java.util.Hashtable#get(java.lang.Object)
+     * @since   JDK1.0
+     */
+    public synchronized Object put(Object key, Object value) {
+        // Make sure the value is not null
+        if (value == null) {
+            throw new NullPointerException();
+        }
+
+        // Makes sure the key is not already in the hashtable.
+        int hash = key.hashCode();
+        int index = locate(key, hash);
+        if (index >= 0) {
+            Object old = values[index];
+            values[index] = value;
+            return old;
+        }
+
+        index = -1 - index;
+        if (keys[index] == null) {
+            if (used >= threshold) {
+                // Rehash the table if the threshold is exceeded
+                rehash();
+                return put(key, value);
+            }
+            used++;
+        }
+
+        // Fills the slot of the new entry.
+        keys[index] = key;
+        values[index] = value;
+        hashes[index] = hash;
+        count++;
+        return null;
+    }
+
+    /**
+     * Removes the key (and its corresponding value) from this
+     * hashtable. This method does nothing if the key is not in the hashtable.
+     *
+     * @param   key   the key that needs to be removed.
+     * @return  the value to which the key had been mapped in this hashtable,
+     *          or <code>null</code> if the key did not have a mapping.
+     * @since   JDK1.0
+     */
+    public synchronized Object remove(Object key) {
+        int index = locate(key, key.hashCode());
+        if (index < 0) {
+            return null;
+        }
+
+        Object tab[] = keys;
+        int length = tab.length;
+        Object old = values[index];
+        values[index] = null;
+        count--;
+
+        if (tab[(index + 1) % length] != null) {
+            // Other keys may have been probed past this slot
+            tab[index] = DELETED;
+        } else {
+            // The end of a run of used slots: no probe needs this
+            // slot or the removed slots just before it
+            do {
+                tab[index] = null;
+                used--;
+                index = ((index == 0) ? length : index) - 1;
+            } while (tab[index] == DELETED);
+        }
+        return old;
+    }
+
+    /**
+     * Clears this hashtable so that it contains no keys.
+     *
+     * @since   JDK1.0
+     */
+    public synchronized void clear() {
+        Object tab[] = keys;
+        Object vals[] = values;
+        for (int index = tab.length; --index >= 0; ) {
+            tab[index] = null;
+            vals[index] = null;
+        }
+        count = 0;
+        used = 0;
+    }
+
+    /**
+     * Returns a rather long string representation of this hashtable.
+     *
+     * @return  a string representation of this hashtable.
+     * @since   JDK1.0
+     */
+    public synchronized String toString() {
+        int max = size() - 1;
+        StringBuffer buf = new StringBuffer();
+        Enumeration k = keys();
+        Enumeration e = elements();
+        buf.append("{");
+
+        for (int i = 0; i <= max; i++) {
+            String s1 = k.nextElement().toString();
+            String s2 = e.nextElement().toString();
+            buf.append(s1 + "=" + s2);
+            if (i < max) {
+                buf.append(", ");
+            }
+        }
+        buf.append("}");
+        return buf.toString();
+    }
+
+    /**
+     * A hashtable enumerator class.  This class should remain opaque
+     * to the client. It will use the Enumeration interface.
+     * <p>
+     * Like the enumerator of the chained hashtable, it walks the slots
+     * from the last to the first and is not fail-fast.  Once
+     * <code>hasMoreElements</code> has found an entry, that entry is
+     * returned by the next <code>nextElement</code> even if it has been
+     * removed in between.  A value replaced in between is returned as
+     * replaced.
+     */
+    class HashtableEnumerator implements Enumeration {
+        boolean keys;
+        int index;
+        Object keyTable[];
+        Object valueTable[];
+        Object key;
+        Object value;
+
+        HashtableEnumerator(Object keyTable[], Object valueTable[],
+                            boolean keys) {
+            this.keyTable = keyTable;
+            this.valueTable = valueTable;
+            this.keys = keys;
+            this.index = keyTable.length;
+        }
+
+        public boolean hasMoreElements() {
+            if (key != null) {
+                return true;
+            }
+            while (index-- > 0) {
+                Object k = keyTable[index];
+                if (k != null && k != DELETED) {
+                    key = k;
+                    value = valueTable[index];
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        public Object nextElement() {
+            if (hasMoreElements()) {
+                Object k = key;
+                key = null;
+                if (keys) {
+                    return k;
+                }
+                return (keyTable[index] == k) ? valueTable[index] : value;
+            }
+            throw new NoSuchElementException("HashtableEnumerator");
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      allocprof.h
+ * OVERVIEW:  Allocation profiler.  The object allocators report every
+ *            Java object they create; the profiler charges the bytes
+ *            to the class of the object and to the allocation site
+ *            of the current thread.  At exit, and on every snapshot,
+ *            the top sites and classes are written out (see
+ *            ENABLE_ALLOCATION_PROFILER in main.h).
+ *=======================================================================*/
+
+#if ENABLE_ALLOCATION_PROFILER
+
+/*=========================================================================
+ * Allocation profiler variables
+ *=======================================================================*/
+
+extern char* AllocationProfilerFile;     /* Report file, NULL if not */
+                                         /* profiling */
+extern long  AllocationProfilerInterval; /* Bytes per recorded allocation */
+extern long  AllocationBytesPending;     /* Bytes not recorded yet */
+
+extern volatile int AllocationSnapshotRequests; /* Counted by the port */
+
+/*=========================================================================
+ * Allocation profiler operations
+ *=======================================================================*/
+
+void InitializeAllocationProfiler(void);
+void FinalizeAllocationProfiler(void);
+
+void recordAllocation(CLASS clazz, long bytes);
+bool_t writeAllocationSnapshot(void);
+void checkAllocationSnapshot(void);
+
+/* Ask for a snapshot at the next reschedule point (signal handler safe) */
+#define requestAllocationSnapshot() (AllocationSnapshotRequests++)
+
+/*
+ * Called by the allocators for every new Java object of "size"
+ * cells (not counting the header)
+ */
+#define RECORD_ALLOCATION(clazz, size)                                \
+    if (AllocationProfilerFile != NULL) {                             \
+        long _bytes_ = ((size) + HEADERSIZE) << log2CELL;             \
+        AllocationBytesPending += _bytes_;                            \
+        if (AllocationBytesPending >= AllocationProfilerInterval) {   \
+            recordAllocation((CLASS)(clazz), _bytes_);                \
+        }                                                             \
+    }
+
+#else
+
+#define InitializeAllocationProfiler()
+#define FinalizeAllocationProfiler()
+#define checkAllocationSnapshot()
+
+#define RECORD_ALLOCATION(clazz, size)
+
+#endif /* ENABLE_ALLOCATION_PROFILER */
+
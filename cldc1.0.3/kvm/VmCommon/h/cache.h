@@ -65,10 +65,10 @@
 /*  The master inline cache in the system */
 /*  In principle, each thread could have its own inline cache area, */
 /*  but this would not improve performance substantially. */
-extern ICACHE InlineCache;
+extern ISOLATE_LOCAL ICACHE InlineCache;
 
 /*  Index of the next inline cache entry to be used */
-extern int InlineCachePointer;
+extern ISOLATE_LOCAL int InlineCachePointer;
 
 /*=========================================================================
  * Inline cache structures
@@ -101,6 +101,7 @@ extern int InlineCachePointer;
 /*  ICACHE (allocated in inline cache area) */
 struct icacheStruct {
     cell* contents;  /* Cache contents (used differently in different entries) */
+    cell* contents2; /* More contents (only used by ARRAYCOPY_FAST) */
     BYTE* codeLoc;   /* Backpointer to the code location using this icache */
     short origParam; /* Original bytecode parameter in (codeLoc+1) */
     BYTE  origInst;  /* Original bytecode instruction in codeLoc */
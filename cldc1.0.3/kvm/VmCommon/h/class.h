@@ -248,6 +248,7 @@ struct stringInstanceStruct {
     SHORTARRAY array;
     cell offset;
     cell length;
+    cell hash;                  /* Cached hash code, or 0 */
 };
 
 /* INTERNED_STRING_INSTANCE */
@@ -257,6 +258,7 @@ struct internedStringInstanceStruct {
     SHORTARRAY array;
     cell offset;
     cell length;
+    cell hash;
     struct internedStringInstanceStruct *next;
 };
 
@@ -332,8 +334,8 @@ struct shortArrayStruct {
 #define SIZEOF_POINTERLIST(n)     (StructSizeInCells(pointerListStruct)+(n-1))
 #define SIZEOF_WEAKPOINTERLIST(n) (StructSizeInCells(weakPointerListStruct)+(n-1))
 
-#define SIZEOF_STRING_INSTANCE           SIZEOF_INSTANCE(3)
-#define SIZEOF_INTERNED_STRING_INSTANCE  SIZEOF_INSTANCE(4)
+#define SIZEOF_STRING_INSTANCE           SIZEOF_INSTANCE(4)
+#define SIZEOF_INTERNED_STRING_INSTANCE  SIZEOF_INSTANCE(5)
 
 /*=========================================================================
  * Definitions that manipulate the monitorOrHashCode (mhc) field
@@ -393,28 +395,29 @@ void setObjectMhcInternal(OBJECT, long);
  *=======================================================================*/
 
 /*  Pointers to the most important Java classes needed by the VM */
-extern INSTANCE_CLASS JavaLangObject;    /* Pointer to java.lang.Object */
-extern INSTANCE_CLASS JavaLangClass;     /* Pointer to java.lang.Class */
-extern INSTANCE_CLASS JavaLangString;    /* Pointer to java.lang.String */
-extern INSTANCE_CLASS JavaLangSystem;    /* Pointer to java.lang.System */
-extern INSTANCE_CLASS JavaLangThread;    /* Pointer to java.lang.Thread */
-extern INSTANCE_CLASS JavaLangThrowable; /* Pointer to java.lang.Throwable */
-extern INSTANCE_CLASS JavaLangError;     /* Pointer to java.lang.Error */
-extern INSTANCE_CLASS JavaLangOutOfMemoryError; /* java.lang.OutOfMemoryError */
+extern ISOLATE_LOCAL INSTANCE_CLASS JavaLangObject;    /* Pointer to java.lang.Object */
+extern ISOLATE_LOCAL INSTANCE_CLASS JavaLangClass;     /* Pointer to java.lang.Class */
+extern ISOLATE_LOCAL INSTANCE_CLASS JavaLangString;    /* Pointer to java.lang.String */
+extern ISOLATE_LOCAL INSTANCE_CLASS JavaLangSystem;    /* Pointer to java.lang.System */
+extern ISOLATE_LOCAL INSTANCE_CLASS JavaLangThread;    /* Pointer to java.lang.Thread */
+extern ISOLATE_LOCAL INSTANCE_CLASS JavaLangThrowable; /* Pointer to java.lang.Throwable */
+extern ISOLATE_LOCAL INSTANCE_CLASS JavaLangError;     /* Pointer to java.lang.Error */
+extern ISOLATE_LOCAL INSTANCE_CLASS JavaLangOutOfMemoryError; /* java.lang.OutOfMemoryError */
+extern ISOLATE_LOCAL INSTANCE_CLASS JavaLangStringBuffer; /* java.lang.StringBuffer */
 extern ARRAY_CLASS    JavaLangCharArray; /* Array of characters */
 
-extern NameTypeKey initNameAndType;
-extern NameTypeKey clinitNameAndType;
-extern NameTypeKey runNameAndType;
-extern NameTypeKey mainNameAndType;
+extern ISOLATE_LOCAL NameTypeKey initNameAndType;
+extern ISOLATE_LOCAL NameTypeKey clinitNameAndType;
+extern ISOLATE_LOCAL NameTypeKey runNameAndType;
+extern ISOLATE_LOCAL NameTypeKey mainNameAndType;
 
 #if CLASS_INITIALIZATION_IN_JAVA
-extern METHOD InitClassMethod;
+extern ISOLATE_LOCAL METHOD InitClassMethod;
 #endif /* CLASS_INITIALIZATION_IN_JAVA */
 
-extern METHOD RunCustomCodeMethod;
-extern THROWABLE_INSTANCE OutOfMemoryObject;
-extern THROWABLE_INSTANCE StackOverflowObject;
+extern ISOLATE_LOCAL METHOD RunCustomCodeMethod;
+extern ISOLATE_LOCAL THROWABLE_INSTANCE OutOfMemoryObject;
+extern ISOLATE_LOCAL THROWABLE_INSTANCE StackOverflowObject;
 
 #define RunCustomCodeMethod_MAX_STACK_SIZE 4
 
@@ -443,7 +446,7 @@ CLASS getClassX(CONST_CHAR_HANDLE nameH, int offset, int length);
 
 ARRAY_CLASS getArrayClass(int depth, INSTANCE_CLASS baseClass, char signCode);
 
-extern ARRAY_CLASS PrimitiveArrayClasses[];
+extern ISOLATE_LOCAL ARRAY_CLASS PrimitiveArrayClasses[];
 ARRAY_CLASS getObjectArrayClass(CLASS elementType);
 
 /* Returns the result.  Note, the return value of the second one is
@@ -464,7 +467,7 @@ INSTANCE_CLASS revertToRawClass(INSTANCE_CLASS clazz);
  * as a result of a call to Class.forName. The loader can then throw the
  * appropriate exception if the load fails.
  */
-extern bool_t LoadingViaReflection;
+extern ISOLATE_LOCAL bool_t LoadingViaReflection;
 
 #if SVM
 /*=========================================================================
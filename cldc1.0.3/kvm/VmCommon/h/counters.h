@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      counters.h
+ * OVERVIEW:  Execution counters.  The interpreter counts the
+ *            invocations and the backward branches (loop iterations)
+ *            of every method, and optionally how often each bytecode
+ *            and each pair of consecutive bytecodes is executed.  At
+ *            exit the hottest methods and bytecode pairs are written
+ *            to a file (see ENABLE_EXECUTION_COUNTERS in main.h).
+ *=======================================================================*/
+
+#if ENABLE_EXECUTION_COUNTERS
+
+/*=========================================================================
+ * Execution counter variables
+ *=======================================================================*/
+
+extern char*  ExecutionCountersFile;    /* Report file, NULL if not counting */
+extern bool_t BytecodeCountersWanted;   /* Count bytecodes and pairs too */
+
+extern bool_t ExecutionCountersEnabled;
+
+/* Indexed by opcode, and by (first opcode << 8) | second opcode; */
+/* NULL unless bytecodes are counted */
+extern unsigned long* BytecodeCounts;
+extern unsigned long* BytecodePairCounts;
+
+/* The last bytecode counted, and where the next one has to start */
+/* to make a pair with it (NULL if no bytecode can)                */
+extern BYTE  PreviousBytecode;
+extern BYTE* NextBytecodeIp;
+
+/*=========================================================================
+ * Execution counter operations
+ *=======================================================================*/
+
+void InitializeExecutionCounters(void);
+void FinalizeExecutionCounters(void);
+
+void countInvocation(METHOD thisMethod);
+void countBackedge(METHOD thisMethod);
+
+/*
+ * The hooks used by the interpreter loop.  Two bytecodes count as a
+ * pair when the second one is executed right after the first one and
+ * starts where the first one ends, that is, when the first one fell
+ * through to the next instruction.  The switches never fall through.
+ * Calls, returns and thrown exceptions leave the code of the method,
+ * so they end the pair (COUNT_PAIR_BREAK), even when execution later
+ * comes back to the next instruction.
+ */
+#define COUNT_INVOCATION(thisMethod)                                  \
+    if (ExecutionCountersEnabled) {                                   \
+        countInvocation(thisMethod);                                  \
+    }
+
+#define COUNT_BACKEDGE(thisMethod)                                    \
+    if (ExecutionCountersEnabled) {                                   \
+        countBackedge(thisMethod);                                    \
+    }
+
+#define COUNT_BYTECODE(ip) {                                          \
+    if (BytecodeCounts != NULL) {                                     \
+        BYTE __op__ = *(ip);                                          \
+        BytecodeCounts[__op__]++;                                     \
+        if ((ip) == NextBytecodeIp) {                                 \
+            BytecodePairCounts[(PreviousBytecode << 8) | __op__]++;   \
+        }                                                             \
+        PreviousBytecode = __op__;                                    \
+        if (__op__ == WIDE) {                                         \
+            NextBytecodeIp = (ip) + ((ip)[1] == IINC ? 6 : 4);        \
+        } else if (byteCodeLengths[__op__] != 0) {                    \
+            NextBytecodeIp = (ip) + byteCodeLengths[__op__];          \
+        } else {                                                      \
+            NextBytecodeIp = NULL;                                    \
+        }                                                             \
+    }                                                                 \
+}
+
+#define COUNT_PAIR_BREAK                                              \
+    NextBytecodeIp = NULL;
+
+#else
+
+#define InitializeExecutionCounters()
+#define FinalizeExecutionCounters()
+
+#define COUNT_INVOCATION(thisMethod)
+#define COUNT_BACKEDGE(thisMethod)
+#define COUNT_BYTECODE(ip)
+#define COUNT_PAIR_BREAK
+
+#endif /* ENABLE_EXECUTION_COUNTERS */
+
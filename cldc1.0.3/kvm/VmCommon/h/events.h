@@ -43,6 +43,31 @@
  * driving the event handling/polling mechanism,
  *=======================================================================*/
 
+#if TIMER_RESCHEDULING
+
+/*
+ * With TIMER_RESCHEDULING the time slice is counted down
+ * by the host timer (see StartRescheduleTimer_md) which
+ * sets RescheduleRequested when it expires.  The interpreter
+ * only tests the flag, so there is nothing to decrement here.
+ */
+#define signalTimeToReschedule() (RescheduleRequested = TRUE)
+
+#define isTimeToReschedule() (RescheduleRequested)
+
+#define checkRescheduleValid() /**/
+
+/*
+ * Give the current thread a fresh time slice
+ * (called whenever a thread is switched in)
+ */
+#define startTimeslice(thread) {                \
+    Timeslice = (thread)->timeslice;            \
+    RescheduleRequested = FALSE;                \
+}
+
+#else /* TIMER_RESCHEDULING */
+
 /*
  * Indicate task switching is necessary
  * (enforce a thread switch)
@@ -67,6 +92,10 @@
 #define checkRescheduleValid() /**/
 #endif /* INCLUDEDEBUGCODE */
 
+#define startTimeslice(thread) (Timeslice = (thread)->timeslice)
+
+#endif /* TIMER_RESCHEDULING */
+
 /*
  * InterpreterHandleEvent
  *
@@ -91,6 +120,22 @@ void InterpreterHandleEvent(ulong64);
 #define __ProcessDebugCmds(x)
 #endif /* ENABLE_JAVA_DEBUGGER */
 
+/*
+ * __RecordRequestedSample()
+ *
+ * Take the sample that the sampling profiler timer asked for.
+ * If the timer tick was the only reason for stopping at this
+ * reschedule point, the current thread simply continues.
+ */
+#if ENABLE_SAMPLING_PROFILER
+#define __RecordRequestedSample()                                   \
+        if (SampleRequested && recordSample()) {                    \
+            break;                                                  \
+        }
+#else
+#define __RecordRequestedSample()
+#endif /* ENABLE_SAMPLING_PROFILER */
+
 /*
  * Reschedule
  *
@@ -104,6 +149,7 @@ void InterpreterHandleEvent(ulong64);
         if (!areAliveThreads()) {                                   \
             return;   /* end of program */                          \
         }                                                           \
+        __RecordRequestedSample()                                   \
         checkTimerQueue(&wakeupTime);                               \
         InterpreterHandleEvent(wakeupTime);                         \
         __ProcessDebugCmds(0);                                      \
@@ -120,7 +166,7 @@ void InterpreterHandleEvent(ulong64);
  * Event handling functions
  *=======================================================================*/
 
-extern int eventCount;                 /* Number of events on event queue */
+extern ISOLATE_LOCAL int eventCount;                 /* Number of events on event queue */
 
 void InitializeEvents(void);
 
@@ -182,6 +182,19 @@
 #define SELECT5(l1, l2, l3, l4, l5)     case l1: case l2: case l3: case l4: case l5: {
 #define SELECT6(l1, l2, l3, l4, l5, l6) case l1: case l2: case l3: case l4: case l5: case l6: {
 
+/*=========================================================================
+ * SELECT_FUSED - To define bytecode(s) that a superinstruction can
+ * continue into without a dispatch (see FUSED_NEXT)
+ *=======================================================================*/
+
+#if ENABLE_SUPERINSTRUCTIONS
+#define SELECT_FUSED(l1, label)         case l1: label: {
+#define SELECT2_FUSED(l1, l2, label)    case l1: case l2: label: {
+#else
+#define SELECT_FUSED(l1, label)         SELECT(l1)
+#define SELECT2_FUSED(l1, l2, label)    SELECT2(l1, l2)
+#endif
+
 /*=========================================================================
  * DONE - To end a bytecode definition and increment ip
  *=======================================================================*/
@@ -200,6 +213,43 @@
 
 #define DONE_R     } goto reschedulePoint;
 
+/*=========================================================================
+ * FUSED_NEXT - To continue a superinstruction with the instruction after
+ * it, when that is the expected one.  Every instruction goes through the
+ * top of the interpreter loop instead while bytecodes are being traced,
+ * counted or single stepped.
+ *=======================================================================*/
+
+#if ENABLE_SUPERINSTRUCTIONS
+
+#if INCLUDEDEBUGCODE
+#define __traceAllowsFusion     (!tracebytecodes)
+#else
+#define __traceAllowsFusion     TRUE
+#endif
+
+#if ENABLE_EXECUTION_COUNTERS
+#define __countersAllowFusion   (BytecodeCounts == NULL)
+#else
+#define __countersAllowFusion   TRUE
+#endif
+
+#if ENABLE_JAVA_DEBUGGER
+#define __debuggerAllowsFusion  (!vmDebugReady)
+#else
+#define __debuggerAllowsFusion  TRUE
+#endif
+
+#define FUSION_ALLOWED                                               \
+    (__traceAllowsFusion && __countersAllowFusion && __debuggerAllowsFusion)
+
+#define FUSED_NEXT(opcode, label)                                    \
+    if (*ip == (opcode) && FUSION_ALLOWED) {                         \
+        goto label;                                                  \
+    }
+
+#endif /* ENABLE_SUPERINSTRUCTIONS */
+
 /*=========================================================================
  * CHECKARRAY - To check for valid array access
  *=======================================================================*/
@@ -217,6 +267,29 @@
         } else goto handleArrayIndexOutOfBoundsException; \
     } else goto handleNullPointerException;               \
 
+/*=========================================================================
+ * ARRAYCOPY_SMALL - Longest byte or char array copy that ARRAYCOPY_FAST
+ *                   does with an inline loop rather than memmove
+ *=======================================================================*/
+
+#define ARRAYCOPY_SMALL 16
+
+/*=========================================================================
+ * SYNCHRONIZED_NATIVE_SKIPS_LOCK - Test whether a synchronized native
+ *                                  method can run without its lock
+ *
+ * The StringBuffer natives run to completion without a thread switch,
+ * so while no thread holds the lock of the buffer (nearly always, as
+ * most buffers are only ever seen by one thread) locking it around the
+ * call could not be observed.  Every other synchronized native method,
+ * and one on a buffer that is locked, is run by
+ * invokeSynchronizedNativeFunction, which waits for the lock.
+ *=======================================================================*/
+
+#define SYNCHRONIZED_NATIVE_SKIPS_LOCK(method, object)        \
+    ((method)->ofClass == JavaLangStringBuffer                \
+        && !OBJECT_HAS_MONITOR(object))
+
 /*=========================================================================
  * CALL_VIRTUAL_METHOD - Branch to common code for Invokevirtual
  *=======================================================================*/
@@ -264,29 +337,41 @@
 }
 
 /*=========================================================================
- * TRACE_METHOD_ENTRY - Macro for tracing
+ * TRACE_METHOD_ENTRY - Macro for tracing (also fires the method__entry
+ * probe, see probes.h)
  *=======================================================================*/
 
 #if INCLUDEDEBUGCODE
 #define TRACE_METHOD_ENTRY(method, what) {                      \
    ASSERTING_NO_ALLOCATION                                      \
    if (tracemethodcallsverbose) Log->enterMethod(method, what); \
+   PROBE_METHOD_ENTRY(method)                                   \
    END_ASSERTING_NO_ALLOCATION                                  \
 }
+#elif ENABLE_USDT_PROBES
+#define TRACE_METHOD_ENTRY(method, what) {                      \
+   PROBE_METHOD_ENTRY(method)                                   \
+}
 #else
 #define TRACE_METHOD_ENTRY(method, what) /**/
 #endif
 
 /*=========================================================================
- * TRACE_METHOD_EXIT - Macro for tracing
+ * TRACE_METHOD_EXIT - Macro for tracing (also fires the method__return
+ * probe, see probes.h)
  *=======================================================================*/
 
 #if INCLUDEDEBUGCODE
 #define TRACE_METHOD_EXIT(method) {                      \
    ASSERTING_NO_ALLOCATION                               \
    if (tracemethodcallsverbose) Log->exitMethod(method); \
+   PROBE_METHOD_RETURN(method)                           \
    END_ASSERTING_NO_ALLOCATION                           \
 }
+#elif ENABLE_USDT_PROBES
+#define TRACE_METHOD_EXIT(method) {                      \
+   PROBE_METHOD_RETURN(method)                           \
+}
 #else
 #define TRACE_METHOD_EXIT(method)        /**/
 #endif
@@ -420,12 +505,42 @@
 
 #endif /* ENABLE_JAVA_DEBUGGER */
 
+/*=========================================================================
+ * BRANCH - Macro to add a branch offset to ip and continue execution.
+ * When timer-driven rescheduling is used, only backward branches need
+ * to test for thread rescheduling (a loop must always contain one).
+ * Backward branches are also what the execution counters count.
+ *=======================================================================*/
+
+#if TIMER_RESCHEDULING
+#define BRANCH(offset) {                        \
+    long __offset__ = (offset);                 \
+    ip += __offset__;                           \
+    if (__offset__ > 0) goto next0;             \
+    COUNT_BACKEDGE(fp->thisMethod)              \
+    goto reschedulePoint;                       \
+}
+#elif ENABLE_EXECUTION_COUNTERS
+#define BRANCH(offset) {                        \
+    long __offset__ = (offset);                 \
+    ip += __offset__;                           \
+    if (__offset__ <= 0) {                      \
+        COUNT_BACKEDGE(fp->thisMethod)          \
+    }                                           \
+    goto reschedulePoint;                       \
+}
+#else
+#define BRANCH(offset) { ip += (offset); goto reschedulePoint; }
+#endif
+
 /*=========================================================================
  * BRANCHIF - Macro to cause a branch if a condition is true
  *=======================================================================*/
 
 #if COMMONBRANCHING
 #define BRANCHIF(cond) { if(cond) { goto branchPoint; } else { goto next3; } }
+#elif TIMER_RESCHEDULING || ENABLE_EXECUTION_COUNTERS
+#define BRANCHIF(cond) { if(cond) BRANCH(getShort(ip + 1)) else { goto next3; } }
 #else
 #define BRANCHIF(cond) { ip += (cond) ? getShort(ip + 1) : 3; goto reschedulePoint; }
 #endif
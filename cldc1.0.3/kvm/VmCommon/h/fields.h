@@ -157,12 +157,12 @@ struct stackMapStruct {
 
 /*=========================================================================
  * COMMENTS:
- * The Java-level debugging interfaces need access to line number 
- * information.  The following structures are used for storing 
- * that information.
+ * The Java-level debugging interfaces and the sampling profiler need
+ * access to line number information.  The following structures are
+ * used for storing that information.
  *=======================================================================*/
 
-#if ENABLE_JAVA_DEBUGGER
+#if ENABLE_JAVA_DEBUGGER || ENABLE_SAMPLING_PROFILER
 
 struct lineNumberStruct {
     unsigned short start_pc;
@@ -174,7 +174,9 @@ struct lineNumberTableStruct {
     struct lineNumberStruct lineNumber[1];
 };
 
-#endif /* ENABLE_JAVA_DEBUGGER */
+typedef struct lineNumberTableStruct* LINENUMBERTABLE;
+
+#endif /* ENABLE_JAVA_DEBUGGER || ENABLE_SAMPLING_PROFILER */
 
 /*=========================================================================
  * Sizes of the data structures above
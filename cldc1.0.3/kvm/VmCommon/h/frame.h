@@ -187,6 +187,13 @@ void printExecutionStack(void);
 
 void throwException(THROWABLE_INSTANCE_HANDLE exception);
 
+#if HANDLER_CACHE_SIZE
+/* The handler cache holds heap pointers, so it is cleared before a GC */
+void clearHandlerCache(void);
+#else
+#define clearHandlerCache()
+#endif
+
 /*=========================================================================
  * Operations for raising exceptions and errors from within the VM
  *=======================================================================*/
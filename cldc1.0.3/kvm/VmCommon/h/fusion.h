@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Interpreter
+ * FILE:      fusion.h
+ * OVERVIEW:  Superinstructions.  When a class has been verified, the
+ *            first instruction of each frequent pair of instructions in
+ *            its methods is replaced by a superinstruction, which does
+ *            the work of the instruction it replaced and then goes on
+ *            with the second one without a dispatch (see bytecodes.c).
+ *            Only the opcode of the first instruction changes, so
+ *            branch targets, exception ranges, stack maps and
+ *            breakpoints stay valid (see ENABLE_SUPERINSTRUCTIONS in
+ *            main.h).
+ *=======================================================================*/
+
+#if ENABLE_SUPERINSTRUCTIONS
+
+/*=========================================================================
+ * Superinstruction variables
+ *=======================================================================*/
+
+extern bool_t SuperinstructionsEnabled; /* FALSE with -nosuperinstructions */
+
+/*=========================================================================
+ * Superinstruction operations
+ *=======================================================================*/
+
+void fuseClassCode(INSTANCE_CLASS thisClass);
+
+/*
+ * The hook used by the verifier once a class has been verified.
+ */
+#define FUSE_CLASS_CODE(thisClass)                                    \
+    if (SuperinstructionsEnabled) {                                   \
+        fuseClassCode(thisClass);                                     \
+    }
+
+#else
+
+#define FUSE_CLASS_CODE(thisClass)
+
+#endif /* ENABLE_SUPERINSTRUCTIONS */
+
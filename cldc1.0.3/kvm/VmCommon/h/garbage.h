@@ -309,11 +309,11 @@ typedef enum {
  * Dynamic heap variables
  *=======================================================================*/
 
-extern cell* AllHeapStart;   /* Lower limits of any heap space */
-extern cell* AllHeapEnd;
+extern ISOLATE_LOCAL cell* AllHeapStart;   /* Lower limits of any heap space */
+extern ISOLATE_LOCAL cell* AllHeapEnd;
 
-extern cell* CurrentHeap;    /* Current limits of heap space */
-extern cell* CurrentHeapEnd; /* Current heap top */
+extern ISOLATE_LOCAL cell* CurrentHeap;    /* Current limits of heap space */
+extern ISOLATE_LOCAL cell* CurrentHeapEnd; /* Current heap top */
 
 /*=========================================================================
  * Garbage collection operations
@@ -443,13 +443,13 @@ void *mallocStaticBytes(int size);
  *=======================================================================*/
 
 #define MAXIMUM_TEMPORARY_ROOTS 50
-#define MAXIMUM_GLOBAL_ROOTS 20
+#define MAXIMUM_GLOBAL_ROOTS 32
 
-extern int TemporaryRootsLength;
-extern int GlobalRootsLength;
+extern ISOLATE_LOCAL int TemporaryRootsLength;
+extern ISOLATE_LOCAL int GlobalRootsLength;
 
-extern union cellOrPointer TemporaryRoots[];
-extern union cellOrPointer GlobalRoots[];
+extern ISOLATE_LOCAL union cellOrPointer TemporaryRoots[];
+extern ISOLATE_LOCAL union cellOrPointer GlobalRoots[];
 
 /* Handling of temporary roots */
 #if  INCLUDEDEBUGCODE
@@ -467,7 +467,7 @@ void verifyTemporaryRootSpace(int size);
 #define END_TEMPORARY_ROOTS      TemporaryRootsLength = _tmp_roots_;  }
 
 #if INCLUDEDEBUGCODE
-extern int NoAllocation;
+extern ISOLATE_LOCAL int NoAllocation;
 #define ASSERTING_NO_ALLOCATION { NoAllocation++; {
 #define END_ASSERTING_NO_ALLOCATION } NoAllocation--; }
 #else
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Memory management
+ * FILE:      gcstats.h
+ * OVERVIEW:  Garbage collection statistics.  Every collection is timed
+ *            phase by phase, and its cause, the bytes it reclaimed and
+ *            the state of the free list afterwards are added to
+ *            log-scale histograms.  A line per collection is printed
+ *            with -verbosegc, and the totals are written to a file at
+ *            exit with -gcstats <file> (see ENABLE_GC_STATISTICS in
+ *            main.h).
+ *=======================================================================*/
+
+/*=========================================================================
+ * Why the collector ran
+ *=======================================================================*/
+
+enum gcCause {
+    GC_CAUSE_OTHER = 0,     /* Debugging and stress collections */
+    GC_CAUSE_ALLOCATION,    /* An allocation did not fit in the free list */
+    GC_CAUSE_EXPLICIT,      /* Runtime.gc() */
+    GC_CAUSE_PERMANENT,     /* Permanent space had to grow */
+    GC_CAUSE_COUNT
+};
+
+/*=========================================================================
+ * Phases of a collection (see garbageCollectForReal)
+ *=======================================================================*/
+
+enum gcPhase {
+    GC_PHASE_ROOTS = 0,     /* Marking the root objects */
+    GC_PHASE_MARK,          /* Marking the objects reachable from them */
+    GC_PHASE_WEAK,          /* Clearing weak pointers */
+    GC_PHASE_SWEEP,         /* Rebuilding the free list */
+    GC_PHASE_COMPACT,       /* Sliding the live objects together */
+    GC_PHASE_UPDATE,        /* Updating pointers from the break table */
+    GC_PHASE_COUNT
+};
+
+#if ENABLE_GC_STATISTICS
+
+/*=========================================================================
+ * Garbage collection statistics variables
+ *=======================================================================*/
+
+extern bool_t VerboseGC;                /* Print a line per collection */
+extern char*  GCStatisticsFile;         /* Summary file, or NULL */
+
+extern ISOLATE_LOCAL bool_t GCStatisticsEnabled;
+extern ISOLATE_LOCAL int    NextGCCause;
+
+/*=========================================================================
+ * Garbage collection statistics operations
+ *=======================================================================*/
+
+void InitializeGCStatistics(void);
+void FinalizeGCStatistics(void);
+
+void gcStatisticsBegin(int moreMemory);
+void gcStatisticsPhase(int phase);
+void gcStatisticsEnd(void);
+
+/*
+ * The hooks used by the collector.  A call site that knows why it
+ * collects sets the cause first; otherwise a collection that asks for
+ * memory counts as an allocation failure.
+ */
+#define setGCCause(cause) (NextGCCause = (cause))
+
+#define RECORD_GC_BEGIN(moreMemory)                                   \
+    if (GCStatisticsEnabled) {                                        \
+        gcStatisticsBegin(moreMemory);                                \
+    }
+
+#define RECORD_GC_PHASE(phase)                                        \
+    if (GCStatisticsEnabled) {                                        \
+        gcStatisticsPhase(phase);                                     \
+    }
+
+#define RECORD_GC_END()                                               \
+    if (GCStatisticsEnabled) {                                        \
+        gcStatisticsEnd();                                            \
+    }
+
+#else
+
+#define InitializeGCStatistics()
+#define FinalizeGCStatistics()
+
+#define setGCCause(cause)
+#define RECORD_GC_BEGIN(moreMemory)
+#define RECORD_GC_PHASE(phase)
+#define RECORD_GC_END()
+
+#endif /* ENABLE_GC_STATISTICS */
+
@@ -207,6 +207,15 @@ typedef union {
 
 #include <runtime.h>
 #include <profiling.h>
+#include <sampler.h>
+#include <recorder.h>
+#include <allocprof.h>
+#include <heapdump.h>
+#include <gcstats.h>
+#include <counters.h>
+#include <probes.h>
+#include <startup.h>
+#include <fusion.h>
 #include <verifier.h>
 #include <log.h>
 #include <property.h>
@@ -222,18 +231,24 @@ typedef union {
  *=======================================================================*/
 
 /* Shared string buffer that is used internally by the VM */
-extern char str_buffer[];
+extern ISOLATE_LOCAL char str_buffer[];
 
 /* Requested heap size when starting the VM from command line */
-extern long RequestedHeapSize;
+extern ISOLATE_LOCAL long RequestedHeapSize;
+
+#if MULTIPLE_ISOLATES
+/* Number of the isolate run by this thread, handed out by */
+/* KVM_StartIsolate (zero if the VM was started otherwise) */
+extern ISOLATE_LOCAL int IsolateNumber;
+#endif /* MULTIPLE_ISOLATES */
 
 /*=========================================================================
  * Global execution modes
  *=======================================================================*/
 
 /*  Flags for toggling certain global modes on and off */
-extern bool_t JamEnabled;
-extern bool_t JamRepeat;
+extern ISOLATE_LOCAL bool_t JamEnabled;
+extern ISOLATE_LOCAL bool_t JamRepeat;
 
 /*=========================================================================
  * Macros for controlling global execution tracing modes
@@ -313,7 +328,7 @@ extern bool_t JamRepeat;
 #endif /* SVM */
                
 #define DECLARE_TRACE_VAR_EXTERNAL(varName, userName) \
-    extern int varName;
+    extern ISOLATE_LOCAL int varName;
 FOR_EACH_TRACE_FLAG(DECLARE_TRACE_VAR_EXTERNAL)
 
 /*=========================================================================
@@ -534,9 +549,9 @@ if (traceexceptions) \
         }                                                      \
     }
 
-extern void* VMScope;
-extern int   VMExitCode;
-extern THROWABLE_SCOPE ThrowableScope;
+extern ISOLATE_LOCAL void* VMScope;
+extern ISOLATE_LOCAL int   VMExitCode;
+extern ISOLATE_LOCAL THROWABLE_SCOPE ThrowableScope;
 
 #ifndef FATAL_ERROR_EXIT_CODE
 #define FATAL_ERROR_EXIT_CODE 127
@@ -87,17 +87,17 @@ typedef struct UTF_Hash_Entry {
  *=======================================================================*/
 
 /* Hashtable containing all the Java strings in the system */
-extern HASHTABLE InternStringTable;
+extern ISOLATE_LOCAL HASHTABLE InternStringTable;
 
 /* Hashtable containing all the utf C strings in the system */
-extern HASHTABLE UTFStringTable;
+extern ISOLATE_LOCAL HASHTABLE UTFStringTable;
 
 /* Hashtable containing all the classes in the system */
-extern HASHTABLE ClassTable;
+extern ISOLATE_LOCAL HASHTABLE ClassTable;
 
 #if SVM
 /* Hashtable containing all unique KEY structures in the system */
-extern HASHTABLE KeyTable;
+extern ISOLATE_LOCAL HASHTABLE KeyTable;
 #endif
 
 /*=========================================================================
@@ -131,6 +131,18 @@ INTERNED_STRING_INSTANCE internString(const char *string, int length);
 /* Convert utf8 to unicode */
 short utf2unicode(const char **utf);
 
+/* Bulk conversion between utf8 (modified or standard) and unicode */
+#define UTF8_DONE       0   /* input used up, or output full */
+#define UTF8_TRUNCATED  1   /* input ends in the middle of a character */
+#define UTF8_MALFORMED  2   /* input has an invalid sequence */
+
+int decodeUTF8(const unsigned char **src, const unsigned char *srcEnd,
+               unsigned short **dst, unsigned short *dstEnd, bool_t modified);
+void encodeUTF8(const unsigned short **src, const unsigned short *srcEnd,
+                unsigned char **dst, unsigned char *dstEnd, bool_t modified);
+long utf8Length(const unsigned short *unistring, long length,
+                bool_t modified);
+
 #if ENABLE_JAVA_DEBUGGER
 char *unicode2utf(unsigned short *, int, char *, int);
 int unicode2utfstrlen(unsigned short *, int);
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Memory management
+ * FILE:      heapdump.h
+ * OVERVIEW:  Heap dumps.  The whole dynamic heap, the classes and the
+ *            garbage collection roots are written to a compact binary
+ *            file, which tools/heapanalyzer reads.  A dump is written
+ *            when the port or the user asks for one, and on the first
+ *            OutOfMemoryError (see ENABLE_HEAP_DUMP in main.h).  The
+ *            file format is described in heapdump.c.
+ *=======================================================================*/
+
+#if ENABLE_HEAP_DUMP
+
+/*=========================================================================
+ * Heap dump variables
+ *=======================================================================*/
+
+extern char* HeapDumpFile;              /* NULL if no dumps were asked for */
+
+extern volatile int HeapDumpRequests;   /* Counted by the port */
+
+/*=========================================================================
+ * Heap dump operations
+ *=======================================================================*/
+
+void InitializeHeapDump(void);
+
+bool_t dumpHeap(const char* fileName);
+void checkHeapDump(void);
+void heapDumpOnOutOfMemory(void);
+
+/* Ask for a dump at the next reschedule point (signal handler safe) */
+#define requestHeapDump() (HeapDumpRequests++)
+
+#else
+
+#define InitializeHeapDump()
+#define checkHeapDump()
+#define heapDumpOnOutOfMemory()
+
+#endif /* ENABLE_HEAP_DUMP */
+
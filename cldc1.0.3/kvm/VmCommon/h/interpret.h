@@ -61,11 +61,11 @@
  * fashion.
  *=======================================================================*/
 
-extern BYTE*        ip_global; /*  Instruction pointer */
-extern FRAME        fp_global; /*  Current frame pointer */
-extern cell*        sp_global; /*  Execution stack pointer */
-extern cell*        lp_global; /*  Local variable pointer */
-extern CONSTANTPOOL cp_global; /*  Constant pool pointer */
+extern ISOLATE_LOCAL BYTE*        ip_global; /*  Instruction pointer */
+extern ISOLATE_LOCAL FRAME        fp_global; /*  Current frame pointer */
+extern ISOLATE_LOCAL cell*        sp_global; /*  Execution stack pointer */
+extern ISOLATE_LOCAL cell*        lp_global; /*  Local variable pointer */
+extern ISOLATE_LOCAL CONSTANTPOOL cp_global; /*  Constant pool pointer */
 
 /* These get and set macros provide better control */
 /* over the way VM registers are accessed. */
@@ -331,7 +331,7 @@ typedef enum {
         GETSTATIC2_FAST       = 0xD2,
         PUTSTATIC_FAST        = 0xD3,
         PUTSTATIC2_FAST       = 0xD4,
-        UNUSED_D5             = 0xD5,
+        ARRAYCOPY_FAST        = 0xD5,
         INVOKEVIRTUAL_FAST    = 0xD6,
         INVOKESPECIAL_FAST    = 0xD7,
 
@@ -345,9 +345,28 @@ typedef enum {
 
         CUSTOMCODE            = 0xDF,
 
-        LASTBYTECODE          = 0xDF
+/*=========================================================================
+ * Superinstructions (used internally by the system only if
+ *                    ENABLE_SUPERINSTRUCTIONS flag is on, see fusion.h)
+ *=======================================================================*/
+
+        ALOAD_0_GETFIELD      = 0xE0,
+        ALOAD_0_INVOKEVIRTUAL = 0xE1,
+        ILOAD_IF_ICMP         = 0xE2,
+        ILOAD_0_IF_ICMP       = 0xE3,
+        ILOAD_1_IF_ICMP       = 0xE4,
+        ILOAD_2_IF_ICMP       = 0xE5,
+        ILOAD_3_IF_ICMP       = 0xE6,
+        ICONST_1_IADD         = 0xE7,
+
+        LASTBYTECODE          = 0xE7
 } ByteCode ;
 
+#if ENABLE_JAVA_DEBUGGER || ENABLE_SUPERINSTRUCTIONS || ENABLE_EXECUTION_COUNTERS
+/* Length of each bytecode, or 0 for TABLESWITCH, LOOKUPSWITCH and WIDE */
+extern const unsigned char byteCodeLengths[];
+#endif
+
 /*=========================================================================
  * Callback function for CUSTOMCODE bytecode
  *=======================================================================*/
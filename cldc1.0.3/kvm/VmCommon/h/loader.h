@@ -41,7 +41,7 @@
  * Definitions and declarations
  *=======================================================================*/
 
-extern char* UserClassPath; /* set in main() or elsewhere */
+extern ISOLATE_LOCAL char* UserClassPath; /* set in main() or elsewhere */
 
 #ifndef PATH_SEPARATOR
 #   define PATH_SEPARATOR ':'
@@ -250,6 +250,24 @@
 #define ENABLEFASTBYTECODES 0
 #endif
 
+/* Turns superinstructions on/off.  When a class has been verified, the
+ * first instruction of some frequent pairs of instructions in its
+ * methods is replaced by an instruction that also executes the second
+ * one without a separate dispatch (see fusion.h).  The pairs were
+ * chosen from the bytecode pair counts of the benchmarks (see
+ * ENABLE_EXECUTION_COUNTERS).  Starting the VM with
+ * "-nosuperinstructions" leaves the bytecodes as they are.  Romized
+ * classes are not rewritten.  Requires ENABLEFASTBYTECODES, since most
+ * of the pairs end with a fast bytecode.
+ */
+#ifndef ENABLE_SUPERINSTRUCTIONS
+#define ENABLE_SUPERINSTRUCTIONS 0
+#endif
+
+#if ENABLE_SUPERINSTRUCTIONS && !ENABLEFASTBYTECODES
+#error "ENABLE_SUPERINSTRUCTIONS requires ENABLEFASTBYTECODES"
+#endif
+
 /* This option can be used for turning on/off constant pool integrity
  * checking. When turned on, the system checks that the given constant
  * pool references point to appropriate constant pool entries at
@@ -296,6 +314,28 @@
 #define RESCHEDULEATBRANCH 1
 #endif
 
+/* Enabling this option replaces the bytecode-counting time slice with
+ * a wall-clock one.  A periodic host timer (see StartRescheduleTimer_md
+ * in runtime.h) counts down the time slice of the current thread and
+ * sets a single flag when it expires; the interpreter merely tests that
+ * flag at its reschedule points, and no longer tests it at forward
+ * branches at all.  This removes the decrement from the interpreter loop
+ * and makes thread fairness independent of the bytecodes being executed.
+ * When this option is on, TIMESLICEFACTOR and BASETIMESLICE are measured
+ * in timer ticks of TIMER_TICK_MICROSECONDS each rather than in branches
+ * or bytecodes.  The target platform must provide the timer functions.
+ */
+#ifndef TIMER_RESCHEDULING
+#define TIMER_RESCHEDULING 0
+#endif
+
+/* The length of one tick of the rescheduling timer in microseconds.
+ * Only used when TIMER_RESCHEDULING is on.
+ */
+#ifndef TIMER_TICK_MICROSECONDS
+#define TIMER_TICK_MICROSECONDS 1000
+#endif
+
 /* The time slice factor is used to calculate the base time slice and to
  * set up a timeslice when a thread has its priority changed. This
  * value determines how much execution time each thread receives
@@ -304,10 +344,14 @@
  * switch threads when 100 branch instructions have been executed.)
  * If RESCHEDULEATBRANCH option is off, we use value 1000 (meaning
  * that thread switch occurs after this many bytecodes have been
- * executed.)
+ * executed.)  If TIMER_RESCHEDULING is on, the value is the number of
+ * timer ticks per priority level, so that a thread of normal priority
+ * runs for 5 * 2 = 10 ticks (10 ms by default) before being switched.
  */
 #ifndef TIMESLICEFACTOR
-#if RESCHEDULEATBRANCH
+#if TIMER_RESCHEDULING
+#define TIMESLICEFACTOR 2
+#elif RESCHEDULEATBRANCH
 #define TIMESLICEFACTOR 100
 #else
 #define TIMESLICEFACTOR 1000
@@ -324,6 +368,56 @@
 #define BASETIMESLICE     TIMESLICEFACTOR
 #endif
 
+/* Enabling this option keeps a separate queue of runnable threads for
+ * each Java priority level, so that a runnable thread of higher priority
+ * is always switched to before any thread of lower priority, and a thread
+ * that becomes runnable preempts a running thread of lower priority.
+ * Picking the next thread to run takes constant time.  To prevent
+ * starvation, every PRIORITY_AGING_INTERVAL thread switches the thread
+ * that has waited longest at each level is moved up one level.  When
+ * this option is off, all runnable threads share one round-robin queue
+ * and the priority only affects the length of the time slice (as in
+ * KVM 1.0).
+ */
+#ifndef PRIORITY_SCHEDULING
+#define PRIORITY_SCHEDULING 1
+#endif
+
+#ifndef PRIORITY_AGING_INTERVAL
+#define PRIORITY_AGING_INTERVAL 8
+#endif
+
+/* The number of "fast locks" each thread has.  An object that is locked
+ * by only one thread is not given a real monitor.  If it is locked just
+ * once, the owning thread is stored directly in the object.  Otherwise
+ * the entry count and the hash code are kept in one of the fast locks
+ * of the owning thread.  A real monitor is only allocated when a second
+ * thread wants the object, when wait() or notify() is called, or when
+ * all the fast locks of the owner are in use.  Idle real monitors are
+ * turned back into fast locks by the garbage collector.
+ */
+#ifndef FAST_LOCKS_PER_THREAD
+#define FAST_LOCKS_PER_THREAD 4
+#endif
+
+/* The number of objects that can be locked just once and have a hash
+ * code at the same time.  The hash codes of such objects are kept in
+ * a table of this size, so that neither hashing a locked object nor
+ * locking a hashed object needs a fast lock or a real monitor.
+ */
+#ifndef IDENTITY_HASH_TABLE_SIZE
+#define IDENTITY_HASH_TABLE_SIZE 32
+#endif
+
+/* Use SSE2 (and AVX2, if the compiler targets it) vector instructions
+ * in the native String comparison and search functions.  This option
+ * has no effect unless the compiler defines __SSE2__; otherwise the
+ * plain C versions are used.
+ */
+#ifndef SIMD_STRING_OPERATIONS
+#define SIMD_STRING_OPERATIONS 1
+#endif
+
 /* This option will cause the infrequently called Java bytecodes to be 
  * split into a separate interpreter loop. It has been found that 
  * doing so gives a small space and performance benefit on many systems.
@@ -445,6 +539,148 @@
 #define ENABLEPROFILING 0
 #endif
 
+/* Includes the sampling profiler.  The profiler is off unless the VM
+ * is started with "-profile <file>".  A host timer that runs on CPU
+ * time (see StartSamplingTimer_md in runtime.h) then asks the
+ * interpreter, SAMPLING_PROFILER_RATE times per second, to record the
+ * Java call stack of the current thread at its next reschedule point.
+ * A flat profile and a call tree are written to the file at exit, and
+ * the stacks in collapsed form (as used by flame graph tools) to the
+ * file with ".collapsed" appended.  Frames of classes loaded from
+ * class files show source line numbers; romized frames show only the
+ * method name.  The target platform must provide the timer functions.
+ */
+#ifndef ENABLE_SAMPLING_PROFILER
+#define ENABLE_SAMPLING_PROFILER 0
+#endif
+
+#ifndef SAMPLING_PROFILER_RATE
+#define SAMPLING_PROFILER_RATE 1000
+#endif
+
+#if ENABLE_SAMPLING_PROFILER && USESTATIC
+#error "ENABLE_SAMPLING_PROFILER cannot be used with USESTATIC"
+#endif
+
+/* Includes the flight recorder, which is cheap enough to be compiled
+ * into production builds.  Recording is off unless the VM is started
+ * with "-record <file>".  The VM then keeps the last
+ * FLIGHT_RECORDER_EVENTS VM events (see recorder.h) in a ring buffer,
+ * and writes them to the file at exit and whenever the port calls
+ * requestFlightRecorderDump() (the Unix port does so on SIGUSR2).
+ * The target platform must provide MonotonicTime_md (see runtime.h).
+ */
+#ifndef ENABLE_FLIGHT_RECORDER
+#define ENABLE_FLIGHT_RECORDER 0
+#endif
+
+#ifndef FLIGHT_RECORDER_EVENTS
+#define FLIGHT_RECORDER_EVENTS 8192
+#endif
+
+#if ENABLE_FLIGHT_RECORDER && !COMPILER_SUPPORTS_LONG
+#error "ENABLE_FLIGHT_RECORDER requires COMPILER_SUPPORTS_LONG"
+#endif
+
+/* Includes the allocation profiler.  The profiler is off unless the
+ * VM is started with "-allocprofile <file>".  It then attributes the
+ * objects allocated by the program to the class of the object and to
+ * the allocation site: the method and bytecode index of the NEW or
+ * xNEWARRAY instruction, or of the call to the native method that
+ * allocated the object.  To keep the overhead down, only one
+ * allocation per ALLOCATION_PROFILER_INTERVAL bytes is recorded, and
+ * stands for all the bytes allocated since the previous one; 0
+ * records every allocation.  The top sites and classes are written to
+ * the file at exit.  Each time the port calls
+ * requestAllocationSnapshot() (the Unix port does so on SIGUSR1), the
+ * allocations since the previous snapshot are written to the file
+ * with ".1", ".2", ... appended.
+ */
+#ifndef ENABLE_ALLOCATION_PROFILER
+#define ENABLE_ALLOCATION_PROFILER 0
+#endif
+
+#ifndef ALLOCATION_PROFILER_INTERVAL
+#define ALLOCATION_PROFILER_INTERVAL 0
+#endif
+
+#if ENABLE_ALLOCATION_PROFILER && USESTATIC
+#error "ENABLE_ALLOCATION_PROFILER cannot be used with USESTATIC"
+#endif
+
+/* Includes heap dumps.  When the VM is started with "-heapdump <file>",
+ * the whole heap, the classes (with their fields and static values)
+ * and the garbage collection roots are written to the file with ".1",
+ * ".2", ... appended each time the port calls requestHeapDump() (the
+ * Unix port does so on SIGQUIT), and to the file itself the first time
+ * the VM runs out of memory.  Native code can call dumpHeap() directly.
+ * The dumps are read by tools/heapanalyzer.  Heap dumps need the
+ * standard mark-and-sweep collector.
+ */
+#ifndef ENABLE_HEAP_DUMP
+#define ENABLE_HEAP_DUMP 0
+#endif
+
+/* Includes garbage collection statistics.  With "-verbosegc" the VM
+ * prints a line per collection: why it ran, the free memory before and
+ * after, the free list chunks and the time taken by each phase.  With
+ * "-gcstats <file>" the pause times, phase times, bytes reclaimed, and
+ * the largest free chunk and fragmentation after each collection are
+ * kept in log-scale histograms, which are written to the file at exit
+ * (the format is described in gcstats.c).  Statistics need the standard
+ * mark-and-sweep collector, and the target platform must provide
+ * MonotonicTime_md (see runtime.h).
+ */
+#ifndef ENABLE_GC_STATISTICS
+#define ENABLE_GC_STATISTICS 0
+#endif
+
+#if ENABLE_GC_STATISTICS && !COMPILER_SUPPORTS_LONG
+#error "ENABLE_GC_STATISTICS requires COMPILER_SUPPORTS_LONG"
+#endif
+
+/* Includes execution counters in the interpreter.  Counting is off
+ * unless the VM is started with "-counters <file>".  The interpreter
+ * then counts the invocations and the backward branches of every
+ * method, and with "-bytecodecounts" also every bytecode and every
+ * pair of consecutive bytecodes.  At exit the hottest methods, the
+ * bytecodes and the most frequent pairs are written to the file.
+ * Even when counting is off, this option adds a test to the dispatch
+ * of every bytecode.
+ */
+#ifndef ENABLE_EXECUTION_COUNTERS
+#define ENABLE_EXECUTION_COUNTERS 0
+#endif
+
+/* Includes statically defined tracing probes (USDT) at method entry and
+ * return, class loading, garbage collection, monitor contention and
+ * exception throws, for use with perf, bpftrace or SystemTap (the
+ * probes are listed in probes.h).  The target platform must provide
+ * the header-only <sys/sdt.h>.  A probe only computes its arguments
+ * while a tool is attached to it; otherwise it costs the test of a
+ * semaphore.
+ */
+#ifndef ENABLE_USDT_PROBES
+#define ENABLE_USDT_PROBES 0
+#endif
+
+/* Includes a startup trace.  With "-startuptrace <file>" the phases of
+ * the VM startup and every class load, verification, static
+ * initializer, native method binding and permit verification up to the
+ * entry of the main method are timed.  The nested spans are printed as
+ * a tree with total and self times, and written to the file as Chrome
+ * trace events.  Static initializers are not timed when
+ * CLASS_INITIALIZATION_IN_JAVA is on.  The target platform must provide
+ * MonotonicTime_md (see runtime.h).
+ */
+#ifndef ENABLE_STARTUP_TRACE
+#define ENABLE_STARTUP_TRACE 0
+#endif
+
+#if ENABLE_STARTUP_TRACE && !COMPILER_SUPPORTS_LONG
+#error "ENABLE_STARTUP_TRACE requires COMPILER_SUPPORTS_LONG"
+#endif
+
 /*=========================================================================
  * Compile-time flags for choosing different tracing/debugging options.
  * These options can make the system very verbose. Turn them all off
@@ -463,6 +699,29 @@
 #define PRINT_BACKTRACE INCLUDEDEBUGCODE
 #endif
 
+/* When this option is on (and PRINT_BACKTRACE is on), the backtrace of
+ * a thrown exception is not recorded when the exception is thrown, but
+ * by the exception unwinder once it has found the handler.  Only the
+ * frames between the point of the throw and the handler are recorded,
+ * so programs that use exceptions for control flow pay for a few frames
+ * instead of the whole stack.  The price is that printStackTrace() does
+ * not show the frames below the method that caught the exception.
+ */
+#ifndef LAZY_BACKTRACE
+#define LAZY_BACKTRACE 0
+#endif
+
+/* The number of entries in the exception handler cache.  The cache
+ * remembers, for a method, a bytecode offset and an exception class,
+ * which handler of the method catches the exception (if any), so that
+ * repeatedly thrown exceptions do not have to resolve and compare the
+ * class of every candidate handler.  Must be a power of two; 0 turns
+ * the cache off.
+ */
+#ifndef HANDLER_CACHE_SIZE
+#define HANDLER_CACHE_SIZE 64
+#endif
+
 /*=========================================================================
  * Miscellaneous macros and options
  *=======================================================================*/
@@ -487,6 +746,71 @@
      ((strncmp(name, "java.", 5) == 0) || (strncmp(name, "javax.", 6) == 0))  
 #endif
 
+/*=========================================================================
+ * Multiple isolate option
+ *=======================================================================*/
+
+/* Enabling this option allows several independent virtual machines
+ * ("isolates") to run in the same process at the same time, each on
+ * its own native thread and therefore possibly on its own processor
+ * (see KVM_StartIsolate below).  Every variable that holds mutable VM
+ * state is declared ISOLATE_LOCAL, which makes it thread-local, so each
+ * isolate has its own heap, Java threads, class table, string tables
+ * and static variables.  The compiler must support thread-local storage
+ * (by default the "__thread" storage class of gcc is used).
+ *
+ * The romized class image is not shared between isolates, and this
+ * option requires ROMIZING to be off: each isolate loads its classes
+ * and builds its UTF string table in its own heap.  The image is not
+ * read-only at runtime.  Class status and initializing thread live in
+ * the ROM class blocks, the ROM field blocks hold the addresses of the
+ * static variables in KVM_staticData, the monitors and hash codes of
+ * ROM objects live in their headers, runtime entries are chained into
+ * the ROM hash tables (ClassTable, InternStringTable, UTFStringTable),
+ * and with ENABLEFASTBYTECODES the interpreter rewrites ROM bytecodes.
+ * Sharing it would require all of these to move to per-isolate
+ * tables first.  Since the options given on the command line are
+ * process-wide except for the trace flags, which KVM_StartIsolate
+ * copies, every isolate runs with the options of the process.  It can
+ * neither be used with the Java-level debugger, which uses a single
+ * socket, nor with TIMER_RESCHEDULING, ENABLE_SAMPLING_PROFILER,
+ * ENABLE_ALLOCATION_PROFILER or ENABLE_HEAP_DUMP, whose signals may be
+ * delivered to any thread of the process, nor with
+ * ENABLE_EXECUTION_COUNTERS, whose counters are shared.
+ */
+#ifndef MULTIPLE_ISOLATES
+#define MULTIPLE_ISOLATES 0
+#endif
+
+#if MULTIPLE_ISOLATES
+#  ifndef ISOLATE_LOCAL
+#  define ISOLATE_LOCAL __thread
+#  endif
+#  if ROMIZING
+#  error "MULTIPLE_ISOLATES requires ROMIZING=0"
+#  endif
+#  if ENABLE_JAVA_DEBUGGER
+#  error "MULTIPLE_ISOLATES cannot be used with ENABLE_JAVA_DEBUGGER"
+#  endif
+#  if TIMER_RESCHEDULING
+#  error "MULTIPLE_ISOLATES cannot be used with TIMER_RESCHEDULING"
+#  endif
+#  if ENABLE_SAMPLING_PROFILER
+#  error "MULTIPLE_ISOLATES cannot be used with ENABLE_SAMPLING_PROFILER"
+#  endif
+#  if ENABLE_ALLOCATION_PROFILER
+#  error "MULTIPLE_ISOLATES cannot be used with ENABLE_ALLOCATION_PROFILER"
+#  endif
+#  if ENABLE_HEAP_DUMP
+#  error "MULTIPLE_ISOLATES cannot be used with ENABLE_HEAP_DUMP"
+#  endif
+#  if ENABLE_EXECUTION_COUNTERS
+#  error "MULTIPLE_ISOLATES cannot be used with ENABLE_EXECUTION_COUNTERS"
+#  endif
+#else
+#  define ISOLATE_LOCAL
+#endif
+
 /*=========================================================================
  * VM startup function prototypes
  *=======================================================================*/
@@ -496,4 +820,31 @@ int KVM_Initialize(void);
 int KVM_Start(int argc, char* argv[]);
 void KVM_Cleanup(void);
 
+#if MULTIPLE_ISOLATES
+
+/* Embedding interface for running several isolates in one process.
+ * KVM_StartIsolate starts a new isolate on a new native thread, running
+ * the "main" method of the class named in argv[0] with the remaining
+ * arguments, and the given class path and heap size (in bytes).  The
+ * other thread-local options (the trace flags) are copied from the
+ * calling thread; the options that are not thread-local are shared.
+ * The argument strings must stay valid until the isolate has terminated.
+ * KVM_JoinIsolate waits for the isolate to terminate, releases it and
+ * returns its exit code.  These functions must be provided by the port.
+ */
+typedef struct isolateStruct* ISOLATE;
+
+ISOLATE KVM_StartIsolate(char* classPath, long heapSize,
+                         int argc, char* argv[]);
+int     KVM_JoinIsolate(ISOLATE isolate);
+
+/* Every isolate writes the output files of the VM options (-record,
+ * -gcstats, -startuptrace) to a file of its own.  isolateFileName
+ * returns a copy of the given file name, allocated with malloc, with
+ * the number of the current isolate appended (e.g., "gc.txt.2").
+ */
+char*   isolateFileName(char* fileName);
+
+#endif /* MULTIPLE_ISOLATES */
+
 
@@ -61,7 +61,7 @@ extern const ClassNativeImplementationType nativeImplementations[];
  *=======================================================================*/
 
 /* Set to the currently executing native method, or NULL */
-extern METHOD CurrentNativeMethod;
+extern ISOLATE_LOCAL METHOD CurrentNativeMethod;
 
 NativeFunctionPtr getNativeFunction(INSTANCE_CLASS clazz, 
                                     const char* methodName, 
@@ -69,6 +69,8 @@ NativeFunctionPtr getNativeFunction(INSTANCE_CLASS clazz,
 
 
 void  invokeNativeFunction(METHOD thisMethod);
+bool_t invokeSynchronizedNativeFunction(METHOD thisMethod, OBJECT object,
+                                        int invokerSize);
 void  nativeInitialization(int *argc, char **argv);
 
 #if INCLUDEDEBUGCODE
@@ -123,11 +125,31 @@ void Java_java_lang_String_charAt(void);
 void Java_java_lang_String_equals(void);
 void Java_java_lang_String_indexOf__I(void);
 void Java_java_lang_String_indexOf__II(void);
+void Java_java_lang_String_indexOf__Ljava_lang_String_2I(void);
+void Java_java_lang_String_lastIndexOf(void);
+void Java_java_lang_String_hashCode(void);
+void Java_java_lang_String_compareTo(void);
+void Java_java_lang_String_startsWith(void);
+void Java_java_lang_String_regionMatches(void);
 void Java_java_lang_String_intern(void);
+void Java_java_lang_StringBuffer_append__C(void);
 void Java_java_lang_StringBuffer_append__I(void);
 void Java_java_lang_StringBuffer_append__Ljava_lang_String_2(void);
+void Java_java_lang_StringBuffer_append___3C(void);
+void Java_java_lang_StringBuffer_append___3CII(void);
+void Java_java_lang_StringBuffer_insert__IC(void);
+void Java_java_lang_StringBuffer_insert__ILjava_lang_String_2(void);
+void Java_java_lang_StringBuffer_setLength(void);
 void Java_java_lang_StringBuffer_toString(void);
 void Java_java_util_Calendar_init(void);
+void Java_java_util_Hashtable_probe(void);
+void Java_com_sun_cldc_i18n_j2me_UTF_18_1Reader_decode(void);
+void Java_com_sun_cldc_i18n_j2me_UTF_18_1Reader_charCount(void);
+void Java_com_sun_cldc_i18n_j2me_UTF_18_1Writer_encode(void);
+void Java_com_sun_cldc_i18n_j2me_UTF_18_1Writer_byteCount(void);
+void Java_java_io_DataInputStream_decodeUTF(void);
+void Java_com_sun_cldc_io_GeneralBase_utfLength(void);
+void Java_com_sun_cldc_io_GeneralBase_encodeUTF(void);
 void Java_java_io_PrintStream_putchar(void);
 
 void printString(INSTANCE string);
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      probes.h
+ * OVERVIEW:  Statically defined tracing probes (USDT) for tools such as
+ *            perf, bpftrace and SystemTap.  The probes are declared
+ *            with the header-only <sys/sdt.h>, and each one has a
+ *            semaphore that the tracing tool sets while it is attached,
+ *            so an unused probe costs a test of a memory location (see
+ *            ENABLE_USDT_PROBES in main.h).
+ *
+ *            All probes belong to the provider "kvm".  Class names are
+ *            in the internal form ("java/lang/String"), and strings are
+ *            passed as a pointer and a length, like the probes of the
+ *            HotSpot VM:
+ *
+ *            method__entry(thread, class, classLen, name, nameLen,
+ *                          signature, signatureLen)
+ *            method__return(thread, class, classLen, name, nameLen,
+ *                           signature, signatureLen)
+ *            class__loaded(class, classLen)
+ *            gc__begin(requestedBytes, freeBytes)
+ *            gc__end(freeBytes)
+ *            monitor__contended__enter(thread, object, class, classLen)
+ *            exception__throw(thread, class, classLen)
+ *
+ *            "thread" is the address of the Java thread structure.
+ *            Method returns are not reported for the frames that are
+ *            unwound by an exception.
+ *=======================================================================*/
+
+#if ENABLE_USDT_PROBES
+
+/*=========================================================================
+ * Probe semaphores (defined in probes.c)
+ *=======================================================================*/
+
+extern unsigned short kvm_method__entry_semaphore;
+extern unsigned short kvm_method__return_semaphore;
+extern unsigned short kvm_class__loaded_semaphore;
+extern unsigned short kvm_gc__begin_semaphore;
+extern unsigned short kvm_gc__end_semaphore;
+extern unsigned short kvm_monitor__contended__enter_semaphore;
+extern unsigned short kvm_exception__throw_semaphore;
+
+/*=========================================================================
+ * Probe operations
+ *=======================================================================*/
+
+void probeMethodEntry(METHOD thisMethod);
+void probeMethodReturn(METHOD thisMethod);
+void probeClassLoaded(CLASS clazz);
+void probeGCBegin(long requestedBytes, long freeBytes);
+void probeGCEnd(long freeBytes);
+void probeMonitorContended(OBJECT object);
+void probeExceptionThrow(THROWABLE_INSTANCE exception);
+
+/*
+ * The hooks used by the VM.  The arguments of a probe are only
+ * computed while a tool is attached to it.
+ */
+#define PROBE_METHOD_ENTRY(thisMethod)                                \
+    if (kvm_method__entry_semaphore) {                                \
+        probeMethodEntry(thisMethod);                                 \
+    }
+
+#define PROBE_METHOD_RETURN(thisMethod)                               \
+    if (kvm_method__return_semaphore) {                               \
+        probeMethodReturn(thisMethod);                                \
+    }
+
+#define PROBE_CLASS_LOADED(clazz)                                     \
+    if (kvm_class__loaded_semaphore) {                                \
+        probeClassLoaded(clazz);                                      \
+    }
+
+#define PROBE_GC_BEGIN(requestedBytes, freeBytes)                     \
+    if (kvm_gc__begin_semaphore) {                                    \
+        probeGCBegin(requestedBytes, freeBytes);                      \
+    }
+
+#define PROBE_GC_END(freeBytes)                                       \
+    if (kvm_gc__end_semaphore) {                                      \
+        probeGCEnd(freeBytes);                                        \
+    }
+
+#define PROBE_MONITOR_CONTENDED(object)                               \
+    if (kvm_monitor__contended__enter_semaphore) {                    \
+        probeMonitorContended(object);                                \
+    }
+
+#define PROBE_EXCEPTION_THROW(exception)                              \
+    if (kvm_exception__throw_semaphore) {                             \
+        probeExceptionThrow(exception);                               \
+    }
+
+#else
+
+#define PROBE_METHOD_ENTRY(thisMethod)
+#define PROBE_METHOD_RETURN(thisMethod)
+#define PROBE_CLASS_LOADED(clazz)
+#define PROBE_GC_BEGIN(requestedBytes, freeBytes)
+#define PROBE_GC_END(freeBytes)
+#define PROBE_MONITOR_CONTENDED(object)
+#define PROBE_EXCEPTION_THROW(exception)
+
+#endif /* ENABLE_USDT_PROBES */
+
@@ -36,26 +36,29 @@
 
 #if ENABLEPROFILING
 
-extern int InstructionCounter;       /* Number of bytecodes executed */
-extern int ThreadSwitchCounter;      /* Number of thread switches */
+extern ISOLATE_LOCAL int InstructionCounter;       /* Number of bytecodes executed */
+extern ISOLATE_LOCAL int ThreadSwitchCounter;      /* Number of thread switches */
 
-extern int DynamicObjectCounter;     /* Number of dynamic objects allocated */
-extern int DynamicAllocationCounter; /* Bytes of dynamic memory allocated */
-extern int DynamicDeallocationCounter; /* Bytes of dynamic memory deallocated */
-extern int GarbageCollectionCounter; /* Number of garbage collections done */
-extern int TotalGCDeferrals;         /* Total number of GC objects deferred */
-extern int MaximumGCDeferrals;       /* Maximum number of GC objects deferred */
-extern int GarbageCollectionRescans; /* Number of extra scans of GC heap */
+extern ISOLATE_LOCAL int DynamicObjectCounter;     /* Number of dynamic objects allocated */
+extern ISOLATE_LOCAL int DynamicAllocationCounter; /* Bytes of dynamic memory allocated */
+extern ISOLATE_LOCAL int DynamicDeallocationCounter; /* Bytes of dynamic memory deallocated */
+extern ISOLATE_LOCAL int GarbageCollectionCounter; /* Number of garbage collections done */
+extern ISOLATE_LOCAL int TotalGCDeferrals;         /* Total number of GC objects deferred */
+extern ISOLATE_LOCAL int MaximumGCDeferrals;       /* Maximum number of GC objects deferred */
+extern ISOLATE_LOCAL int GarbageCollectionRescans; /* Number of extra scans of GC heap */
+
+extern ISOLATE_LOCAL int MonitorInflationCounter;  /* Number of real monitors attached */
+extern ISOLATE_LOCAL int MonitorDeflationCounter;  /* Number of real monitors detached */
 
 #if ENABLEFASTBYTECODES
-extern int InlineCacheHitCounter;    /* Number of inline cache hits */
-extern int InlineCacheMissCounter;   /* Number of inline cache misses */
-extern int MaxStackCounter;          /* Maximum amount of stack space needed */
+extern ISOLATE_LOCAL int InlineCacheHitCounter;    /* Number of inline cache hits */
+extern ISOLATE_LOCAL int InlineCacheMissCounter;   /* Number of inline cache misses */
+extern ISOLATE_LOCAL int MaxStackCounter;          /* Maximum amount of stack space needed */
 #endif
 
 #if USESTATIC
-extern int StaticObjectCounter;      /* Number of static objects allocated */
-extern int StaticAllocationCounter;  /* Bytes of static memory allocated */
+extern ISOLATE_LOCAL int StaticObjectCounter;      /* Number of static objects allocated */
+extern ISOLATE_LOCAL int StaticAllocationCounter;  /* Bytes of static memory allocated */
 #endif
 
 /*=========================================================================
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      recorder.h
+ * OVERVIEW:  Flight recorder.  When switched on at runtime, the VM
+ *            keeps the most recent VM events (garbage collections,
+ *            class loads, monitor contention, thread switches,
+ *            exceptions, SVM permit verifications and socket waits)
+ *            in a ring buffer of fixed size binary records.  The
+ *            buffer is written to a file at exit, and whenever the
+ *            port or the user asks for it (see ENABLE_FLIGHT_RECORDER
+ *            in main.h).  The file format is described in recorder.c;
+ *            tools/frdecode prints such files.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Event types
+ *=======================================================================*/
+
+/*
+ * Besides the time stamp, the thread and a duration, every event
+ * carries two values.  Their meaning is listed below.  "class" and
+ * "method" values are written out by name.
+ */
+enum recordedEventType {
+    FR_GC_BEGIN = 1,        /* bytes requested, bytes free */
+    FR_GC_END,              /* bytes free, 0; duration is the GC pause */
+    FR_CLASS_LOAD,          /* class, 0; duration of loading the class */
+    FR_MONITOR_CONTENDED,   /* class of the object, thread owning it */
+    FR_THREAD_SWITCH,       /* previous thread, new thread */
+    FR_EXCEPTION_THROWN,    /* exception class, throwing method */
+    FR_EXCEPTION_CAUGHT,    /* exception class, catching method, */
+                            /* or 0 if the exception is uncaught */
+    FR_PERMIT_VERIFIED,     /* grantee class, grantor class; duration */
+                            /* of the verification.  A failure is */
+                            /* followed by the exception it raises */
+    FR_SOCKET_WAIT,         /* socket handle, FR_SOCKET_xxx; duration */
+                            /* spent in the operation */
+    FR_LAST_EVENT_TYPE = FR_SOCKET_WAIT
+};
+
+/* Socket operations of FR_SOCKET_WAIT events */
+#define FR_SOCKET_CONNECT 1
+#define FR_SOCKET_READ    2
+#define FR_SOCKET_WRITE   3
+#define FR_SOCKET_ACCEPT  4
+
+#if ENABLE_FLIGHT_RECORDER
+
+/*=========================================================================
+ * Flight recorder variables
+ *=======================================================================*/
+
+extern char* FlightRecorderFile;     /* Dump file, NULL if not recording */
+extern long  FlightRecorderSize;     /* Number of events kept */
+
+extern ISOLATE_LOCAL bool_t FlightRecorderEnabled;
+extern ISOLATE_LOCAL long   FlightRecorderThreadCount; /* Last thread id */
+
+extern volatile int FlightRecorderDumpRequests; /* Counted by the port */
+
+/*=========================================================================
+ * Flight recorder operations
+ *=======================================================================*/
+
+void InitializeFlightRecorder(void);
+void FinalizeFlightRecorder(void);
+
+void recordEvent(THREAD thread, int type, ulong64 start,
+                 long value1, long value2);
+void recordThreadSwitch(THREAD thread);
+bool_t dumpFlightRecorder(const char* fileName);
+void checkFlightRecorderDump(void);
+
+/* Ask for a dump at the next reschedule point (signal handler safe) */
+#define requestFlightRecorderDump() (FlightRecorderDumpRequests++)
+
+/*
+ * The hooks used in the rest of the VM.  An event with a start
+ * time gets the time since then as its duration.  The start
+ * time must come from RECORDER_START_TIME(), usually through
+ * DECLARE_RECORDER_START(), which is a declaration.
+ */
+#define RECORDER_START_TIME() \
+    (FlightRecorderEnabled ? MonotonicTime_md() : 0)
+
+#define DECLARE_RECORDER_START(name) \
+    ulong64 name = RECORDER_START_TIME();
+
+#define RECORD_EVENT(type, value1, value2)                            \
+    if (FlightRecorderEnabled) {                                      \
+        recordEvent(CurrentThread, type, 0,                           \
+                    (long)(value1), (long)(value2));                  \
+    }
+
+#define RECORD_TIMED_EVENT(type, start, value1, value2)               \
+    if (FlightRecorderEnabled) {                                      \
+        recordEvent(CurrentThread, type, start,                       \
+                    (long)(value1), (long)(value2));                  \
+    }
+
+#define RECORD_THREAD_EVENT(thread, type, start, value1, value2)      \
+    if (FlightRecorderEnabled) {                                      \
+        recordEvent(thread, type, start,                              \
+                    (long)(value1), (long)(value2));                  \
+    }
+
+#define RECORD_THREAD_SWITCH(thread)                                  \
+    if (FlightRecorderEnabled) {                                      \
+        recordThreadSwitch(thread);                                   \
+    }
+
+#define recorderThreadId(thread) \
+    ((thread) == NULL ? 0 : (thread)->recorderId)
+
+#else
+
+#define InitializeFlightRecorder()
+#define FinalizeFlightRecorder()
+#define checkFlightRecorderDump()
+
+#define DECLARE_RECORDER_START(name)
+#define RECORD_EVENT(type, value1, value2)
+#define RECORD_TIMED_EVENT(type, start, value1, value2)
+#define RECORD_THREAD_EVENT(thread, type, start, value1, value2)
+#define RECORD_THREAD_SWITCH(thread)
+
+#endif /* ENABLE_FLIGHT_RECORDER */
+
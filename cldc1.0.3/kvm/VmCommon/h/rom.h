@@ -54,9 +54,9 @@
 /* The layout of an originally created string */
 
 
-#define KVM_INIT_JAVA_STRING(offset, length, next) \
+#define KVM_INIT_JAVA_STRING(offset, length, hash, next) \
     { &AllClassblocks.java_lang_String, { NULL }, \
-      (SHORTARRAY)&stringCharArrayInternal, offset, length, \
+      (SHORTARRAY)&stringCharArrayInternal, offset, length, hash, \
       (INTERNED_STRING_INSTANCE)next }
 
 #define CHARARRAY_X(len)              \
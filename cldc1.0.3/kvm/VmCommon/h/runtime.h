@@ -75,6 +75,51 @@ ulong64 CurrentTime_md(void);
 long RandomNumber_md();
 #endif
 
+#if TIMER_RESCHEDULING
+
+/* Start and stop the periodic timer that counts down Timeslice */
+/* and requests a thread switch when it runs out (see main.h)   */
+
+#ifndef StartRescheduleTimer_md
+void StartRescheduleTimer_md(void);
+#endif
+
+#ifndef StopRescheduleTimer_md
+void StopRescheduleTimer_md(void);
+#endif
+
+#else
+
+#define StartRescheduleTimer_md() /**/
+#define StopRescheduleTimer_md()  /**/
+
+#endif /* TIMER_RESCHEDULING */
+
+#if ENABLE_SAMPLING_PROFILER
+
+/* Start and stop the timer that asks for a profiler sample */
+/* "rate" times per second of CPU time (see sampler.h)      */
+
+#ifndef StartSamplingTimer_md
+void StartSamplingTimer_md(int rate);
+#endif
+
+#ifndef StopSamplingTimer_md
+void StopSamplingTimer_md(void);
+#endif
+
+#endif /* ENABLE_SAMPLING_PROFILER */
+
+#if ENABLE_FLIGHT_RECORDER || ENABLE_GC_STATISTICS || ENABLE_STARTUP_TRACE
+
+/* Microseconds from a clock that never goes backwards */
+
+#ifndef MonotonicTime_md
+ulong64 MonotonicTime_md(void);
+#endif
+
+#endif /* ENABLE_FLIGHT_RECORDER || ENABLE_GC_STATISTICS || ENABLE_STARTUP_TRACE */
+
 #if ASYNCHRONOUS_NATIVE_FUNCTIONS
 
 #ifndef Yield_md
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ * 
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ * 
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ * 
+ */
+
+/*=========================================================================
+ * KVM 
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      sampler.h
+ * OVERVIEW:  Sampling profiler for Java code.  A host timer running
+ *            on CPU time periodically asks the interpreter to record
+ *            the Java call stack of the current thread.  At exit the
+ *            samples are written out as a flat profile, a call tree
+ *            and as collapsed stacks (see ENABLE_SAMPLING_PROFILER
+ *            in main.h).
+ *=======================================================================*/
+
+#if ENABLE_SAMPLING_PROFILER
+
+/*=========================================================================
+ * Sampling profiler variables
+ *=======================================================================*/
+
+extern char* SamplingProfilerFile;  /* Report file, NULL if not profiling */
+extern int   SamplingProfilerRate;  /* Samples per second of CPU time */
+
+extern volatile int SampleRequested; /* Set by the sampling timer */
+
+/*
+ * With TIMER_RESCHEDULING the sampling timer stops the interpreter
+ * by setting RescheduleRequested to this value, unless a reschedule
+ * is already pending.  recordSample() can then tell that the thread
+ * does not have to be switched.
+ */
+#define SAMPLE_RESCHEDULE 2
+
+/*=========================================================================
+ * Sampling profiler operations
+ *=======================================================================*/
+
+void InitializeSamplingProfiler(void);
+void FinalizeSamplingProfiler(void);
+
+bool_t recordSample(void);
+void setMethodLineNumbers(METHOD thisMethod, LINENUMBERTABLE lineNumberTable);
+
+/*
+ * Called from the sampling timer signal handler
+ */
+#if TIMER_RESCHEDULING
+#define requestSample() {                                  \
+    SampleRequested = TRUE;                                \
+    if (!RescheduleRequested) {                            \
+        RescheduleRequested = SAMPLE_RESCHEDULE;           \
+    }                                                      \
+}
+#else
+#define requestSample() (SampleRequested = TRUE)
+#endif /* TIMER_RESCHEDULING */
+
+#else
+
+#define InitializeSamplingProfiler()
+#define FinalizeSamplingProfiler()
+
+#endif /* ENABLE_SAMPLING_PROFILER */
+
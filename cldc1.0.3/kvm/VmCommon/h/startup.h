@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      startup.h
+ * OVERVIEW:  Startup trace.  From the start of the VM until the main
+ *            method of the application is entered, the phases of
+ *            KVM_Start and every class load, verification, class
+ *            initialization, native method binding and permit
+ *            verification are timed as nested spans.  The spans are
+ *            printed as a tree with total and self times, and written
+ *            to a file in the Chrome trace event format (see
+ *            ENABLE_STARTUP_TRACE in main.h).
+ *=======================================================================*/
+
+/*=========================================================================
+ * Kinds of spans
+ *=======================================================================*/
+
+enum startupSpanKind {
+    STARTUP_PHASE = 0,      /* A phase of KVM_Start */
+    STARTUP_LOAD,           /* Loading a class file */
+    STARTUP_VERIFY,         /* Verifying a class */
+    STARTUP_INITIALIZE,     /* Running the <clinit> of a class */
+    STARTUP_NATIVE,         /* Binding a native method */
+    STARTUP_PERMIT,         /* Verifying a permit */
+    STARTUP_KIND_COUNT
+};
+
+#if ENABLE_STARTUP_TRACE
+
+/*=========================================================================
+ * Startup trace variables
+ *=======================================================================*/
+
+extern char* StartupTraceFile;          /* Trace event file, or NULL */
+
+extern ISOLATE_LOCAL bool_t StartupTraceEnabled;
+
+/*=========================================================================
+ * Startup trace operations
+ *=======================================================================*/
+
+void InitializeStartupTrace(void);
+void FinalizeStartupTrace(void);
+
+void startupTraceBegin(int kind, const char* name);
+void startupTraceBeginClass(int kind, CLASS clazz, CLASS other);
+void startupTraceEnd(int kind);
+
+/*
+ * The hooks used by the VM.  A span that an exception leaves open is
+ * closed together with the first enclosing span that is ended.  The
+ * trace is finished when the main method is entered.
+ */
+#define STARTUP_TRACE_BEGIN(kind, name)                               \
+    if (StartupTraceEnabled) {                                        \
+        startupTraceBegin(kind, name);                                \
+    }
+
+#define STARTUP_TRACE_BEGIN_CLASS(kind, clazz, other)                 \
+    if (StartupTraceEnabled) {                                        \
+        startupTraceBeginClass(kind, (CLASS)(clazz), (CLASS)(other)); \
+    }
+
+#define STARTUP_TRACE_END(kind)                                       \
+    if (StartupTraceEnabled) {                                        \
+        startupTraceEnd(kind);                                        \
+    }
+
+#define STARTUP_TRACE_DONE()                                          \
+    if (StartupTraceEnabled) {                                        \
+        FinalizeStartupTrace();                                       \
+    }
+
+#else
+
+#define InitializeStartupTrace()
+#define FinalizeStartupTrace()
+
+#define STARTUP_TRACE_BEGIN(kind, name)
+#define STARTUP_TRACE_BEGIN_CLASS(kind, clazz, other)
+#define STARTUP_TRACE_END(kind)
+#define STARTUP_TRACE_DONE()
+
+#endif /* ENABLE_STARTUP_TRACE */
+
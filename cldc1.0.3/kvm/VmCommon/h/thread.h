@@ -74,6 +74,16 @@
  * NOTE: RunnableThreads points to the >>last<< item on the circular queue.
  * This makes it easy to add items to either the front or back of the queue.
  *
+ * If PRIORITY_SCHEDULING is enabled, RunnableThreads is replaced by an
+ * array RunQueues of such circular queues, one for each Java priority
+ * level, and a bitmap RunQueueMask of the levels that are in use.
+ * SwitchThread always takes the first thread of the highest level in
+ * use.  A thread that is running keeps the processor at the end of its
+ * time slice unless there is a runnable thread of at least the same
+ * priority.  To prevent starvation the queues are aged: periodically
+ * the first thread of each level is moved up one level.  A thread
+ * returns to the level of its own priority the next time it is queued.
+ *
  * Important routine changes:
  *
  * suspendThread()
@@ -100,6 +110,11 @@
  * to the code in the original threading system.  The function
  * signalTimeToReschedule() simply sets Timeslice to zero.
  *
+ * If TIMER_RESCHEDULING is enabled, Timeslice is instead counted
+ * down in timer ticks by a host timer signal, which sets the flag
+ * RescheduleRequested when the slice runs out. isTimeToReschedule()
+ * then simply tests that flag, and signalTimeToReschedule() sets it.
+ *
  * startThread()
  * -------------
  *
@@ -252,17 +267,29 @@
 #ifndef __THREAD_H__
 #define __THREAD_H__
 
-extern THREAD CurrentThread;    /* Current thread */
-extern THREAD MainThread;       /* For debugger code to access */
+extern ISOLATE_LOCAL THREAD CurrentThread;    /* Current thread */
+extern ISOLATE_LOCAL THREAD MainThread;       /* For debugger code to access */
 
-extern THREAD AllThreads;       /* List of all threads */
-extern THREAD RunnableThreads;  /* Queue of all threads that can be run */
+extern ISOLATE_LOCAL THREAD AllThreads;       /* List of all threads */
+#if PRIORITY_SCHEDULING
+extern ISOLATE_LOCAL THREAD RunQueues[];      /* Queue of runnable threads per priority */
+extern ISOLATE_LOCAL int    RunQueueMask;     /* Bit n is set if RunQueues[n] is in use */
+#define areRunnableThreads() (RunQueueMask != 0)
+#else
+extern ISOLATE_LOCAL THREAD RunnableThreads;  /* Queue of all threads that can be run */
+#define areRunnableThreads() (RunnableThreads != NULL)
+#endif
 
-extern int AliveThreadCount;    /* Number of alive threads */
+extern ISOLATE_LOCAL int AliveThreadCount;    /* Number of alive threads */
 
-extern int Timeslice;           /* Time slice counter for multitasking */
+#if TIMER_RESCHEDULING
+extern ISOLATE_LOCAL volatile int Timeslice;  /* Ticks left, counted down by the timer */
+extern ISOLATE_LOCAL volatile int RescheduleRequested; /* Set when Timeslice expires */
+#else
+extern ISOLATE_LOCAL int Timeslice;           /* Time slice counter for multitasking */
+#endif
 
-#define areActiveThreads() (CurrentThread != NULL || RunnableThreads != NULL)
+#define areActiveThreads() (CurrentThread != NULL || areRunnableThreads())
 #define areAliveThreads()  (AliveThreadCount > 0)
 
 #define MAX_PRIORITY  10        /* These constants must be the same */
@@ -331,15 +358,26 @@ struct threadQueue {
 
     MONITOR monitor;         /*  Monitor whose queue this thread is  on */
     short monitor_depth;
+    bool_t nativeLockGiven;  /*  Holds the lock that a synchronized */
+                             /*  native method waited for */
 
     THREAD nextAlarmThread;  /* The next thread on this queue */
     long   wakeupTime[2];    /* We can't demand 8-byte alignment of heap
                                 objects  */
     void (*wakeupCall)(THREAD); /* Callback when thread's alarm goes off */
-    struct {
-        int depth;
-        long hashCode;
-    } extendedLock;          /* Used by an object with a FASTLOCK */
+    struct fastLockStruct {
+        OBJECT object;       /* Object locked with this fast lock */
+        int    depth;        /* Locking depth, or 0 if the lock is free */
+        long   hashCode;     /* Hash code of the object */
+    } extendedLocks[FAST_LOCKS_PER_THREAD]; /* Used by MHC_EXTENDED_LOCK */
+
+#if PRIORITY_SCHEDULING
+    long   runLevel;         /* Run queue the thread is on or was taken from */
+#endif
+
+#if ENABLE_FLIGHT_RECORDER
+    long   recorderId;       /* Number of the thread in recorded events */
+#endif
 
 #if ASYNCHRONOUS_NATIVE_FUNCTIONS
     char *pendingException;  /* Name of class for which the thread */
@@ -444,7 +482,7 @@ void   printFullThreadStatus(void);
  *=======================================================================*/
 
 /* Threads waiting for a timer interrupt */
-extern THREAD TimerQueue;
+extern ISOLATE_LOCAL THREAD TimerQueue;
 
 /*=========================================================================
  * Timer operations
@@ -458,7 +496,7 @@ bool_t inTimerQueue(THREAD thread);
  * Monitor data structures and operations
  *=======================================================================*/
 
-extern MONITOR MonitorCache;
+extern ISOLATE_LOCAL MONITOR MonitorCache;
 
 /*=========================================================================
  * COMMENTS:
@@ -497,13 +535,14 @@ enum MHC_Tag_TypeCode {
     MHC_UNLOCKED  = 0,
 
     /* The upper 30 bits are the thread that locks this object.
-     * This object implicitly has no hash code, and the locking
-     * depth is 1.  There is no other contention for this object */
+     * The locking depth is 1, and the hash code is the one recorded
+     * for this object in IdentityHashes[], or 0 if there is none.
+     * There is no other contention for this object */
     MHC_SIMPLE_LOCK  = 1,
 
     /* The upper 30 bits are the thread that locks this object.
-     * thread->extendedLock.hashCode & thread->extendedLock->depth
-     * contain this object's hashCode and and locking depth.
+     * The entry of thread->extendedLocks[] whose .object is this object
+     * contains this object's hashCode and locking depth.
      * There is no other contention for this object. */
     MHC_EXTENDED_LOCK = 2,
 
@@ -523,8 +562,24 @@ enum MHC_Tag_TypeCode {
              ((THREAD)(((char *)(obj)->mhc.address) - MHC_EXTENDED_LOCK))
 
 /* Utility macros for checking and setting lock values */
-#define IS_EXTENDED_LOCK_FREE(thread) (thread->extendedLock.depth == 0)
-#define FREE_EXTENDED_LOCK(thread)    (thread->extendedLock.depth = 0)
+typedef struct fastLockStruct* FASTLOCK;
+
+#define IS_FAST_LOCK_FREE(lock) ((lock)->depth == 0)
+#define FREE_FAST_LOCK(lock)    ((lock)->depth = 0, (lock)->object = NIL)
+
+/* Hash code of an object that is locked with a simple lock.  The
+ * garbage collector treats the objects in this table as roots and
+ * updates them when the heap is compacted.
+ */
+struct identityHashStruct {
+    OBJECT object;
+    long   hashCode;
+};
+
+typedef struct identityHashStruct* IDENTITYHASH;
+
+extern ISOLATE_LOCAL struct identityHashStruct IdentityHashes[];
+extern ISOLATE_LOCAL int IdentityHashCount;
 
 /*  MONITOR (allocated in stack frames) */
 struct monitorStruct {
@@ -563,6 +618,12 @@ enum MonitorStatusType  monitorNotify(OBJECT object, bool_t wakeAll);
 /* Remove any monitor associated with this object */
 void clearObjectMonitor(OBJECT object);
 
+/* Called by the garbage collector to turn an idle real monitor back into
+ * a fast lock or a plain hash code.  Returns TRUE if the monitor is no
+ * longer attached to the object.
+ */
+bool_t deflateObjectMonitor(OBJECT object);
+
 /* If this object has a monitor or monitor-like structure associated with it,
  * then return the address of its "hash code" field.  This function may GC
  * if it returns a non-NULL value.
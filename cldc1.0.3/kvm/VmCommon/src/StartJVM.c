@@ -88,8 +88,13 @@ int KVM_Start(int argc, char* argv[])
     int returnValue = 0; /* Needed to make compiler happy */
     TRY {
         VM_START {
+            /* Time the startup if asked to */
+            InitializeStartupTrace();
+
             /* If ROMIZING and RELOCATABLE_ROM */
+            STARTUP_TRACE_BEGIN(STARTUP_PHASE, "CreateROMImage")
             CreateROMImage();
+            STARTUP_TRACE_END(STARTUP_PHASE)
 
 #if ASYNCHRONOUS_NATIVE_FUNCTIONS
             /* Initialize asynchronous I/O system */
@@ -97,6 +102,7 @@ int KVM_Start(int argc, char* argv[])
 #endif
 
             /* Initialize all the essential runtime structures of the VM */
+            STARTUP_TRACE_BEGIN(STARTUP_PHASE, "InitializeVM")
             InitializeNativeCode();
             InitializeVM();
 
@@ -105,11 +111,21 @@ int KVM_Start(int argc, char* argv[])
 
             /* Initialize profiling variables */
             InitializeProfiling();
+            InitializeSamplingProfiler();
+            InitializeFlightRecorder();
+            InitializeAllocationProfiler();
+            InitializeHeapDump();
+            InitializeGCStatistics();
+            InitializeExecutionCounters();
+            STARTUP_TRACE_END(STARTUP_PHASE)
 
             /* Initialize the memory system */
+            STARTUP_TRACE_BEGIN(STARTUP_PHASE, "InitializeMemoryManagement")
             InitializeMemoryManagement();
+            STARTUP_TRACE_END(STARTUP_PHASE)
 
             /* Initialize internal hash tables */
+            STARTUP_TRACE_BEGIN(STARTUP_PHASE, "InitializeHashtables")
             InitializeHashtables();
 
             /* Initialize inline caching structures */
@@ -117,9 +133,12 @@ int KVM_Start(int argc, char* argv[])
 
             /* Initialize the class loading interface */
             InitializeClassLoading();
+            STARTUP_TRACE_END(STARTUP_PHASE)
 
             /* Load and initialize the Java system classes needed by the VM */
+            STARTUP_TRACE_BEGIN(STARTUP_PHASE, "InitializeJavaSystemClasses")
             InitializeJavaSystemClasses();
+            STARTUP_TRACE_END(STARTUP_PHASE)
 
             /* Initialize the class file verifier */
             InitializeVerifier();
@@ -128,8 +147,10 @@ int KVM_Start(int argc, char* argv[])
             InitializeEvents();
             
             /* Load the main application class */
+            STARTUP_TRACE_BEGIN(STARTUP_PHASE, "LoadMainClass")
             mainClass = (INSTANCE_CLASS)getClass(replaceLetters(argv[0],
                         '.', '/'));
+            STARTUP_TRACE_END(STARTUP_PHASE)
             if (!mainClass) {
                 sprintf(str_buffer, KVM_MSG_CLASS_NOT_FOUND_1STRPARAM, argv[0]);
                 AlertUser(str_buffer);
@@ -140,7 +161,9 @@ int KVM_Start(int argc, char* argv[])
 
                 /* Now that we have a main class, initialize */
                 /* the multithreading system */
+                STARTUP_TRACE_BEGIN(STARTUP_PHASE, "InitializeThreading")
                 InitializeThreading(mainClass, arguments);
+                STARTUP_TRACE_END(STARTUP_PHASE)
 
                 /* Instances of these classes may have been created without
                  * explicitly executing the "new" instruction. Thus we have
@@ -153,8 +176,10 @@ int KVM_Start(int argc, char* argv[])
                 }
 #endif
                 /* These are pushed onto the stack.  So JavaLangClass is
-                 * the first class that is initialized.
+                 * the first class that is initialized.  The phase ends
+                 * when the main method is entered.
                  */
+                STARTUP_TRACE_BEGIN(STARTUP_PHASE, "InitializeClasses")
                 initializeClass(JavaLangOutOfMemoryError);
                 initializeClass(JavaLangSystem);
                 initializeClass(JavaLangString);
@@ -167,7 +192,7 @@ int KVM_Start(int argc, char* argv[])
                     THREAD ct = CurrentThread;                
                     setEvent_VMInit();
                     if (CurrentThread == NIL) {
-                        if (RunnableThreads != NIL)
+                        if (areRunnableThreads())
                             CurrentThread = removeFirstRunnableThread();
                         else {
                             ct->state |= THREAD_SUSPENDED;
@@ -183,6 +208,7 @@ int KVM_Start(int argc, char* argv[])
 #endif /* ENABLE_JAVA_DEBUGGER */
 
                 /* Start the interpreter */
+                StartRescheduleTimer_md();
                 Interpret();
             }
         } VM_FINISH(value) {
@@ -215,6 +241,13 @@ void KVM_Cleanup()
         clearAllBreakpoints();
     }
 #endif
+    StopRescheduleTimer_md();
+    FinalizeStartupTrace();
+    FinalizeSamplingProfiler();
+    FinalizeFlightRecorder();
+    FinalizeAllocationProfiler();
+    FinalizeGCStatistics();
+    FinalizeExecutionCounters();
     FinalizeVM();
     FinalizeInlineCaching();
     FinalizeNativeCode();
@@ -249,4 +282,26 @@ int StartJVM(int argc, char* argv[])
     return returnValue;
 }
 
+#if MULTIPLE_ISOLATES
+
+/*=========================================================================
+ * FUNCTION:      isolateFileName
+ * TYPE:          public global operation
+ * OVERVIEW:      Give the output file of a VM option a name of its own
+ *                in every isolate, by appending the isolate number.
+ * INTERFACE:
+ *   parameters:  file name given on the command line
+ *   returns:     the new file name (to be released with free), or
+ *                NULL if there is no memory for it
+ *=======================================================================*/
+
+char* isolateFileName(char* fileName)
+{
+    char* result = (char*)malloc(strlen(fileName) + 12);
+    if (result != NULL) {
+        sprintf(result, "%s.%d", fileName, IsolateNumber);
+    }
+    return result;
+}
 
+#endif /* MULTIPLE_ISOLATES */
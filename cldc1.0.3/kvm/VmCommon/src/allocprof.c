@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      allocprof.c
+ * OVERVIEW:  Allocation profiler (see allocprof.h).  Allocations are
+ *            counted per (method, bytecode index, class) in a hash
+ *            table of malloc'ed records, so that profiling does not
+ *            change the Java heap it measures.  Since the allocators
+ *            are called with the interpreter registers saved, the
+ *            allocation site is simply the ip of the current frame.
+ *
+ *            With a sampling interval, the recorded allocation is
+ *            charged with all the bytes allocated since the previous
+ *            recorded one, and its object count is estimated from its
+ *            size.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if ENABLE_ALLOCATION_PROFILER
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+#define ALLOCATION_SITE_TABLE_SIZE 1024  /* Must be a power of two */
+#define ALLOCATION_SITE_BLOCK_SIZE  256  /* Sites malloc'ed at once */
+#define ALLOCATION_REPORT_LINES      40  /* Sites and classes listed */
+
+typedef struct allocationSiteStruct* ALLOCATIONSITE;
+
+struct allocationSiteStruct {
+    METHOD         method;         /* NULL for allocations by the VM */
+    long           offset;         /* Bytecode index of the site */
+    CLASS          clazz;          /* Class of the objects */
+    long           bytes;          /* Totals since the VM started */
+    long           count;
+    long           snapshotBytes;  /* Totals at the last snapshot */
+    long           snapshotCount;
+    ALLOCATIONSITE next;           /* Next site in the hash bucket */
+};
+
+/*
+ * The bytes and objects of a site or class in a report
+ */
+struct allocationTotalStruct {
+    ALLOCATIONSITE site;
+    long           bytes;
+    long           count;
+};
+
+/*=========================================================================
+ * Allocation profiler variables
+ *=======================================================================*/
+
+char* AllocationProfilerFile = NULL;
+long  AllocationProfilerInterval = ALLOCATION_PROFILER_INTERVAL;
+long  AllocationBytesPending;
+
+volatile int AllocationSnapshotRequests;
+
+static int SnapshotRequestsHandled;
+static int SnapshotNumber;
+
+static ALLOCATIONSITE AllocationSites[ALLOCATION_SITE_TABLE_SIZE];
+static ALLOCATIONSITE FreeAllocationSites;
+static int FreeAllocationSiteCount;
+static long AllocationSiteCount;
+
+/*=========================================================================
+ * Static functions (private to this file)
+ *=======================================================================*/
+
+static ALLOCATIONSITE getAllocationSite(METHOD thisMethod, long offset,
+                                        CLASS clazz);
+static bool_t writeAllocationReport(const char* fileName,
+                                    bool_t sinceSnapshot);
+
+/*=========================================================================
+ * Allocation profiler operations
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      InitializeAllocationProfiler
+ * TYPE:          Profiling
+ * OVERVIEW:      Reset the profiler.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void InitializeAllocationProfiler(void)
+{
+    AllocationBytesPending = 0;
+    SnapshotRequestsHandled = AllocationSnapshotRequests;
+    SnapshotNumber = 0;
+    AllocationSiteCount = 0;
+    memset(AllocationSites, 0, sizeof(AllocationSites));
+    if (AllocationProfilerInterval < 0) {
+        AllocationProfilerInterval = 0;
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      FinalizeAllocationProfiler
+ * TYPE:          Profiling
+ * OVERVIEW:      Write the report for the whole run.  Must be called
+ *                while the classes are still loaded.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void FinalizeAllocationProfiler(void)
+{
+    if (AllocationProfilerFile == NULL) {
+        return;
+    }
+    if (!writeAllocationReport(AllocationProfilerFile, FALSE)) {
+        fprintf(stderr, "Cannot write allocation profile to %s\n",
+                AllocationProfilerFile);
+    }
+    AllocationProfilerFile = NULL;
+}
+
+/*=========================================================================
+ * FUNCTION:      recordAllocation
+ * TYPE:          Profiling
+ * OVERVIEW:      Charge the bytes allocated since the last recorded
+ *                allocation to the current allocation site.  Called
+ *                through RECORD_ALLOCATION once AllocationBytesPending
+ *                reaches the sampling interval.
+ * INTERFACE:
+ *   parameters:  class and size in bytes of the new object
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void recordAllocation(CLASS clazz, long bytes)
+{
+    METHOD thisMethod = NULL;
+    long offset = 0;
+    long count = AllocationBytesPending / bytes;
+    ALLOCATIONSITE site;
+
+    /* Allocations made before the first thread runs belong to the VM */
+    if (CurrentThread != NULL && getFP() != NULL) {
+        thisMethod = getFP()->thisMethod;
+        offset = getIP() - thisMethod->u.java.code;
+    }
+    site = getAllocationSite(thisMethod, offset, clazz);
+    site->bytes += AllocationBytesPending;
+    site->count += (count > 0) ? count : 1;
+    AllocationBytesPending = 0;
+}
+
+/*=========================================================================
+ * FUNCTION:      writeAllocationSnapshot
+ * TYPE:          Profiling
+ * OVERVIEW:      Write the allocations since the previous snapshot
+ *                (or since the VM started) to the report file with
+ *                the number of the snapshot appended, and start the
+ *                next snapshot.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     TRUE if the file was written
+ *=======================================================================*/
+
+bool_t writeAllocationSnapshot(void)
+{
+    char* fileName;
+    bool_t written;
+    int i;
+
+    if (AllocationProfilerFile == NULL) {
+        return FALSE;
+    }
+    fileName = (char*)malloc(strlen(AllocationProfilerFile) + 12);
+    if (fileName == NULL) {
+        return FALSE;
+    }
+    sprintf(fileName, "%s.%d", AllocationProfilerFile, ++SnapshotNumber);
+    written = writeAllocationReport(fileName, TRUE);
+    free(fileName);
+
+    for (i = 0; i < ALLOCATION_SITE_TABLE_SIZE; i++) {
+        ALLOCATIONSITE site;
+        for (site = AllocationSites[i]; site != NULL; site = site->next) {
+            site->snapshotBytes = site->bytes;
+            site->snapshotCount = site->count;
+        }
+    }
+    return written;
+}
+
+/*=========================================================================
+ * FUNCTION:      checkAllocationSnapshot
+ * TYPE:          Profiling
+ * OVERVIEW:      Write a snapshot if the port asked for one since the
+ *                last call.  Called by the interpreter at reschedule
+ *                points.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void checkAllocationSnapshot(void)
+{
+    int requests = AllocationSnapshotRequests;
+    if (requests != SnapshotRequestsHandled) {
+        SnapshotRequestsHandled = requests;
+        writeAllocationSnapshot();
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      getAllocationSite
+ * TYPE:          private profiling operation
+ * OVERVIEW:      Find the record of a site and class, adding it if
+ *                there is none yet.
+ * INTERFACE:
+ *   parameters:  method (NULL for the VM), bytecode index, class
+ *   returns:     the site record
+ *=======================================================================*/
+
+static ALLOCATIONSITE getAllocationSite(METHOD thisMethod, long offset,
+                                        CLASS clazz)
+{
+    unsigned long hash = ((unsigned long)thisMethod >> 2)
+                       + ((unsigned long)clazz >> 2) * 31 + offset;
+    ALLOCATIONSITE* bucket =
+        &AllocationSites[hash & (ALLOCATION_SITE_TABLE_SIZE - 1)];
+    ALLOCATIONSITE site;
+
+    for (site = *bucket; site != NULL; site = site->next) {
+        if (site->method == thisMethod && site->offset == offset
+                && site->clazz == clazz) {
+            return site;
+        }
+    }
+    if (FreeAllocationSiteCount == 0) {
+        FreeAllocationSites = (ALLOCATIONSITE)
+            malloc(ALLOCATION_SITE_BLOCK_SIZE
+                   * sizeof(struct allocationSiteStruct));
+        if (FreeAllocationSites == NULL) {
+            fatalError("Out of memory in the allocation profiler");
+        }
+        FreeAllocationSiteCount = ALLOCATION_SITE_BLOCK_SIZE;
+    }
+    site = FreeAllocationSites++;
+    FreeAllocationSiteCount--;
+    memset(site, 0, sizeof(struct allocationSiteStruct));
+    site->method = thisMethod;
+    site->offset = offset;
+    site->clazz = clazz;
+    site->next = *bucket;
+    *bucket = site;
+    AllocationSiteCount++;
+    return site;
+}
+
+/*=========================================================================
+ * Report generation
+ *=======================================================================*/
+
+/*
+ * Print a class name in Java form, e.g. "java.lang.String" or "[C"
+ */
+static void printAllocatedClass(FILE* file, CLASS clazz)
+{
+    char* name = str_buffer;
+    char* end = getClassName_inBuffer(clazz, name);
+    char* p;
+
+    for (p = name; p < end; p++) {
+        if (*p == '/') {
+            *p = '.';
+        }
+    }
+    fputs(name, file);
+}
+
+/*
+ * Print an allocation site, e.g. "java.lang.String.<init>@14"
+ */
+static void printAllocationSite(FILE* file, ALLOCATIONSITE site)
+{
+    if (site->method == NULL) {
+        fputs("(vm)", file);
+        return;
+    }
+    printAllocatedClass(file, (CLASS)site->method->ofClass);
+    fprintf(file, ".%s@%ld", methodName(site->method), site->offset);
+}
+
+/*
+ * Print "bytes" as a percentage of "total", e.g. " 12.5%"
+ */
+static void printPercentage(FILE* file, long bytes, long total)
+{
+    long perMille = (total == 0) ? 0
+                  : (long)(((double)bytes * 1000) / total);
+    fprintf(file, "%4ld.%ld%%", perMille / 10, perMille % 10);
+}
+
+static int compareTotals(const void* first, const void* second)
+{
+    const struct allocationTotalStruct* a = first;
+    const struct allocationTotalStruct* b = second;
+    if (a->bytes != b->bytes) {
+        return (a->bytes > b->bytes) ? -1 : 1;
+    }
+    return 0;
+}
+
+static int compareClasses(const void* first, const void* second)
+{
+    const struct allocationTotalStruct* a = first;
+    const struct allocationTotalStruct* b = second;
+    if (a->site->clazz != b->site->clazz) {
+        return ((unsigned long)a->site->clazz
+                < (unsigned long)b->site->clazz) ? -1 : 1;
+    }
+    return 0;
+}
+
+/*
+ * Print the first ALLOCATION_REPORT_LINES of a sorted list of totals
+ */
+static void writeTotals(FILE* file, struct allocationTotalStruct* totals,
+                        long count, long totalBytes, bool_t bySite)
+{
+    long otherBytes = 0, otherCount = 0;
+    long i;
+
+    fprintf(file, "%5s %12s %10s  %s\n", "%", "bytes", "objects",
+            bySite ? "class  site" : "class");
+    for (i = 0; i < count; i++) {
+        if (i >= ALLOCATION_REPORT_LINES) {
+            otherBytes += totals[i].bytes;
+            otherCount += totals[i].count;
+            continue;
+        }
+        printPercentage(file, totals[i].bytes, totalBytes);
+        fprintf(file, " %12ld %10ld  ", totals[i].bytes, totals[i].count);
+        printAllocatedClass(file, totals[i].site->clazz);
+        if (bySite) {
+            fputs("  ", file);
+            printAllocationSite(file, totals[i].site);
+        }
+        fputc('\n', file);
+    }
+    if (otherBytes > 0) {
+        printPercentage(file, otherBytes, totalBytes);
+        fprintf(file, " %12ld %10ld  (other)\n", otherBytes, otherCount);
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      writeAllocationReport
+ * TYPE:          private profiling operation
+ * OVERVIEW:      Write the top allocation sites and classes, either
+ *                for the whole run or since the last snapshot.
+ * INTERFACE:
+ *   parameters:  file name, TRUE for the allocations since the last
+ *                snapshot
+ *   returns:     TRUE if the file was written
+ *=======================================================================*/
+
+static bool_t writeAllocationReport(const char* fileName,
+                                    bool_t sinceSnapshot)
+{
+    struct allocationTotalStruct* sites;
+    struct allocationTotalStruct* classes;
+    long siteCount = 0, classCount = 0;
+    long totalBytes = 0, totalCount = 0;
+    FILE* file;
+    long i;
+
+    sites = (struct allocationTotalStruct*)
+        malloc((AllocationSiteCount + 1)
+               * sizeof(struct allocationTotalStruct));
+    classes = (struct allocationTotalStruct*)
+        malloc((AllocationSiteCount + 1)
+               * sizeof(struct allocationTotalStruct));
+    file = (sites == NULL || classes == NULL) ? NULL : fopen(fileName, "w");
+    if (file == NULL) {
+        free(sites);
+        free(classes);
+        return FALSE;
+    }
+
+    for (i = 0; i < ALLOCATION_SITE_TABLE_SIZE; i++) {
+        ALLOCATIONSITE site;
+        for (site = AllocationSites[i]; site != NULL; site = site->next) {
+            long bytes = site->bytes;
+            long count = site->count;
+            if (sinceSnapshot) {
+                bytes -= site->snapshotBytes;
+                count -= site->snapshotCount;
+            }
+            if (bytes > 0) {
+                sites[siteCount].site = site;
+                sites[siteCount].bytes = bytes;
+                sites[siteCount].count = count;
+                siteCount++;
+                totalBytes += bytes;
+                totalCount += count;
+            }
+        }
+    }
+
+    /* Add up the sites of each class */
+    memcpy(classes, sites, siteCount * sizeof(struct allocationTotalStruct));
+    qsort(classes, siteCount, sizeof(struct allocationTotalStruct),
+          compareClasses);
+    for (i = 0; i < siteCount; i++) {
+        if (classCount > 0
+                && classes[classCount - 1].site->clazz == classes[i].site->clazz) {
+            classes[classCount - 1].bytes += classes[i].bytes;
+            classes[classCount - 1].count += classes[i].count;
+        } else {
+            classes[classCount++] = classes[i];
+        }
+    }
+    qsort(sites, siteCount, sizeof(struct allocationTotalStruct),
+          compareTotals);
+    qsort(classes, classCount, sizeof(struct allocationTotalStruct),
+          compareTotals);
+
+    if (sinceSnapshot) {
+        if (SnapshotNumber > 1) {
+            fprintf(file, "Allocations since snapshot %d: ",
+                    SnapshotNumber - 1);
+        } else {
+            fprintf(file, "Allocations since start: ");
+        }
+    } else {
+        fprintf(file, "Allocations: ");
+    }
+    fprintf(file, "%ld bytes in %ld objects\n", totalBytes, totalCount);
+    if (AllocationProfilerInterval > 0) {
+        fprintf(file, "Recorded one allocation per %ld bytes; "
+                "object counts are estimates\n", AllocationProfilerInterval);
+    }
+
+    fprintf(file, "\nTop allocation sites:\n\n");
+    writeTotals(file, sites, siteCount, totalBytes, TRUE);
+    fprintf(file, "\nTop classes:\n\n");
+    writeTotals(file, classes, classCount, totalBytes, FALSE);
+
+    fclose(file);
+    free(sites);
+    free(classes);
+    return TRUE;
+}
+
+#endif /* ENABLE_ALLOCATION_PROFILER */
+
@@ -1746,8 +1746,8 @@ DONEX
 
 #if STANDARDBYTECODES
 SELECT(GOTO)                      /*  Branch if references are not equal */
-        ip += getShort(ip + 1);
-DONE_R
+        BRANCH(getShort(ip + 1))
+DONEX
 #endif
 
 /* --------------------------------------------------------------------- */
@@ -1847,6 +1847,7 @@ SELECT6(IRETURN, LRETURN, FRETURN, DRETURN, ARETURN, RETURN)
         OBJECT synchronized  = fp->syncObject;
 
         TRACE_METHOD_EXIT(fp->thisMethod);
+        COUNT_PAIR_BREAK
 
         if (synchronized != NULL) {
             char*  exitError;
@@ -2253,7 +2254,17 @@ SELECT(INVOKESTATIC)                  /*  Invoke a class (static) method */
         if (thisMethod) {
 
 #if ENABLEFASTBYTECODES
-            REPLACE_BYTECODE(ip, INVOKESTATIC_FAST)
+            if (   (thisMethod->accessFlags & ACC_NATIVE)
+                && thisMethod->u.native.code == Java_java_lang_System_arraycopy
+               ) {
+                int iCacheIndex;
+                /* Copy arrays within the interpreter from now on */
+                CREATE_CACHE_ENTRY(NULL, ip)
+                REPLACE_BYTECODE(ip, ARRAYCOPY_FAST)
+                putShort(ip + 1, iCacheIndex);
+            } else {
+                REPLACE_BYTECODE(ip, INVOKESTATIC_FAST)
+            }
 #endif
             TRACE_METHOD_ENTRY(thisMethod, "static");
 
@@ -2452,7 +2463,7 @@ SELECT(ATHROW)                          /* Throw exception or error */
             START_TEMPORARY_ROOTS
                 DECLARE_TEMPORARY_ROOT(THROWABLE_INSTANCE, exceptionX,
                                        exception);
-#if PRINT_BACKTRACE
+#if PRINT_BACKTRACE && !LAZY_BACKTRACE
                 if (exceptionX->backtrace == NULL) {
                     fillInStackTrace(&exceptionX);
                 }
@@ -2669,8 +2680,8 @@ DONEX
 
 #if STANDARDBYTECODES
 SELECT(GOTO_W)                   /*  Branch unconditionally (wide index) */
-        ip += getCell(ip + 1);
-DONE_R
+        BRANCH(getCell(ip + 1))
+DONEX
 #endif
 
 /* --------------------------------------------------------------------- */
@@ -2728,7 +2739,7 @@ DONE(1)
 /* --------------------------------------------------------------------- */
 
 #if FASTBYTECODES
-SELECT2(GETFIELD_FAST, GETFIELDP_FAST)
+SELECT2_FUSED(GETFIELD_FAST, GETFIELDP_FAST, fusedGetfield)
         /* Get single-word field (instance variable) from object */
         /* (fast version) */
 
@@ -2898,12 +2909,97 @@ DONE(3)
 
 /* --------------------------------------------------------------------- */
 
-NOTIMPLEMENTED(UNUSED_D5)                   /*  Not used */
+#if FASTBYTECODES
+SELECT(ARRAYCOPY_FAST)
+        /* Invoke System.arraycopy (fast version).  Valid copies between
+         * arrays of the same primitive type, or between object arrays
+         * whose element types are known to be assignable, are done here
+         * without calling the native method.  The inline cache entry
+         * remembers the last pair of object array classes found to be
+         * assignable at this call site.  Everything else, including all
+         * the error cases, is left to the native method.
+         */
+        ICACHE thisICache = GETINLINECACHE(getUShort(ip + 1));
+        ARRAY src    = *(ARRAY*)(sp - 4);
+        long  srcPos = *(long*)(sp - 3);
+        ARRAY dst    = *(ARRAY*)(sp - 2);
+        long  dstPos = *(long*)(sp - 1);
+        long  length = *(long*)sp;
+        ARRAY_CLASS srcClass = (src != NULL) ? src->ofClass : NULL;
+        ARRAY_CLASS dstClass = (dst != NULL) ? dst->ofClass : NULL;
+        bool_t isFast = FALSE;
+
+        if (   srcClass != NULL && dstClass != NULL
+            && IS_ARRAY_CLASS((CLASS)srcClass)
+            && IS_ARRAY_CLASS((CLASS)dstClass)
+            && length >= 0 && srcPos >= 0 && dstPos >= 0
+            && length <= (long)src->length - srcPos
+            && length <= (long)dst->length - dstPos) {
+            if (srcClass == dstClass) {
+                isFast = TRUE;
+            } else if (   srcClass->gcType == GCT_OBJECTARRAY
+                       && dstClass->gcType == GCT_OBJECTARRAY) {
+                if (   (cell*)srcClass == thisICache->contents
+                    && (cell*)dstClass == thisICache->contents2) {
+                    isFast = TRUE;
+                } else if (isAssignableTo(srcClass->u.elemClass,
+                                          dstClass->u.elemClass)) {
+                    thisICache->contents  = (cell*)srcClass;
+                    thisICache->contents2 = (cell*)dstClass;
+                    isFast = TRUE;
+                }
+            }
+        }
+
+        if (isFast) {
+            if (srcClass->gcType != GCT_ARRAY) {
+                memmove(&dst->data[dstPos], &src->data[srcPos],
+                        length << log2CELL);
+            } else if (length > ARRAYCOPY_SMALL || srcClass->itemSize > 2) {
+                int itemSize = srcClass->itemSize;
+                memmove(&((BYTEARRAY)dst)->bdata[dstPos * itemSize],
+                        &((BYTEARRAY)src)->bdata[srcPos * itemSize],
+                        itemSize * length);
+            } else if (srcClass->itemSize == 1) {
+                /* Short byte array copy (StringBuffer, streams) */
+                signed char* from = &((BYTEARRAY)src)->bdata[srcPos];
+                signed char* to   = &((BYTEARRAY)dst)->bdata[dstPos];
+                if (to <= from) {
+                    while (--length >= 0) *to++ = *from++;
+                } else {
+                    while (--length >= 0) to[length] = from[length];
+                }
+            } else {
+                /* Short char array copy (StringBuffer, String) */
+                short* from = &((SHORTARRAY)src)->sdata[srcPos];
+                short* to   = &((SHORTARRAY)dst)->sdata[dstPos];
+                if (to <= from) {
+                    while (--length >= 0) *to++ = *from++;
+                } else {
+                    while (--length >= 0) to[length] = from[length];
+                }
+            }
+            sp -= 5;
+            goto next3;
+        }
+
+        /* Call the native method, which is in the original constant
+         * pool entry of this call site
+         */
+        thisMethod = (METHOD)
+            cp->entries[(unsigned short)thisICache->origParam].cache;
+        thisObject = (OBJECT)thisMethod->ofClass;
+
+        TRACE_METHOD_ENTRY(thisMethod, "fast static");
+        CALL_STATIC_METHOD
+DONEX
+#endif
+
 
 /* --------------------------------------------------------------------- */
 
 #if FASTBYTECODES
-SELECT(INVOKEVIRTUAL_FAST)
+SELECT_FUSED(INVOKEVIRTUAL_FAST, fusedInvokevirtual)
         /* Invoke instance method; dispatch based on dynamic class */
         /* (fast version) */
 
@@ -3214,6 +3310,100 @@ DONE(3)
  * End of FAST bytecodes
  *=======================================================================*/
 
+/*=========================================================================
+ * If superinstructions are enabled, the system replaces the first
+ * instruction of some frequent pairs of instructions when a class has
+ * been verified (see fusion.c).  A superinstruction does the work of the
+ * instruction it replaced and then goes on to the second instruction
+ * without a dispatch.  The bytes of the second instruction are left
+ * intact, so that branches to it, exception handlers, stack maps and
+ * breakpoints see the original code; if it is not the expected one
+ * (e.g., because it has not been replaced by its fast version yet),
+ * execution simply continues at the top of the interpreter loop.
+ *=======================================================================*/
+
+/* --------------------------------------------------------------------- */
+
+#if SUPERINSTRUCTIONS
+SELECT(ALOAD_0_GETFIELD)
+        /* ALOAD_0 followed by GETFIELD_FAST or GETFIELDP_FAST */
+        pushStack(lp[0]);
+        ip++;
+        FUSED_NEXT(GETFIELD_FAST, fusedGetfield)
+        FUSED_NEXT(GETFIELDP_FAST, fusedGetfield)
+DONE(0)
+#endif
+
+/* --------------------------------------------------------------------- */
+
+#if SUPERINSTRUCTIONS
+SELECT(ALOAD_0_INVOKEVIRTUAL)
+        /* ALOAD_0 followed by INVOKEVIRTUAL_FAST */
+        pushStack(lp[0]);
+        ip++;
+        FUSED_NEXT(INVOKEVIRTUAL_FAST, fusedInvokevirtual)
+DONE(0)
+#endif
+
+/* --------------------------------------------------------------------- */
+
+#if SUPERINSTRUCTIONS
+SELECT5(ILOAD_IF_ICMP,
+        ILOAD_0_IF_ICMP, ILOAD_1_IF_ICMP, ILOAD_2_IF_ICMP, ILOAD_3_IF_ICMP)
+        /* ILOAD or ILOAD_<n> followed by IF_ICMP<cond> */
+        long b;
+        if (TOKEN == ILOAD_IF_ICMP) {
+            b = lp[ip[1]];
+            ip += 2;
+        } else {
+            b = lp[TOKEN - ILOAD_0_IF_ICMP];
+            ip++;
+        }
+        if (*ip >= IF_ICMPEQ && *ip <= IF_ICMPLE && FUSION_ALLOWED) {
+            long a = popStack();
+            bool_t cond;
+            switch (*ip) {
+                case IF_ICMPEQ: cond = (a == b); break;
+                case IF_ICMPNE: cond = (a != b); break;
+                case IF_ICMPLT: cond = (a <  b); break;
+                case IF_ICMPGE: cond = (a >= b); break;
+                case IF_ICMPGT: cond = (a >  b); break;
+                default:        cond = (a <= b); break;
+            }
+            BRANCHIF( cond )
+        }
+        pushStack(b);
+DONE(0)
+#endif
+
+/* --------------------------------------------------------------------- */
+
+#if SUPERINSTRUCTIONS
+SELECT(ICONST_1_IADD)
+        /* ICONST_1 followed by IADD, and possibly by ISTORE or */
+        /* ISTORE_<n> */
+        ip++;
+        if (*ip == IADD && FUSION_ALLOWED) {
+            *(long*)sp += 1;
+            ip++;
+            if (*ip == ISTORE) {
+                lp[ip[1]] = popStack();
+                goto next2;
+            }
+            if (*ip >= ISTORE_0 && *ip <= ISTORE_3) {
+                lp[*ip - ISTORE_0] = popStack();
+                goto next1;
+            }
+        } else {
+            pushStack(1);
+        }
+DONE(0)
+#endif
+
+/*=========================================================================
+ * End of superinstructions
+ *=======================================================================*/
+
 #if INFREQUENTSTANDARDBYTECODES
 SELECT(CUSTOMCODE)                             /* 0xDF */
         cell *stack = (cell*)(fp + 1);
@@ -3339,6 +3529,7 @@ NOTIMPLEMENTED(GETSTATICP_FAST)
 NOTIMPLEMENTED(GETSTATIC2_FAST)
 NOTIMPLEMENTED(PUTSTATIC_FAST)
 NOTIMPLEMENTED(PUTSTATIC2_FAST)
+NOTIMPLEMENTED(ARRAYCOPY_FAST)
 NOTIMPLEMENTED(INVOKEVIRTUAL_FAST)
 NOTIMPLEMENTED(INVOKESPECIAL_FAST)
 NOTIMPLEMENTED(INVOKESTATIC_FAST)
@@ -3350,14 +3541,17 @@ NOTIMPLEMENTED(CHECKCAST_FAST)
 NOTIMPLEMENTED(INSTANCEOF_FAST)
 #endif /* !FASTBYTECODES */
 
-NOTIMPLEMENTED(224)
-NOTIMPLEMENTED(225)
-NOTIMPLEMENTED(226)
-NOTIMPLEMENTED(227)
-NOTIMPLEMENTED(228)
-NOTIMPLEMENTED(229)
-NOTIMPLEMENTED(230)
-NOTIMPLEMENTED(231)
+#if !SUPERINSTRUCTIONS
+NOTIMPLEMENTED(ALOAD_0_GETFIELD)
+NOTIMPLEMENTED(ALOAD_0_INVOKEVIRTUAL)
+NOTIMPLEMENTED(ILOAD_IF_ICMP)
+NOTIMPLEMENTED(ILOAD_0_IF_ICMP)
+NOTIMPLEMENTED(ILOAD_1_IF_ICMP)
+NOTIMPLEMENTED(ILOAD_2_IF_ICMP)
+NOTIMPLEMENTED(ILOAD_3_IF_ICMP)
+NOTIMPLEMENTED(ICONST_1_IADD)
+#endif /* !SUPERINSTRUCTIONS */
+
 NOTIMPLEMENTED(232)
 NOTIMPLEMENTED(233)
 NOTIMPLEMENTED(234)
@@ -44,13 +44,13 @@
  *=======================================================================*/
 
 /*  The master inline cache in the system (see Cache.h) */
-ICACHE InlineCache;
+ISOLATE_LOCAL ICACHE InlineCache;
 
 /*  Index of the next inline cache entry to be used */
-int InlineCachePointer;
+ISOLATE_LOCAL int InlineCachePointer;
 
 /*  Flag telling whether inline cache area is full or not */
-int InlineCacheAreaFull;
+ISOLATE_LOCAL int InlineCacheAreaFull;
 
 static void releaseInlineCacheEntry(int index);
 
@@ -178,6 +178,7 @@ createInlineCacheEntry(cell* contents, BYTE* originalCode)
 
     /*  Initialize icache values */
     thisICache->contents = contents;
+    thisICache->contents2 = NULL;
     thisICache->codeLoc = originalCode;
     thisICache->origInst = *originalCode;
     thisICache->origParam = getShort(originalCode+1);
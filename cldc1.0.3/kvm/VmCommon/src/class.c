@@ -48,42 +48,43 @@
 #endif
 
 EXTERN_IF_ROMIZING
-INSTANCE_CLASS JavaLangObject;    /*  Pointer to class 'java.lang.Object' */
+ISOLATE_LOCAL INSTANCE_CLASS JavaLangObject;    /*  Pointer to class 'java.lang.Object' */
 
 EXTERN_IF_ROMIZING
-INSTANCE_CLASS JavaLangClass;     /*  Pointer to class 'java.lang.Class' */
+ISOLATE_LOCAL INSTANCE_CLASS JavaLangClass;     /*  Pointer to class 'java.lang.Class' */
 
 EXTERN_IF_ROMIZING
-INSTANCE_CLASS JavaLangSystem;    /*  Pointer to class 'java.lang.System' */
+ISOLATE_LOCAL INSTANCE_CLASS JavaLangSystem;    /*  Pointer to class 'java.lang.System' */
 
 EXTERN_IF_ROMIZING
-INSTANCE_CLASS JavaLangString;    /*  Pointer to class 'java.lang.String' */
+ISOLATE_LOCAL INSTANCE_CLASS JavaLangString;    /*  Pointer to class 'java.lang.String' */
 
 EXTERN_IF_ROMIZING
-INSTANCE_CLASS JavaLangThread;    /*  Pointer to class 'java.lang.Thread' */
+ISOLATE_LOCAL INSTANCE_CLASS JavaLangThread;    /*  Pointer to class 'java.lang.Thread' */
 
 EXTERN_IF_ROMIZING
-INSTANCE_CLASS JavaLangThrowable; /*  Pointer to class 'java.lang.Throwable' */
+ISOLATE_LOCAL INSTANCE_CLASS JavaLangThrowable; /*  Pointer to class 'java.lang.Throwable' */
 
 EXTERN_IF_ROMIZING
-INSTANCE_CLASS JavaLangError; /*  Pointer to class 'java.lang.Throwable' */
+ISOLATE_LOCAL INSTANCE_CLASS JavaLangError; /*  Pointer to class 'java.lang.Throwable' */
 
 #if CLASS_INITIALIZATION_IN_JAVA
-EXTERN_IF_ROMIZING METHOD InitClassMethod;
+EXTERN_IF_ROMIZING ISOLATE_LOCAL METHOD InitClassMethod;
 #endif /* CLASS_INITIALIZATION_IN_JAVA */
 
-EXTERN_IF_ROMIZING METHOD RunCustomCodeMethod;
+EXTERN_IF_ROMIZING ISOLATE_LOCAL METHOD RunCustomCodeMethod;
 
-EXTERN_IF_ROMIZING NameTypeKey initNameAndType;   /* void <init>() */
-EXTERN_IF_ROMIZING NameTypeKey clinitNameAndType; /* void <clinit>() */
-EXTERN_IF_ROMIZING NameTypeKey runNameAndType;    /* void run() */
-EXTERN_IF_ROMIZING NameTypeKey mainNameAndType;   /* void main(String[]) */
+EXTERN_IF_ROMIZING ISOLATE_LOCAL NameTypeKey initNameAndType;   /* void <init>() */
+EXTERN_IF_ROMIZING ISOLATE_LOCAL NameTypeKey clinitNameAndType; /* void <clinit>() */
+EXTERN_IF_ROMIZING ISOLATE_LOCAL NameTypeKey runNameAndType;    /* void run() */
+EXTERN_IF_ROMIZING ISOLATE_LOCAL NameTypeKey mainNameAndType;   /* void main(String[]) */
 
-EXTERN_IF_ROMIZING ARRAY_CLASS PrimitiveArrayClasses[T_LASTPRIMITIVETYPE + 1];
+EXTERN_IF_ROMIZING ISOLATE_LOCAL ARRAY_CLASS PrimitiveArrayClasses[T_LASTPRIMITIVETYPE + 1];
 
-INSTANCE_CLASS JavaLangOutOfMemoryError;
-THROWABLE_INSTANCE OutOfMemoryObject;
-THROWABLE_INSTANCE StackOverflowObject;
+ISOLATE_LOCAL INSTANCE_CLASS JavaLangOutOfMemoryError;
+ISOLATE_LOCAL INSTANCE_CLASS JavaLangStringBuffer;
+ISOLATE_LOCAL THROWABLE_INSTANCE OutOfMemoryObject;
+ISOLATE_LOCAL THROWABLE_INSTANCE StackOverflowObject;
 
 /*=========================================================================
  * Static methods (only used in this file)
@@ -420,6 +421,7 @@ runClinit(FRAME_HANDLE exceptionFrameH)
             }
 #endif /* INCLUDEDEBUGCODE */
 
+            STARTUP_TRACE_BEGIN_CLASS(STARTUP_INITIALIZE, thisClass, NULL)
             topStack = 5;
             pushFrame(thisMethod);
             return;
@@ -429,6 +431,11 @@ runClinit(FRAME_HANDLE exceptionFrameH)
         }
     }
     case 5:
+        if (state == 5) {
+            /* The <clinit> method has returned */
+            STARTUP_TRACE_END(STARTUP_INITIALIZE)
+        }
+
         /* Step 9:
          * Grab the monitor so we can change the flags, and wake up any
          * other thread waiting on us.
@@ -504,6 +511,9 @@ runClinitException(FRAME_HANDLE frameH)
         if (state != 1 && state != 4 && state != 5)
             fatalVMError(KVM_MSG_STATIC_INITIALIZER_FAILED);
         
+        if (state == 5) {
+            STARTUP_TRACE_END(STARTUP_INITIALIZE)
+        }
         setClassStatus(thisClass, CLASS_ERROR);
         setClassInitialThread(thisClass, NULL);
 
@@ -634,6 +644,8 @@ void InitializeJavaSystemClasses()
     }
 
     JavaLangOutOfMemoryError = (INSTANCE_CLASS)getClass(OutOfMemoryError);
+    JavaLangStringBuffer =
+        (INSTANCE_CLASS)getClass("java/lang/StringBuffer");
     OutOfMemoryObject =
         (THROWABLE_INSTANCE)instantiate(JavaLangOutOfMemoryError);
     makeGlobalRoot((cell **)&OutOfMemoryObject);
@@ -1130,6 +1142,7 @@ INSTANCE instantiate(INSTANCE_CLASS thisClass)
         memset(newInstance, 0, size << log2CELL);
         /*  initialize the class pointer (zeroeth field in the instance) */
         newInstance->ofClass = thisClass;
+        RECORD_ALLOCATION(thisClass, size)
     } else {
         THROW(OutOfMemoryObject);
     }
@@ -1152,7 +1165,7 @@ INSTANCE instantiate(INSTANCE_CLASS thisClass)
 long 
 objectHashCode(OBJECT object)
 {
-    unsigned static long lastHash = 0xCAFEBABE;
+    static ISOLATE_LOCAL unsigned long lastHash = 0xCAFEBABE;
 
     /* The following may GC, but only if the result it returns is non-NULL */
     long* hashAddress = monitorHashCodeAddress(object); 
@@ -1419,6 +1432,7 @@ ARRAY instantiateArray(ARRAY_CLASS arrayClass, long length)
             memset(newArray, 0, arraySize << log2CELL);
             newArray->ofClass   = arrayClass;
             newArray->length    = length;
+            RECORD_ALLOCATION(arrayClass, arraySize)
         }
         return newArray;
     }
@@ -1615,9 +1629,10 @@ static SHORTARRAY createCharArray(const char *utf8stringArg,
                                   bool_t isPermanent)
 {
     int unicodelength = 0;
-    int i;
     SHORTARRAY newArray;
     const char *p, *end;
+    const unsigned char *src;
+    unsigned short *dst, *dstEnd;
     int size, objSize;
 
     START_TEMPORARY_ROOTS
@@ -1635,10 +1650,27 @@ static SHORTARRAY createCharArray(const char *utf8stringArg,
                        : (SHORTARRAY)callocObject(objSize, GCT_ARRAY);
         newArray->ofClass = PrimitiveArrayClasses[T_CHAR];
         newArray->length  = unicodelength;
+        if (!isPermanent) {
+            RECORD_ALLOCATION(newArray->ofClass, objSize)
+        }
 
-        /*  Initialize the array with string contents; */
-        for (p = utf8string, i = 0; i < unicodelength; i++) { 
-            newArray->sdata[i] = utf2unicode(&p);
+        /*  Initialize the array with string contents.  Convert in bulk,
+         *  and one character at a time where decodeUTF8 gives up, so that
+         *  bad input is treated the same as by the loop above.
+         */
+        src = (const unsigned char *)utf8string;
+        dst = (unsigned short *)newArray->sdata;
+        dstEnd = dst + unicodelength;
+        while (dst < dstEnd) {
+            if (decodeUTF8(&src, (const unsigned char *)end,
+                           &dst, dstEnd, TRUE) != UTF8_DONE
+                    || src >= (const unsigned char *)end) {
+                if (dst < dstEnd) {
+                    p = (const char *)src;
+                    *dst++ = utf2unicode(&p);
+                    src = (const unsigned char *)p;
+                }
+            }
         }
         *unicodelengthP = unicodelength;
     END_TEMPORARY_ROOTS
@@ -1786,6 +1818,32 @@ static bool_t LOG_VERIFICATION(INSTANCE_CLASS grantee, INSTANCE_CLASS grantor)
 #define LOG_VERIFICATION(grantor,grantee) TRUE
 #endif
 
+/*=========================================================================
+ * FUNCTION:      verifyPermit
+ * TYPE:          SVM operation
+ * OVERVIEW:      Verify the signature of a permit, tracing and
+ *                recording the verification.
+ * INTERFACE:
+ *   parameters:  grantee, grantor, the permit signature, the digest
+ *                of the grantee and the key of the grantor
+ *   returns:     the result of Crypto_VerifySignature
+ *=======================================================================*/
+
+static CryptoResultCode
+verifyPermit(INSTANCE_CLASS grantee, INSTANCE_CLASS grantor,
+             SIGNATURE signature, DIGEST digest, KEY key)
+{
+    CryptoResultCode code;
+    DECLARE_RECORDER_START(verifyStart)
+
+    (void)LOG_VERIFICATION(grantee, grantor);
+    STARTUP_TRACE_BEGIN_CLASS(STARTUP_PERMIT, grantee, grantor)
+    code = Crypto_VerifySignature(signature, digest, key);
+    STARTUP_TRACE_END(STARTUP_PERMIT)
+    RECORD_TIMED_EVENT(FR_PERMIT_VERIFIED, verifyStart, grantee, grantor)
+    return code;
+}
+
 /*=========================================================================
  * FUNCTION:      classDomainsIntersect
  * TYPE:          SVM operation
@@ -1949,9 +2007,8 @@ verifySubclassPrivileges(INSTANCE_CLASS clazz)
             if (key == NULL)
                 raiseExceptionCharMsg(IllegalSubclassError,
                         SVM_MSG_GRANTOR_HAS_NO_KEY);
-            if (LOG_VERIFICATION(clazz,clazz->superClass) &&
-              (code=Crypto_VerifySignature(sig,ppermits->digest,key))
-                    != Crypto_OK)
+            if ((code=verifyPermit(clazz,clazz->superClass,
+                                   sig,ppermits->digest,key)) != Crypto_OK)
                 raiseExceptionCharMsg(IllegalSubclassError,
                             CryptoResultCodeMessages[code]);
         }
@@ -1987,8 +2044,8 @@ verifySubclassPrivileges(INSTANCE_CLASS clazz)
                             /*
                              * We now just need to verify the permit.
                              */
-                            if (LOG_VERIFICATION(clazz,permit->grantor) &&
-                                (code=Crypto_VerifySignature(permit->signature,
+                            if ((code=verifyPermit(clazz,permit->grantor,
+                                   permit->signature,
                                    ppermits->digest,key)) != Crypto_OK)
                                 raiseExceptionCharMsg(IllegalSubclassError,
                                     CryptoResultCodeMessages[code]);
@@ -2125,9 +2182,8 @@ verifyClassResourceAccessPrivilege(INSTANCE_CLASS grantor,
         if(key == NULL)
             raiseExceptionCharMsg(IllegalSubclassError,
                     SVM_MSG_GRANTOR_HAS_NO_KEY);
-        if (LOG_VERIFICATION(requestor,grantor) &&
-             (code=Crypto_VerifySignature(permit->signature, ppermits->digest,
-             key)) != Crypto_OK)
+        if ((code=verifyPermit(requestor,grantor,permit->signature,
+             ppermits->digest,key)) != Crypto_OK)
             raiseExceptionCharMsg(IllegalClassResourceAccessError,
                        CryptoResultCodeMessages[code]);
     }
@@ -2209,9 +2265,8 @@ verifyClassResourceAccessPrivilege_Reflection(INSTANCE_CLASS grantor,
                 /*
                  * Otherwise verify the signature now and then zero it.
                  */
-                if (LOG_VERIFICATION(requestor,grantor)
-                    && (code=Crypto_VerifySignature(permit->signature,
-                                           ppermits->digest,key)) != Crypto_OK)
+                if ((code=verifyPermit(requestor,grantor,permit->signature,
+                                       ppermits->digest,key)) != Crypto_OK)
                     raiseExceptionCharMsg(IllegalClassResourceAccessError,
                           CryptoResultCodeMessages[code]); 
                 permit->signature = NULL;
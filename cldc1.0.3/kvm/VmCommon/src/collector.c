@@ -67,27 +67,27 @@ typedef struct breakTableEntryStruct {
  * Variables
  *=======================================================================*/
 
-void* TheHeap;
-long  VMHeapSize;               /*  Heap size */
+ISOLATE_LOCAL void* TheHeap;
+ISOLATE_LOCAL long  VMHeapSize;               /*  Heap size */
 
-cell* AllHeapStart;             /*  Heap bottom */
-cell* CurrentHeap;              /*  Same as AllHeapStart*/
-cell* CurrentHeapEnd;           /*  End of heap */
-cell* AllHeapEnd;
+ISOLATE_LOCAL cell* AllHeapStart;             /*  Heap bottom */
+ISOLATE_LOCAL cell* CurrentHeap;              /*  Same as AllHeapStart*/
+ISOLATE_LOCAL cell* CurrentHeapEnd;           /*  End of heap */
+ISOLATE_LOCAL cell* AllHeapEnd;
 
-WEAKPOINTERLIST WeakPointers;
-CHUNK FirstFreeChunk;
+ISOLATE_LOCAL WEAKPOINTERLIST WeakPointers;
+ISOLATE_LOCAL CHUNK FirstFreeChunk;
 
 #if ENABLE_HEAP_COMPACTION
-cell* PermanentSpaceFreePtr;
+ISOLATE_LOCAL cell* PermanentSpaceFreePtr;
 #endif
 
 #define DEFERRED_OBJECT_TABLE_SIZE 40
-static cell *deferredObjectTable[DEFERRED_OBJECT_TABLE_SIZE];
+static ISOLATE_LOCAL cell *deferredObjectTable[DEFERRED_OBJECT_TABLE_SIZE];
 #define endDeferredObjectTable (deferredObjectTable + DEFERRED_OBJECT_TABLE_SIZE)
-static cell **startDeferredObjects,  **endDeferredObjects;
-static int deferredObjectCount;
-static int deferredObjectTableOverflow;
+static ISOLATE_LOCAL cell **startDeferredObjects,  **endDeferredObjects;
+static ISOLATE_LOCAL int deferredObjectCount;
+static ISOLATE_LOCAL int deferredObjectTableOverflow;
 
 /*=========================================================================
  * Static functions (private to this file)
@@ -123,7 +123,7 @@ void printBreakTable(breakTableEntryStruct *table, int length) ;
 
 #if INCLUDEDEBUGCODE
 static void checkValidHeapPointer(cell *number);
-int NoAllocation = 0;
+ISOLATE_LOCAL int NoAllocation = 0;
 #else
 #define checkValidHeapPointer(number)
 #define NoAllocation 0
@@ -244,6 +244,7 @@ cell* mallocHeapObject(long size, GCT_ObjectType type)
         garbageCollect(realSize); /* So it knows what we need */
         thisChunk = allocateFreeChunk(realSize);
         if (thisChunk == NULL) {
+            heapDumpOnOutOfMemory();
             return NULL;
         }
     }
@@ -335,6 +336,7 @@ callocPermanentObject(long size) {
         /* We pass GC a request that is larger than it could possibly
          * fulfill, so as to force a GC.
          */
+        setGCCause(GC_CAUSE_PERMANENT);
         garbageCollect(AllHeapEnd - AllHeapStart);
 
         if (newPermanentSpace < (cell *)FirstFreeChunk + 2 * HEADERSIZE) {
@@ -367,18 +369,24 @@ garbageCollectForReal(int realSize)
     long maximumFreeSize;
 
     markRootObjects();
+    RECORD_GC_PHASE(GC_PHASE_ROOTS)
     markNonRootObjects();
+    RECORD_GC_PHASE(GC_PHASE_MARK)
     markWeakPointerLists();
+    RECORD_GC_PHASE(GC_PHASE_WEAK)
     firstFreeChunk = sweepTheHeap(&maximumFreeSize);
+    RECORD_GC_PHASE(GC_PHASE_SWEEP)
 #if ENABLE_HEAP_COMPACTION
     if (realSize > maximumFreeSize) {
         /* We need to compact the heap. */
         breakTableStruct currentTable;
         cell* freeStart = compactTheHeap(&currentTable, firstFreeChunk);
+        RECORD_GC_PHASE(GC_PHASE_COMPACT)
         if (currentTable.length > 0) {
             updateRootObjects(&currentTable);
             updateHeapObjects(&currentTable, freeStart);
         }
+        RECORD_GC_PHASE(GC_PHASE_UPDATE)
         if (freeStart < CurrentHeapEnd - 1) {
             firstFreeChunk = (CHUNK)freeStart;
             firstFreeChunk->size =
@@ -544,14 +552,27 @@ markRootObjects(void)
     }
 
     for (thread = AllThreads; thread != NULL; thread = thread->nextAliveThread){
+        int i;
         MARK_OBJECT(thread);
         if (thread->javaThread != NULL) {
             MARK_OBJECT(thread->javaThread);
         }
+        /* Objects locked with a fast lock */
+        for (i = 0; i < FAST_LOCKS_PER_THREAD; i++) {
+            MARK_OBJECT_IF_NON_NULL(thread->extendedLocks[i].object);
+        }
         if (thread->stack != NULL) {
             markThreadStack(thread);
         }
     }
+
+    /* Hashed objects locked with a simple lock */
+    {
+        int i;
+        for (i = 0; i < IdentityHashCount; i++) {
+            MARK_OBJECT(IdentityHashes[i].object);
+        }
+    }
 }
 
 #if ENABLE_HEAP_COMPACTION
@@ -583,6 +604,13 @@ updateRootObjects(breakTableStruct *currentTable)
         }
     }
 
+    {
+        int i;
+        for (i = 0; i < IdentityHashCount; i++) {
+            updatePointer(&IdentityHashes[i].object, currentTable);
+        }
+    }
+
 #if ASYNCHRONOUS_NATIVE_FUNCTIONS
 {
     int i;
@@ -1096,8 +1124,11 @@ markThreadStack(THREAD thisThread)
 static void checkMonitorAndMark(OBJECT object)
 {
     /* We only need to mark real monitors.  We don't need to mark threads'
-     * in the monitor/hashcode slot since they will be marked elsewhere */
-    if (OBJECT_HAS_REAL_MONITOR(object)) {
+     * in the monitor/hashcode slot since they will be marked elsewhere.
+     * A real monitor that no thread is waiting on is replaced by a fast
+     * lock or hash code, and is then left for the collector to reclaim.
+     */
+    if (OBJECT_HAS_REAL_MONITOR(object) && !deflateObjectMonitor(object)) {
         cell *heapSpace = CurrentHeap;
         cell *heapSpaceEnd = CurrentHeapEnd;
         MONITOR monitor = OBJECT_MHC_MONITOR(object);
@@ -1223,12 +1254,16 @@ updateHeapObjects(breakTableStruct *currentTable, cell* endScanPoint)
 
         case GCT_THREAD: {
             THREAD thread  = (THREAD)object;
+            int i;
             updatePointer(&thread->nextAliveThread, currentTable);
             updatePointer(&thread->nextThread, currentTable);
             updatePointer(&thread->javaThread, currentTable);
             updatePointer(&thread->monitor, currentTable);
             updatePointer(&thread->nextAlarmThread, currentTable);
             updatePointer(&thread->stack, currentTable);
+            for (i = 0; i < FAST_LOCKS_PER_THREAD; i++) {
+                updatePointer(&thread->extendedLocks[i].object, currentTable);
+            }
 
 #if  ENABLE_JAVA_DEBUGGER
           {
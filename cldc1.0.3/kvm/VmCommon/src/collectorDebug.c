@@ -72,25 +72,25 @@
  * Variables
  *=======================================================================*/
 
-cell* AllHeapStart;             /*  Start of first heap */
-cell* CurrentHeap;              /*  Bottom of current heap */
-cell* CurrentHeapEnd;           /*  End of current heap */
-cell* CurrentHeapFreePtr;       /* Next allocation in current space */
+ISOLATE_LOCAL cell* AllHeapStart;             /*  Start of first heap */
+ISOLATE_LOCAL cell* CurrentHeap;              /*  Bottom of current heap */
+ISOLATE_LOCAL cell* CurrentHeapEnd;           /*  End of current heap */
+ISOLATE_LOCAL cell* CurrentHeapFreePtr;       /* Next allocation in current space */
 
-cell* PermanentSpace;   /* beginning of permanent space */
-cell* PermanentSpaceFreePtr;
-cell* AllHeapEnd;
+ISOLATE_LOCAL cell* PermanentSpace;   /* beginning of permanent space */
+ISOLATE_LOCAL cell* PermanentSpaceFreePtr;
+ISOLATE_LOCAL cell* AllHeapEnd;
 
-WEAKPOINTERLIST WeakPointers;
+ISOLATE_LOCAL WEAKPOINTERLIST WeakPointers;
 
-static cell* TargetSpace;
-static cell* TargetSpaceFreePtr;
+static ISOLATE_LOCAL cell* TargetSpace;
+static ISOLATE_LOCAL cell* TargetSpaceFreePtr;
 
-long nHeapSize;                 /* size of each heap */
+ISOLATE_LOCAL long nHeapSize;                 /* size of each heap */
 
 #if INCLUDEDEBUGCODE
 static void checkValidHeapPointer(cell *number);
-int NoAllocation = 0;
+ISOLATE_LOCAL int NoAllocation = 0;
 #else
 #define checkValidHeapPointer(x)
 #define NoAllocation 0
@@ -118,7 +118,7 @@ static void expandPermanentMemory(cell *newPermanentSpace);
  *=======================================================================*/
 
 #if CHENEY_TWO_SPACE
-void* TheHeap;
+ISOLATE_LOCAL void* TheHeap;
 #endif;
 
 void InitializeHeap(void)
@@ -399,6 +399,13 @@ copyRootObjects(void)
         }
     }
 
+    {
+        int i;
+        for (i = 0; i < IdentityHashCount; i++) {
+            updatePointer(&IdentityHashes[i].object);
+        }
+    }
+
 #if ASYNCHRONOUS_NATIVE_FUNCTIONS
 {
     int i;
@@ -612,12 +619,16 @@ copyNonRootObjects()
 
         case GCT_THREAD: {
             THREAD thread  = (THREAD)object;
+            int i;
             updatePointer(&thread->nextAliveThread);
             updatePointer(&thread->nextThread);
             updatePointer(&thread->javaThread);
             updatePointer(&thread->monitor);
             updatePointer(&thread->nextAlarmThread);
             updatePointer(&thread->stack);
+            for (i = 0; i < FAST_LOCKS_PER_THREAD; i++) {
+                updatePointer(&thread->extendedLocks[i].object);
+            }
             if (thread->fpStore != NULL) {
                 updateThreadAndStack(thread);
             }
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      counters.c
+ * OVERVIEW:  Execution counters (see counters.h).  The counters of a
+ *            method are kept in a hash table keyed by the METHOD, so
+ *            that the method structures (and the romized image) keep
+ *            their layout.  The report lists the methods by decreasing
+ *            invocations plus backward branches, the bytecodes by
+ *            decreasing count and the bytecode pairs by decreasing
+ *            count.  The pairs are what superinstructions would be
+ *            made of.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if ENABLE_EXECUTION_COUNTERS
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+#define COUNTED_METHOD_TABLE_SIZE 1024
+#define HOT_METHOD_COUNT          100   /* Methods listed in the report */
+#define HOT_PAIR_COUNT            100   /* Bytecode pairs listed */
+
+typedef struct countedMethodStruct* COUNTEDMETHOD;
+
+struct countedMethodStruct {
+    METHOD        method;
+    unsigned long invocations;
+    unsigned long backedges;
+    COUNTEDMETHOD next;             /* Next method in the hash bucket */
+};
+
+extern const char* const byteCodeNames[];
+
+/*=========================================================================
+ * Execution counter variables
+ *=======================================================================*/
+
+char*  ExecutionCountersFile = NULL;
+bool_t BytecodeCountersWanted = FALSE;
+
+bool_t ExecutionCountersEnabled = FALSE;
+
+unsigned long* BytecodeCounts = NULL;
+unsigned long* BytecodePairCounts = NULL;
+
+BYTE  PreviousBytecode;
+BYTE* NextBytecodeIp;
+
+static COUNTEDMETHOD CountedMethods[COUNTED_METHOD_TABLE_SIZE];
+static long          CountedMethodCount;
+static COUNTEDMETHOD LastCountedMethod;    /* Loops hit this one */
+
+/*=========================================================================
+ * Static functions (private to this file)
+ *=======================================================================*/
+
+static COUNTEDMETHOD getCountedMethod(METHOD thisMethod);
+static void writeReport(FILE* file);
+
+/*=========================================================================
+ * Execution counter operations
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      InitializeExecutionCounters
+ * TYPE:          Profiling
+ * OVERVIEW:      Start counting if a report file was given on the
+ *                command line.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void InitializeExecutionCounters(void)
+{
+    ExecutionCountersEnabled = FALSE;
+    BytecodeCounts = NULL;
+    BytecodePairCounts = NULL;
+    NextBytecodeIp = NULL;
+    if (ExecutionCountersFile == NULL) {
+        return;
+    }
+    memset(CountedMethods, 0, sizeof(CountedMethods));
+    CountedMethodCount = 0;
+    LastCountedMethod = NULL;
+    if (BytecodeCountersWanted) {
+        BytecodeCounts = (unsigned long*)
+            calloc(256, sizeof(unsigned long));
+        BytecodePairCounts = (unsigned long*)
+            calloc(256 * 256, sizeof(unsigned long));
+        if (BytecodeCounts == NULL || BytecodePairCounts == NULL) {
+            free(BytecodeCounts);
+            free(BytecodePairCounts);
+            BytecodeCounts = NULL;
+            BytecodePairCounts = NULL;
+            fprintf(stderr, "Not enough memory for the bytecode counters\n");
+        }
+    }
+    ExecutionCountersEnabled = TRUE;
+}
+
+/*=========================================================================
+ * FUNCTION:      FinalizeExecutionCounters
+ * TYPE:          Profiling
+ * OVERVIEW:      Write the report and stop counting.  Must be called
+ *                while the classes are still loaded.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void FinalizeExecutionCounters(void)
+{
+    FILE* file;
+    int i;
+
+    if (!ExecutionCountersEnabled) {
+        return;
+    }
+    ExecutionCountersEnabled = FALSE;
+
+    file = fopen(ExecutionCountersFile, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot write execution counters to %s\n",
+                ExecutionCountersFile);
+    } else {
+        writeReport(file);
+        fclose(file);
+    }
+
+    for (i = 0; i < COUNTED_METHOD_TABLE_SIZE; i++) {
+        COUNTEDMETHOD counted = CountedMethods[i];
+        while (counted != NULL) {
+            COUNTEDMETHOD next = counted->next;
+            free(counted);
+            counted = next;
+        }
+        CountedMethods[i] = NULL;
+    }
+    free(BytecodeCounts);
+    free(BytecodePairCounts);
+    BytecodeCounts = NULL;
+    BytecodePairCounts = NULL;
+}
+
+/*=========================================================================
+ * FUNCTION:      countInvocation, countBackedge
+ * TYPE:          Profiling
+ * OVERVIEW:      Called by the interpreter when it invokes a method,
+ *                and when it takes a backward branch in a method.
+ * INTERFACE:
+ *   parameters:  the method
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void countInvocation(METHOD thisMethod)
+{
+    getCountedMethod(thisMethod)->invocations++;
+}
+
+void countBackedge(METHOD thisMethod)
+{
+    getCountedMethod(thisMethod)->backedges++;
+}
+
+/*=========================================================================
+ * Static functions
+ *=======================================================================*/
+
+static COUNTEDMETHOD getCountedMethod(METHOD thisMethod)
+{
+    unsigned int bucket;
+    COUNTEDMETHOD counted = LastCountedMethod;
+
+    if (counted != NULL && counted->method == thisMethod) {
+        return counted;
+    }
+    bucket = ((unsigned long)thisMethod >> 2) % COUNTED_METHOD_TABLE_SIZE;
+    for (counted = CountedMethods[bucket]; counted != NULL;
+             counted = counted->next) {
+        if (counted->method == thisMethod) {
+            LastCountedMethod = counted;
+            return counted;
+        }
+    }
+    counted = (COUNTEDMETHOD)malloc(sizeof(struct countedMethodStruct));
+    if (counted == NULL) {
+        fatalError("Out of memory in the execution counters");
+    }
+    memset(counted, 0, sizeof(struct countedMethodStruct));
+    counted->method = thisMethod;
+    counted->next = CountedMethods[bucket];
+    CountedMethods[bucket] = counted;
+    CountedMethodCount++;
+    LastCountedMethod = counted;
+    return counted;
+}
+
+static const char* getBytecodeName(int opcode)
+{
+    return (opcode <= LASTBYTECODE) ? byteCodeNames[opcode] : "?";
+}
+
+static void printCountedMethod(FILE* file, METHOD thisMethod)
+{
+    char signature[STRINGBUFFERSIZE];
+    char* name = str_buffer;
+    char* end = getClassName_inBuffer((CLASS)thisMethod->ofClass, name);
+    char* p;
+    for (p = name; p < end; p++) {
+        if (*p == '/') {
+            *p = '.';
+        }
+    }
+    change_Key_to_MethodSignature_inBuffer(
+        thisMethod->nameTypeKey.nt.typeKey, signature);
+    fprintf(file, "%s.%s%s", name, methodName(thisMethod), signature);
+}
+
+/*
+ * Print "count" as a percentage of "total", e.g. " 12.5%"
+ */
+static void printPercentage(FILE* file, unsigned long count,
+                            unsigned long total)
+{
+    long perMille = (total == 0) ? 0
+                  : (long)(((double)count * 1000) / total);
+    fprintf(file, "%4ld.%ld%%", perMille / 10, perMille % 10);
+}
+
+static int compareCountedMethods(const void* first, const void* second)
+{
+    COUNTEDMETHOD a = *(COUNTEDMETHOD*)first;
+    COUNTEDMETHOD b = *(COUNTEDMETHOD*)second;
+    unsigned long hotA = a->invocations + a->backedges;
+    unsigned long hotB = b->invocations + b->backedges;
+    if (hotA != hotB) {
+        return (hotA > hotB) ? -1 : 1;
+    }
+    return 0;
+}
+
+/*
+ * Sort the indices of a counter array by decreasing count
+ */
+static unsigned long* SortedCounts;
+
+static int compareCountIndices(const void* first, const void* second)
+{
+    unsigned long a = SortedCounts[*(const long*)first];
+    unsigned long b = SortedCounts[*(const long*)second];
+    if (a != b) {
+        return (a > b) ? -1 : 1;
+    }
+    return 0;
+}
+
+static long* sortCounts(unsigned long* counts, long length, long* nonZero)
+{
+    long* indices = (long*)malloc(length * sizeof(long));
+    long i, n = 0;
+    if (indices == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < length; i++) {
+        if (counts[i] != 0) {
+            indices[n++] = i;
+        }
+    }
+    SortedCounts = counts;
+    qsort(indices, n, sizeof(long), compareCountIndices);
+    *nonZero = n;
+    return indices;
+}
+
+static void writeMethods(FILE* file)
+{
+    COUNTEDMETHOD* sorted;
+    unsigned long totalInvocations = 0, totalBackedges = 0;
+    long i, n = 0;
+
+    sorted = (COUNTEDMETHOD*)malloc((CountedMethodCount + 1)
+                                    * sizeof(COUNTEDMETHOD));
+    if (sorted == NULL) {
+        return;
+    }
+    for (i = 0; i < COUNTED_METHOD_TABLE_SIZE; i++) {
+        COUNTEDMETHOD counted;
+        for (counted = CountedMethods[i]; counted != NULL;
+                 counted = counted->next) {
+            sorted[n++] = counted;
+            totalInvocations += counted->invocations;
+            totalBackedges += counted->backedges;
+        }
+    }
+    qsort(sorted, n, sizeof(COUNTEDMETHOD), compareCountedMethods);
+
+    fprintf(file, "Hot methods: %ld methods, %lu invocations, "
+            "%lu backward branches\n\n", n, totalInvocations, totalBackedges);
+    fprintf(file, "  share  invocations    backedges  method\n");
+    for (i = 0; i < n && i < HOT_METHOD_COUNT; i++) {
+        printPercentage(file, sorted[i]->invocations + sorted[i]->backedges,
+                        totalInvocations + totalBackedges);
+        fprintf(file, " %12lu %12lu  ",
+                sorted[i]->invocations, sorted[i]->backedges);
+        printCountedMethod(file, sorted[i]->method);
+        if (sorted[i]->method->accessFlags & ACC_NATIVE) {
+            fputs(" (native)", file);
+        }
+        fputc('\n', file);
+    }
+    free(sorted);
+}
+
+static void writeBytecodes(FILE* file)
+{
+    unsigned long total = 0, pairs = 0;
+    long* sorted;
+    long i, n;
+
+    for (i = 0; i < 256; i++) {
+        total += BytecodeCounts[i];
+    }
+    sorted = sortCounts(BytecodeCounts, 256, &n);
+    if (sorted == NULL) {
+        return;
+    }
+    fprintf(file, "\nBytecodes: %lu executed\n\n", total);
+    fprintf(file, "  share        count  bytecode\n");
+    for (i = 0; i < n; i++) {
+        printPercentage(file, BytecodeCounts[sorted[i]], total);
+        fprintf(file, " %12lu  %s\n", BytecodeCounts[sorted[i]],
+                getBytecodeName(sorted[i]));
+    }
+    free(sorted);
+
+    for (i = 0; i < 256 * 256; i++) {
+        pairs += BytecodePairCounts[i];
+    }
+    sorted = sortCounts(BytecodePairCounts, 256 * 256, &n);
+    if (sorted == NULL) {
+        return;
+    }
+    fprintf(file, "\nBytecode pairs: %lu executed, %ld different\n\n",
+            pairs, n);
+    fprintf(file, "  share        count  first -> second\n");
+    for (i = 0; i < n && i < HOT_PAIR_COUNT; i++) {
+        printPercentage(file, BytecodePairCounts[sorted[i]], pairs);
+        fprintf(file, " %12lu  %s -> %s\n", BytecodePairCounts[sorted[i]],
+                getBytecodeName(sorted[i] >> 8),
+                getBytecodeName(sorted[i] & 0xFF));
+    }
+    free(sorted);
+}
+
+static void writeReport(FILE* file)
+{
+    writeMethods(file);
+    if (BytecodeCounts != NULL) {
+        writeBytecodes(file);
+    }
+}
+
+#endif /* ENABLE_EXECUTION_COUNTERS */
+
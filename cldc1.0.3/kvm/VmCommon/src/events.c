@@ -62,12 +62,12 @@
  * Local variables
  *=======================================================================*/
 
-static THREAD waitingThread;
-static int    opened;
+static ISOLATE_LOCAL THREAD waitingThread;
+static ISOLATE_LOCAL int    opened;
 
-static cell   eventBuffer[MAXPARMLENGTH];
-static int    eventInP;
-       int    eventCount;
+static ISOLATE_LOCAL cell   eventBuffer[MAXPARMLENGTH];
+static ISOLATE_LOCAL int    eventInP;
+ISOLATE_LOCAL int    eventCount;
 
 /*=========================================================================
  * Event handling functions
@@ -198,6 +198,12 @@ getKVMEvent(bool_t forever, ulong64 waitUntil, cell *result) {
 void InterpreterHandleEvent(ulong64 wakeupTime) {
     bool_t forever = FALSE;     /* The most common value */
     
+    /* Write the flight recorder buffer, the allocation */
+    /* profile and the heap if the port asked for them */
+    checkFlightRecorderDump();
+    checkAllocationSnapshot();
+    checkHeapDump();
+
     if (areActiveThreads()) { 
         /* Indicate that we don't wait for an event */
         ll_setZero(wakeupTime);
@@ -72,18 +72,18 @@
  *=======================================================================*/
 
 #if INSTRUMENT
-int calls;
-int reshed;
-int bytecodes;
-int slowcodes;
-int branches;
+ISOLATE_LOCAL int calls;
+ISOLATE_LOCAL int reshed;
+ISOLATE_LOCAL int bytecodes;
+ISOLATE_LOCAL int slowcodes;
+ISOLATE_LOCAL int branches;
 #endif
 
 /*************************************************************************
  *                 Start of infrequent bytecodes option                  *
  *************************************************************************/
 
-OBJECT thisObjectGCSafe = NULL;
+ISOLATE_LOCAL OBJECT thisObjectGCSafe = NULL;
 
 #if SPLITINFREQUENTBYTECODES
 
@@ -142,11 +142,13 @@ void SlowInterpret(ByteCode token) {
 #define STANDARDBYTECODES 0
 #define FLOATBYTECODES 0
 #define FASTBYTECODES 0
+#define SUPERINSTRUCTIONS 0
 #define INFREQUENTSTANDARDBYTECODES 1
 #include "bytecodes.c"
 #undef STANDARDBYTECODES
 #undef FLOATBYTECODES
 #undef FASTBYTECODES
+#undef SUPERINSTRUCTIONS
 #undef INFREQUENTSTANDARDBYTECODES
 /*=======================================================================*/
 
@@ -163,9 +165,20 @@ void SlowInterpret(ByteCode token) {
         callMethod_general: {
 
             INC_CALLS
+            COUNT_INVOCATION(thisMethod)
+            COUNT_PAIR_BREAK
 
             /*  Check if the method is a native method */
             if (thisMethod->accessFlags & ACC_NATIVE) {
+                if ((thisMethod->accessFlags & ACC_SYNCHRONIZED)
+                        && !SYNCHRONIZED_NATIVE_SKIPS_LOCK(thisMethod,
+                                                           thisObject)) {
+                    if (invokeSynchronizedNativeFunction(thisMethod,
+                            thisObject, invokerSize)) {
+                        TRACE_METHOD_EXIT(thisMethod)
+                    }
+                    goto reschedulePoint;
+                }
                 ip += invokerSize;
                 invokeNativeFunction(thisMethod);
 
@@ -434,6 +447,11 @@ next0a:
     */
     INSTRUCTIONPROFILE
 
+   /*
+    * Count the bytecode and the pair it makes with the previous one
+    */
+    COUNT_BYTECODE(ip)
+
    /*
     * Trace the instruction here if the option is enabled
     */
@@ -465,6 +483,7 @@ next0a:
 #define STANDARDBYTECODES 1
 #define FLOATBYTECODES    IMPLEMENTS_FLOAT
 #define FASTBYTECODES     ENABLEFASTBYTECODES
+#define SUPERINSTRUCTIONS ENABLE_SUPERINSTRUCTIONS
 #if SPLITINFREQUENTBYTECODES
 #define INFREQUENTSTANDARDBYTECODES 0
 #else
@@ -474,6 +493,7 @@ next0a:
 #undef STANDARDBYTECODES
 #undef FLOATBYTECODES
 #undef FASTBYTECODES
+#undef SUPERINSTRUCTIONS
 #undef INFREQUENTSTANDARDBYTECODES
 
 /*=======================================================================*/
@@ -485,8 +505,7 @@ next0a:
 #if COMMONBRANCHING
         branchPoint: {
             INC_BRANCHES
-            ip += getShort(ip + 1);
-            goto reschedulePoint;
+            BRANCH(getShort(ip + 1))
         }
 #endif
 
@@ -502,9 +521,24 @@ next0a:
         callMethod_general: {
 
             INC_CALLS
+            COUNT_INVOCATION(thisMethod)
+            COUNT_PAIR_BREAK
 
             /*  Check if the method is a native method */
             if (thisMethod->accessFlags & ACC_NATIVE) {
+                if ((thisMethod->accessFlags & ACC_SYNCHRONIZED)
+                        && !SYNCHRONIZED_NATIVE_SKIPS_LOCK(thisMethod,
+                                                           thisObject)) {
+                    bool_t invoked;
+                    VMSAVE
+                    invoked = invokeSynchronizedNativeFunction(thisMethod,
+                                  thisObject, invokerSize);
+                    VMRESTORE
+                    if (invoked) {
+                        TRACE_METHOD_EXIT(thisMethod);
+                    }
+                    goto reschedulePoint;
+                }
                 ip += invokerSize;
                 VMSAVE
                 invokeNativeFunction(thisMethod);
@@ -579,6 +579,50 @@ void printExecutionStack()
  * Actual exception handling operations
  *=======================================================================*/
 
+#if HANDLER_CACHE_SIZE
+
+/* The exception handler cache.  Each entry remembers the result of
+ * looking up a handler for a given exception class at a given offset
+ * in the handler table of a method.  A NULL handler means that the
+ * method does not catch the exception at that offset, which is just as
+ * useful to remember.  Since the handler table of a method is searched
+ * in order, the cached result is always the first matching handler.
+ */
+typedef struct handlerCacheEntryStruct {
+    HANDLERTABLE   handlerTable;   /* Handler table of the method */
+    CLASS          exceptionClass; /* Class of the exception */
+    unsigned short ipOffset;       /* Offset of the throwing instruction */
+    HANDLER        handler;        /* The matching handler, or NULL */
+} handlerCacheEntry;
+
+static ISOLATE_LOCAL handlerCacheEntry HandlerCache[HANDLER_CACHE_SIZE];
+
+#define HANDLER_CACHE_INDEX(handlerTable, exceptionClass, ipOffset)   \
+    (((((long)(handlerTable) ^ (long)(exceptionClass)) >> 2)          \
+       ^ (ipOffset)) & (HANDLER_CACHE_SIZE - 1))
+
+/*=========================================================================
+ * FUNCTION:      clearHandlerCache()
+ * TYPE:          exception handler table lookup operation
+ * OVERVIEW:      Invalidate all the entries of the exception handler
+ *                cache.  Called before each garbage collection, since
+ *                handler tables may be moved by the collector.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void clearHandlerCache()
+{
+    memset(HandlerCache, 0, sizeof(HandlerCache));
+}
+
+#endif /* HANDLER_CACHE_SIZE */
+
+#if PRINT_BACKTRACE
+static void recordBacktrace(THROWABLE_INSTANCE_HANDLE exceptionH, int depth);
+#endif
+
 /*=========================================================================
  * FUNCTION:      findHandler()
  * TYPE:          exception handler table lookup operation
@@ -595,6 +639,17 @@ findHandler(INSTANCE_CLASS thisClass, HANDLERTABLE handlerTable,
             THROWABLE_INSTANCE_HANDLE exceptionH, unsigned short ipOffset)
 {
     HANDLER result = NULL;
+#if HANDLER_CACHE_SIZE
+    CLASS exceptionClass = (CLASS)unhand(exceptionH)->ofClass;
+    handlerCacheEntry *entry = &HandlerCache[
+        HANDLER_CACHE_INDEX(handlerTable, exceptionClass, ipOffset)];
+    if (   entry->handlerTable == handlerTable
+        && entry->exceptionClass == exceptionClass
+        && entry->ipOffset == ipOffset) {
+        return entry->handler;
+    }
+#endif /* HANDLER_CACHE_SIZE */
+
     ASSERTING_NO_ALLOCATION    
         FOR_EACH_HANDLER(thisHandler, handlerTable)
             if (ipOffset < thisHandler->startPC) { 
@@ -623,9 +678,65 @@ findHandler(INSTANCE_CLASS thisClass, HANDLERTABLE handlerTable,
             }
         END_FOR_EACH_HANDLER
     END_ASSERTING_NO_ALLOCATION
+
+#if HANDLER_CACHE_SIZE
+    entry->handlerTable = handlerTable;
+    entry->exceptionClass = exceptionClass;
+    entry->ipOffset = ipOffset;
+    entry->handler = result;
+#endif /* HANDLER_CACHE_SIZE */
+
     return result;
 }
 
+#if PRINT_BACKTRACE && LAZY_BACKTRACE
+
+/*=========================================================================
+ * FUNCTION:      countUnwoundFrames()
+ * TYPE:          internal exception handling operation
+ * OVERVIEW:      Count the stack frames that throwException() will
+ *                unwind, including the frame of the method that catches
+ *                the exception.  This does not change any state, other
+ *                than filling in the exception handler cache.
+ * INTERFACE:
+ *   parameters:  exception object, ip correction of the top frame
+ *   returns:     the number of frames
+ *=======================================================================*/
+
+static int
+countUnwoundFrames(THROWABLE_INSTANCE_HANDLE exceptionH, int ipCorrection)
+{
+    FRAME thisFP = getFP();
+    BYTE* thisIP = getIP();
+    int depth = 1;
+
+    for (;;) {
+        METHOD thisMethod = thisFP->thisMethod;
+        HANDLERTABLE handlerTable = thisMethod->u.java.handlers;
+        if (handlerTable != NULL) {
+            unsigned short ipOffset = thisIP - thisMethod->u.java.code;
+            if (findHandler(thisMethod->ofClass, handlerTable, exceptionH,
+                            (unsigned short)(ipOffset - ipCorrection))) {
+                return depth;
+            }
+        } else if (thisMethod == RunCustomCodeMethod) {
+            /* The callback of a custom code frame may handle it */
+            if (*(void **)(thisFP + 1) != NULL) {
+                return depth;
+            }
+        }
+        if (thisFP->previousIp == KILLTHREAD) {
+            return depth;
+        }
+        thisIP = thisFP->previousIp;
+        thisFP = thisFP->previousFp;
+        ipCorrection = (thisMethod == RunCustomCodeMethod) ? 0 : 1;
+        depth++;
+    }
+}
+
+#endif /* PRINT_BACKTRACE && LAZY_BACKTRACE */
+
 /*=========================================================================
  * FUNCTION:      throwException()
  * TYPE:          internal exception handling operation
@@ -699,6 +810,19 @@ restartOnError:
         Log->throwException(unhand(exceptionH));
     }
 #endif
+    RECORD_EVENT(FR_EXCEPTION_THROWN, unhand(exceptionH)->ofClass,
+                 thisFP == NULL ? NULL : thisFP->thisMethod)
+    PROBE_EXCEPTION_THROW(unhand(exceptionH))
+    COUNT_PAIR_BREAK
+
+#if PRINT_BACKTRACE && LAZY_BACKTRACE
+    /* Record only the frames that are about to be unwound */
+    if (unhand(exceptionH)->backtrace == NULL) {
+        recordBacktrace(exceptionH, countUnwoundFrames(exceptionH, ipCorrection));
+        thisFP = getFP();
+        thisIP = getIP();
+    }
+#endif
 
     while (thisFP != NULL) { 
         /*  Check if the current execution frame/method */
@@ -729,6 +853,8 @@ restartOnError:
                 setCP(thisFP->thisMethod->ofClass->constPool);
                 setStackHeight(1);
                 topStackAsType(THROWABLE_INSTANCE) = unhand(exceptionH);
+                RECORD_EVENT(FR_EXCEPTION_CAUGHT,
+                             unhand(exceptionH)->ofClass, thisMethod)
 #if ENABLE_JAVA_DEBUGGER
                 if (vmDebugReady) {
                     CEModPtr cep = GetCEModifier();
@@ -788,6 +914,7 @@ restartOnError:
         ipCorrection = (thisMethod == RunCustomCodeMethod) ? 0 : 1;
     }
     /* If we've gotten here, then there is no exception handler */
+    RECORD_EVENT(FR_EXCEPTION_CAUGHT, unhand(exceptionH)->ofClass, NULL)
     Log->uncaughtException(unhand(exceptionH));
 
 #if ENABLE_JAVA_DEBUGGER
@@ -840,8 +967,8 @@ restartOnError:
  *   returns:     <nothing>
  *=======================================================================*/
 
-static const char* CurrentException = NULL;
-static const char* CurrentExceptionMsg = NULL;
+static ISOLATE_LOCAL const char* CurrentException = NULL;
+static ISOLATE_LOCAL const char* CurrentExceptionMsg = NULL;
 
 static THROWABLE_INSTANCE getExceptionInstance(const char* name,
        const char* msg) {
@@ -882,7 +1009,7 @@ static THROWABLE_INSTANCE getExceptionInstance(const char* name,
         IS_TEMPORARY_ROOT(exception, (THROWABLE_INSTANCE)instantiate(clazz));
         /* The exception object instantiation is successful otherwise we
          * will have already thrown an OutOfMemoryError */
-#if PRINT_BACKTRACE
+#if PRINT_BACKTRACE && !LAZY_BACKTRACE
         fillInStackTrace(&exception);
 #endif
     END_TEMPORARY_ROOTS
@@ -1035,11 +1162,8 @@ void fatalError(const char* errorMessage)
 #if PRINT_BACKTRACE
 
 void fillInStackTrace(THROWABLE_INSTANCE_HANDLE exceptionH) {
-    ARRAY backtrace;
-    int i;
     int depth;
     FRAME thisFp;
-    BYTE* thisIp;
 
     /* Can't do much if we are in VM startup... */
     if (CurrentThread == NULL)
@@ -1051,6 +1175,19 @@ void fillInStackTrace(THROWABLE_INSTANCE_HANDLE exceptionH) {
           depth++, thisFp = thisFp->previousFp) 
         ; /* intentionally empty */
 
+    recordBacktrace(exceptionH, depth);
+}
+
+/* Save the method and offset of the top "depth" frames of the current
+ * thread in the backtrace of the exception.  Strings are only created
+ * if the backtrace is printed.
+ */
+static void recordBacktrace(THROWABLE_INSTANCE_HANDLE exceptionH, int depth) {
+    ARRAY backtrace;
+    int i;
+    FRAME thisFp;
+    BYTE* thisIp;
+
     /* We are essentially doing an instantiateArray here, but we don't 
      * want it to throw an error if it runs out of memory.  For now, we
      * have to roll our own, but this may become its own function, someday */
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Interpreter
+ * FILE:      fusion.c
+ * OVERVIEW:  Superinstructions (see fusion.h).  The pairs below are the
+ *            most frequent ones in the bytecode pair counts of the
+ *            benchmarks ("-counters <file> -bytecodecounts") that a
+ *            single superinstruction can cover.  ALOAD_0 before a field
+ *            access or a call covers most accessors and methods of the
+ *            receiver, and an integer load before IF_ICMP<cond> and
+ *            ICONST_1 before IADD cover most loop tests and counters.
+ *            The second instruction is usually still unquickened when
+ *            the rewriting is done; the superinstruction only goes on
+ *            without a dispatch once it has been replaced by its fast
+ *            version.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if ENABLE_SUPERINSTRUCTIONS
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+struct fusedPairStruct {
+    BYTE first;         /* The instruction replaced */
+    BYTE secondLow;     /* The range of instructions that must follow it */
+    BYTE secondHigh;
+    BYTE fused;         /* The superinstruction replacing it */
+};
+
+static const struct fusedPairStruct FusedPairs[] = {
+    { ALOAD_0,  GETFIELD,      GETFIELD,      ALOAD_0_GETFIELD      },
+    { ALOAD_0,  INVOKEVIRTUAL, INVOKEVIRTUAL, ALOAD_0_INVOKEVIRTUAL },
+    { ILOAD,    IF_ICMPEQ,     IF_ICMPLE,     ILOAD_IF_ICMP         },
+    { ILOAD_0,  IF_ICMPEQ,     IF_ICMPLE,     ILOAD_0_IF_ICMP       },
+    { ILOAD_1,  IF_ICMPEQ,     IF_ICMPLE,     ILOAD_1_IF_ICMP       },
+    { ILOAD_2,  IF_ICMPEQ,     IF_ICMPLE,     ILOAD_2_IF_ICMP       },
+    { ILOAD_3,  IF_ICMPEQ,     IF_ICMPLE,     ILOAD_3_IF_ICMP       },
+    { ICONST_1, IADD,          IADD,          ICONST_1_IADD         }
+};
+
+#define FUSED_PAIR_COUNT (sizeof(FusedPairs) / sizeof(FusedPairs[0]))
+
+/*=========================================================================
+ * Superinstruction variables
+ *=======================================================================*/
+
+bool_t SuperinstructionsEnabled = TRUE;
+
+/*=========================================================================
+ * Static functions (private to this file)
+ *=======================================================================*/
+
+static unsigned int getInstructionLength(METHOD thisMethod,
+                                         unsigned int offset);
+static void fuseMethodCode(METHOD thisMethod);
+
+/*=========================================================================
+ * Superinstruction operations
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      fuseClassCode
+ * TYPE:          public operation on classes
+ * OVERVIEW:      Install the superinstructions in the methods of a class
+ *                that has just been verified.
+ * INTERFACE:
+ *   parameters:  thisClass: the verified class
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void fuseClassCode(INSTANCE_CLASS thisClass)
+{
+    int i;
+
+    if (thisClass->methodTable == NULL) {
+        return;
+    }
+    for (i = 0; i < thisClass->methodTable->length; i++) {
+        METHOD thisMethod = &thisClass->methodTable->methods[i];
+
+        /* Skip special synthesized methods. */
+        if (thisMethod == RunCustomCodeMethod) {
+            continue;
+        }
+        /* Skip abstract and native methods. */
+        if (thisMethod->accessFlags & (ACC_NATIVE | ACC_ABSTRACT)) {
+            continue;
+        }
+        fuseMethodCode(thisMethod);
+    }
+}
+
+/*=========================================================================
+ * Static functions
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      fuseMethodCode
+ * TYPE:          private operation on methods
+ * OVERVIEW:      Walk the instructions of a method and replace the first
+ *                instruction of each pair in FusedPairs by its
+ *                superinstruction.  An instruction that has a breakpoint
+ *                set is neither replaced nor matched as the second
+ *                instruction of a pair.
+ * INTERFACE:
+ *   parameters:  thisMethod: a verified Java method
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+static void fuseMethodCode(METHOD thisMethod)
+{
+    BYTE* code = thisMethod->u.java.code;
+    unsigned int codeLength = thisMethod->u.java.codeLength;
+    unsigned int offset = 0;
+
+    while (offset < codeLength) {
+        unsigned int next = offset + getInstructionLength(thisMethod, offset);
+        if (next < codeLength) {
+            BYTE first = code[offset];
+            BYTE second = code[next];
+            unsigned int i;
+            for (i = 0; i < FUSED_PAIR_COUNT; i++) {
+                const struct fusedPairStruct* pair = &FusedPairs[i];
+                if (pair->first == first &&
+                    second >= pair->secondLow && second <= pair->secondHigh) {
+                    code[offset] = pair->fused;
+                    break;
+                }
+            }
+        }
+        offset = next;
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      getInstructionLength
+ * TYPE:          private operation on methods
+ * OVERVIEW:      Return the length of the instruction at the given
+ *                offset, including its operands and the padding of the
+ *                switches.  All but the switches and WIDE have their
+ *                length in byteCodeLengths.
+ * INTERFACE:
+ *   parameters:  thisMethod: the method, offset: the instruction offset
+ *   returns:     the length in bytes
+ *=======================================================================*/
+
+static unsigned int getInstructionLength(METHOD thisMethod,
+                                         unsigned int offset)
+{
+    BYTE* code = thisMethod->u.java.code;
+    int token = code[offset];
+
+#if ENABLE_JAVA_DEBUGGER
+    if (token == BREAKPOINT) {
+        token = getVerifierBreakpointOpcode(thisMethod,
+                                            (unsigned short)offset);
+    }
+#endif
+
+    switch (token) {
+        case WIDE:
+            return (code[offset + 1] == IINC) ? 6 : 4;
+
+        case TABLESWITCH: {
+            long* lpc = (long*)(((long)(code + offset + 1) + 3) & ~3);
+            long low = getCell(&lpc[1]);
+            long high = getCell(&lpc[2]);
+            return (BYTE*)&lpc[3 + (high - low + 1)] - (code + offset);
+        }
+
+        case LOOKUPSWITCH: {
+            long* lpc = (long*)(((long)(code + offset + 1) + 3) & ~3);
+            long pairs = getCell(&lpc[1]);
+            return (BYTE*)&lpc[2 + 2 * pairs] - (code + offset);
+        }
+
+        default:
+            return byteCodeLengths[token];
+    }
+}
+
+#endif /* ENABLE_SUPERINSTRUCTIONS */
+
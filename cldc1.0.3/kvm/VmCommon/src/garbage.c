@@ -41,12 +41,12 @@
  * Variables
  *=======================================================================*/
 
-int TemporaryRootsLength;
-int GlobalRootsLength;
+ISOLATE_LOCAL int TemporaryRootsLength;
+ISOLATE_LOCAL int GlobalRootsLength;
 
-union cellOrPointer TemporaryRoots[MAXIMUM_TEMPORARY_ROOTS];
-union cellOrPointer GlobalRoots[MAXIMUM_GLOBAL_ROOTS];
-POINTERLIST         CleanupRoots;
+ISOLATE_LOCAL union cellOrPointer TemporaryRoots[MAXIMUM_TEMPORARY_ROOTS];
+ISOLATE_LOCAL union cellOrPointer GlobalRoots[MAXIMUM_GLOBAL_ROOTS];
+ISOLATE_LOCAL POINTERLIST         CleanupRoots;
 
 /*=========================================================================
  * Functions
@@ -71,8 +71,12 @@ garbageCollect(int moreMemory)
     int beforeCollection = 0;
     int afterCollection = 0;
 #endif
+    DECLARE_RECORDER_START(gcStart)
 
+    RECORD_EVENT(FR_GC_BEGIN, moreMemory * CELL, memoryFree())
+    PROBE_GC_BEGIN(moreMemory * CELL, memoryFree())
     RundownAsynchronousFunctions();
+    RECORD_GC_BEGIN(moreMemory)
 
     if (ENABLEPROFILING && INCLUDEDEBUGCODE) {
         checkHeap();
@@ -93,6 +97,7 @@ garbageCollect(int moreMemory)
 #endif
 
     MonitorCache = NULL;        /* Clear any temporary monitors */
+    clearHandlerCache();        /* Handler tables may move */
 
     /* Store virtual machine registers of the currently active thread before
      * garbage collection (must be  done to enable execution stack scanning).
@@ -102,11 +107,15 @@ garbageCollect(int moreMemory)
     }
 
     garbageCollectForReal(moreMemory);
+    RECORD_GC_END()
 
     if (CurrentThread) {
         loadExecutionEnvironment(CurrentThread);
     }
 
+    RECORD_TIMED_EVENT(FR_GC_END, gcStart, memoryFree(), 0)
+    PROBE_GC_END(memoryFree())
+
 #if INCLUDEDEBUGCODE
     if (ENABLEPROFILING || tracegarbagecollection
         || tracegarbagecollectionverbose) {
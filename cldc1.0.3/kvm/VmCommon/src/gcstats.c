@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Memory management
+ * FILE:      gcstats.c
+ * OVERVIEW:  Garbage collection statistics (see gcstats.h).
+ *
+ *            Each histogram has a bucket for 0 and then one bucket
+ *            per power of two: bucket i (i > 0) counts the values from
+ *            2^(i-1) to 2^i - 1.  The summary file has one "key value"
+ *            pair per line:
+ *
+ *              collections <count>
+ *              elapsed_us <time since the VM started>
+ *              gc_us <time spent collecting>
+ *              throughput_percent <time not spent collecting>
+ *              cause.<cause> <count>
+ *              <histogram>.samples <count>
+ *              <histogram>.total <sum of the values>
+ *              <histogram>.max <largest value>
+ *              <histogram>.bucket.<lowest value of the bucket> <count>
+ *
+ *            Times are in microseconds and sizes in bytes.  Buckets
+ *            that are empty are left out.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if ENABLE_GC_STATISTICS
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+extern ISOLATE_LOCAL CHUNK FirstFreeChunk;  /* In collector.c */
+
+#define HISTOGRAM_BUCKETS 32
+
+typedef struct gcHistogramStruct {
+    unsigned long samples;
+    ulong64       total;
+    ulong64       max;
+    unsigned long buckets[HISTOGRAM_BUCKETS];
+} gcHistogram;
+
+/* The histograms, besides the phases */
+enum {
+    GC_HISTOGRAM_PAUSE = GC_PHASE_COUNT,
+    GC_HISTOGRAM_RECLAIMED,
+    GC_HISTOGRAM_LARGEST_CHUNK,
+    GC_HISTOGRAM_FRAGMENTATION,
+    GC_HISTOGRAM_COUNT
+};
+
+static const char* histogramNames[GC_HISTOGRAM_COUNT] = {
+    "phase.roots_us",
+    "phase.mark_us",
+    "phase.weak_us",
+    "phase.sweep_us",
+    "phase.compact_us",
+    "phase.update_us",
+    "pause_us",
+    "reclaimed_bytes",
+    "largest_free_chunk_bytes",
+    "fragmentation_percent"
+};
+
+static const char* causeNames[GC_CAUSE_COUNT] = {
+    "other", "allocation", "explicit", "permanent"
+};
+
+/*=========================================================================
+ * Garbage collection statistics variables
+ *=======================================================================*/
+
+bool_t VerboseGC = FALSE;
+char*  GCStatisticsFile = NULL;
+
+ISOLATE_LOCAL bool_t GCStatisticsEnabled = FALSE;
+ISOLATE_LOCAL int    NextGCCause;
+
+static ISOLATE_LOCAL gcHistogram*  Histograms;
+static ISOLATE_LOCAL unsigned long CauseCounts[GC_CAUSE_COUNT];
+static ISOLATE_LOCAL unsigned long CollectionCount;
+static ISOLATE_LOCAL ulong64       StatisticsStartTime;
+
+/* The collection in progress */
+static ISOLATE_LOCAL int     CurrentCause;
+static ISOLATE_LOCAL long    FreeBefore;
+static ISOLATE_LOCAL ulong64 CollectionStartTime;
+static ISOLATE_LOCAL ulong64 PhaseStartTime;
+static ISOLATE_LOCAL ulong64 PhaseTimes[GC_PHASE_COUNT];
+
+/*=========================================================================
+ * Static functions (private to this file)
+ *=======================================================================*/
+
+static void addSample(int histogram, ulong64 value);
+static void writeHistogram(FILE* file, int histogram);
+
+/*=========================================================================
+ * Garbage collection statistics operations
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      InitializeGCStatistics
+ * TYPE:          Memory management
+ * OVERVIEW:      Start gathering statistics if -verbosegc or -gcstats
+ *                was given on the command line.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void InitializeGCStatistics(void)
+{
+    GCStatisticsEnabled = FALSE;
+    NextGCCause = GC_CAUSE_OTHER;
+    if (!VerboseGC && GCStatisticsFile == NULL) {
+        return;
+    }
+    Histograms = (gcHistogram*)
+        calloc(GC_HISTOGRAM_COUNT, sizeof(gcHistogram));
+    if (Histograms == NULL) {
+        fprintf(stderr, "Not enough memory for garbage collection "
+                        "statistics\n");
+        return;
+    }
+    memset(CauseCounts, 0, sizeof(CauseCounts));
+    CollectionCount = 0;
+    StatisticsStartTime = MonotonicTime_md();
+    GCStatisticsEnabled = TRUE;
+}
+
+/*=========================================================================
+ * FUNCTION:      FinalizeGCStatistics
+ * TYPE:          Memory management
+ * OVERVIEW:      Write the summary file, if one was asked for, and stop
+ *                gathering statistics.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void FinalizeGCStatistics(void)
+{
+    ulong64 elapsed, gcTime;
+    char* fileName = GCStatisticsFile;
+    FILE* file;
+    int i;
+
+    if (!GCStatisticsEnabled) {
+        return;
+    }
+    GCStatisticsEnabled = FALSE;
+
+    if (fileName != NULL) {
+#if MULTIPLE_ISOLATES
+        fileName = isolateFileName(GCStatisticsFile);
+#endif /* MULTIPLE_ISOLATES */
+        file = (fileName != NULL) ? fopen(fileName, "w") : NULL;
+        if (file == NULL) {
+            fprintf(stderr, "Cannot write garbage collection statistics "
+                            "to %s\n", GCStatisticsFile);
+        } else {
+            elapsed = MonotonicTime_md() - StatisticsStartTime;
+            gcTime = Histograms[GC_HISTOGRAM_PAUSE].total;
+            fprintf(file, "collections %lu\n", CollectionCount);
+            fprintf(file, "elapsed_us %lu\n", (unsigned long)elapsed);
+            fprintf(file, "gc_us %lu\n", (unsigned long)gcTime);
+            fprintf(file, "throughput_percent %.2f\n", elapsed == 0 ? 100.0
+                    : 100.0 - (double)gcTime * 100.0 / (double)elapsed);
+            for (i = 0; i < GC_CAUSE_COUNT; i++) {
+                fprintf(file, "cause.%s %lu\n", causeNames[i], CauseCounts[i]);
+            }
+            for (i = 0; i < GC_HISTOGRAM_COUNT; i++) {
+                writeHistogram(file, i);
+            }
+            fclose(file);
+        }
+#if MULTIPLE_ISOLATES
+        free(fileName);
+#endif
+    }
+    free(Histograms);
+    Histograms = NULL;
+}
+
+/*=========================================================================
+ * FUNCTION:      gcStatisticsBegin, gcStatisticsPhase, gcStatisticsEnd
+ * TYPE:          Memory management
+ * OVERVIEW:      Called by the collector when a collection starts, when
+ *                each phase ends, and when the collection is over.
+ *                Phases that do not run (compaction, usually) take no
+ *                time.
+ * INTERFACE:
+ *   parameters:  the memory asked for (cells); the phase that ended
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void gcStatisticsBegin(int moreMemory)
+{
+    CurrentCause = NextGCCause;
+    if (CurrentCause == GC_CAUSE_OTHER && moreMemory > 0) {
+        CurrentCause = GC_CAUSE_ALLOCATION;
+    }
+    NextGCCause = GC_CAUSE_OTHER;
+    FreeBefore = memoryFree();
+    memset(PhaseTimes, 0, sizeof(PhaseTimes));
+    CollectionStartTime = PhaseStartTime = MonotonicTime_md();
+}
+
+void gcStatisticsPhase(int phase)
+{
+    ulong64 now = MonotonicTime_md();
+    PhaseTimes[phase] += now - PhaseStartTime;
+    PhaseStartTime = now;
+}
+
+void gcStatisticsEnd(void)
+{
+    ulong64 pause = MonotonicTime_md() - CollectionStartTime;
+    long freeAfter = 0;
+    long largestChunk = 0;
+    long chunkCount = 0;
+    long reclaimed;
+    long fragmentation;
+    CHUNK chunk;
+    int i;
+
+    for (chunk = FirstFreeChunk; chunk != NULL; chunk = chunk->next) {
+        long size = ((chunk->size >> TYPEBITS) + HEADERSIZE) * CELL;
+        freeAfter += size;
+        if (size > largestChunk) {
+            largestChunk = size;
+        }
+        chunkCount++;
+    }
+    reclaimed = freeAfter - FreeBefore;
+    if (reclaimed < 0) {
+        reclaimed = 0;
+    }
+    /* Share of the free memory that is not in the largest chunk */
+    fragmentation = (freeAfter == 0) ? 0 :
+        (long)((double)(freeAfter - largestChunk) * 100.0 / freeAfter);
+
+    CollectionCount++;
+    CauseCounts[CurrentCause]++;
+    for (i = 0; i < GC_PHASE_COUNT; i++) {
+        addSample(i, PhaseTimes[i]);
+    }
+    addSample(GC_HISTOGRAM_PAUSE, pause);
+    addSample(GC_HISTOGRAM_RECLAIMED, reclaimed);
+    addSample(GC_HISTOGRAM_LARGEST_CHUNK, largestChunk);
+    addSample(GC_HISTOGRAM_FRAGMENTATION, fragmentation);
+
+    if (VerboseGC) {
+        fprintf(stdout, "[GC #%lu %s: %ld->%ld bytes free of %ld, "
+                "%ld chunks, largest %ld, %.3f ms "
+                "(roots %.3f, mark %.3f, weak %.3f, sweep %.3f, "
+                "compact %.3f, update %.3f)]\n",
+                CollectionCount, causeNames[CurrentCause],
+                FreeBefore, freeAfter, getHeapSize(),
+                chunkCount, largestChunk, pause / 1000.0,
+                PhaseTimes[GC_PHASE_ROOTS] / 1000.0,
+                PhaseTimes[GC_PHASE_MARK] / 1000.0,
+                PhaseTimes[GC_PHASE_WEAK] / 1000.0,
+                PhaseTimes[GC_PHASE_SWEEP] / 1000.0,
+                PhaseTimes[GC_PHASE_COMPACT] / 1000.0,
+                PhaseTimes[GC_PHASE_UPDATE] / 1000.0);
+        fflush(stdout);
+    }
+}
+
+/*=========================================================================
+ * Static functions
+ *=======================================================================*/
+
+static void addSample(int histogram, ulong64 value)
+{
+    gcHistogram* h = &Histograms[histogram];
+    int bucket = 0;
+    while (value >> bucket != 0 && bucket < HISTOGRAM_BUCKETS - 1) {
+        bucket++;
+    }
+    h->samples++;
+    h->total += value;
+    if (value > h->max) {
+        h->max = value;
+    }
+    h->buckets[bucket]++;
+}
+
+static void writeHistogram(FILE* file, int histogram)
+{
+    gcHistogram* h = &Histograms[histogram];
+    const char* name = histogramNames[histogram];
+    int i;
+
+    fprintf(file, "%s.samples %lu\n", name, h->samples);
+    fprintf(file, "%s.total %lu\n", name, (unsigned long)h->total);
+    fprintf(file, "%s.max %lu\n", name, (unsigned long)h->max);
+    for (i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        if (h->buckets[i] != 0) {
+            fprintf(file, "%s.bucket.%lu %lu\n", name,
+                    i == 0 ? 0 : 1UL << (i - 1), h->buckets[i]);
+        }
+    }
+}
+
+#endif /* ENABLE_GC_STATISTICS */
+
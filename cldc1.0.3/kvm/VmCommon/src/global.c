@@ -44,18 +44,23 @@
 
 /* Shared string buffer that is used internally by the VM */
 /* NOTE: STRINGBUFFERSIZE is defined in main.h */
-char str_buffer[STRINGBUFFERSIZE];
+ISOLATE_LOCAL char str_buffer[STRINGBUFFERSIZE];
 
 /* Requested heap size when starting the VM from the command line */
-long RequestedHeapSize;    
+ISOLATE_LOCAL long RequestedHeapSize;    
+
+#if MULTIPLE_ISOLATES
+/* Number of the isolate run by this thread (see KVM_StartIsolate) */
+ISOLATE_LOCAL int IsolateNumber = 0;
+#endif /* MULTIPLE_ISOLATES */
 
 /*=========================================================================
  * Global execution modes
  *=======================================================================*/
 
 /*  Flags for toggling certain global modes on and off */
-bool_t JamEnabled;
-bool_t JamRepeat;
+ISOLATE_LOCAL bool_t JamEnabled;
+ISOLATE_LOCAL bool_t JamRepeat;
 
 /*========================================================================
  * Runtime flags for choosing different tracing/debugging options.
@@ -63,13 +68,19 @@ bool_t JamRepeat;
  * for normal VM operation.
  *=======================================================================*/
                       
-#define DEFINE_TRACE_VAR_AND_ZERO(varName, userName) int varName = 0;
+#define DEFINE_TRACE_VAR_AND_ZERO(varName, userName) \
+    ISOLATE_LOCAL int varName = 0;
 FOR_EACH_TRACE_FLAG(DEFINE_TRACE_VAR_AND_ZERO)
 
 /*=========================================================================
  * Error handling definitions
  *=======================================================================*/
 
+#if MULTIPLE_ISOLATES
+/* The address of a thread-local variable is not a constant, so
+ * each isolate starts with no outer scope instead */
+ISOLATE_LOCAL THROWABLE_SCOPE ThrowableScope = NULL;
+#else
 static struct throwableScopeStruct ThrowableScopeStruct = {
    /* env =           */ NULL,
    /* throwable =     */ NULL,
@@ -77,6 +88,7 @@ static struct throwableScopeStruct ThrowableScopeStruct = {
    /* outer =         */ NULL
 };
 THROWABLE_SCOPE ThrowableScope = &ThrowableScopeStruct;
-void* VMScope = NULL;
-int   VMExitCode = 0;
+#endif
+ISOLATE_LOCAL void* VMScope = NULL;
+ISOLATE_LOCAL int   VMExitCode = 0;
 
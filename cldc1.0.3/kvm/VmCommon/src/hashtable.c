@@ -35,6 +35,13 @@
 
 #include <global.h>
 
+#if SIMD_STRING_OPERATIONS && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if SIMD_STRING_OPERATIONS && defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 /*=========================================================================
  * Global variables
  *=======================================================================*/
@@ -42,23 +49,23 @@
 #if ROMIZING
 extern
 #endif
-HASHTABLE InternStringTable;    /* char* to String */
+ISOLATE_LOCAL HASHTABLE InternStringTable;    /* char* to String */
 
 #if ROMIZING
 extern
 #endif
-HASHTABLE UTFStringTable;       /* char* to unique instance */
+ISOLATE_LOCAL HASHTABLE UTFStringTable;       /* char* to unique instance */
 
 #if ROMIZING
 extern
 #endif
-HASHTABLE ClassTable;           /* package/base to CLASS */
+ISOLATE_LOCAL HASHTABLE ClassTable;           /* package/base to CLASS */
 
 #if SVM
 #if 0 && ROMIZING
 extern
 #endif
-HASHTABLE KeyTable;            /* KEY to unique instance */
+ISOLATE_LOCAL HASHTABLE KeyTable;            /* KEY to unique instance */
 #endif
 
 /*=========================================================================
@@ -470,6 +477,360 @@ utfStringLength(const char *utfstring, int length)
     return count;
 }
 
+/*=========================================================================
+ * Bulk conversions between UTF-8 and unicode
+ *
+ * decodeUTF8 and encodeUTF8 convert whole buffers, copying runs of
+ * ASCII characters 16 (SSE2) or 32 (AVX2) at a time when
+ * SIMD_STRING_OPERATIONS is on.  With modified set they use the
+ * "modified UTF-8" of class files and readUTF/writeUTF: '\0' is
+ * encoded in two bytes and surrogates are encoded one by one.
+ * Otherwise they use standard UTF-8, where characters above U+FFFF
+ * take four bytes and are surrogate pairs in unicode.
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      widenASCII
+ * TYPE:          helper function
+ * OVERVIEW:      Copy the ASCII bytes at the start of a buffer to
+ *                unicode characters.
+ * INTERFACE
+ *   parameters:  src: the bytes, dst: the characters, length: the
+ *                maximum number of bytes to copy
+ *   returns:     the number of bytes copied
+ *====================================================================*/
+
+static long
+widenASCII(const unsigned char *src, unsigned short *dst, long length)
+{
+    long i = 0;
+#if SIMD_STRING_OPERATIONS && defined(__AVX2__)
+    for ( ; i + 32 <= length; i += 32) {
+        __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+        if (_mm256_movemask_epi8(b) != 0) {
+            break;
+        }
+        _mm256_storeu_si256((__m256i *)(dst + i),
+                            _mm256_cvtepu8_epi16(_mm256_castsi256_si128(b)));
+        _mm256_storeu_si256((__m256i *)(dst + i + 16),
+                            _mm256_cvtepu8_epi16(
+                                _mm256_extracti128_si256(b, 1)));
+    }
+#endif
+#if SIMD_STRING_OPERATIONS && defined(__SSE2__)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        for ( ; i + 16 <= length; i += 16) {
+            __m128i b = _mm_loadu_si128((const __m128i *)(src + i));
+            if (_mm_movemask_epi8(b) != 0) {
+                break;
+            }
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_unpacklo_epi8(b, zero));
+            _mm_storeu_si128((__m128i *)(dst + i + 8),
+                             _mm_unpackhi_epi8(b, zero));
+        }
+    }
+#endif
+    for ( ; i < length && src[i] < 0x80; i++) {
+        dst[i] = src[i];
+    }
+    return i;
+}
+
+/*=========================================================================
+ * FUNCTION:      narrowASCII
+ * TYPE:          helper function
+ * OVERVIEW:      Copy the characters at the start of a buffer that
+ *                UTF-8 encodes in one byte.
+ * INTERFACE
+ *   parameters:  src: the characters, dst: the bytes, or NULL to only
+ *                count the characters, length: the maximum number of
+ *                characters, modified: TRUE if '\0' takes two bytes
+ *   returns:     the number of characters copied
+ *====================================================================*/
+
+static long
+narrowASCII(const unsigned short *src, unsigned char *dst, long length,
+            bool_t modified)
+{
+    long i = 0;
+#if SIMD_STRING_OPERATIONS && defined(__AVX2__)
+    {
+        const __m256i high = _mm256_set1_epi16((short)0xFF80);
+        const __m256i zero = _mm256_setzero_si256();
+        for ( ; i + 32 <= length; i += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i *)(src + i));
+            __m256i b = _mm256_loadu_si256((const __m256i *)(src + i + 16));
+            __m256i bytes;
+            if (!_mm256_testz_si256(_mm256_or_si256(a, b), high)) {
+                break;
+            }
+            /* packus works within 128-bit lanes; put the lanes in order */
+            bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+            if (modified &&
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, zero)) != 0) {
+                break;
+            }
+            if (dst != NULL) {
+                _mm256_storeu_si256((__m256i *)(dst + i), bytes);
+            }
+        }
+    }
+#endif
+#if SIMD_STRING_OPERATIONS && defined(__SSE2__)
+    {
+        const __m128i high = _mm_set1_epi16((short)0xFF80);
+        const __m128i zero = _mm_setzero_si128();
+        for ( ; i + 16 <= length; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i b = _mm_loadu_si128((const __m128i *)(src + i + 8));
+            __m128i bytes;
+            __m128i ascii = _mm_cmpeq_epi16(
+                               _mm_and_si128(_mm_or_si128(a, b), high), zero);
+            if (_mm_movemask_epi8(ascii) != 0xFFFF) {
+                break;
+            }
+            bytes = _mm_packus_epi16(a, b);
+            if (modified &&
+                _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)) != 0) {
+                break;
+            }
+            if (dst != NULL) {
+                _mm_storeu_si128((__m128i *)(dst + i), bytes);
+            }
+        }
+    }
+#endif
+    for ( ; i < length; i++) {
+        unsigned short ch = src[i];
+        if (ch >= 0x80 || (ch == 0 && modified)) {
+            break;
+        }
+        if (dst != NULL) {
+            dst[i] = (unsigned char)ch;
+        }
+    }
+    return i;
+}
+
+/*=========================================================================
+ * FUNCTION:      decodeUTF8
+ * OVERVIEW:      Converts UTF-8 bytes to unicode characters until the
+ *                bytes are used up, the output has no room for the
+ *                next character, or an invalid sequence is found.
+ *
+ *   parameters:  srcPtr: pointer to the bytes; set to point past the
+ *                bytes converted upon return.  srcEnd: end of the bytes.
+ *                dstPtr: pointer to the output; set to point past the
+ *                characters written upon return.  dstEnd: end of the
+ *                output.  modified: TRUE for modified UTF-8.
+ *   returns      UTF8_DONE, or UTF8_TRUNCATED if the bytes end in the
+ *                middle of a character, or UTF8_MALFORMED if *srcPtr
+ *                starts an invalid sequence.
+ *=======================================================================*/
+
+int
+decodeUTF8(const unsigned char **srcPtr, const unsigned char *srcEnd,
+           unsigned short **dstPtr, unsigned short *dstEnd, bool_t modified)
+{
+    const unsigned char *src = *srcPtr;
+    unsigned short *dst = *dstPtr;
+    int status = UTF8_DONE;
+
+    while (src < srcEnd && dst < dstEnd) {
+        unsigned long ch = src[0];
+        unsigned long value;
+        int length, i;
+
+        if (ch < 0x80) {
+            long n = srcEnd - src;
+            if (n > dstEnd - dst) {
+                n = dstEnd - dst;
+            }
+            n = widenASCII(src, dst, n);
+            src += n;
+            dst += n;
+            continue;
+        }
+
+        if (ch < 0xC0 || (!modified && ch < 0xC2)) {
+            /* Continuation byte, or (standard) overlong '\0' to '\177' */
+            status = UTF8_MALFORMED;
+            break;
+        } else if (ch < 0xE0) {
+            length = 2;
+            value = ch & 0x1F;
+        } else if (ch < 0xF0) {
+            length = 3;
+            value = ch & 0x0F;
+        } else if (!modified && ch < 0xF5) {
+            length = 4;
+            value = ch & 0x07;
+        } else {
+            status = UTF8_MALFORMED;
+            break;
+        }
+
+        for (i = 1; i < length; i++) {
+            if (src + i >= srcEnd) {
+                status = UTF8_TRUNCATED;
+                goto done;
+            }
+            if ((src[i] & 0xC0) != 0x80) {
+                status = UTF8_MALFORMED;
+                goto done;
+            }
+            value = (value << 6) | (src[i] & 0x3F);
+        }
+
+        if (length == 4) {
+            if (value < 0x10000 || value > 0x10FFFF) {
+                status = UTF8_MALFORMED;
+                break;
+            }
+            if (dstEnd - dst < 2) {
+                break;
+            }
+            value -= 0x10000;
+            *dst++ = (unsigned short)(0xD800 + (value >> 10));
+            *dst++ = (unsigned short)(0xDC00 + (value & 0x3FF));
+        } else {
+            if (length == 3 && !modified && value < 0x800) {
+                status = UTF8_MALFORMED;
+                break;
+            }
+            *dst++ = (unsigned short)value;
+        }
+        src += length;
+    }
+
+done:
+    *srcPtr = src;
+    *dstPtr = dst;
+    return status;
+}
+
+/*=========================================================================
+ * FUNCTION:      encodeUTF8
+ * OVERVIEW:      Converts unicode characters to UTF-8 until the
+ *                characters are used up or the output has no room for
+ *                the next one.  In standard UTF-8, an unpaired
+ *                surrogate is written as '?', and a high surrogate
+ *                that ends the input is left for the next call, as its
+ *                low surrogate may follow.
+ *
+ *   parameters:  srcPtr: pointer to the characters; set to point past
+ *                the characters converted upon return.  srcEnd: end of
+ *                the characters.  dstPtr: pointer to the output; set to
+ *                point past the bytes written upon return.  dstEnd: end
+ *                of the output.  modified: TRUE for modified UTF-8.
+ *   returns      nothing
+ *=======================================================================*/
+
+void
+encodeUTF8(const unsigned short **srcPtr, const unsigned short *srcEnd,
+           unsigned char **dstPtr, unsigned char *dstEnd, bool_t modified)
+{
+    const unsigned short *src = *srcPtr;
+    unsigned char *dst = *dstPtr;
+
+    while (src < srcEnd) {
+        unsigned long ch = src[0];
+
+        if (ch < 0x80 && (ch != 0 || !modified)) {
+            long n = srcEnd - src;
+            if (n > dstEnd - dst) {
+                n = dstEnd - dst;
+            }
+            if (n == 0) {
+                break;
+            }
+            n = narrowASCII(src, dst, n, modified);
+            src += n;
+            dst += n;
+            continue;
+        }
+
+        if (ch < 0x800) {
+            if (dstEnd - dst < 2) {
+                break;
+            }
+            *dst++ = (unsigned char)(0xC0 | (ch >> 6));
+            *dst++ = (unsigned char)(0x80 | (ch & 0x3F));
+        } else if (modified || ch < 0xD800 || ch > 0xDFFF) {
+            if (dstEnd - dst < 3) {
+                break;
+            }
+            *dst++ = (unsigned char)(0xE0 | (ch >> 12));
+            *dst++ = (unsigned char)(0x80 | ((ch >> 6) & 0x3F));
+            *dst++ = (unsigned char)(0x80 | (ch & 0x3F));
+        } else if (ch < 0xDC00 && src + 1 == srcEnd) {
+            /* The low surrogate may come with the next call */
+            break;
+        } else if (ch < 0xDC00 && src[1] >= 0xDC00 && src[1] <= 0xDFFF) {
+            unsigned long value =
+                0x10000 + ((ch - 0xD800) << 10) + (src[1] - 0xDC00);
+            if (dstEnd - dst < 4) {
+                break;
+            }
+            *dst++ = (unsigned char)(0xF0 | (value >> 18));
+            *dst++ = (unsigned char)(0x80 | ((value >> 12) & 0x3F));
+            *dst++ = (unsigned char)(0x80 | ((value >> 6) & 0x3F));
+            *dst++ = (unsigned char)(0x80 | (value & 0x3F));
+            src++;
+        } else {
+            if (dst == dstEnd) {
+                break;
+            }
+            *dst++ = '?';
+        }
+        src++;
+    }
+    *srcPtr = src;
+    *dstPtr = dst;
+}
+
+/*=========================================================================
+ * FUNCTION:      utf8Length
+ * OVERVIEW:      Determine the number of bytes encodeUTF8 produces for
+ *                a unicode string, counting a high surrogate at the end
+ *                as the '?' it becomes if nothing follows.
+ *
+ *   parameters:  unistring: the characters, length: their number,
+ *                modified: TRUE for modified UTF-8
+ *   returns      the number of bytes
+ *=======================================================================*/
+
+long
+utf8Length(const unsigned short *unistring, long length, bool_t modified)
+{
+    long result = 0;
+    long i = 0;
+
+    while (i < length) {
+        unsigned short ch = unistring[i];
+        if (ch < 0x80 && (ch != 0 || !modified)) {
+            long n = narrowASCII(unistring + i, NULL, length - i, modified);
+            result += n;
+            i += n;
+            continue;
+        }
+        if (ch < 0x800) {
+            result += 2;
+        } else if (modified || ch < 0xD800 || ch > 0xDFFF) {
+            result += 3;
+        } else if (ch < 0xDC00 && i + 1 < length
+                   && unistring[i+1] >= 0xDC00 && unistring[i+1] <= 0xDFFF) {
+            result += 4;
+            i++;
+        } else {
+            result += 1;
+        }
+        i++;
+    }
+    return result;
+}
+
 #if ENABLE_JAVA_DEBUGGER
 
 /*
@@ -488,39 +849,12 @@ utfStringLength(const char *utfstring, int length)
 
 char *unicode2utf(unsigned short *unistring, int length, char *buffer, int buflength)
 {
-    int i;
-    unsigned short *uniptr;
-    char *bufptr;
-    unsigned bufleft;
-
-    bufleft = buflength - 1; /* take note of null now! */
+    const unsigned short *uniptr = unistring;
+    unsigned char *bufptr = (unsigned char *)buffer;
 
-    for (i = length, uniptr = unistring, bufptr = buffer; --i >= 0; uniptr++) {
-        unsigned short ch = *uniptr;
-        if ((ch != 0) && (ch <=0x7f)) {
-            if ((int)(--bufleft) < 0)     /* no space for character */
-                break;
-            *bufptr++ = (char)ch;
-        } else if (ch <= 0x7FF) { 
-            /* 11 bits or less. */
-            unsigned char high_five = ch >> 6;
-            unsigned char low_six = ch & 0x3F;
-            if ((int)(bufleft -= 2) < 0)  /* no space for character */
-                break;
-            *bufptr++ = high_five | 0xC0; /* 110xxxxx */
-            *bufptr++ = low_six | 0x80;   /* 10xxxxxx */
-        } else {
-            /* possibly full 16 bits. */
-            char high_four = ch >> 12;
-            char mid_six = (ch >> 6) & 0x3F;
-            char low_six = ch & 0x3f;
-            if ((int)(bufleft -= 3) < 0) /* no space for character */
-                break;
-            *bufptr++ = high_four | 0xE0; /* 1110xxxx */
-            *bufptr++ = mid_six | 0x80;   /* 10xxxxxx */
-            *bufptr++ = low_six | 0x80;   /* 10xxxxxx*/
-        }
-    }
+    /* take note of null now! */
+    encodeUTF8(&uniptr, unistring + length,
+               &bufptr, (unsigned char *)buffer + buflength - 1, TRUE);
     *bufptr = 0;
     return buffer;
 }
@@ -530,18 +864,7 @@ char *unicode2utf(unsigned short *unistring, int length, char *buffer, int bufle
  */
 int unicode2utfstrlen(unsigned short *unistring, int unilength)
 {
-    int result_length = 0;
-    
-    for (; unilength > 0; unistring++, unilength--) {
-        unsigned short ch = *unistring;
-        if ((ch != 0) && (ch <= 0x7f)) /* 1 byte */
-            result_length++;
-        else if (ch <= 0x7FF)
-            result_length += 2;        /* 2 byte character */
-        else 
-            result_length += 3;        /* 3 byte character */
-    }
-    return result_length;
+    return utf8Length(unistring, unilength, TRUE);
 }
 
 #endif /* ENABLE_JAVA_DEBUGGER */
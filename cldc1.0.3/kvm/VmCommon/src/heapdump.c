@@ -0,0 +1,644 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Memory management
+ * FILE:      heapdump.c
+ * OVERVIEW:  Heap dumps (see heapdump.h).  The dynamic heap is walked
+ *            object by object, the same way the mark-and-sweep
+ *            collector (collector.c) does, and the roots are found the
+ *            way the collector finds them.  Writing a dump does not
+ *            allocate heap memory, so that a dump can be taken when
+ *            the heap is full.
+ *
+ *            A dump file has a header followed by tagged records.
+ *            Numbers are big-endian; an "id" is the address of an
+ *            object or class, written in "id size" bytes:
+ *
+ *              header:  u1 magic[4] = "KVMH"
+ *                       u2 version = 1
+ *                       u1 id size
+ *                       u1 1 if the host is big-endian, else 0
+ *                       u8 wall clock time of the dump (ms)
+ *                       u4 heap size, u4 free bytes
+ *              class:   u1 1, id class, id superclass (0 if none)
+ *                       u4 instance size in cells (0 for arrays)
+ *                       name (u2 length, UTF-8 bytes)
+ *                       u2 number of fields, each:
+ *                         name, signature (as above)
+ *                         u1 1 if static, else 0
+ *                         instance field: u4 cell offset in the object
+ *                         static field: its cells (2 for long and
+ *                         double, else 1), each an id
+ *                       u1 1 if the class is an SVM trusted class,
+ *                       followed by u2 access flags, u2 number of
+ *                       domains, u2 number of pending permits, and an
+ *                       id grantor for each pending permit
+ *              instance: u1 2, id, id class, u4 size (bytes with header)
+ *                       u4 number of cells, each an id
+ *              object array: u1 3, id, id class, u4 size, u4 length,
+ *                       the elements, each an id
+ *              primitive array: u1 4, id, id class, u4 size, u4 length,
+ *                       u1 element size, the elements in host byte order
+ *              VM object: u1 5, id, u1 GCT_xxx type, u4 size,
+ *                       u4 number of references, each an id
+ *              root:    u1 6, u1 root kind (HD_ROOT_xxx), id object,
+ *                       id holder (class of a static or SVM root,
+ *                       thread of a stack or lock root, else 0)
+ *
+ *            Cells that hold references are only known for the fields
+ *            with a reference signature.  Internal VM objects only list
+ *            the references the collector follows.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if ENABLE_HEAP_DUMP
+
+#if ASYNCHRONOUS_NATIVE_FUNCTIONS
+#include <async.h>
+extern ASYNCIOCB IocbRoots[];
+#endif
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+#define HD_MAGIC            "KVMH"
+#define HD_VERSION          1
+
+#define HD_CLASS            1
+#define HD_INSTANCE         2
+#define HD_OBJECT_ARRAY     3
+#define HD_PRIMITIVE_ARRAY  4
+#define HD_VM_OBJECT        5
+#define HD_ROOT             6
+
+#define HD_ROOT_GLOBAL      1   /* Global roots of the VM */
+#define HD_ROOT_TEMPORARY   2   /* Temporary roots of native code */
+#define HD_ROOT_STATIC      3   /* Static field */
+#define HD_ROOT_STACK       4   /* Local variable or operand of a frame */
+#define HD_ROOT_THREAD      5   /* A live thread and its Java object */
+#define HD_ROOT_LOCK        6   /* Object locked or hashed by the VM */
+#define HD_ROOT_SVM         7   /* Permit, signature or digest of a */
+                                /* trusted class */
+#define HD_ROOT_VM          8   /* Anything else the VM keeps alive */
+
+#define OBJECT_HEADER(object) ((cell *)(object))[-HEADERSIZE]
+
+/*=========================================================================
+ * Heap dump variables
+ *=======================================================================*/
+
+char* HeapDumpFile = NULL;
+
+volatile int HeapDumpRequests;
+
+static int  DumpRequestsHandled;
+static int  HeapDumpCount;
+static bool_t OutOfMemoryDumped;
+
+/*=========================================================================
+ * Static functions (private to this file)
+ *=======================================================================*/
+
+static void dumpClasses(FILE* file);
+static void dumpObjects(FILE* file);
+static void dumpRoots(FILE* file);
+static void dumpThreadStack(FILE* file, THREAD thisThread);
+
+/*=========================================================================
+ * Heap dump operations
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      InitializeHeapDump
+ * TYPE:          Memory management
+ * OVERVIEW:      Reset the dump counters.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void InitializeHeapDump(void)
+{
+    DumpRequestsHandled = HeapDumpRequests;
+    HeapDumpCount = 0;
+    OutOfMemoryDumped = FALSE;
+}
+
+/*=========================================================================
+ * FUNCTION:      checkHeapDump
+ * TYPE:          Memory management
+ * OVERVIEW:      Write a heap dump to the next numbered dump file if
+ *                the port asked for one since the last call.  Called
+ *                by the interpreter at reschedule points.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void checkHeapDump(void)
+{
+    int requests = HeapDumpRequests;
+    if (requests != DumpRequestsHandled && HeapDumpFile != NULL) {
+        char* fileName = (char*)malloc(strlen(HeapDumpFile) + 12);
+        DumpRequestsHandled = requests;
+        if (fileName != NULL) {
+            sprintf(fileName, "%s.%d", HeapDumpFile, ++HeapDumpCount);
+            if (!dumpHeap(fileName)) {
+                fprintf(stderr, "Cannot write heap dump to %s\n", fileName);
+            }
+            free(fileName);
+        }
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      heapDumpOnOutOfMemory
+ * TYPE:          Memory management
+ * OVERVIEW:      Called by the allocator when it runs out of heap
+ *                memory even after a garbage collection.  Writes a
+ *                dump the first time only.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void heapDumpOnOutOfMemory(void)
+{
+    if (HeapDumpFile != NULL && !OutOfMemoryDumped) {
+        OutOfMemoryDumped = TRUE;
+        if (dumpHeap(HeapDumpFile)) {
+            fprintf(stderr, "Out of memory; heap dumped to %s\n",
+                    HeapDumpFile);
+        }
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      dumpHeap
+ * TYPE:          Memory management
+ * OVERVIEW:      Write the heap, the classes and the roots to a file
+ *                (see the format at the top of this file).  Can be
+ *                called from native code and at any point where the
+ *                collector could run.
+ * INTERFACE:
+ *   parameters:  name of the file
+ *   returns:     TRUE if the file was written
+ *=======================================================================*/
+
+static void putU1(FILE* file, unsigned long value)
+{
+    putc((int)(value & 0xFF), file);
+}
+
+static void putU2(FILE* file, unsigned long value)
+{
+    putU1(file, value >> 8);
+    putU1(file, value);
+}
+
+static void putU4(FILE* file, unsigned long value)
+{
+    putU2(file, value >> 16);
+    putU2(file, value);
+}
+
+static void putID(FILE* file, const void* pointer)
+{
+    unsigned long value = (unsigned long)pointer;
+    int shift;
+    for (shift = (sizeof(void*) - 1) * 8; shift >= 0; shift -= 8) {
+        putU1(file, value >> shift);
+    }
+}
+
+static void putString(FILE* file, const char* string, int length)
+{
+    putU2(file, length);
+    fwrite(string, 1, length, file);
+}
+
+bool_t dumpHeap(const char* fileName)
+{
+    FILE* file = fopen(fileName, "wb");
+    ulong64 now;
+    short one = 1;
+
+    if (file == NULL) {
+        return FALSE;
+    }
+
+    RundownAsynchronousFunctions();
+
+    /* Make the stack of the current thread visible, as for a collection */
+    if (CurrentThread) {
+        storeExecutionEnvironment(CurrentThread);
+    }
+
+    fputs(HD_MAGIC, file);
+    putU2(file, HD_VERSION);
+    putU1(file, sizeof(void*));
+    putU1(file, *(char*)&one == 0);
+    now = CurrentTime_md();
+    putU4(file, (unsigned long)(now >> 32));
+    putU4(file, (unsigned long)now);
+    putU4(file, getHeapSize());
+    putU4(file, memoryFree());
+
+    dumpClasses(file);
+    dumpObjects(file);
+    dumpRoots(file);
+
+    RestartAsynchronousFunctions();
+
+    return (fclose(file) == 0);
+}
+
+/*=========================================================================
+ * Static functions
+ *=======================================================================*/
+
+static void dumpClasses(FILE* file)
+{
+    char buffer[STRINGBUFFERSIZE];
+
+    if (!ROMIZING && ClassTable == NULL) {
+        return;
+    }
+
+    FOR_ALL_CLASSES(clazz)
+        char* end = getClassName_inBuffer(clazz, buffer);
+
+        putU1(file, HD_CLASS);
+        putID(file, clazz);
+        if (IS_ARRAY_CLASS(clazz)) {
+            putID(file, JavaLangObject);
+            putU4(file, 0);
+            putString(file, buffer, end - buffer);
+            putU2(file, 0);
+            putU1(file, 0);
+        } else {
+            INSTANCE_CLASS iclazz = (INSTANCE_CLASS)clazz;
+            FIELDTABLE fieldTable = iclazz->fieldTable;
+
+            putID(file, iclazz->superClass);
+            putU4(file, iclazz->instSize);
+            putString(file, buffer, end - buffer);
+
+            putU2(file, fieldTable == NULL ? 0 : fieldTable->length);
+            FOR_EACH_FIELD(thisField, fieldTable)
+                int length;
+                char* name = change_Key_to_Name(
+                                 thisField->nameTypeKey.nt.nameKey, &length);
+                end = change_Key_to_FieldSignature_inBuffer(
+                                 thisField->nameTypeKey.nt.typeKey, buffer);
+                putString(file, name, name == NULL ? 0 : length);
+                putString(file, buffer, end - buffer);
+                if (thisField->accessFlags & ACC_STATIC) {
+                    cell* value = (cell*)thisField->u.staticAddress;
+                    putU1(file, 1);
+                    putID(file, (void*)value[0]);
+                    if (thisField->accessFlags & ACC_DOUBLE) {
+                        putID(file, (void*)value[1]);
+                    }
+                } else {
+                    putU1(file, 0);
+                    putU4(file, thisField->u.offset);
+                }
+            END_FOR_EACH_FIELD
+
+#if SVM
+            if (iclazz->tclazz != NULL) {
+                TRUSTED_CLASS tclazz = iclazz->tclazz;
+                PENDING_PERMITS ppermits = tclazz->ppermits;
+                int count = (ppermits == NULL) ? 0 : ppermits->count;
+                int i;
+                putU1(file, 1);
+                putU2(file, tclazz->accessFlags);
+                putU2(file, tclazz->domainsLength);
+                putU2(file, count);
+                for (i = 0; i < count; i++) {
+                    putID(file, ppermits->permits[i]->grantor);
+                }
+            } else {
+                putU1(file, 0);
+            }
+#else
+            putU1(file, 0);
+#endif /* SVM */
+        }
+    END_FOR_ALL_CLASSES
+}
+
+static void dumpObjects(FILE* file)
+{
+    cell* scanner;
+    cell* heapSpaceTop = CurrentHeapEnd;
+
+    for (scanner = CurrentHeap; scanner < heapSpaceTop;
+             scanner += SIZE(*scanner) + HEADERSIZE) {
+        GCT_ObjectType gctype = TYPE(*scanner);
+        cell* object = scanner + HEADERSIZE;
+        unsigned long size = (SIZE(*scanner) + HEADERSIZE) << log2CELL;
+        long i;
+
+        switch (gctype) {
+
+        case GCT_FREE:
+            break;
+
+        case GCT_INSTANCE: {
+            INSTANCE instance = (INSTANCE)object;
+            long length = instance->ofClass->instSize;
+            putU1(file, HD_INSTANCE);
+            putID(file, object);
+            putID(file, instance->ofClass);
+            putU4(file, size);
+            putU4(file, length);
+            for (i = 0; i < length; i++) {
+                putID(file, instance->data[i].cellp);
+            }
+            break;
+        }
+
+        case GCT_OBJECTARRAY: {
+            ARRAY array = (ARRAY)object;
+            long length = array->length;
+            putU1(file, HD_OBJECT_ARRAY);
+            putID(file, object);
+            putID(file, array->ofClass);
+            putU4(file, size);
+            putU4(file, length);
+            for (i = 0; i < length; i++) {
+                putID(file, array->data[i].cellp);
+            }
+            break;
+        }
+
+        case GCT_ARRAY: {
+            ARRAY array = (ARRAY)object;
+            long itemSize = array->ofClass->itemSize;
+            putU1(file, HD_PRIMITIVE_ARRAY);
+            putID(file, object);
+            putID(file, array->ofClass);
+            putU4(file, size);
+            putU4(file, array->length);
+            putU1(file, itemSize);
+            fwrite(((BYTEARRAY)array)->bdata, itemSize, array->length, file);
+            break;
+        }
+
+        default: {
+            /* Internal VM object: list what the collector follows */
+            void* refs[3];
+            long count = 0;
+            long length = 0;
+            cellOrPointer* data = NULL;
+
+            switch (gctype) {
+            case GCT_POINTERLIST:
+                length = ((POINTERLIST)object)->length;
+                data = ((POINTERLIST)object)->data;
+                break;
+            case GCT_THREAD:
+                refs[count++] = ((THREAD)object)->javaThread;
+                refs[count++] = ((THREAD)object)->stack;
+                break;
+            case GCT_EXECSTACK:
+                refs[count++] = ((STACK)object)->next;
+                break;
+            default:
+                break;
+            }
+            putU1(file, HD_VM_OBJECT);
+            putID(file, object);
+            putU1(file, gctype);
+            putU4(file, size);
+            if (gctype == GCT_METHODTABLE) {
+                FOR_EACH_METHOD(thisMethod, ((METHODTABLE)object))
+                    if ((thisMethod->accessFlags & ACC_NATIVE) == 0) {
+                        length += 2;
+                    }
+                END_FOR_EACH_METHOD
+                putU4(file, length);
+                FOR_EACH_METHOD(thisMethod, ((METHODTABLE)object))
+                    if ((thisMethod->accessFlags & ACC_NATIVE) == 0) {
+                        putID(file, thisMethod->u.java.code);
+                        putID(file, thisMethod->u.java.handlers);
+                    }
+                END_FOR_EACH_METHOD
+            } else {
+                putU4(file, count + length);
+                for (i = 0; i < count; i++) {
+                    putID(file, refs[i]);
+                }
+                for (i = 0; i < length; i++) {
+                    putID(file, data[i].cellp);
+                }
+            }
+            break;
+        }
+        }
+    }
+}
+
+static void putRoot(FILE* file, int kind, void* object, void* holder)
+{
+    if (object != NULL && inCurrentHeap(object)) {
+        putU1(file, HD_ROOT);
+        putU1(file, kind);
+        putID(file, object);
+        putID(file, holder);
+    }
+}
+
+static void dumpRoots(FILE* file)
+{
+    cellOrPointer *ptr, *endptr;
+    THREAD thread;
+    int i;
+
+    ptr = &GlobalRoots[0];
+    endptr = ptr + GlobalRootsLength;
+    for ( ; ptr < endptr; ptr++) {
+        putRoot(file, HD_ROOT_GLOBAL, *(ptr->cellpp), NULL);
+    }
+
+    ptr = &TemporaryRoots[0];
+    endptr = ptr + TemporaryRootsLength;
+    for ( ; ptr < endptr; ptr++) {
+        cellOrPointer location = *ptr;
+        if (location.cell == -1) {
+            /* Actual Location is ptr[1], base is ptr[2] */
+            putRoot(file, HD_ROOT_TEMPORARY, ptr[2].cellp, NULL);
+            ptr += 2;
+        } else {
+            putRoot(file, HD_ROOT_TEMPORARY, *(location.cellpp), NULL);
+        }
+    }
+
+#if ASYNCHRONOUS_NATIVE_FUNCTIONS
+    for (i = 0 ; i < ASYNC_IOCB_COUNT ; i++) {
+        ASYNCIOCB *aiocb = &IocbRoots[i];
+        putRoot(file, HD_ROOT_VM, aiocb->thread, NULL);
+        putRoot(file, HD_ROOT_VM, aiocb->instance, NULL);
+        putRoot(file, HD_ROOT_VM, aiocb->array, NULL);
+    }
+#endif
+
+#if ROMIZING
+    {
+#if RELOCATABLE_ROM
+        long *staticPtr = KVM_staticDataPtr;
+#else
+        long *staticPtr = KVM_staticData;
+#endif
+        int refCount = staticPtr[0];
+        for( ; refCount > 0; refCount--) {
+            putRoot(file, HD_ROOT_STATIC, (void*)staticPtr[refCount], NULL);
+        }
+    }
+#endif /* ROMIZING */
+
+    if (ROMIZING || ClassTable != NULL) {
+        FOR_ALL_CLASSES(clazz)
+            if (!IS_ARRAY_CLASS(clazz)) {
+                INSTANCE_CLASS iclazz = (INSTANCE_CLASS)clazz;
+                POINTERLIST statics = iclazz->staticFields;
+
+                putRoot(file, HD_ROOT_VM, iclazz->initThread, clazz);
+                if (clazz->accessFlags & ACC_ROM_CLASS) {
+                    continue;
+                }
+                if (statics != NULL) {
+                    int count = statics->length;
+                    while (--count >= 0) {
+                        putRoot(file, HD_ROOT_STATIC,
+                                statics->data[count].cellp, clazz);
+                    }
+                }
+#if SVM
+                if (iclazz->tclazz != NULL
+                        && iclazz->tclazz->ppermits != NULL) {
+                    PENDING_PERMITS ppermits = iclazz->tclazz->ppermits;
+                    putRoot(file, HD_ROOT_SVM, ppermits, clazz);
+                    for (i = 0; i != ppermits->count; i++) {
+                        PERMIT permit = ppermits->permits[i];
+                        putRoot(file, HD_ROOT_SVM, permit, clazz);
+                        putRoot(file, HD_ROOT_SVM, permit->signature, clazz);
+                    }
+                    putRoot(file, HD_ROOT_SVM, ppermits->digest, clazz);
+                    putRoot(file, HD_ROOT_SVM, ppermits->subclassPermit, clazz);
+                }
+#endif /* SVM */
+                if (iclazz->status == CLASS_VERIFIED) {
+                    continue;
+                }
+                FOR_EACH_METHOD(thisMethod, iclazz->methodTable)
+                    if (!(thisMethod->accessFlags & ACC_NATIVE)) {
+                        putRoot(file, HD_ROOT_VM,
+                                thisMethod->u.java.stackMaps.verifierMap,
+                                clazz);
+                    }
+                END_FOR_EACH_METHOD
+            }
+        END_FOR_ALL_CLASSES
+    }
+
+    for (thread = AllThreads; thread != NULL; thread = thread->nextAliveThread) {
+        putRoot(file, HD_ROOT_THREAD, thread, NULL);
+        putRoot(file, HD_ROOT_THREAD, thread->javaThread, NULL);
+        for (i = 0; i < FAST_LOCKS_PER_THREAD; i++) {
+            putRoot(file, HD_ROOT_LOCK, thread->extendedLocks[i].object,
+                    thread);
+        }
+        if (thread->stack != NULL) {
+            dumpThreadStack(file, thread);
+        }
+    }
+
+    for (i = 0; i < IdentityHashCount; i++) {
+        putRoot(file, HD_ROOT_LOCK, IdentityHashes[i].object, NULL);
+    }
+}
+
+/*
+ * The references in the frames of a thread, found with the
+ * stack maps in the same way as in markThreadStack (collector.c)
+ */
+static void dumpThreadStack(FILE* file, THREAD thisThread)
+{
+    FRAME  thisFP = thisThread->fpStore;
+    cell*  thisSP = thisThread->spStore;
+    BYTE*  thisIP = thisThread->ipStore;
+    char   map[(MAXIMUM_STACK_AND_LOCALS + 7) >> 3];
+    long   i;
+
+    putRoot(file, HD_ROOT_STACK, thisThread->stack, thisThread);
+
+    while (thisFP != NULL) {
+        METHOD method = thisFP->thisMethod;
+        cell* localVars = FRAMELOCALS(thisFP);
+        cell *operandStack = (cell*)thisFP + SIZEOF_FRAME;
+        int localsCount = method->frameSize;
+        long realStackSize = thisSP - (cell*)thisFP - SIZEOF_FRAME + 1;
+        unsigned int totalSize = realStackSize + localsCount;
+
+        putRoot(file, HD_ROOT_STACK, thisFP->syncObject, thisThread);
+        putRoot(file, HD_ROOT_STACK, thisFP->stack, thisThread);
+
+        if (method == RunCustomCodeMethod) {
+            memset(map, -1, (realStackSize + 7) >> 3);
+#if CLASS_INITIALIZATION_IN_JAVA
+        } else if (method == InitClassMethod &&
+                    method->ofClass->status < CLASS_VERIFIED) {
+            totalSize = 1;
+            map[0] = 0xFF;
+#endif /* CLASS_INITIALIZATION_IN_JAVA */
+        } else {
+            getGCRegisterMask(method, thisIP, map);
+        }
+        for (i = 0; i < totalSize; i++) {
+            if (map[i >> 3] & (1 << (i & 7))) {
+                cell *arg;
+                if (i < localsCount) {
+                    arg = *(cell **)&localVars[i];
+                } else {
+                    arg = *(cell **)&operandStack[i - localsCount];
+                }
+                putRoot(file, HD_ROOT_STACK, arg, thisThread);
+            }
+        }
+
+        thisSP = thisFP->previousSp;
+        thisIP = thisFP->previousIp;
+        thisFP = thisFP->previousFp;
+    }
+}
+
+#endif /* ENABLE_HEAP_DUMP */
+
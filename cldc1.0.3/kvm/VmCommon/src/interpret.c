@@ -43,11 +43,11 @@
  * Virtual machine global registers (see description in Interpreter.h)
  *=======================================================================*/
 
-BYTE*         ip_global; /*  Instruction pointer (program counter) */
-FRAME         fp_global; /*  Current frame pointer */
-cell*         sp_global; /*  Execution stack pointer */
-cell*         lp_global; /*  Local variable pointer */
-CONSTANTPOOL  cp_global; /*  Constant pool pointer */
+ISOLATE_LOCAL BYTE*         ip_global; /*  Instruction pointer (program counter) */
+ISOLATE_LOCAL FRAME         fp_global; /*  Current frame pointer */
+ISOLATE_LOCAL cell*         sp_global; /*  Execution stack pointer */
+ISOLATE_LOCAL cell*         lp_global; /*  Local variable pointer */
+ISOLATE_LOCAL CONSTANTPOOL  cp_global; /*  Constant pool pointer */
 
 #define ip ip_global
 #define fp fp_global
@@ -57,10 +57,10 @@ CONSTANTPOOL  cp_global; /*  Constant pool pointer */
 
 /*=========================================================================
  * Bytecode table for debugging purposes (included
- * only if certain tracing modes are enabled).
+ * only if certain tracing modes or the execution counters are enabled).
  *=======================================================================*/
 
-#if INCLUDEDEBUGCODE
+#if INCLUDEDEBUGCODE || ENABLE_EXECUTION_COUNTERS
 const char* const byteCodeNames[] = {
     "NOP",              /*  0x00 */
     "ACONST_NULL",      /*  0x01 */
@@ -277,7 +277,7 @@ const char* const byteCodeNames[] = {
     "GETSTATIC2_FAST",      /*  0xD2 */
     "PUTSTATIC_FAST",       /*  0xD3 */
     "PUTSTATIC2_FAST",      /*  0xD4 */
-    "UNUSED_D5",            /*  0xD5 */
+    "ARRAYCOPY_FAST",       /*  0xD5 */
     "INVOKEVIRTUAL_FAST",   /*  0xD6 */
     "INVOKESPECIAL_FAST",   /*  0xD7 */
     "INVOKESTATIC_FAST",    /*  0xD8 */
@@ -287,9 +287,55 @@ const char* const byteCodeNames[] = {
     "MULTIANEWARRAY_FAST",  /*  0xDC */
     "CHECKCAST_FAST",       /*  0xDD */
     "INSTANCEOF_FAST",      /*  0xDE */
-    "CUSTOMCODE"            /*  0xDF */
+    "CUSTOMCODE",           /*  0xDF */
+    "ALOAD_0_GETFIELD",     /*  0xE0 */
+    "ALOAD_0_INVOKEVIRTUAL",/*  0xE1 */
+    "ILOAD_IF_ICMP",        /*  0xE2 */
+    "ILOAD_0_IF_ICMP",      /*  0xE3 */
+    "ILOAD_1_IF_ICMP",      /*  0xE4 */
+    "ILOAD_2_IF_ICMP",      /*  0xE5 */
+    "ILOAD_3_IF_ICMP",      /*  0xE6 */
+    "ICONST_1_IADD"         /*  0xE7 */
 };
-#endif /* INCLUDEDEBUGCODE */
+#endif /* INCLUDEDEBUGCODE || ENABLE_EXECUTION_COUNTERS */
+
+/*=========================================================================
+ * Bytecode lengths, including the operands, for walking the code of a
+ * method (included only if the debugger, the superinstructions or the
+ * execution counters are enabled).  The length of TABLESWITCH,
+ * LOOKUPSWITCH and WIDE depends on their operands, so they have a
+ * length of 0 and the caller has to work it out.
+ *=======================================================================*/
+
+#if ENABLE_JAVA_DEBUGGER || ENABLE_SUPERINSTRUCTIONS || ENABLE_EXECUTION_COUNTERS
+const unsigned char byteCodeLengths[] = {
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 0 */
+    1, 1, 1, 1, 1, 1, 2, 3, 2, 3, /* 10 */
+    3, 2, 2, 2, 2, 2, 1, 1, 1, 1, /* 20 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 30 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 40 */
+    1, 1, 1, 1, 2, 2, 2, 2, 2, 1, /* 50 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 60 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 70 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 80 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 90 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 100 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 110 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 120 */
+    1, 1, 3, 1, 1, 1, 1, 1, 1, 1, /* 130 */
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 140 */
+    1, 1, 1, 3, 3, 3, 3, 3, 3, 3, /* 150 */
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 2, /* 160 */
+    0, 0, 1, 1, 1, 1, 1, 1, 3, 3, /* 170 */
+    3, 3, 3, 3, 3, 5, 0, 3, 2, 3, /* 180 */
+    1, 1, 3, 3, 1, 1, 0, 4, 3, 3, /* 190 */
+    5, 5, 1,                      /* 200 - 202 */
+             3, 3, 3, 3, 3, 3, 3, /* 203 - 209.  Artificial */
+    3, 3, 3, 3, 3, 3, 3, 5, 3, 3, /* 210.        Artificial */
+    4, 3, 3, 1,                   /* 220 - 223.  Artificial */
+    1, 1, 2, 1, 1, 1, 1, 1        /* 224 - 231.  Superinstructions */
+};
+#endif /* ENABLE_JAVA_DEBUGGER || ENABLE_SUPERINSTRUCTIONS || ENABLE_EXECUTION_COUNTERS */
 
 
 /*=========================================================================
@@ -1501,6 +1501,52 @@ loadStackMaps(FILEPOINTER_HANDLE ClassFileH, METHOD_HANDLE thisMethodH)
     return bytesRead;
 }
 
+#if ENABLE_SAMPLING_PROFILER
+
+/*=========================================================================
+ * FUNCTION:      loadLineNumberTable()
+ * TYPE:          private class file load operation
+ * OVERVIEW:      Load the line number table of a method and hand it
+ *                to the sampling profiler.  Only called when the
+ *                profiler is on.
+ * INTERFACE:
+ *   parameters:  classfile pointer, method pointer, attribute length
+ *   returns:     <nothing>
+ *   throws:      ClassFormatError if the attribute length is invalid
+ *=======================================================================*/
+
+static void
+loadLineNumberTable(FILEPOINTER_HANDLE ClassFileH, 
+                    METHOD_HANDLE thisMethodH, unsigned int attrLength)
+{
+    unsigned short length = loadShort(ClassFileH);
+    LINENUMBERTABLE lineNumberTable;
+    int i;
+
+    if (attrLength != 2 + 4 * (unsigned int)length) {
+        raiseExceptionCharMsg(ClassFormatError, KVM_MSG_BAD_ATTRIBUTE_SIZE);
+    }
+    if (length == 0) {
+        return;
+    }
+    lineNumberTable = (LINENUMBERTABLE)
+        malloc(sizeof(struct lineNumberTableStruct) + 
+               (length - 1) * sizeof(struct lineNumberStruct));
+    if (lineNumberTable == NULL) {
+        /* Not fatal: the profiler just shows no line numbers */
+        skipBytes(ClassFileH, attrLength - 2);
+        return;
+    }
+    lineNumberTable->length = length;
+    for (i = 0; i < length; i++) {
+        lineNumberTable->lineNumber[i].start_pc    = loadShort(ClassFileH);
+        lineNumberTable->lineNumber[i].line_number = loadShort(ClassFileH);
+    }
+    setMethodLineNumbers(unhand(thisMethodH), lineNumberTable);
+}
+
+#endif /* ENABLE_SAMPLING_PROFILER */
+
 /*=========================================================================
  * FUNCTION:      loadMethodAttributes()
  * TYPE:          private class file load operation
@@ -1578,6 +1624,11 @@ loadCodeAttribute(FILEPOINTER_HANDLE ClassFileH,
                 raiseExceptionCharMsg(ClassFormatError,
                         KVM_MSG_BAD_ATTRIBUTE_SIZE);
             }
+#if ENABLE_SAMPLING_PROFILER
+        } else if (SamplingProfilerFile != NULL && 
+                   !strcmp(codeAttrName, "LineNumberTable")) { 
+            loadLineNumberTable(ClassFileH, thisMethodH, codeAttrLength);
+#endif
         } else {
             skipBytes(ClassFileH, codeAttrLength);
         }
@@ -1739,8 +1790,10 @@ loadOneMethod(FILEPOINTER_HANDLE ClassFileH, INSTANCE_CLASS CurrentClass,
         if (accessFlags & ACC_NATIVE) {
             /*  Store native function pointer in the code field */
             thisMethod->u.native.info = NULL;
+            STARTUP_TRACE_BEGIN_CLASS(STARTUP_NATIVE, CurrentClass, NULL)
             thisMethod->u.native.code = 
                 getNativeFunction(CurrentClass, methodName, signature);
+            STARTUP_TRACE_END(STARTUP_NATIVE)
         }
     END_TEMPORARY_ROOTS
 
@@ -2576,6 +2629,8 @@ ignoreAttributes(FILEPOINTER_HANDLE ClassFileH, POINTERLIST_HANDLE StringPoolH)
 
 static void loadRawClass(INSTANCE_CLASS clazz)
 {
+        DECLARE_RECORDER_START(loadStart)
+        STARTUP_TRACE_BEGIN_CLASS(STARTUP_LOAD, clazz, NULL)
         START_TEMPORARY_ROOTS
             /* The UTF8 strings in the constant pool are put into a temporary
              * (directly indexable) list of strings that is discarded after
@@ -2666,6 +2721,9 @@ static void loadRawClass(INSTANCE_CLASS clazz)
 #endif /* INCLUDEDEBUGCODE */
 
         END_TEMPORARY_ROOTS
+        RECORD_TIMED_EVENT(FR_CLASS_LOAD, loadStart, clazz, 0)
+        PROBE_CLASS_LOADED((CLASS)clazz)
+        STARTUP_TRACE_END(STARTUP_LOAD)
 }
 
 /*
@@ -3006,7 +3064,7 @@ loadClassfile(INSTANCE_CLASS InitiatingClass)
 void
 loadClassfile(INSTANCE_CLASS clazz)
 {
-    static int ClassesBeingLoaded = 0;
+    static ISOLATE_LOCAL int ClassesBeingLoaded = 0;
 
     /*
      * This keeps track of whether or not this is a recursive call to this
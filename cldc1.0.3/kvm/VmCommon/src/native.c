@@ -36,7 +36,7 @@
 
 #include <global.h>
 
-METHOD CurrentNativeMethod;
+ISOLATE_LOCAL METHOD CurrentNativeMethod;
 
 /*=========================================================================
  * Operations on native functions
@@ -231,3 +231,53 @@ void invokeNativeFunction(METHOD thisMethod)
 #endif
 
 }
+
+/*=========================================================================
+ * FUNCTION:      invokeSynchronizedNativeFunction()
+ * TYPE:          private operation
+ * OVERVIEW:      Invoke a synchronized native function while holding
+ *                the lock of its object.  If another thread holds the
+ *                lock, this thread waits for it instead, and the invoke
+ *                bytecode is run again once the thread has been given
+ *                the lock.
+ * INTERFACE:
+ *   parameters:  method pointer, the object to lock, the size of the
+ *                invoke bytecode
+ *   returns:     TRUE if the function was invoked, FALSE if the thread
+ *                is waiting for the lock
+ *   throws:      anything the native function throws, after releasing
+ *                the lock
+ *=======================================================================*/
+
+bool_t invokeSynchronizedNativeFunction(METHOD thisMethod, OBJECT object,
+                                        int invokerSize)
+{
+    bool_t invoked;
+
+    START_TEMPORARY_ROOTS
+        DECLARE_TEMPORARY_ROOT(OBJECT, lock, object);
+        DECLARE_TEMPORARY_ROOT(THREAD, thisThread, CurrentThread);
+        if (thisThread->nativeLockGiven) {
+            /* We waited for the lock below, and have been given it */
+            thisThread->nativeLockGiven = FALSE;
+            invoked = TRUE;
+        } else {
+            invoked = (monitorEnter(lock) == MonitorStatusOwn);
+            thisThread->nativeLockGiven = !invoked;
+        }
+        if (invoked) {
+            char* exitFailure;
+            setIP(getIP() + invokerSize);
+            TRY {
+                invokeNativeFunction(thisMethod);
+            } CATCH (e) {
+                monitorExit(lock, &exitFailure);
+                THROW(e);
+            } END_CATCH
+            if (monitorExit(lock, &exitFailure) == MonitorStatusError) {
+                raiseException(exitFailure);
+            }
+        }
+    END_TEMPORARY_ROOTS
+    return invoked;
+}
@@ -35,6 +35,13 @@
 
 #include <global.h>
 
+#if SIMD_STRING_OPERATIONS && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if SIMD_STRING_OPERATIONS && defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 /*=========================================================================
  * FUNCTION:      getClass()Ljava/lang/Class
  * CLASS:         java.lang.Object
@@ -213,7 +220,7 @@ void Java_java_lang_Class_isPrimitive(void)
  *   returns:     a class object
  *=======================================================================*/
 
-bool_t LoadingViaReflection = FALSE;
+ISOLATE_LOCAL bool_t LoadingViaReflection = FALSE;
 void Java_java_lang_Class_forName(void)
 {
     /*
@@ -750,6 +757,7 @@ void Java_java_lang_Runtime_gc(void)
     oneLess; /* Discard runtime object */
 
     /*  Garbage collect now, keeping the heap size the same as currently */
+    setGCCause(GC_CAUSE_EXPLICIT);
     garbageCollect(0);
 }
 
@@ -855,7 +863,7 @@ void Java_java_lang_System_arraycopy(void)
  *=======================================================================*/
 
 #ifdef BEDETERMINISTIC
-ulong64 last;
+ISOLATE_LOCAL ulong64 last;
 
 void Java_java_lang_System_currentTimeMillis(void)
 {
@@ -1004,6 +1012,189 @@ void Java_java_lang_Throwable_printStackTrace0() {
  * Native functions of classes java.util.String and StringBuffer
  *=======================================================================*/
 
+/*=========================================================================
+ * Helper functions operating on the characters of strings.  Each of
+ * them has a vector loop (if SIMD_STRING_OPERATIONS is on and the
+ * compiler supports SSE2 or AVX2) followed by a plain C loop that
+ * handles the remaining characters.
+ *=======================================================================*/
+
+#define STRING_CHARS(string) \
+    ((unsigned short *)((string)->array->sdata) + (string)->offset)
+
+/*=========================================================================
+ * FUNCTION:      firstMismatch
+ * TYPE:          helper function
+ * OVERVIEW:      Compare two character sequences of the same length.
+ * INTERFACE
+ *   parameters:  s1, s2: the characters, length: number of characters
+ *   returns:     the index of the first character that differs, or
+ *                length if the sequences are identical
+ *====================================================================*/
+
+static long
+firstMismatch(const unsigned short *s1, const unsigned short *s2, long length)
+{
+    long i = 0;
+#if SIMD_STRING_OPERATIONS && defined(__AVX2__)
+    for ( ; i + 16 <= length; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(s1 + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(s2 + i));
+        unsigned int mask =
+            ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b));
+        if (mask != 0) {
+            return i + (__builtin_ctz(mask) >> 1);
+        }
+    }
+#endif
+#if SIMD_STRING_OPERATIONS && defined(__SSE2__)
+    for ( ; i + 8 <= length; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s1 + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s2 + i));
+        unsigned int mask =
+            ~(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi16(a, b)) & 0xFFFF;
+        if (mask != 0) {
+            return i + (__builtin_ctz(mask) >> 1);
+        }
+    }
+#endif
+    while (i < length && s1[i] == s2[i]) {
+        i++;
+    }
+    return i;
+}
+
+/*=========================================================================
+ * FUNCTION:      findChar, findLastChar
+ * TYPE:          helper functions
+ * OVERVIEW:      Find the first (last) occurrence of a character
+ * INTERFACE
+ *   parameters:  s: the characters, length: number of characters,
+ *                ch: the character to look for
+ *   returns:     the index of the character, or -1
+ *====================================================================*/
+
+static long
+findChar(const unsigned short *s, long length, long ch)
+{
+    long i = 0;
+    if ((unsigned long)ch > 0xFFFF) {
+        /* Not a char, so it can't be in the string */
+        return -1;
+    }
+#if SIMD_STRING_OPERATIONS && defined(__AVX2__)
+    {
+        __m256i needle = _mm256_set1_epi16((short)ch);
+        for ( ; i + 16 <= length; i += 16) {
+            __m256i a = _mm256_loadu_si256((const __m256i *)(s + i));
+            unsigned int mask =
+                (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, needle));
+            if (mask != 0) {
+                return i + (__builtin_ctz(mask) >> 1);
+            }
+        }
+    }
+#endif
+#if SIMD_STRING_OPERATIONS && defined(__SSE2__)
+    {
+        __m128i needle = _mm_set1_epi16((short)ch);
+        for ( ; i + 8 <= length; i += 8) {
+            __m128i a = _mm_loadu_si128((const __m128i *)(s + i));
+            unsigned int mask =
+                (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi16(a, needle));
+            if (mask != 0) {
+                return i + (__builtin_ctz(mask) >> 1);
+            }
+        }
+    }
+#endif
+    for ( ; i < length; i++) {
+        if (s[i] == ch) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static long
+findLastChar(const unsigned short *s, long length, long ch)
+{
+    long i = length;
+    if ((unsigned long)ch > 0xFFFF) {
+        return -1;
+    }
+#if SIMD_STRING_OPERATIONS && defined(__SSE2__)
+    {
+        __m128i needle = _mm_set1_epi16((short)ch);
+        for ( ; i >= 8; i -= 8) {
+            __m128i a = _mm_loadu_si128((const __m128i *)(s + i - 8));
+            unsigned int mask =
+                (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi16(a, needle));
+            if (mask != 0) {
+                return i - 8 + ((31 - __builtin_clz(mask)) >> 1);
+            }
+        }
+    }
+#endif
+    while (--i >= 0) {
+        if (s[i] == ch) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*=========================================================================
+ * FUNCTION:      stringHash
+ * TYPE:          helper function
+ * OVERVIEW:      Compute s[0]*31^(n-1) + s[1]*31^(n-2) + ... + s[n-1]
+ *                using 32-bit arithmetic, as String.hashCode() does.
+ * INTERFACE
+ *   parameters:  s: the characters, length: number of characters
+ *   returns:     the hash code
+ *====================================================================*/
+
+static long
+stringHash(const unsigned short *s, long length)
+{
+    unsigned int h = 0;
+    long i = 0;
+#if SIMD_STRING_OPERATIONS && defined(__AVX2__)
+    if (length >= 16) {
+        /* Lane j accumulates the characters j, j+8, j+16, ... with the
+         * multiplier 31^8.  Combining the lanes with the multipliers
+         * 31^7 ... 31^0 gives the hash code of the characters so far.
+         */
+        const __m256i step = _mm256_set1_epi32((int)0x94446F01); /* 31^8 */
+        const __m256i powers = _mm256_setr_epi32(0x67E12CDF, 0x34E63B41,
+                                                 0x01B4D89F, 0x000E1781,
+                                                 0x0000745F, 0x000003C1,
+                                                 0x0000001F, 0x00000001);
+        __m256i acc = _mm256_setzero_si256();
+        unsigned int lanes[8];
+        int j;
+        for ( ; i + 8 <= length; i += 8) {
+            __m256i c = _mm256_cvtepu16_epi32(
+                            _mm_loadu_si128((const __m128i *)(s + i)));
+            acc = _mm256_add_epi32(_mm256_mullo_epi32(acc, step), c);
+        }
+        _mm256_storeu_si256((__m256i *)lanes,
+                            _mm256_mullo_epi32(acc, powers));
+        for (j = 0; j < 8; j++) {
+            h += lanes[j];
+        }
+    }
+#endif
+    /* Four characters at a time to shorten the chain of multiplies */
+    for ( ; i + 4 <= length; i += 4) {
+        h = h * 923521 + s[i] * 29791 + s[i+1] * 961 + s[i+2] * 31 + s[i+3];
+    }
+    for ( ; i < length; i++) {
+        h = 31 * h + s[i];
+    }
+    return (long)(int)h;
+}
+
 /*=========================================================================
  * FUNCTION:      charAt()
  * CLASS:         java.lang.String
@@ -1042,23 +1233,15 @@ void Java_java_lang_String_charAt() {
 static void string_indexOf(int fromIndex) {
     long ch = popStack();
     STRING_INSTANCE this = popStackAsType(STRING_INSTANCE);
-    long offset = this->offset;
     long length = this->length;
     long result = -1;
-    int i;
 
     if (fromIndex < length) {
-        SHORTARRAY array = this->array;
-        /* Max is the largest position in the underlying char array */
-        long max = offset + length;
-        for (i = offset + fromIndex; i < max; i++) {
-            if (((unsigned short *)(array->sdata))[i] == ch) {
-                /* i is the position in the underlying char array.  We must
-                 * normalize it to the position in the String
-                 */
-                result = i - offset;
-                break;
-            }
+        /* findChar returns the position relative to fromIndex */
+        result = findChar(STRING_CHARS(this) + fromIndex,
+                          length - fromIndex, ch);
+        if (result >= 0) {
+            result += fromIndex;
         }
     }
     pushStack(result);
@@ -1133,6 +1316,201 @@ void Java_java_lang_String_equals() {
     pushStack(result);
 }
 
+/*=========================================================================
+ * FUNCTION:      lastIndexOf(II)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      returns last index of a character
+ *   parameters:  this
+ *                character
+ *                fromIndex:  last location to look for that character
+ *   returns:     index of the last occurrence of that character
+ *====================================================================*/
+
+void Java_java_lang_String_lastIndexOf(void) {
+    long fromIndex = popStack();
+    long ch = popStack();
+    STRING_INSTANCE this = topStackAsType(STRING_INSTANCE);
+    long result = -1;
+
+    if (fromIndex >= this->length) {
+        fromIndex = this->length - 1;
+    }
+    if (fromIndex >= 0) {
+        result = findLastChar(STRING_CHARS(this), fromIndex + 1, ch);
+    }
+    topStack = result;
+}
+
+/*=========================================================================
+ * FUNCTION:      indexOf(Ljava/lang/String;I)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      returns index of a substring
+ *   parameters:  this
+ *                str:        the substring
+ *                fromIndex:  first location to look for the substring
+ *   returns:     index of the first occurrence of the substring
+ *====================================================================*/
+
+void Java_java_lang_String_indexOf__Ljava_lang_String_2I(void) {
+    long fromIndex = popStack();
+    STRING_INSTANCE str = popStackAsType(STRING_INSTANCE);
+    STRING_INSTANCE this = topStackAsType(STRING_INSTANCE);
+    long count, strCount, result;
+
+    if (str == NULL) {
+        raiseException(NullPointerException);
+    }
+    count = this->length;
+    strCount = str->length;
+
+    if (fromIndex >= count) {
+        /* There is an empty string at index 0 in an empty string. */
+        result = (count == 0 && fromIndex == 0 && strCount == 0) ? 0 : -1;
+    } else {
+        if (fromIndex < 0) {
+            fromIndex = 0;
+        }
+        if (strCount == 0) {
+            result = fromIndex;
+        } else {
+            unsigned short *v1 = STRING_CHARS(this);
+            unsigned short *v2 = STRING_CHARS(str);
+            /* Max is the last position at which str can start */
+            long max = count - strCount;
+            long i = fromIndex;
+            result = -1;
+            while (i <= max) {
+                /* Look for the first character, then compare the rest */
+                long k = findChar(v1 + i, max - i + 1, v2[0]);
+                if (k < 0) {
+                    break;
+                }
+                i += k;
+                if (firstMismatch(v1 + i + 1, v2 + 1, strCount - 1)
+                       == strCount - 1) {
+                    result = i;
+                    break;
+                }
+                i++;
+            }
+        }
+    }
+    topStack = result;
+}
+
+/*=========================================================================
+ * FUNCTION:      hashCode()
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      returns the hash code of a string.  The hash code is
+ *                cached in the string.  Strings in ROM get their hash
+ *                code from the romizer, so they are never written to.
+ *   parameters:  this
+ *   returns:     hash code
+ *====================================================================*/
+
+void Java_java_lang_String_hashCode(void) {
+    STRING_INSTANCE this = topStackAsType(STRING_INSTANCE);
+    long hash = this->hash;
+
+    if (hash == 0) {
+        hash = stringHash(STRING_CHARS(this), this->length);
+        if (hash != 0) {
+            this->hash = hash;
+        }
+    }
+    topStack = hash;
+}
+
+/*=========================================================================
+ * FUNCTION:      compareTo(Ljava/lang/String;)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      compares two strings lexicographically
+ *   parameters:  this
+ *                anotherString
+ *   returns:     the difference of the first differing characters, or
+ *                the difference of the lengths
+ *====================================================================*/
+
+void Java_java_lang_String_compareTo(void) {
+    STRING_INSTANCE other = popStackAsType(STRING_INSTANCE);
+    STRING_INSTANCE this = topStackAsType(STRING_INSTANCE);
+    long len1, len2, n, i;
+    unsigned short *v1, *v2;
+
+    if (other == NULL) {
+        raiseException(NullPointerException);
+    }
+    len1 = this->length;
+    len2 = other->length;
+    n = (len1 < len2) ? len1 : len2;
+    v1 = STRING_CHARS(this);
+    v2 = STRING_CHARS(other);
+
+    i = firstMismatch(v1, v2, n);
+    topStack = (i < n) ? (long)v1[i] - (long)v2[i] : len1 - len2;
+}
+
+/*=========================================================================
+ * FUNCTION:      startsWith(Ljava/lang/String;I)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      tests if a string starts with a prefix at an offset
+ *   parameters:  this
+ *                prefix
+ *                toffset:  where to begin looking in the string
+ *   returns:     TRUE if the prefix is found at toffset
+ *====================================================================*/
+
+void Java_java_lang_String_startsWith(void) {
+    long toffset = popStack();
+    STRING_INSTANCE prefix = popStackAsType(STRING_INSTANCE);
+    STRING_INSTANCE this = topStackAsType(STRING_INSTANCE);
+    long pc;
+    bool_t result = FALSE;
+
+    if (prefix == NULL) {
+        raiseException(NullPointerException);
+    }
+    pc = prefix->length;
+    /* Note: toffset might be near -1>>>1 */
+    if (toffset >= 0 && toffset <= this->length - pc) {
+        result = firstMismatch(STRING_CHARS(this) + toffset,
+                               STRING_CHARS(prefix), pc) == pc;
+    }
+    topStack = result;
+}
+
+/*=========================================================================
+ * FUNCTION:      regionMatches(ILjava/lang/String;II)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function (private)
+ * OVERVIEW:      compares two string regions.  The Java caller checks
+ *                that the regions are within the strings, and handles
+ *                case insensitive comparison.
+ *   parameters:  this
+ *                toffset, other, ooffset, len
+ *   returns:     TRUE if the regions have the same characters
+ *====================================================================*/
+
+void Java_java_lang_String_regionMatches(void) {
+    long len = popStack();
+    long ooffset = popStack();
+    STRING_INSTANCE other = popStackAsType(STRING_INSTANCE);
+    long toffset = popStack();
+    STRING_INSTANCE this = topStackAsType(STRING_INSTANCE);
+    bool_t result = TRUE;
+
+    if (len > 0) {
+        result = firstMismatch(STRING_CHARS(this) + toffset,
+                               STRING_CHARS(other) + ooffset, len) == len;
+    }
+    topStack = result;
+}
+
 /*=========================================================================
  * FUNCTION:      append(String)
  * CLASS:         java.lang.StringBuffer
@@ -1151,6 +1529,7 @@ typedef struct stringBufferInstanceStruct {
 } *STRINGBUFFER_INSTANCE, **STRINGBUFFER_HANDLE;
 
 static void expandStringBufferCapacity(STRINGBUFFER_HANDLE, int size);
+static void reallocateStringBuffer(STRINGBUFFER_HANDLE, int length);
 
 void Java_java_lang_StringBuffer_append__Ljava_lang_String_2(void) {
     STRING_INSTANCE string = popStackAsType(STRING_INSTANCE);
@@ -1265,17 +1644,262 @@ void Java_java_lang_StringBuffer_toString(void) {
     pushStackAsType(STRING_INSTANCE, result);
 }
 
+/*=========================================================================
+ * FUNCTION:      append(C)
+ * CLASS:         java.lang.StringBuffer
+ * TYPE:          virtual native function
+ * OVERVIEW:      appends a character to a string buffer
+ *   parameters:  this
+ *                char
+ *   returns:     the "this" argument
+ *==================================================================== */
+
+void Java_java_lang_StringBuffer_append__C(void) {
+    short c = (short)popStack();
+    STRINGBUFFER_INSTANCE this = popStackAsType(STRINGBUFFER_INSTANCE);
+    long count = this->count;
+
+    if (count >= (long)this->array->length) {
+        START_TEMPORARY_ROOTS
+            DECLARE_TEMPORARY_ROOT(STRINGBUFFER_INSTANCE, thisX, this);
+            expandStringBufferCapacity(&thisX, count + 1);
+            this = thisX;
+        END_TEMPORARY_ROOTS
+    }
+    if (count < (long)this->array->length) {
+        /* Characters past count are never seen by a String that shares
+         * the array, so appending needs no copy.
+         */
+        this->array->sdata[count] = c;
+        this->count = count + 1;
+        pushStackAsType(STRINGBUFFER_INSTANCE, this);
+    } else {
+        /* We will have gotten an OutOfMemoryException from the
+         * expandStringBufferCapacity
+         */
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      append([C), append([CII)
+ * CLASS:         java.lang.StringBuffer
+ * TYPE:          virtual native function
+ * OVERVIEW:      appends (part of) a character array to a string buffer
+ *   parameters:  this
+ *                char array
+ *                offset, length (if given)
+ *   returns:     the "this" argument
+ *==================================================================== */
+
+static void appendCharArray(STRINGBUFFER_INSTANCE this, SHORTARRAY chars,
+                            long offset, long length) {
+    long count, newCount;
+
+    if (chars == NULL) {
+        raiseException(NullPointerException);
+        return;
+    }
+    if (offset < 0 || length < 0 || offset > (long)chars->length - length) {
+        raiseException(ArrayIndexOutOfBoundsException);
+        return;
+    }
+
+    count = this->count;
+    newCount = count + length;
+    if (newCount > (long)this->array->length) {
+        START_TEMPORARY_ROOTS
+            DECLARE_TEMPORARY_ROOT(SHORTARRAY, charsX, chars);
+            DECLARE_TEMPORARY_ROOT(STRINGBUFFER_INSTANCE, thisX, this);
+            expandStringBufferCapacity(&thisX, newCount);
+            chars = charsX;
+            this = thisX;
+        END_TEMPORARY_ROOTS
+    }
+    if (newCount <= (long)this->array->length) {
+        memcpy(&this->array->sdata[count], &chars->sdata[offset],
+               length * sizeof(short));
+        this->count = newCount;
+        pushStackAsType(STRINGBUFFER_INSTANCE, this);
+    } else {
+        /* We will have gotten an OutOfMemoryException from the
+         * expandStringBufferCapacity
+         */
+    }
+}
+
+void Java_java_lang_StringBuffer_append___3C(void) {
+    SHORTARRAY chars = popStackAsType(SHORTARRAY);
+    STRINGBUFFER_INSTANCE this = popStackAsType(STRINGBUFFER_INSTANCE);
+    appendCharArray(this, chars, 0, chars == NULL ? 0 : chars->length);
+}
+
+void Java_java_lang_StringBuffer_append___3CII(void) {
+    long length = popStack();
+    long offset = popStack();
+    SHORTARRAY chars = popStackAsType(SHORTARRAY);
+    STRINGBUFFER_INSTANCE this = popStackAsType(STRINGBUFFER_INSTANCE);
+    appendCharArray(this, chars, offset, length);
+}
+
+/*=========================================================================
+ * FUNCTION:      insert(IC), insert(ILjava/lang/String;)
+ * CLASS:         java.lang.StringBuffer
+ * TYPE:          virtual native function
+ * OVERVIEW:      inserts a character or a String into a string buffer
+ *   parameters:  this
+ *                offset
+ *                char or String
+ *   returns:     the "this" argument
+ *==================================================================== */
+
+/* Open a gap of length characters at offset, which has already been
+ * checked.  Unlike appending, this moves characters that a String may
+ * be sharing, so a shared array is copied first.  This may GC.  Returns
+ * the string buffer, or NULL if we ran out of memory.
+ */
+static STRINGBUFFER_INSTANCE
+openStringBufferGap(STRINGBUFFER_HANDLE sbH, long offset, long length) {
+    STRINGBUFFER_INSTANCE sb = unhand(sbH);
+    long count = sb->count;
+    long newCount = count + length;
+
+    if (newCount > (long)sb->array->length) {
+        expandStringBufferCapacity(sbH, newCount);
+    } else if (sb->shared) {
+        reallocateStringBuffer(sbH, sb->array->length);
+    }
+    sb = unhand(sbH);
+    if (newCount > (long)sb->array->length || sb->shared) {
+        return NULL;
+    }
+    memmove(&sb->array->sdata[offset + length], &sb->array->sdata[offset],
+            (count - offset) * sizeof(short));
+    sb->count = newCount;
+    return sb;
+}
+
+void Java_java_lang_StringBuffer_insert__IC(void) {
+    short c = (short)popStack();
+    long offset = popStack();
+    STRINGBUFFER_INSTANCE this = popStackAsType(STRINGBUFFER_INSTANCE);
+
+    if (offset < 0 || offset > this->count) {
+        raiseException("java/lang/StringIndexOutOfBoundsException");
+        return;
+    }
+    START_TEMPORARY_ROOTS
+        DECLARE_TEMPORARY_ROOT(STRINGBUFFER_INSTANCE, thisX, this);
+        this = openStringBufferGap(&thisX, offset, 1);
+    END_TEMPORARY_ROOTS
+    if (this != NULL) {
+        this->array->sdata[offset] = c;
+        pushStackAsType(STRINGBUFFER_INSTANCE, this);
+    }
+}
+
+void Java_java_lang_StringBuffer_insert__ILjava_lang_String_2(void) {
+    STRING_INSTANCE string = popStackAsType(STRING_INSTANCE);
+    long offset = popStack();
+    STRINGBUFFER_INSTANCE this = popStackAsType(STRINGBUFFER_INSTANCE);
+
+    if (offset < 0 || offset > this->count) {
+        raiseException("java/lang/StringIndexOutOfBoundsException");
+        return;
+    }
+    START_TEMPORARY_ROOTS
+        DECLARE_TEMPORARY_ROOT(STRING_INSTANCE, stringX, string);
+        DECLARE_TEMPORARY_ROOT(STRINGBUFFER_INSTANCE, thisX, this);
+        if (stringX == NULL) {
+            stringX = (STRING_INSTANCE)internString("null", 4);
+        }
+        /* The String may share the array of this buffer, but then the
+         * gap is opened in a copy and the String keeps the original.
+         */
+        this = openStringBufferGap(&thisX, offset, stringX->length);
+        string = stringX;
+    END_TEMPORARY_ROOTS
+    if (this != NULL) {
+        memcpy(&this->array->sdata[offset],
+               &string->array->sdata[string->offset],
+               string->length * sizeof(short));
+        pushStackAsType(STRINGBUFFER_INSTANCE, this);
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      setLength(I)
+ * CLASS:         java.lang.StringBuffer
+ * TYPE:          virtual native function
+ * OVERVIEW:      truncates a string buffer or pads it with null characters
+ *   parameters:  this
+ *                int
+ *   returns:     nothing
+ *==================================================================== */
+
+void Java_java_lang_StringBuffer_setLength(void) {
+    long newLength = popStack();
+    STRINGBUFFER_INSTANCE this = popStackAsType(STRINGBUFFER_INSTANCE);
+    long count = this->count;
+
+    if (newLength < 0) {
+        raiseException("java/lang/StringIndexOutOfBoundsException");
+        return;
+    }
+    START_TEMPORARY_ROOTS
+        DECLARE_TEMPORARY_ROOT(STRINGBUFFER_INSTANCE, thisX, this);
+        if (newLength > (long)thisX->array->length) {
+            expandStringBufferCapacity(&thisX, newLength);
+        } else if (newLength < count && thisX->shared) {
+            /* Later appends would overwrite characters of the String that
+             * shares the array.  If the buffer is being emptied for reuse,
+             * give it a fresh array of the default size.
+             */
+            thisX->count = newLength;
+            reallocateStringBuffer(&thisX, newLength == 0
+                                           ? 16 : thisX->array->length);
+            if (thisX->shared) {
+                thisX->count = count;
+            }
+        }
+        this = thisX;
+    END_TEMPORARY_ROOTS
+    if (newLength <= (long)this->array->length
+            && (newLength >= count || !this->shared)) {
+        if (count < newLength) {
+            memset(&this->array->sdata[count], 0,
+                   (newLength - count) * sizeof(short));
+        }
+        this->count = newLength;
+    } else {
+        /* We will have gotten an OutOfMemoryException from the
+         * expandStringBufferCapacity or reallocateStringBuffer
+         */
+    }
+}
+
+/* Grow the array of a string buffer to at least newLength characters,
+ * at least doubling it, as expandCapacity() does, so that a sequence of
+ * appends takes amortized constant time per character.
+ */
 static void expandStringBufferCapacity(STRINGBUFFER_HANDLE sbH, int newLength)
 {
-    STRINGBUFFER_INSTANCE sb = unhand(sbH);
-    long oldLength = sb->array->length;
-    SHORTARRAY newArray;
+    long doubledLength = (unhand(sbH)->array->length + 1) * 2;
 
-    if (newLength < oldLength * 2) {
-        newLength = oldLength * 2;
+    if (newLength < doubledLength) {
+        newLength = doubledLength;
     }
-    newArray =
-        (SHORTARRAY)instantiateArray(PrimitiveArrayClasses[T_CHAR], newLength);
+    reallocateStringBuffer(sbH, newLength);
+}
+
+/* Give a string buffer a private array of the given length, holding
+ * its first count characters.  Leaves the buffer alone if we run out of
+ * memory.
+ */
+static void reallocateStringBuffer(STRINGBUFFER_HANDLE sbH, int length)
+{
+    STRINGBUFFER_INSTANCE sb;
+    SHORTARRAY newArray =
+        (SHORTARRAY)instantiateArray(PrimitiveArrayClasses[T_CHAR], length);
 
     if (newArray != NULL) {
         sb = unhand(sbH);           /* in case of GC */
@@ -1285,3 +1909,315 @@ static void expandStringBufferCapacity(STRINGBUFFER_HANDLE sbH, int newLength)
         sb->shared = FALSE;
     }
 }
+
+/*=========================================================================
+ * Native functions of class java.util.Hashtable
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      probe
+ * CLASS:         java.util.Hashtable (open addressing version)
+ * TYPE:          static native function
+ * OVERVIEW:      Find the slot of a String or Integer key by linear
+ *                probing.  Stored keys of the same class as the key
+ *                are compared as String.equals or Integer.equals would
+ *                compare them.  A stored key of another class with
+ *                the same hash code makes the probe give up, since
+ *                only that key's equals method can decide.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  keys, hashes: the key and hash code arrays
+ *                key: a String or Integer
+ *                hash: the hash code of key
+ *                deleted: the marker of removed slots
+ *   returns:     the index of the slot of the key; if the key isn't
+ *                in the table, -1 - the index of the first free slot
+ *                on its probe path; 0x80000000 if the probe gave up
+ *====================================================================*/
+
+void Java_java_util_Hashtable_probe(void)
+{
+    OBJECT deleted = popStackAsType(OBJECT);
+    long hash = popStack();
+    OBJECT key = popStackAsType(OBJECT);
+    ARRAY hashes = popStackAsType(ARRAY);
+    ARRAY keys = popStackAsType(ARRAY);
+    long length = keys->length;
+    long index = (unsigned long)(hash & 0x7FFFFFFF) % length;
+    long free = -1;
+    long result;
+    OBJECT k;
+
+    for (;;) {
+        k = (OBJECT)keys->data[index].cellp;
+        if (k == NULL) {
+            result = -1 - ((free >= 0) ? free : index);
+            break;
+        }
+        if (k == deleted) {
+            if (free < 0) {
+                free = index;
+            }
+        } else if ((long)hashes->data[index].cell == hash) {
+            if (k == key) {
+                result = index;
+                break;
+            }
+            if (k->ofClass != key->ofClass) {
+                result = 0x80000000;
+                break;
+            }
+            if (key->ofClass == (CLASS)JavaLangString) {
+                STRING_INSTANCE s1 = (STRING_INSTANCE)k;
+                STRING_INSTANCE s2 = (STRING_INSTANCE)key;
+                long count = s1->length;
+                if (count == (long)s2->length &&
+                    firstMismatch(STRING_CHARS(s1), STRING_CHARS(s2),
+                                  count) == count) {
+                    result = index;
+                    break;
+                }
+            } else if (((INSTANCE)k)->data[0].cell ==
+                       ((INSTANCE)key)->data[0].cell) {
+                /* java.lang.Integer: the only field is the value */
+                result = index;
+                break;
+            }
+        }
+        if (++index == length) {
+            index = 0;
+        }
+    }
+    pushStack(result);
+}
+
+/*=========================================================================
+ * Native functions for UTF-8 conversion in com.sun.cldc.i18n.j2me,
+ * java.io.DataInputStream and com.sun.cldc.io.GeneralBase.  They use
+ * the bulk converters in hashtable.c.
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      decodeReplacing
+ * TYPE:          helper function
+ * OVERVIEW:      Decode standard UTF-8 as a reader does: each byte of
+ *                an invalid sequence becomes U+FFFD, and so does each
+ *                byte of a character cut off by the end of the input.
+ *                A character cut off by the end of the bytes at hand
+ *                is left for later unless endOfInput is set.
+ * INTERFACE
+ *   parameters:  src, srcEnd, dst, dstEnd: as for decodeUTF8
+ *                endOfInput: TRUE if no more bytes will follow
+ *   returns:     nothing
+ *====================================================================*/
+
+static void
+decodeReplacing(const unsigned char **src, const unsigned char *srcEnd,
+                unsigned short **dst, unsigned short *dstEnd,
+                bool_t endOfInput)
+{
+    while (*dst < dstEnd) {
+        int status = decodeUTF8(src, srcEnd, dst, dstEnd, FALSE);
+        if (status == UTF8_DONE ||
+                (status == UTF8_TRUNCATED && !endOfInput) ||
+                *dst == dstEnd) {
+            break;
+        }
+        *(*dst)++ = 0xFFFD;
+        (*src)++;
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      decode(B[IIC[IIZ)J
+ * CLASS:         com.sun.cldc.i18n.j2me.UTF_8_Reader
+ * TYPE:          static native function
+ * OVERVIEW:      Decode bytes into characters.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  src, srcOff, srcEnd: the bytes
+ *                dst, dstOff, dstEnd: the room for the characters
+ *                endOfInput: true if no more bytes will follow
+ *   returns:     the index after the last byte used in the high word,
+ *                and the index after the last character written in
+ *                the low word
+ *====================================================================*/
+
+void Java_com_sun_cldc_i18n_j2me_UTF_18_1Reader_decode(void)
+{
+    bool_t endOfInput = popStack();
+    long dstEnd = popStack();
+    long dstOff = popStack();
+    SHORTARRAY dstArray = popStackAsType(SHORTARRAY);
+    long srcEnd = popStack();
+    long srcOff = popStack();
+    BYTEARRAY srcArray = popStackAsType(BYTEARRAY);
+    const unsigned char *srcBase = (const unsigned char *)srcArray->bdata;
+    unsigned short *dstBase = (unsigned short *)dstArray->sdata;
+    const unsigned char *src = srcBase + srcOff;
+    unsigned short *dst = dstBase + dstOff;
+    long64 result;
+
+    decodeReplacing(&src, srcBase + srcEnd, &dst, dstBase + dstEnd,
+                    endOfInput);
+#if COMPILER_SUPPORTS_LONG
+    result = (((ulong64)(src - srcBase)) << 32) + (unsigned)(dst - dstBase);
+#else
+    result.high = src - srcBase;
+    result.low = dst - dstBase;
+#endif /* COMPILER_SUPPORTS_LONG */
+    pushLong(result);
+}
+
+/*=========================================================================
+ * FUNCTION:      charCount(B[II)I
+ * CLASS:         com.sun.cldc.i18n.j2me.UTF_8_Reader
+ * TYPE:          static native function
+ * OVERVIEW:      Count the characters decode makes of all of a
+ *                sequence of bytes.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  src, offset, length: the bytes
+ *   returns:     the number of characters
+ *====================================================================*/
+
+void Java_com_sun_cldc_i18n_j2me_UTF_18_1Reader_charCount(void)
+{
+    long length = popStack();
+    long offset = popStack();
+    BYTEARRAY srcArray = popStackAsType(BYTEARRAY);
+    const unsigned char *src = (const unsigned char *)srcArray->bdata + offset;
+    const unsigned char *srcEnd = src + length;
+    unsigned short buffer[256];
+    long count = 0;
+
+    while (src < srcEnd) {
+        unsigned short *dst = buffer;
+        decodeReplacing(&src, srcEnd, &dst, buffer + 256, TRUE);
+        count += dst - buffer;
+    }
+    pushStack(count);
+}
+
+/*=========================================================================
+ * FUNCTION:      encode(C[IIB[II)J
+ * CLASS:         com.sun.cldc.i18n.j2me.UTF_8_Writer
+ * TYPE:          static native function
+ * OVERVIEW:      Encode characters into bytes.  Stops before a high
+ *                surrogate that ends the characters.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  src, srcOff, srcEnd: the characters
+ *                dst, dstOff, dstEnd: the room for the bytes
+ *   returns:     the index after the last character used in the high
+ *                word, and the index after the last byte written in
+ *                the low word
+ *====================================================================*/
+
+void Java_com_sun_cldc_i18n_j2me_UTF_18_1Writer_encode(void)
+{
+    long dstEnd = popStack();
+    long dstOff = popStack();
+    BYTEARRAY dstArray = popStackAsType(BYTEARRAY);
+    long srcEnd = popStack();
+    long srcOff = popStack();
+    SHORTARRAY srcArray = popStackAsType(SHORTARRAY);
+    const unsigned short *srcBase = (const unsigned short *)srcArray->sdata;
+    unsigned char *dstBase = (unsigned char *)dstArray->bdata;
+    const unsigned short *src = srcBase + srcOff;
+    unsigned char *dst = dstBase + dstOff;
+    long64 result;
+
+    encodeUTF8(&src, srcBase + srcEnd, &dst, dstBase + dstEnd, FALSE);
+#if COMPILER_SUPPORTS_LONG
+    result = (((ulong64)(src - srcBase)) << 32) + (unsigned)(dst - dstBase);
+#else
+    result.high = src - srcBase;
+    result.low = dst - dstBase;
+#endif /* COMPILER_SUPPORTS_LONG */
+    pushLong(result);
+}
+
+/*=========================================================================
+ * FUNCTION:      byteCount(C[II)I
+ * CLASS:         com.sun.cldc.i18n.j2me.UTF_8_Writer
+ * TYPE:          static native function
+ * OVERVIEW:      Count the bytes that encoding characters takes.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  src, offset, length: the characters
+ *   returns:     the number of bytes
+ *====================================================================*/
+
+void Java_com_sun_cldc_i18n_j2me_UTF_18_1Writer_byteCount(void)
+{
+    long length = popStack();
+    long offset = popStack();
+    SHORTARRAY srcArray = popStackAsType(SHORTARRAY);
+
+    pushStack(utf8Length((unsigned short *)srcArray->sdata + offset,
+                         length, FALSE));
+}
+
+/*=========================================================================
+ * FUNCTION:      decodeUTF([BI[C)I
+ * CLASS:         java.io.DataInputStream
+ * TYPE:          static native function
+ * OVERVIEW:      Decode the modified UTF-8 read by readUTF.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  src, length: the bytes
+ *                dst: room for at least length characters
+ *   returns:     the number of characters, or throws
+ *                UTFDataFormatException if the bytes are invalid
+ *====================================================================*/
+
+void Java_java_io_DataInputStream_decodeUTF(void)
+{
+    SHORTARRAY dstArray = popStackAsType(SHORTARRAY);
+    long length = popStack();
+    BYTEARRAY srcArray = popStackAsType(BYTEARRAY);
+    const unsigned char *src = (const unsigned char *)srcArray->bdata;
+    unsigned short *dst = (unsigned short *)dstArray->sdata;
+
+    if (decodeUTF8(&src, src + length, &dst, dst + length, TRUE)
+            != UTF8_DONE) {
+        raiseException("java/io/UTFDataFormatException");
+    } else {
+        pushStack(dst - (unsigned short *)dstArray->sdata);
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      utfLength(Ljava/lang/String;)I
+ * CLASS:         com.sun.cldc.io.GeneralBase
+ * TYPE:          static native function
+ * OVERVIEW:      Count the bytes writeUTF takes for a string.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  str: the string
+ *   returns:     the number of bytes, not counting the length
+ *====================================================================*/
+
+void Java_com_sun_cldc_io_GeneralBase_utfLength(void)
+{
+    STRING_INSTANCE str = popStackAsType(STRING_INSTANCE);
+    pushStack(utf8Length(STRING_CHARS(str), str->length, TRUE));
+}
+
+/*=========================================================================
+ * FUNCTION:      encodeUTF(Ljava/lang/String;[BI)V
+ * CLASS:         com.sun.cldc.io.GeneralBase
+ * TYPE:          static native function
+ * OVERVIEW:      Encode a string in modified UTF-8 for writeUTF.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  str: the string
+ *                dst, offset: room for utfLength(str) bytes
+ *   returns:     nothing
+ *====================================================================*/
+
+void Java_com_sun_cldc_io_GeneralBase_encodeUTF(void)
+{
+    long offset = popStack();
+    BYTEARRAY dstArray = popStackAsType(BYTEARRAY);
+    STRING_INSTANCE str = popStackAsType(STRING_INSTANCE);
+    const unsigned short *src = STRING_CHARS(str);
+    unsigned char *dst = (unsigned char *)dstArray->bdata + offset;
+
+    encodeUTF8(&src, src + str->length,
+               &dst, (unsigned char *)dstArray->bdata + dstArray->length,
+               TRUE);
+}
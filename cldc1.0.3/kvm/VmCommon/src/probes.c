@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      probes.c
+ * OVERVIEW:  Statically defined tracing probes (see probes.h).  The
+ *            probe sites and their semaphores are placed in the ELF
+ *            notes and in the ".probes" section by <sys/sdt.h>, where
+ *            perf, bpftrace and SystemTap find them; no tool or
+ *            generated file is needed at build time.  The probes are
+ *            fired from here rather than from the call sites, so that
+ *            the interpreter loop only carries the semaphore tests.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if ENABLE_USDT_PROBES
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+/*=========================================================================
+ * Probe semaphores
+ *=======================================================================*/
+
+/* A tracing tool increments the semaphore of a probe when it attaches */
+/* to it, and decrements it when it detaches */
+#define PROBE_SEMAPHORE(name) \
+    unsigned short kvm_##name##_semaphore __attribute__((section(".probes")))
+
+PROBE_SEMAPHORE(method__entry);
+PROBE_SEMAPHORE(method__return);
+PROBE_SEMAPHORE(class__loaded);
+PROBE_SEMAPHORE(gc__begin);
+PROBE_SEMAPHORE(gc__end);
+PROBE_SEMAPHORE(monitor__contended__enter);
+PROBE_SEMAPHORE(exception__throw);
+
+/*=========================================================================
+ * Static functions (private to this file)
+ *=======================================================================*/
+
+/* The strings passed to a probe only have to live until it returns.
+ * Isolates fire probes concurrently, so each has its own buffers. */
+static ISOLATE_LOCAL char probeClassName[STRINGBUFFERSIZE];
+static ISOLATE_LOCAL char probeSignature[STRINGBUFFERSIZE];
+
+static int getProbeClassName(CLASS clazz)
+{
+    return getClassName_inBuffer(clazz, probeClassName) - probeClassName;
+}
+
+static int getProbeSignature(METHOD thisMethod)
+{
+    change_Key_to_MethodSignature_inBuffer(
+        thisMethod->nameTypeKey.nt.typeKey, probeSignature);
+    return strlen(probeSignature);
+}
+
+/*=========================================================================
+ * Probe operations
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      probeMethodEntry, probeMethodReturn
+ * TYPE:          profiling
+ * OVERVIEW:      Fire the method__entry or method__return probe.
+ * INTERFACE:
+ *   parameters:  the method being entered or left
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void probeMethodEntry(METHOD thisMethod)
+{
+    int classLength = getProbeClassName((CLASS)thisMethod->ofClass);
+    int nameLength;
+    char* name = change_Key_to_Name(thisMethod->nameTypeKey.nt.nameKey,
+                                    &nameLength);
+    int signatureLength = getProbeSignature(thisMethod);
+
+    STAP_PROBE7(kvm, method__entry, CurrentThread,
+                probeClassName, classLength, name, nameLength,
+                probeSignature, signatureLength);
+}
+
+void probeMethodReturn(METHOD thisMethod)
+{
+    int classLength = getProbeClassName((CLASS)thisMethod->ofClass);
+    int nameLength;
+    char* name = change_Key_to_Name(thisMethod->nameTypeKey.nt.nameKey,
+                                    &nameLength);
+    int signatureLength = getProbeSignature(thisMethod);
+
+    STAP_PROBE7(kvm, method__return, CurrentThread,
+                probeClassName, classLength, name, nameLength,
+                probeSignature, signatureLength);
+}
+
+/*=========================================================================
+ * FUNCTION:      probeClassLoaded
+ * TYPE:          profiling
+ * OVERVIEW:      Fire the class__loaded probe.
+ * INTERFACE:
+ *   parameters:  the class that has just been loaded
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void probeClassLoaded(CLASS clazz)
+{
+    int classLength = getProbeClassName(clazz);
+
+    STAP_PROBE2(kvm, class__loaded, probeClassName, classLength);
+}
+
+/*=========================================================================
+ * FUNCTION:      probeGCBegin, probeGCEnd
+ * TYPE:          profiling
+ * OVERVIEW:      Fire the gc__begin or gc__end probe.
+ * INTERFACE:
+ *   parameters:  the bytes the collection was asked for, and the
+ *                free bytes in the heap
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void probeGCBegin(long requestedBytes, long freeBytes)
+{
+    STAP_PROBE2(kvm, gc__begin, requestedBytes, freeBytes);
+}
+
+void probeGCEnd(long freeBytes)
+{
+    STAP_PROBE1(kvm, gc__end, freeBytes);
+}
+
+/*=========================================================================
+ * FUNCTION:      probeMonitorContended
+ * TYPE:          profiling
+ * OVERVIEW:      Fire the monitor__contended__enter probe.  Called when
+ *                the current thread has to wait for the monitor of an
+ *                object that another thread owns.
+ * INTERFACE:
+ *   parameters:  the object
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void probeMonitorContended(OBJECT object)
+{
+    int classLength = getProbeClassName(object->ofClass);
+
+    STAP_PROBE4(kvm, monitor__contended__enter, CurrentThread, object,
+                probeClassName, classLength);
+}
+
+/*=========================================================================
+ * FUNCTION:      probeExceptionThrow
+ * TYPE:          profiling
+ * OVERVIEW:      Fire the exception__throw probe.
+ * INTERFACE:
+ *   parameters:  the exception being thrown
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void probeExceptionThrow(THROWABLE_INSTANCE exception)
+{
+    int classLength = getProbeClassName((CLASS)exception->ofClass);
+
+    STAP_PROBE3(kvm, exception__throw, CurrentThread,
+                probeClassName, classLength);
+}
+
+#endif /* ENABLE_USDT_PROBES */
+
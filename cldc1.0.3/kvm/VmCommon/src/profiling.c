@@ -42,26 +42,29 @@
 
 #if ENABLEPROFILING
 
-int InstructionCounter;         /* Number of bytecodes executed */
-int ThreadSwitchCounter;        /* Number of thread switches */
+ISOLATE_LOCAL int InstructionCounter;         /* Number of bytecodes executed */
+ISOLATE_LOCAL int ThreadSwitchCounter;        /* Number of thread switches */
 
-int DynamicObjectCounter;       /* Number of dynamic objects allocated */
-int DynamicAllocationCounter;   /* Bytes of dynamic memory allocated */
-int DynamicDeallocationCounter; /* Bytes of dynamic memory deallocated */
-int GarbageCollectionCounter;   /* Number of garbage collections done */
-int TotalGCDeferrals;           /* Total number of GC objects deferred */
-int MaximumGCDeferrals;         /* Maximum number of GC objects deferred */
-int GarbageCollectionRescans;   /* Number of extra scans of GC heap */
+ISOLATE_LOCAL int DynamicObjectCounter;       /* Number of dynamic objects allocated */
+ISOLATE_LOCAL int DynamicAllocationCounter;   /* Bytes of dynamic memory allocated */
+ISOLATE_LOCAL int DynamicDeallocationCounter; /* Bytes of dynamic memory deallocated */
+ISOLATE_LOCAL int GarbageCollectionCounter;   /* Number of garbage collections done */
+ISOLATE_LOCAL int TotalGCDeferrals;           /* Total number of GC objects deferred */
+ISOLATE_LOCAL int MaximumGCDeferrals;         /* Maximum number of GC objects deferred */
+ISOLATE_LOCAL int GarbageCollectionRescans;   /* Number of extra scans of GC heap */
+
+ISOLATE_LOCAL int MonitorInflationCounter;    /* Number of real monitors attached */
+ISOLATE_LOCAL int MonitorDeflationCounter;    /* Number of real monitors detached */
 
 #if ENABLEFASTBYTECODES
-int InlineCacheHitCounter;      /* Number of inline cache hits */
-int InlineCacheMissCounter;     /* Number of inline cache misses */
-int MaxStackCounter;            /* Maximum amount of stack space needed */
+ISOLATE_LOCAL int InlineCacheHitCounter;      /* Number of inline cache hits */
+ISOLATE_LOCAL int InlineCacheMissCounter;     /* Number of inline cache misses */
+ISOLATE_LOCAL int MaxStackCounter;            /* Maximum amount of stack space needed */
 #endif
 
 #if USESTATIC
-int StaticObjectCounter;        /* Number of static objects allocated */
-int StaticAllocationCounter;    /* Bytes of static memory allocated */
+ISOLATE_LOCAL int StaticObjectCounter;        /* Number of static objects allocated */
+ISOLATE_LOCAL int StaticAllocationCounter;    /* Bytes of static memory allocated */
 #endif
 
 /*=========================================================================
@@ -91,6 +94,9 @@ void InitializeProfiling()
     MaximumGCDeferrals         = 0;
     GarbageCollectionRescans   = 0;
 
+    MonitorInflationCounter    = 0;
+    MonitorDeflationCounter    = 0;
+
 #if ENABLEFASTBYTECODES
     InlineCacheHitCounter      = 0;
     InlineCacheMissCounter     = 0;
@@ -130,6 +136,8 @@ void printProfileInfo()
             (long)GarbageCollectionCounter);
     fprintf(stdout, "(%ld bytes collected)\n",
             (long)DynamicDeallocationCounter);
+    fprintf(stdout, "%ld monitors inflated, %ld deflated\n",
+            (long)MonitorInflationCounter, (long)MonitorDeflationCounter);
 
 /* This info is too detailed for most users:
     fprintf(stdout, "%ld objects deferred in GC\n", (long)TotalGCDeferrals);
@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      recorder.c
+ * OVERVIEW:  Flight recorder (see recorder.h).  Every VM has its
+ *            own ring buffer, allocated when the VM starts with
+ *            recording switched on.  Recording an event only fills
+ *            in one fixed size slot of the ring.
+ *
+ *            A dump file has a header followed by a sequence of
+ *            records, oldest event first.  All numbers are big-endian:
+ *
+ *              header:  u1 magic[4] = "KVMR"
+ *                       u2 version = 1
+ *                       u4 number of events in the file
+ *                       u4 number of older events that were lost
+ *                       u8 wall clock time (ms since the epoch) at
+ *                          which recording started
+ *              name:    u1 0
+ *                       u4 id (> 0)
+ *                       u2 length, followed by the name in UTF-8
+ *              event:   u1 type (enum recordedEventType)
+ *                       u2 thread (0 if none)
+ *                       u8 time (us since recording started)
+ *                       u4 duration (us)
+ *                       u4 value1, u4 value2
+ *
+ *            Event values that are classes or methods are written as
+ *            the id of a name record that comes before the event.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if ENABLE_FLIGHT_RECORDER
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+#define FR_MAGIC     "KVMR"
+#define FR_VERSION   1
+#define FR_NAME      0
+
+typedef struct recordedEventStruct* RECORDEDEVENT;
+
+struct recordedEventStruct {
+    ulong64        time;      /* Microseconds since recording started */
+    long           duration;  /* Microseconds, 0 for instant events */
+    long           value1;
+    long           value2;
+    unsigned short thread;
+    unsigned char  type;
+};
+
+/* What the values of each event type are */
+#define FR_NUMBER    0
+#define FR_CLASS     1
+#define FR_METHOD    2
+
+static const unsigned char valueKinds[FR_LAST_EVENT_TYPE + 1][2] = {
+    { FR_NUMBER, FR_NUMBER },   /* unused */
+    { FR_NUMBER, FR_NUMBER },   /* FR_GC_BEGIN */
+    { FR_NUMBER, FR_NUMBER },   /* FR_GC_END */
+    { FR_CLASS,  FR_NUMBER },   /* FR_CLASS_LOAD */
+    { FR_CLASS,  FR_NUMBER },   /* FR_MONITOR_CONTENDED */
+    { FR_NUMBER, FR_NUMBER },   /* FR_THREAD_SWITCH */
+    { FR_CLASS,  FR_METHOD },   /* FR_EXCEPTION_THROWN */
+    { FR_CLASS,  FR_METHOD },   /* FR_EXCEPTION_CAUGHT */
+    { FR_CLASS,  FR_CLASS  },   /* FR_PERMIT_VERIFIED */
+    { FR_NUMBER, FR_NUMBER }    /* FR_SOCKET_WAIT */
+};
+
+/*=========================================================================
+ * Flight recorder variables
+ *=======================================================================*/
+
+char* FlightRecorderFile = NULL;
+long  FlightRecorderSize = FLIGHT_RECORDER_EVENTS;
+
+ISOLATE_LOCAL bool_t FlightRecorderEnabled = FALSE;
+ISOLATE_LOCAL long   FlightRecorderThreadCount;
+
+volatile int FlightRecorderDumpRequests = 0;
+
+static ISOLATE_LOCAL RECORDEDEVENT RecordedEvents;
+static ISOLATE_LOCAL long          RecordedEventNext;  /* Next slot */
+static ISOLATE_LOCAL unsigned long RecordedEventTotal; /* All events */
+static ISOLATE_LOCAL ulong64       RecorderStartTime;
+static ISOLATE_LOCAL ulong64       RecorderStartMillis;
+static ISOLATE_LOCAL long          LastSwitchedThread;
+static ISOLATE_LOCAL int           DumpRequestsHandled;
+static ISOLATE_LOCAL char*         DumpFileName;
+
+/*=========================================================================
+ * Flight recorder operations
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      InitializeFlightRecorder
+ * TYPE:          Profiling
+ * OVERVIEW:      Allocate the event ring buffer and start recording,
+ *                if recording was asked for on the command line.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void InitializeFlightRecorder(void)
+{
+    FlightRecorderEnabled = FALSE;
+    FlightRecorderThreadCount = 0;
+    if (FlightRecorderFile == NULL || FlightRecorderSize <= 0) {
+        return;
+    }
+
+#if MULTIPLE_ISOLATES
+    DumpFileName = isolateFileName(FlightRecorderFile);
+    if (DumpFileName == NULL) {
+        return;
+    }
+#else
+    DumpFileName = FlightRecorderFile;
+#endif /* MULTIPLE_ISOLATES */
+
+    RecordedEvents = (RECORDEDEVENT)
+        malloc(FlightRecorderSize * sizeof(struct recordedEventStruct));
+    if (RecordedEvents == NULL) {
+        fprintf(stderr, "Not enough memory for the flight recorder\n");
+        return;
+    }
+    RecordedEventNext = 0;
+    RecordedEventTotal = 0;
+    LastSwitchedThread = 0;
+    DumpRequestsHandled = FlightRecorderDumpRequests;
+    RecorderStartTime = MonotonicTime_md();
+    RecorderStartMillis = CurrentTime_md();
+    FlightRecorderEnabled = TRUE;
+}
+
+/*=========================================================================
+ * FUNCTION:      FinalizeFlightRecorder
+ * TYPE:          Profiling
+ * OVERVIEW:      Dump the recorded events and stop recording.  Must
+ *                be called while the classes are still loaded.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void FinalizeFlightRecorder(void)
+{
+    if (!FlightRecorderEnabled) {
+        return;
+    }
+    dumpFlightRecorder(DumpFileName);
+    FlightRecorderEnabled = FALSE;
+    free(RecordedEvents);
+    RecordedEvents = NULL;
+#if MULTIPLE_ISOLATES
+    free(DumpFileName);
+#endif
+    DumpFileName = NULL;
+}
+
+/*=========================================================================
+ * FUNCTION:      recordEvent
+ * TYPE:          Profiling
+ * OVERVIEW:      Store an event in the ring buffer, overwriting the
+ *                oldest event if the buffer is full.  Use the
+ *                RECORD_xxx macros in recorder.h rather than calling
+ *                this function directly.
+ * INTERFACE:
+ *   parameters:  thread: the thread the event happened in, or NULL
+ *                type: the event type
+ *                start: RECORDER_START_TIME() at the start of the
+ *                       event, or 0 if the event has no duration
+ *                value1, value2: event values (see recorder.h)
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void recordEvent(THREAD thread, int type, ulong64 start,
+                 long value1, long value2)
+{
+    ulong64 now = MonotonicTime_md();
+    RECORDEDEVENT event;
+
+    /* Socket waits may be recorded from I/O threads */
+    START_CRITICAL_SECTION
+        event = &RecordedEvents[RecordedEventNext];
+        if (++RecordedEventNext == FlightRecorderSize) {
+            RecordedEventNext = 0;
+        }
+        RecordedEventTotal++;
+        event->time = now - RecorderStartTime;
+        event->duration = (start == 0) ? 0 : (long)(now - start);
+        event->value1 = value1;
+        event->value2 = value2;
+        event->thread = (unsigned short)recorderThreadId(thread);
+        event->type = (unsigned char)type;
+    END_CRITICAL_SECTION
+}
+
+/*=========================================================================
+ * FUNCTION:      recordThreadSwitch
+ * TYPE:          Profiling
+ * OVERVIEW:      Record that the given thread was switched in.
+ * INTERFACE:
+ *   parameters:  the new current thread
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void recordThreadSwitch(THREAD thread)
+{
+    long id = recorderThreadId(thread);
+    recordEvent(thread, FR_THREAD_SWITCH, 0, LastSwitchedThread, id);
+    LastSwitchedThread = id;
+}
+
+/*=========================================================================
+ * FUNCTION:      checkFlightRecorderDump
+ * TYPE:          Profiling
+ * OVERVIEW:      Dump the recorded events if a dump was requested
+ *                since the last check.  Called from the event loop.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void checkFlightRecorderDump(void)
+{
+    int requests = FlightRecorderDumpRequests;
+    if (FlightRecorderEnabled && requests != DumpRequestsHandled) {
+        DumpRequestsHandled = requests;
+        dumpFlightRecorder(DumpFileName);
+    }
+}
+
+/*=========================================================================
+ * Dumping
+ *=======================================================================*/
+
+static void putU1(FILE* file, unsigned long value)
+{
+    putc((int)(value & 0xFF), file);
+}
+
+static void putU2(FILE* file, unsigned long value)
+{
+    putU1(file, value >> 8);
+    putU1(file, value);
+}
+
+static void putU4(FILE* file, unsigned long value)
+{
+    putU2(file, value >> 16);
+    putU2(file, value);
+}
+
+static void putU8(FILE* file, ulong64 value)
+{
+    putU4(file, (unsigned long)(value >> 32));
+    putU4(file, (unsigned long)value);
+}
+
+/*
+ * Write the name of a class or method, e.g. "java.lang.Object.wait"
+ */
+static void putName(FILE* file, long id, void* pointer, int kind)
+{
+    char* name = str_buffer;
+    char* end;
+    char* p;
+
+    if (kind == FR_METHOD) {
+        METHOD thisMethod = (METHOD)pointer;
+        end = getClassName_inBuffer((CLASS)thisMethod->ofClass, name);
+        sprintf(end, ".%.200s", methodName(thisMethod));
+    } else {
+        end = getClassName_inBuffer((CLASS)pointer, name);
+    }
+    for (p = name; p < end; p++) {
+        if (*p == '/') {
+            *p = '.';
+        }
+    }
+    putU1(file, FR_NAME);
+    putU4(file, id);
+    putU2(file, strlen(name));
+    fputs(name, file);
+}
+
+/*
+ * Map a class or method to the id of its name record, writing the
+ * record the first time.  "names" is an open addressing hash table
+ * of "size" (a power of two) entries.
+ */
+static long nameId(FILE* file, void** names, long* ids, long size,
+                   long* lastId, void* pointer, int kind)
+{
+    long index = ((unsigned long)pointer >> 2) & (size - 1);
+
+    if (pointer == NULL) {
+        return 0;
+    }
+    while (names[index] != NULL) {
+        if (names[index] == pointer) {
+            return ids[index];
+        }
+        index = (index + 1) & (size - 1);
+    }
+    names[index] = pointer;
+    ids[index] = ++*lastId;
+    putName(file, ids[index], pointer, kind);
+    return ids[index];
+}
+
+/*=========================================================================
+ * FUNCTION:      dumpFlightRecorder
+ * TYPE:          Profiling
+ * OVERVIEW:      Write the events in the ring buffer to a file (see
+ *                the format at the top of this file).  Recording goes
+ *                on afterwards.  Does not allocate Java heap memory,
+ *                so that it can be called at any reschedule point.
+ * INTERFACE:
+ *   parameters:  name of the file
+ *   returns:     TRUE if the file was written
+ *=======================================================================*/
+
+bool_t dumpFlightRecorder(const char* fileName)
+{
+    FILE* file;
+    long count, first, size, lastId, i;
+    void** names;
+    long* ids;
+
+    if (!FlightRecorderEnabled) {
+        return FALSE;
+    }
+    file = fopen(fileName, "wb");
+    if (file == NULL) {
+        return FALSE;
+    }
+
+    if (RecordedEventTotal < (unsigned long)FlightRecorderSize) {
+        count = RecordedEventTotal;
+        first = 0;
+    } else {
+        count = FlightRecorderSize;
+        first = RecordedEventNext;
+    }
+
+    /* Every event refers to at most two names */
+    for (size = 16; size < 4 * count; size <<= 1);
+    names = (void**)calloc(size, sizeof(void*));
+    ids = (long*)malloc(size * sizeof(long));
+    if (names == NULL || ids == NULL) {
+        free(names);
+        free(ids);
+        fclose(file);
+        return FALSE;
+    }
+    lastId = 0;
+
+    fputs(FR_MAGIC, file);
+    putU2(file, FR_VERSION);
+    putU4(file, count);
+    putU4(file, RecordedEventTotal - count);
+    putU8(file, RecorderStartMillis);
+
+    for (i = 0; i < count; i++) {
+        RECORDEDEVENT event = &RecordedEvents[(first + i) % FlightRecorderSize];
+        long values[2];
+        int v;
+        values[0] = event->value1;
+        values[1] = event->value2;
+        for (v = 0; v < 2; v++) {
+            int kind = (event->type <= FR_LAST_EVENT_TYPE)
+                           ? valueKinds[event->type][v] : FR_NUMBER;
+            if (kind != FR_NUMBER) {
+                values[v] = nameId(file, names, ids, size, &lastId,
+                                   (void*)values[v], kind);
+            }
+        }
+        putU1(file, event->type);
+        putU2(file, event->thread);
+        putU8(file, event->time);
+        putU4(file, event->duration);
+        putU4(file, values[0]);
+        putU4(file, values[1]);
+    }
+
+    free(names);
+    free(ids);
+    fclose(file);
+    return TRUE;
+}
+
+#endif /* ENABLE_FLIGHT_RECORDER */
+
@@ -0,0 +1,626 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      sampler.c
+ * OVERVIEW:  Sampling profiler for Java code.  The sampling timer
+ *            sets SampleRequested; the interpreter then calls
+ *            recordSample() at its next reschedule point, which copies
+ *            the (method, offset) pairs of the current thread's frames
+ *            into a flat sample buffer.  Samples are only ever written
+ *            and read by the interpreter, so the buffer needs no
+ *            locking.  When the buffer fills up, and at exit, the
+ *            samples are folded into per-method counts and a call
+ *            tree, from which the report is written.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if ENABLE_SAMPLING_PROFILER
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+#define SAMPLE_BUFFER_SIZE   4096   /* Entries in the raw sample buffer */
+#define MAX_SAMPLE_DEPTH      128   /* Frames kept per sample, leaf first */
+#define SAMPLED_METHOD_TABLE_SIZE 256
+#define CALL_NODE_BLOCK_SIZE  256   /* Call tree nodes malloc'ed at once */
+
+/* The tree lists calls that took less than this many */
+/* tenths of a percent of all samples only as a total */
+#define CALL_TREE_CUTOFF        1
+
+/*
+ * The raw sample buffer.  Every sample is a header entry whose
+ * "value" is the number of frames that follow, leaf frame first.
+ * In a frame entry "value" is the offset of ip from the start of
+ * the method's bytecode.  A frame entry with a NULL method marks
+ * a sample that was cut off at MAX_SAMPLE_DEPTH frames.
+ */
+struct sampleEntryStruct {
+    METHOD method;
+    long   value;
+};
+
+/*
+ * Everything the profiler knows about a method
+ */
+typedef struct sampledMethodStruct* SAMPLEDMETHOD;
+
+struct sampledMethodStruct {
+    METHOD          method;
+    LINENUMBERTABLE lineNumberTable; /* NULL if there was none */
+    long            selfSamples;     /* Samples with the method on top */
+    long            totalSamples;    /* Samples with the method anywhere */
+    long            lastSample;      /* Avoids counting recursion twice */
+    SAMPLEDMETHOD   next;            /* Next method in the hash bucket */
+};
+
+/*
+ * A call tree node stands for a method called from a given
+ * line of its caller, or running a given line if it is a leaf
+ */
+typedef struct callNodeStruct* CALLNODE;
+
+struct callNodeStruct {
+    SAMPLEDMETHOD method;            /* NULL for the root and for */
+                                     /* samples that were cut off */
+    int           lineNumber;        /* 0 if unknown */
+    long          selfSamples;
+    long          totalSamples;
+    CALLNODE      firstChild;
+    CALLNODE      nextSibling;
+};
+
+/*=========================================================================
+ * Sampling profiler variables
+ *=======================================================================*/
+
+char* SamplingProfilerFile = NULL;
+int   SamplingProfilerRate = SAMPLING_PROFILER_RATE;
+
+volatile int SampleRequested;
+
+static struct sampleEntryStruct SampleBuffer[SAMPLE_BUFFER_SIZE];
+static int SampleBufferCount;
+
+static SAMPLEDMETHOD SampledMethods[SAMPLED_METHOD_TABLE_SIZE];
+static int SampledMethodCount;
+
+static struct callNodeStruct CallTreeRoot;
+static CALLNODE FreeCallNodes;
+static int FreeCallNodeCount;
+
+static long SampleCount;
+
+/*=========================================================================
+ * Static functions (private to this file)
+ *=======================================================================*/
+
+static void storeSample(void);
+static void foldSamples(void);
+static SAMPLEDMETHOD getSampledMethod(METHOD thisMethod);
+static int getLineNumber(SAMPLEDMETHOD sampled, long offset);
+static CALLNODE getCallNode(CALLNODE parent, SAMPLEDMETHOD method,
+                            int lineNumber);
+static void writeProfile(FILE* file);
+static void writeCollapsedStacks(FILE* file, CALLNODE node,
+                                 CALLNODE* path, int depth);
+
+/*=========================================================================
+ * Sampling profiler operations
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      InitializeSamplingProfiler
+ * TYPE:          Profiling
+ * OVERVIEW:      Reset the profiler and start the sampling timer if
+ *                a profile was asked for on the command line.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void InitializeSamplingProfiler(void)
+{
+    SampleRequested = FALSE;
+    SampleBufferCount = 0;
+    SampleCount = 0;
+    memset(&CallTreeRoot, 0, sizeof(CallTreeRoot));
+
+    if (SamplingProfilerFile != NULL) {
+        StartSamplingTimer_md(SamplingProfilerRate);
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      FinalizeSamplingProfiler
+ * TYPE:          Profiling
+ * OVERVIEW:      Stop the sampling timer and write the report files.
+ *                Must be called while the classes are still loaded.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void FinalizeSamplingProfiler(void)
+{
+    FILE* file;
+    char* collapsedFile;
+    CALLNODE path[MAX_SAMPLE_DEPTH + 2];
+
+    if (SamplingProfilerFile == NULL) {
+        return;
+    }
+    StopSamplingTimer_md();
+    foldSamples();
+
+    file = fopen(SamplingProfilerFile, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot write profile to %s\n", SamplingProfilerFile);
+        return;
+    }
+    writeProfile(file);
+    fclose(file);
+
+    collapsedFile = (char*)malloc(strlen(SamplingProfilerFile) + 11);
+    if (collapsedFile != NULL) {
+        sprintf(collapsedFile, "%s.collapsed", SamplingProfilerFile);
+        file = fopen(collapsedFile, "w");
+        if (file != NULL) {
+            writeCollapsedStacks(file, &CallTreeRoot, path, 0);
+            fclose(file);
+        }
+        free(collapsedFile);
+    }
+    SamplingProfilerFile = NULL;
+}
+
+/*=========================================================================
+ * FUNCTION:      recordSample
+ * TYPE:          Profiling
+ * OVERVIEW:      Called from reschedule() when the sampling timer
+ *                has ticked.  Records the Java stack of the current
+ *                thread.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     TRUE if the interpreter stopped only to take the
+ *                sample, so that the current thread can go on running
+ *=======================================================================*/
+
+bool_t recordSample(void)
+{
+    bool_t sampleOnly = FALSE;
+
+    SampleRequested = FALSE;
+    if (CurrentThread == NULL || SamplingProfilerFile == NULL) {
+        return FALSE;
+    }
+    storeSample();
+
+#if TIMER_RESCHEDULING
+    /* If the time slice runs out right now, the next tick of the */
+    /* rescheduling timer asks for the thread switch again        */
+    if (RescheduleRequested == SAMPLE_RESCHEDULE && Timeslice > 0) {
+        RescheduleRequested = FALSE;
+        sampleOnly = TRUE;
+    }
+#endif /* TIMER_RESCHEDULING */
+
+    return sampleOnly;
+}
+
+/*=========================================================================
+ * FUNCTION:      setMethodLineNumbers
+ * TYPE:          Profiling
+ * OVERVIEW:      Remember the line number table of a method, as read
+ *                from its class file by the class loader.  The table
+ *                is malloc'ed and belongs to the profiler from now on.
+ * INTERFACE:
+ *   parameters:  method, line number table
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void setMethodLineNumbers(METHOD thisMethod, LINENUMBERTABLE lineNumberTable)
+{
+    SAMPLEDMETHOD sampled = getSampledMethod(thisMethod);
+    if (sampled->lineNumberTable != NULL) {
+        free(sampled->lineNumberTable);
+    }
+    sampled->lineNumberTable = lineNumberTable;
+}
+
+/*=========================================================================
+ * FUNCTION:      storeSample
+ * TYPE:          private profiling operation
+ * OVERVIEW:      Copy the frames of the current thread into the
+ *                sample buffer, folding the buffer first if there
+ *                might not be room for another sample.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+static void storeSample(void)
+{
+    FRAME thisFP = getFP();
+    BYTE* thisIP = getIP();
+    struct sampleEntryStruct* header;
+    struct sampleEntryStruct* entry;
+    int depth = 0;
+
+    if (thisFP == NULL) {
+        return;
+    }
+    if (SampleBufferCount + MAX_SAMPLE_DEPTH + 2 > SAMPLE_BUFFER_SIZE) {
+        foldSamples();
+    }
+    header = &SampleBuffer[SampleBufferCount];
+    entry = header + 1;
+
+    for (;;) {
+        METHOD thisMethod = thisFP->thisMethod;
+        if (thisMethod != RunCustomCodeMethod) {
+            if (depth == MAX_SAMPLE_DEPTH) {
+                entry->method = NULL;
+                entry->value = 0;
+                depth++;
+                break;
+            }
+            entry->method = thisMethod;
+            entry->value = thisIP - thisMethod->u.java.code;
+            entry++;
+            depth++;
+        }
+        thisIP = thisFP->previousIp;
+        thisFP = thisFP->previousFp;
+        if (thisIP == KILLTHREAD || thisFP == NULL) {
+            break;
+        }
+    }
+
+    header->method = NULL;
+    header->value = depth;
+    SampleBufferCount += depth + 1;
+}
+
+/*=========================================================================
+ * FUNCTION:      foldSamples
+ * TYPE:          private profiling operation
+ * OVERVIEW:      Add the samples in the sample buffer to the method
+ *                counts and the call tree, and empty the buffer.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+static void foldSamples(void)
+{
+    int index = 0;
+
+    while (index < SampleBufferCount) {
+        int depth = SampleBuffer[index].value;
+        struct sampleEntryStruct* frames = &SampleBuffer[index + 1];
+        CALLNODE node = &CallTreeRoot;
+        int i;
+
+        SampleCount++;
+        CallTreeRoot.totalSamples++;
+
+        /* Walk from the outermost frame to the leaf */
+        for (i = depth - 1; i >= 0; i--) {
+            SAMPLEDMETHOD sampled = NULL;
+            int lineNumber = 0;
+            if (frames[i].method != NULL) {
+                sampled = getSampledMethod(frames[i].method);
+                /* The ip of a caller is just past its invoke instruction */
+                lineNumber = getLineNumber(sampled,
+                                 i == 0 ? frames[i].value : frames[i].value - 1);
+                if (sampled->lastSample != SampleCount) {
+                    sampled->lastSample = SampleCount;
+                    sampled->totalSamples++;
+                }
+                if (i == 0) {
+                    sampled->selfSamples++;
+                }
+            }
+            node = getCallNode(node, sampled, lineNumber);
+            node->totalSamples++;
+        }
+        node->selfSamples++;
+        index += depth + 1;
+    }
+    SampleBufferCount = 0;
+}
+
+/*=========================================================================
+ * FUNCTION:      getSampledMethod
+ * TYPE:          private profiling operation
+ * OVERVIEW:      Find the profiler's record of a method, creating
+ *                it the first time the method is seen.
+ * INTERFACE:
+ *   parameters:  method
+ *   returns:     the record of the method
+ *=======================================================================*/
+
+static SAMPLEDMETHOD getSampledMethod(METHOD thisMethod)
+{
+    unsigned int bucket =
+        ((unsigned long)thisMethod >> 2) % SAMPLED_METHOD_TABLE_SIZE;
+    SAMPLEDMETHOD sampled;
+
+    for (sampled = SampledMethods[bucket]; sampled != NULL;
+             sampled = sampled->next) {
+        if (sampled->method == thisMethod) {
+            return sampled;
+        }
+    }
+    sampled = (SAMPLEDMETHOD)malloc(sizeof(struct sampledMethodStruct));
+    if (sampled == NULL) {
+        fatalError("Out of memory in the sampling profiler");
+    }
+    memset(sampled, 0, sizeof(struct sampledMethodStruct));
+    sampled->method = thisMethod;
+    sampled->next = SampledMethods[bucket];
+    SampledMethods[bucket] = sampled;
+    SampledMethodCount++;
+    return sampled;
+}
+
+/*=========================================================================
+ * FUNCTION:      getLineNumber
+ * TYPE:          private profiling operation
+ * OVERVIEW:      Map a bytecode offset to a source line number.
+ * INTERFACE:
+ *   parameters:  method record, bytecode offset
+ *   returns:     the line number, or 0 if it is not known
+ *=======================================================================*/
+
+static int getLineNumber(SAMPLEDMETHOD sampled, long offset)
+{
+    LINENUMBERTABLE table = sampled->lineNumberTable;
+    int lineNumber = 0;
+    long bestStart = -1;
+    int i;
+
+    if (table == NULL) {
+        return 0;
+    }
+    /* The table is not necessarily sorted by start_pc */
+    for (i = 0; i < table->length; i++) {
+        long start = table->lineNumber[i].start_pc;
+        if (start <= offset && start > bestStart) {
+            bestStart = start;
+            lineNumber = table->lineNumber[i].line_number;
+        }
+    }
+    return lineNumber;
+}
+
+/*=========================================================================
+ * FUNCTION:      getCallNode
+ * TYPE:          private profiling operation
+ * OVERVIEW:      Find the child of a call tree node for the given
+ *                method and line, adding it if there is none yet.
+ * INTERFACE:
+ *   parameters:  parent node, method record (or NULL), line number
+ *   returns:     the child node
+ *=======================================================================*/
+
+static CALLNODE getCallNode(CALLNODE parent, SAMPLEDMETHOD method,
+                            int lineNumber)
+{
+    CALLNODE node;
+
+    for (node = parent->firstChild; node != NULL; node = node->nextSibling) {
+        if (node->method == method && node->lineNumber == lineNumber) {
+            return node;
+        }
+    }
+    if (FreeCallNodeCount == 0) {
+        FreeCallNodes = (CALLNODE)
+            malloc(CALL_NODE_BLOCK_SIZE * sizeof(struct callNodeStruct));
+        if (FreeCallNodes == NULL) {
+            fatalError("Out of memory in the sampling profiler");
+        }
+        FreeCallNodeCount = CALL_NODE_BLOCK_SIZE;
+    }
+    node = FreeCallNodes++;
+    FreeCallNodeCount--;
+    memset(node, 0, sizeof(struct callNodeStruct));
+    node->method = method;
+    node->lineNumber = lineNumber;
+    node->nextSibling = parent->firstChild;
+    parent->firstChild = node;
+    return node;
+}
+
+/*=========================================================================
+ * Report generation
+ *=======================================================================*/
+
+/*
+ * Build the printable name of a frame, e.g. "java.lang.String.charAt:512"
+ */
+static char* getFrameName(SAMPLEDMETHOD sampled, int lineNumber)
+{
+    char* name = str_buffer;
+    char* end;
+    char* p;
+    int room;
+
+    if (sampled == NULL) {
+        return "(truncated)";
+    }
+    end = getClassName_inBuffer((CLASS)sampled->method->ofClass, name);
+    for (p = name; p < end; p++) {
+        if (*p == '/') {
+            *p = '.';
+        }
+    }
+    /* Leave room for the line number */
+    room = STRINGBUFFERSIZE - (int)(end - name) - 16;
+    sprintf(end, ".%.*s", room > 0 ? room : 0, methodName(sampled->method));
+    if (lineNumber > 0) {
+        sprintf(end + strlen(end), ":%d", lineNumber);
+    }
+    return name;
+}
+
+/*
+ * Print "count" as a percentage of all samples, e.g. " 12.5%"
+ */
+static void printPercentage(FILE* file, long count)
+{
+    long perMille = (SampleCount == 0) ? 0 : (count * 1000) / SampleCount;
+    fprintf(file, "%4ld.%ld%%", perMille / 10, perMille % 10);
+}
+
+static int compareSampledMethods(const void* first, const void* second)
+{
+    SAMPLEDMETHOD a = *(SAMPLEDMETHOD*)first;
+    SAMPLEDMETHOD b = *(SAMPLEDMETHOD*)second;
+    if (a->selfSamples != b->selfSamples) {
+        return (a->selfSamples > b->selfSamples) ? -1 : 1;
+    }
+    if (a->totalSamples != b->totalSamples) {
+        return (a->totalSamples > b->totalSamples) ? -1 : 1;
+    }
+    return 0;
+}
+
+/*
+ * Sort the children of a node by decreasing total samples
+ * (insertion sort; most nodes have only a few children)
+ */
+static void sortCallNodes(CALLNODE parent)
+{
+    CALLNODE sorted = NULL;
+    CALLNODE node = parent->firstChild;
+
+    while (node != NULL) {
+        CALLNODE next = node->nextSibling;
+        CALLNODE* link = &sorted;
+        while (*link != NULL && (*link)->totalSamples >= node->totalSamples) {
+            link = &(*link)->nextSibling;
+        }
+        node->nextSibling = *link;
+        *link = node;
+        node = next;
+    }
+    parent->firstChild = sorted;
+}
+
+static void writeCallTree(FILE* file, CALLNODE parent, int depth)
+{
+    CALLNODE node;
+    long omitted = 0;
+
+    sortCallNodes(parent);
+    for (node = parent->firstChild; node != NULL; node = node->nextSibling) {
+        if (node->totalSamples * 1000 < SampleCount * CALL_TREE_CUTOFF) {
+            omitted += node->totalSamples;
+            continue;
+        }
+        printPercentage(file, node->totalSamples);
+        fprintf(file, " %8ld %8ld  %*s%s\n",
+                node->totalSamples, node->selfSamples, 2 * depth, "",
+                getFrameName(node->method, node->lineNumber));
+        writeCallTree(file, node, depth + 1);
+    }
+    if (omitted > 0) {
+        printPercentage(file, omitted);
+        fprintf(file, " %8ld %8s  %*s(other)\n", omitted, "", 2 * depth, "");
+    }
+}
+
+static void writeProfile(FILE* file)
+{
+    SAMPLEDMETHOD* methods;
+    int count = 0;
+    int i;
+
+    fprintf(file, "Sampling profile: %ld samples at %d per second\n\n",
+            SampleCount, SamplingProfilerRate);
+
+    fprintf(file, "Flat profile (by self samples):\n\n");
+    fprintf(file, "  self%%  total%%     self    total  method\n");
+    methods = (SAMPLEDMETHOD*)
+        malloc((SampledMethodCount + 1) * sizeof(SAMPLEDMETHOD));
+    if (methods != NULL) {
+        for (i = 0; i < SAMPLED_METHOD_TABLE_SIZE; i++) {
+            SAMPLEDMETHOD sampled;
+            for (sampled = SampledMethods[i]; sampled != NULL;
+                     sampled = sampled->next) {
+                if (sampled->totalSamples > 0) {
+                    methods[count++] = sampled;
+                }
+            }
+        }
+        qsort(methods, count, sizeof(SAMPLEDMETHOD), compareSampledMethods);
+        for (i = 0; i < count; i++) {
+            printPercentage(file, methods[i]->selfSamples);
+            fprintf(file, " ");
+            printPercentage(file, methods[i]->totalSamples);
+            fprintf(file, " %8ld %8ld  %s\n",
+                    methods[i]->selfSamples, methods[i]->totalSamples,
+                    getFrameName(methods[i], 0));
+        }
+        free(methods);
+    }
+
+    fprintf(file, "\nCall tree (by total samples):\n\n");
+    fprintf(file, " total%%    total     self  method\n");
+    writeCallTree(file, &CallTreeRoot, 0);
+}
+
+/*
+ * Write one line "outer;...;leaf count" for every call tree node
+ * that has self samples.  This is the input format of the common
+ * flame graph tools.
+ */
+static void writeCollapsedStacks(FILE* file, CALLNODE node,
+                                 CALLNODE* path, int depth)
+{
+    CALLNODE child;
+
+    path[depth] = node;
+    if (node->selfSamples > 0 && depth > 0) {
+        int i;
+        for (i = 1; i <= depth; i++) {
+            fprintf(file, (i == 1) ? "%s" : ";%s",
+                    getFrameName(path[i]->method, path[i]->lineNumber));
+        }
+        fprintf(file, " %ld\n", node->selfSamples);
+    }
+    for (child = node->firstChild; child != NULL; child = child->nextSibling) {
+        writeCollapsedStacks(file, child, path, depth + 1);
+    }
+}
+
+#endif /* ENABLE_SAMPLING_PROFILER */
+
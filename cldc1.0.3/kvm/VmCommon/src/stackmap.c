@@ -497,6 +497,28 @@ again:
                 thisIP += (token == INVOKEINTERFACE_FAST) ? 4 : 2;
                 goto handleMethodCall;
             }
+
+            case ARRAYCOPY_FAST:
+                /* System.arraycopy: five arguments and no result */
+                stackSize -= 5;
+                thisIP += 2;
+                break;
+#endif
+
+#if ENABLE_SUPERINSTRUCTIONS
+                /* A superinstruction has the effect of the instruction
+                 * it replaced; the instruction after it follows as usual */
+            case ALOAD_0_GETFIELD: case ALOAD_0_INVOKEVIRTUAL:
+                goto pushPointer;
+
+            case ILOAD_IF_ICMP:
+                thisIP++;
+                goto pushInt;
+
+            case ILOAD_0_IF_ICMP: case ILOAD_1_IF_ICMP:
+            case ILOAD_2_IF_ICMP: case ILOAD_3_IF_ICMP:
+            case ICONST_1_IADD:
+                goto pushInt;
 #endif
 
 #if ENABLEFASTBYTECODES
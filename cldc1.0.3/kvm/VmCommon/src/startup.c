@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Profiling
+ * FILE:      startup.c
+ * OVERVIEW:  Startup trace (see startup.h).  The spans are kept in an
+ *            array in the order they began, each with the index of the
+ *            span that encloses it, so the array is the tree in
+ *            preorder.  When the trace is finished the tree is printed
+ *            to stdout, one span per line with its total and self time
+ *            in microseconds; consecutive leaf spans with the same name
+ *            (the native methods of a class, typically) are merged into
+ *            one line.  The file is a JSON object whose "traceEvents"
+ *            are complete ("X") events, which chrome://tracing and
+ *            Perfetto display as a flame chart.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if ENABLE_STARTUP_TRACE
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+#define INITIAL_SPAN_CAPACITY 256
+
+typedef struct startupSpanStruct {
+    int     kind;
+    int     parent;         /* Index of the enclosing span, or -1 */
+    char*   name;
+    ulong64 start;
+    ulong64 end;
+} startupSpan;
+
+static const char* kindNames[STARTUP_KIND_COUNT] = {
+    "phase", "load", "verify", "initialize", "native", "permit"
+};
+
+/*=========================================================================
+ * Startup trace variables
+ *=======================================================================*/
+
+char* StartupTraceFile = NULL;
+
+ISOLATE_LOCAL bool_t StartupTraceEnabled = FALSE;
+
+static ISOLATE_LOCAL startupSpan* Spans;
+static ISOLATE_LOCAL int          SpanCount;
+static ISOLATE_LOCAL int          SpanCapacity;
+static ISOLATE_LOCAL int          OpenSpan;     /* Innermost open span */
+
+/*=========================================================================
+ * Static functions (private to this file)
+ *=======================================================================*/
+
+static void freeSpans(void);
+static void printSpans(void);
+static void writeSpans(FILE* file);
+static void writeSpanName(FILE* file, startupSpan* span);
+
+/*=========================================================================
+ * Startup trace operations
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      InitializeStartupTrace
+ * TYPE:          profiling
+ * OVERVIEW:      Start tracing if -startuptrace was given on the command
+ *                line.  The whole trace is one span, "StartJVM".
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void InitializeStartupTrace(void)
+{
+    StartupTraceEnabled = FALSE;
+    if (StartupTraceFile == NULL) {
+        return;
+    }
+    Spans = (startupSpan*)malloc(INITIAL_SPAN_CAPACITY * sizeof(startupSpan));
+    if (Spans == NULL) {
+        fprintf(stderr, "Not enough memory for the startup trace\n");
+        return;
+    }
+    SpanCapacity = INITIAL_SPAN_CAPACITY;
+    SpanCount = 0;
+    OpenSpan = -1;
+    StartupTraceEnabled = TRUE;
+    startupTraceBegin(STARTUP_PHASE, "StartJVM");
+}
+
+/*=========================================================================
+ * FUNCTION:      FinalizeStartupTrace
+ * TYPE:          profiling
+ * OVERVIEW:      Finish the trace: close the spans that are still open,
+ *                print the tree and write the trace event file.  Called
+ *                when the main method is entered, or when the VM exits
+ *                before that.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void FinalizeStartupTrace(void)
+{
+    char* fileName = StartupTraceFile;
+    ulong64 now;
+    FILE* file;
+
+    if (!StartupTraceEnabled) {
+        return;
+    }
+    StartupTraceEnabled = FALSE;
+
+    now = MonotonicTime_md();
+    for (; OpenSpan >= 0; OpenSpan = Spans[OpenSpan].parent) {
+        Spans[OpenSpan].end = now;
+    }
+    printSpans();
+
+#if MULTIPLE_ISOLATES
+    fileName = isolateFileName(StartupTraceFile);
+#endif /* MULTIPLE_ISOLATES */
+    file = (fileName != NULL) ? fopen(fileName, "w") : NULL;
+    if (file == NULL) {
+        fprintf(stderr, "Cannot write the startup trace to %s\n",
+                StartupTraceFile);
+    } else {
+        writeSpans(file);
+        fclose(file);
+    }
+#if MULTIPLE_ISOLATES
+    free(fileName);
+#endif
+    freeSpans();
+}
+
+/*=========================================================================
+ * FUNCTION:      startupTraceBegin, startupTraceBeginClass
+ * TYPE:          profiling
+ * OVERVIEW:      Open a span inside the innermost open span.  The span
+ *                of a class is named after the class, or after both
+ *                classes for a permit ("grantee -> grantor").
+ * INTERFACE:
+ *   parameters:  the kind of span; its name, or the class(es)
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void startupTraceBegin(int kind, const char* name)
+{
+    startupSpan* span;
+    char* copy = (char*)malloc(strlen(name) + 1);
+
+    if (copy != NULL && SpanCount == SpanCapacity) {
+        startupSpan* grown = (startupSpan*)
+            realloc(Spans, 2 * SpanCapacity * sizeof(startupSpan));
+        if (grown == NULL) {
+            free(copy);
+            copy = NULL;
+        } else {
+            Spans = grown;
+            SpanCapacity *= 2;
+        }
+    }
+    if (copy == NULL) {
+        fprintf(stderr, "Not enough memory for the startup trace\n");
+        StartupTraceEnabled = FALSE;
+        freeSpans();
+        return;
+    }
+    strcpy(copy, name);
+
+    span = &Spans[SpanCount];
+    span->kind = kind;
+    span->parent = OpenSpan;
+    span->name = copy;
+    span->start = MonotonicTime_md();
+    span->end = span->start;
+    OpenSpan = SpanCount++;
+}
+
+void startupTraceBeginClass(int kind, CLASS clazz, CLASS other)
+{
+    char name[2 * STRINGBUFFERSIZE];
+    char* end = getClassName_inBuffer(clazz, name);
+    if (other != NULL) {
+        strcpy(end, " -> ");
+        getClassName_inBuffer(other, end + 4);
+    }
+    startupTraceBegin(kind, name);
+}
+
+/*=========================================================================
+ * FUNCTION:      startupTraceEnd
+ * TYPE:          profiling
+ * OVERVIEW:      Close the innermost open span of the given kind, and
+ *                any spans inside it that an exception left open.
+ * INTERFACE:
+ *   parameters:  the kind of span
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void startupTraceEnd(int kind)
+{
+    ulong64 now;
+    int span = OpenSpan;
+
+    while (span >= 0 && Spans[span].kind != kind) {
+        span = Spans[span].parent;
+    }
+    if (span < 0) {
+        return;
+    }
+    now = MonotonicTime_md();
+    for (; OpenSpan != Spans[span].parent; OpenSpan = Spans[OpenSpan].parent) {
+        Spans[OpenSpan].end = now;
+    }
+}
+
+/*=========================================================================
+ * Static functions
+ *=======================================================================*/
+
+static void freeSpans(void)
+{
+    int i;
+    for (i = 0; i < SpanCount; i++) {
+        free(Spans[i].name);
+    }
+    free(Spans);
+    Spans = NULL;
+    SpanCount = 0;
+    OpenSpan = -1;
+}
+
+static void printSpans(void)
+{
+    ulong64* childTime = (ulong64*)calloc(SpanCount, sizeof(ulong64));
+    int* childCount = (int*)calloc(SpanCount, sizeof(int));
+    int* depth = (int*)calloc(SpanCount, sizeof(int));
+    int i, j;
+
+    if (childTime == NULL || childCount == NULL || depth == NULL) {
+        fprintf(stderr, "Not enough memory to print the startup trace\n");
+        goto done;
+    }
+
+    for (i = 0; i < SpanCount; i++) {
+        int parent = Spans[i].parent;
+        if (parent >= 0) {
+            childTime[parent] += Spans[i].end - Spans[i].start;
+            childCount[parent]++;
+            depth[i] = depth[parent] + 1;
+        }
+    }
+
+    fprintf(stdout, "Startup trace (microseconds):\n");
+    fprintf(stdout, "%10s %10s\n", "total", "self");
+    for (i = 0; i < SpanCount; i = j) {
+        ulong64 total = Spans[i].end - Spans[i].start;
+        ulong64 self = total - childTime[i];
+        int merged = 1;
+
+        /* Merge the leaf spans with the same name that follow */
+        for (j = i + 1; j < SpanCount && childCount[i] == 0
+                 && childCount[j] == 0
+                 && Spans[j].parent == Spans[i].parent
+                 && Spans[j].kind == Spans[i].kind
+                 && strcmp(Spans[j].name, Spans[i].name) == 0; j++) {
+            total += Spans[j].end - Spans[j].start;
+            merged++;
+        }
+        if (merged > 1) {
+            self = total;
+        }
+
+        fprintf(stdout, "%10lu %10lu  %*s", (unsigned long)total,
+                (unsigned long)self, 2 * depth[i], "");
+        if (Spans[i].kind != STARTUP_PHASE) {
+            fprintf(stdout, "%s ", kindNames[Spans[i].kind]);
+        }
+        fprintf(stdout, "%s", Spans[i].name);
+        if (merged > 1) {
+            fprintf(stdout, " (x%d)", merged);
+        }
+        fprintf(stdout, "\n");
+    }
+
+done:
+    free(childTime);
+    free(childCount);
+    free(depth);
+}
+
+static void writeSpans(FILE* file)
+{
+    ulong64 origin = SpanCount > 0 ? Spans[0].start : 0;
+    int i;
+
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    for (i = 0; i < SpanCount; i++) {
+        fprintf(file, "{\"name\": ");
+        writeSpanName(file, &Spans[i]);
+        fprintf(file, ", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %lu, "
+                      "\"dur\": %lu, \"pid\": 1, \"tid\": 1}%s\n",
+                kindNames[Spans[i].kind],
+                (unsigned long)(Spans[i].start - origin),
+                (unsigned long)(Spans[i].end - Spans[i].start),
+                (i < SpanCount - 1) ? "," : "");
+    }
+    fprintf(file, "]}\n");
+}
+
+/* Write the name of a span as a JSON string, as it is printed */
+static void writeSpanName(FILE* file, startupSpan* span)
+{
+    const char* string;
+
+    putc('"', file);
+    if (span->kind != STARTUP_PHASE) {
+        fprintf(file, "%s ", kindNames[span->kind]);
+    }
+    for (string = span->name; *string != '\0'; string++) {
+        unsigned char c = (unsigned char)*string;
+        if (c == '"' || c == '\\') {
+            putc('\\', file);
+            putc(c, file);
+        } else if (c < 0x20) {
+            fprintf(file, "\\u%04x", c);
+        } else {
+            putc(c, file);
+        }
+    }
+    putc('"', file);
+}
+
+#endif /* ENABLE_STARTUP_TRACE */
+
@@ -44,23 +44,36 @@
  * Global variables needed for multitasking
  *=======================================================================*/
 
-THREAD CurrentThread;   /* Current thread pointer */
-THREAD MainThread;      /* Global so debugger code can create a name */
+ISOLATE_LOCAL THREAD CurrentThread;   /* Current thread pointer */
+ISOLATE_LOCAL THREAD MainThread;      /* Global so debugger code can create a name */
 
-THREAD AllThreads;      /* List of all threads */
-THREAD RunnableThreads;  /* Runnable thread list */
+ISOLATE_LOCAL THREAD AllThreads;      /* List of all threads */
+
+#if PRIORITY_SCHEDULING
+ISOLATE_LOCAL THREAD RunQueues[MAX_PRIORITY + 1]; /* Runnable thread list per priority */
+ISOLATE_LOCAL int    RunQueueMask;                /* Bit n set if RunQueues[n] is in use */
+static ISOLATE_LOCAL int SwitchesUntilAging;      /* Thread switches until next aging */
+#else
+ISOLATE_LOCAL THREAD RunnableThreads;  /* Runnable thread list */
+#endif
 
 /* NOTE:
  * RunnableThreads is a circular queue of threads.  RunnableThreads
  * is either NULL or points to the >>last<< element of the list.
  * This makes it easier to add to either end of the list *
+ * The same applies to each of the queues in RunQueues.
  */
 
-int AliveThreadCount;   /* Number of alive threads in AllThreads.  This count
+ISOLATE_LOCAL int AliveThreadCount;   /* Number of alive threads in AllThreads.  This count
                          * does >>not<< include threads that haven't yet been
                          * started */
 
-int Timeslice;          /* Time slice counter for multitasking */
+#if TIMER_RESCHEDULING
+ISOLATE_LOCAL volatile int Timeslice;           /* Ticks left, counted down by the timer */
+ISOLATE_LOCAL volatile int RescheduleRequested; /* Set when Timeslice expires */
+#else
+ISOLATE_LOCAL int Timeslice;          /* Time slice counter for multitasking */
+#endif
 
 /*=========================================================================
  * Static declarations needed for this file
@@ -89,6 +102,19 @@ static THREAD removeQueueStart(THREAD *queue);
 static bool_t removeFromQueue(THREAD *queue, THREAD waiter);
 static int    queueLength(THREAD queue);
 
+/* Internal run queue operations */
+static void   addRunnableThread(THREAD thread, queueWhere where);
+#if ENABLE_JAVA_DEBUGGER
+static void   removeRunnableThread(THREAD thread);
+#endif
+static bool_t isRunnableThreadWaiting(THREAD thread);
+
+#if PRIORITY_SCHEDULING
+#define threadPriority(thread) ((int)(thread)->javaThread->priority)
+static int    highestRunLevel(int mask);
+static void   ageRunQueues(void);
+#endif
+
 static void   monitorWaitAlarm(THREAD thread);
 
 /*=========================================================================
@@ -162,6 +188,13 @@ bool_t SwitchThread(void)
 {
     THREAD threadToAdd = NIL;
 
+#if PRIORITY_SCHEDULING
+    if (--SwitchesUntilAging <= 0) {
+        ageRunQueues();
+        SwitchesUntilAging = PRIORITY_AGING_INTERVAL;
+    }
+#endif
+
     if (CurrentThread != NIL) {
 
 #if ASYNCHRONOUS_NATIVE_FUNCTIONS
@@ -173,9 +206,12 @@ bool_t SwitchThread(void)
         if (CurrentThread->state == THREAD_ACTIVE) {
             /* If there is only one thread, or we can't switch threads then
                just return */
-            if (RunnableThreads == NULL) {
+            if (!isRunnableThreadWaiting(CurrentThread)) {
                 /* Nothing else to run */
-                Timeslice = CurrentThread->timeslice;
+#if PRIORITY_SCHEDULING
+                CurrentThread->runLevel = threadPriority(CurrentThread);
+#endif
+                startTimeslice(CurrentThread);
                 return TRUE;
             } else {
                 /* Save the VM registers.  Indicate that this thread is to */
@@ -190,11 +226,11 @@ bool_t SwitchThread(void)
     }
 
     /*  Try and find a thread */
-    CurrentThread = removeQueueStart(&RunnableThreads);
+    CurrentThread = removeFirstRunnableThread();
 
     /* If there was a thread to add then do so */
     if (threadToAdd != NIL) {
-        addThreadToQueue(&RunnableThreads, threadToAdd, AT_END);
+        addRunnableThread(threadToAdd, AT_END);
     }
 
     /* If nothing can run then return FALSE */
@@ -205,6 +241,8 @@ bool_t SwitchThread(void)
 #if ENABLEPROFILING
     ThreadSwitchCounter++;
 #endif
+    RECORD_THREAD_SWITCH(CurrentThread)
+
     /*  Load the VM registers of the new thread */
     loadExecutionEnvironment(CurrentThread);
 
@@ -216,7 +254,7 @@ bool_t SwitchThread(void)
 #endif
 
     /*  Load new time slice */
-    Timeslice = CurrentThread->timeslice;
+    startTimeslice(CurrentThread);
 
 #if ASYNCHRONOUS_NATIVE_FUNCTIONS
     if (CurrentThread->pendingException != NIL) {
@@ -280,6 +318,10 @@ static THREAD BuildThread(JAVATHREAD_HANDLE javaThreadH)
     /*  Time slice will be initialized to default value */
     newThread->timeslice = BASETIMESLICE;
 
+#if ENABLE_FLIGHT_RECORDER
+    newThread->recorderId = ++FlightRecorderThreadCount;
+#endif
+
     /* Link the THREAD to the JAVATHREAD */
     javaThread = unhand(javaThreadH);
     newThread->javaThread = javaThread;
@@ -373,8 +415,21 @@ void InitializeThreading(INSTANCE_CLASS mainClass, ARRAY argumentsArg)
 
         MainThread = NULL;
         MonitorCache = NULL;
+        IdentityHashCount = 0;
         makeGlobalRoot((cell **)&CurrentThread);
+#if PRIORITY_SCHEDULING
+        {
+            int level;
+            for (level = MIN_PRIORITY; level <= MAX_PRIORITY; level++) {
+                RunQueues[level] = NULL;
+                makeGlobalRoot((cell **)&RunQueues[level]);
+            }
+            RunQueueMask = 0;
+            SwitchesUntilAging = PRIORITY_AGING_INTERVAL;
+        }
+#else
         makeGlobalRoot((cell **)&RunnableThreads);
+#endif
         makeGlobalRoot((cell **)&TimerQueue);
 
         /*  Initialize the field of the Java-level thread structure */
@@ -391,10 +446,15 @@ void InitializeThreading(INSTANCE_CLASS mainClass, ARRAY argumentsArg)
         AliveThreadCount = 1;
         Timeslice = BASETIMESLICE;
         MainThread->state = THREAD_ACTIVE;
+#if PRIORITY_SCHEDULING
+        MainThread->runLevel = NORM_PRIORITY;
+#endif
 
         /*  Initialize VM registers */
         CurrentThread = MainThread;
+#if !PRIORITY_SCHEDULING
         RunnableThreads = NULL;
+#endif
         TimerQueue = NULL;
 
         setSP((MainThread->stack->cells - 1));
@@ -424,6 +484,9 @@ static void
 initInitialThreadBehaviorFromThread(FRAME_HANDLE exceptionFrameH) {
     INSTANCE_CLASS thisClass;
     METHOD thisMethod;
+
+    /* The main class is initialized, so the startup is over */
+    STARTUP_TRACE_DONE()
     if (exceptionFrameH != NULL) {
         /* We have no interest in dealing with exceptions. */
         return;
@@ -711,7 +774,7 @@ void suspendSpecificThread(THREAD thread)
     } else {
 
         if (!(thread->state & (THREAD_SUSPENDED | THREAD_DEAD))) {
-            removeFromQueue(&RunnableThreads, thread);
+            removeRunnableThread(thread);
         }
     }
     thread->state |= THREAD_DBG_SUSPENDED;
@@ -765,7 +828,13 @@ void resumeThread(THREAD thisThread)
         /* If the new thread has higher priority then */
         /* add to head of the wait queue and signal that */
         /* it is time to reschedule the processor */
-        addThreadToQueue(&RunnableThreads, thisThread, AT_END);
+        addRunnableThread(thisThread, AT_END);
+#if PRIORITY_SCHEDULING
+        if (CurrentThread != NIL &&
+            thisThread->runLevel > CurrentThread->runLevel) {
+            signalTimeToReschedule();
+        }
+#endif
     }
 }
 
@@ -796,7 +865,16 @@ void resumeSpecificThread(THREAD thisThread)
  *=======================================================================*/
 
 int activeThreadCount() {
+#if PRIORITY_SCHEDULING
+    int count = (CurrentThread ? 1 : 0);
+    int level;
+    for (level = MIN_PRIORITY; level <= MAX_PRIORITY; level++) {
+        count += queueLength(RunQueues[level]);
+    }
+    return count;
+#else
     return (CurrentThread ? 1 : 0) + queueLength(RunnableThreads);
+#endif
 }
 
 /*=========================================================================
@@ -821,7 +899,9 @@ int isActivated(THREAD thread)
 /*=========================================================================
  * FUNCTION:      removeFirstRunnableThread()
  * OVERVIEW:      Return (and remove) the first runnable
- *                thread of the queue.
+ *                thread of the queue.  With PRIORITY_SCHEDULING
+ *                this is the first thread of the highest priority
+ *                level that has runnable threads.
  * INTERFACE:
  *   parameters:  <none>
  *   returns:     A THREAD object.
@@ -829,7 +909,27 @@ int isActivated(THREAD thread)
 
 THREAD removeFirstRunnableThread()
 {
+#if PRIORITY_SCHEDULING
+    /* A bit of RunQueueMask may still be set for a queue that was */
+    /* just emptied by an asynchronous function, so loop until a   */
+    /* thread is found or the mask is clear                        */
+    while (RunQueueMask != 0) {
+        int level = highestRunLevel(RunQueueMask);
+        THREAD thread = removeQueueStart(&RunQueues[level]);
+        START_CRITICAL_SECTION
+            if (RunQueues[level] == NIL) {
+                RunQueueMask &= ~(1 << level);
+            }
+        END_CRITICAL_SECTION
+        if (thread != NIL) {
+            thread->runLevel = level;
+            return thread;
+        }
+    }
+    return NIL;
+#else
     return removeQueueStart(&RunnableThreads);
+#endif
 }
 
 /*=========================================================================
@@ -1091,7 +1191,7 @@ void printFullThreadStatus(void)
  *=======================================================================*/
 
 /* Threads waiting for a timer interrupt */
-THREAD TimerQueue;
+ISOLATE_LOCAL THREAD TimerQueue;
 
 /*=========================================================================
  * Timer operations
@@ -1271,7 +1371,11 @@ bool_t inTimerQueue(THREAD thread) {
  * Monitor implementation
  *=======================================================================*/
 
-MONITOR MonitorCache;
+ISOLATE_LOCAL MONITOR MonitorCache;
+
+/* Hash codes of objects that are locked with a simple lock */
+ISOLATE_LOCAL struct identityHashStruct IdentityHashes[IDENTITY_HASH_TABLE_SIZE];
+ISOLATE_LOCAL int IdentityHashCount;
 
 static char IllegalMonitorStateException[] =
           "java/lang/IllegalMonitorStateException";
@@ -1413,17 +1517,114 @@ removeCondvarWait(MONITOR monitor, bool_t notifyAll) {
     while (notifyAll);
 }
 
-static bool_t
+/*=========================================================================
+ * FUNCTION:      allocateFastLock
+ * TYPE:          Monitor handler
+ * OVERVIEW:      Lock an object with one of the fast locks of a thread,
+ *                if the thread has a fast lock available.
+ * INTERFACE:
+ *   parameters:  thread: the thread that owns the object
+ *                object: the object being locked
+ *                depth, hashCode: locking depth and hash code of object
+ *   returns:     the fast lock, or NULL if all fast locks are in use
+ *=======================================================================*/
+
+static FASTLOCK
 allocateFastLock(THREAD thread, OBJECT object, int depth, long hashCode) {
-    if (IS_EXTENDED_LOCK_FREE(thread)) {
-        /* thisLock->object = object; */
-        thread->extendedLock.depth = depth;
-        thread->extendedLock.hashCode = hashCode;
-        SET_OBJECT_EXTENDED_LOCK(object, thread);
-        return TRUE;
-    } else {
-        return FALSE;
+    FASTLOCK lock = &thread->extendedLocks[0];
+    FASTLOCK lastLock = &thread->extendedLocks[FAST_LOCKS_PER_THREAD];
+    for ( ; lock < lastLock; lock++) {
+        if (IS_FAST_LOCK_FREE(lock)) {
+            lock->object = object;
+            lock->depth = depth;
+            lock->hashCode = hashCode;
+            SET_OBJECT_EXTENDED_LOCK(object, thread);
+            return lock;
+        }
     }
+    return NULL;
+}
+
+/*=========================================================================
+ * FUNCTION:      getFastLock
+ * TYPE:          Monitor handler
+ * OVERVIEW:      Find the fast lock that holds the entry count and hash
+ *                code of an object whose mhc tag is MHC_EXTENDED_LOCK.
+ * INTERFACE:
+ *   parameters:  object: the object
+ *   returns:     the fast lock
+ *=======================================================================*/
+
+static FASTLOCK
+getFastLock(OBJECT object) {
+    THREAD thread = OBJECT_MHC_EXTENDED_THREAD(object);
+    FASTLOCK lock = &thread->extendedLocks[0];
+    /* The first lock is by far the most frequently used one */
+    while (lock->object != object) {
+        lock++;
+    }
+    return lock;
+}
+
+/*=========================================================================
+ * FUNCTION:      findIdentityHash, allocateIdentityHash, takeIdentityHash
+ * TYPE:          Monitor handler
+ * OVERVIEW:      Maintain the hash codes of objects that are locked with
+ *                a simple lock.  Such an object has no room for its hash
+ *                code in its mhc field, so rather than giving it a fast
+ *                lock or a real monitor, the hash code is kept in the
+ *                IdentityHashes table.  The table only ever holds a few
+ *                entries, so it is searched linearly.
+ * INTERFACE:
+ *   parameters:  object: the object
+ *   returns:     findIdentityHash: the entry of the object, or NULL
+ *                allocateIdentityHash: the entry of the object, which is
+ *                    created with a zero hash code if necessary, or NULL
+ *                    if the table is full
+ *                takeIdentityHash: the hash code of the object, which is
+ *                    removed from the table, or 0 if there is none
+ *=======================================================================*/
+
+static IDENTITYHASH
+findIdentityHash(OBJECT object) {
+    IDENTITYHASH entry = &IdentityHashes[0];
+    IDENTITYHASH lastEntry = &IdentityHashes[IdentityHashCount];
+    for ( ; entry < lastEntry; entry++) {
+        if (entry->object == object) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static IDENTITYHASH
+allocateIdentityHash(OBJECT object) {
+    IDENTITYHASH entry = findIdentityHash(object);
+    if (entry == NULL && IdentityHashCount < IDENTITY_HASH_TABLE_SIZE) {
+        entry = &IdentityHashes[IdentityHashCount++];
+        entry->object = object;
+        entry->hashCode = 0;
+    }
+    return entry;
+}
+
+static void
+removeIdentityHash(IDENTITYHASH entry) {
+    /* Fill the hole with the last entry */
+    *entry = IdentityHashes[--IdentityHashCount];
+}
+
+static long
+takeIdentityHash(OBJECT object) {
+    if (IdentityHashCount > 0) {
+        IDENTITYHASH entry = findIdentityHash(object);
+        if (entry != NULL) {
+            long hashCode = entry->hashCode;
+            removeIdentityHash(entry);
+            return hashCode;
+        }
+    }
+    return 0;
 }
 
 void
@@ -1435,13 +1636,13 @@ clearObjectMonitor(OBJECT object) {
             return;
 
         case MHC_SIMPLE_LOCK:
-            hashCode = 0;
+            hashCode = takeIdentityHash(object);
             break;
 
         case MHC_EXTENDED_LOCK: {
-            THREAD thread = OBJECT_MHC_EXTENDED_THREAD(object);
-            hashCode = thread->extendedLock.hashCode;
-            FREE_EXTENDED_LOCK(thread);
+            FASTLOCK lock = getFastLock(object);
+            hashCode = lock->hashCode;
+            FREE_FAST_LOCK(lock);
             break;
         }
 
@@ -1463,6 +1664,10 @@ upgradeToRealMonitor(OBJECT object)
         return OBJECT_MHC_MONITOR(object);
     }
 
+#if ENABLEPROFILING
+    MonitorInflationCounter++;
+#endif
+
     if (MonitorCache != NULL) {
         monitor = MonitorCache;
         MonitorCache = (MONITOR)monitor->owner;
@@ -1493,15 +1698,16 @@ upgradeToRealMonitor(OBJECT object)
         case MHC_SIMPLE_LOCK:
             monitor->owner = OBJECT_MHC_SIMPLE_THREAD(object);
             monitor->depth = 1;
+            monitor->hashCode = takeIdentityHash(object);
             break;
 
         case MHC_EXTENDED_LOCK: {
-            THREAD thread = OBJECT_MHC_EXTENDED_THREAD(object);
-            monitor->owner = thread;
-            monitor->depth = thread->extendedLock.depth;
-            monitor->hashCode = thread->extendedLock.hashCode;
+            FASTLOCK lock = getFastLock(object);
+            monitor->owner = OBJECT_MHC_EXTENDED_THREAD(object);
+            monitor->depth = lock->depth;
+            monitor->hashCode = lock->hashCode;
             /* Free this fast lock, since it is no longer in use */
-            FREE_EXTENDED_LOCK(thread);
+            FREE_FAST_LOCK(lock);
             break;
 
        default:                /* Needed to keep compiler happy */
@@ -1517,8 +1723,15 @@ monitorHashCodeAddress(OBJECT object) {
     switch (OBJECT_MHC_TAG(object)) {
         case MHC_SIMPLE_LOCK: {
             THREAD thisThread = OBJECT_MHC_SIMPLE_THREAD(object);
-            if (allocateFastLock(thisThread, object, 1, 0)) {
-                return &thisThread->extendedLock.hashCode;
+            IDENTITYHASH entry = allocateIdentityHash(object);
+            FASTLOCK lock;
+            if (entry != NULL) {
+                /* The object keeps its simple lock */
+                return &entry->hashCode;
+            }
+            lock = allocateFastLock(thisThread, object, 1, 0);
+            if (lock != NULL) {
+                return &lock->hashCode;
             } else {
                 MONITOR monitor = upgradeToRealMonitor(object);
                 /* object may be trash, because of a GC, but doesn't matter */
@@ -1526,10 +1739,11 @@ monitorHashCodeAddress(OBJECT object) {
             }
         }
 
-        case MHC_EXTENDED_LOCK: {
-            THREAD thread = OBJECT_MHC_EXTENDED_THREAD(object);
-            return &thread->extendedLock.hashCode;
-        }
+        case MHC_EXTENDED_LOCK:
+            return &getFastLock(object)->hashCode;
+
+        case MHC_MONITOR:
+            return &OBJECT_MHC_MONITOR(object)->hashCode;
 
         default:                /* Keep compiler happy */
             /* Do nothing */
@@ -1553,6 +1767,8 @@ monitorEnter(OBJECT object)
     THREAD thisThread = CurrentThread;
     long value = object->mhc.hashCode;
     MONITOR monitor;
+    FASTLOCK lock;
+    IDENTITYHASH entry;
 
 #if INCLUDEDEBUGCODE
     const char *format =
@@ -1575,7 +1791,21 @@ monitorEnter(OBJECT object)
 #endif /* INCLUDEDEBUGCODE */
 
                 return MonitorStatusOwn;
-            } else if (allocateFastLock(thisThread, object, 1, value)) {
+            } else if ((entry = allocateIdentityHash(object)) != NULL) {
+                /* We already have a hash code.  Move it to the side
+                 * table, so that a simple lock will still do.
+                 */
+                entry->hashCode = value;
+                SET_OBJECT_SIMPLE_LOCK(object, thisThread);
+#if INCLUDEDEBUGCODE
+                if (tracemonitors) {
+                    fprintf(stdout, format,
+                            (long)thisThread, "simple", (long)object, 0L, 0L);
+                }
+#endif /* INCLUDEDEBUGCODE */
+
+                return MonitorStatusOwn;
+            } else if (allocateFastLock(thisThread, object, 1, value) != NULL) {
                 /* We need a fast lock, since we already have a hash code.
                  * If the above allocation succeeds, then we're done.
                  */
@@ -1594,11 +1824,17 @@ monitorEnter(OBJECT object)
 
         case MHC_SIMPLE_LOCK:
             if (OBJECT_MHC_SIMPLE_THREAD(object) == thisThread) {
-                if (allocateFastLock(thisThread, object, 2, 0)) {
+                entry = IdentityHashCount > 0 ? findIdentityHash(object) : NULL;
+                if (allocateFastLock(thisThread, object, 2,
+                                     entry != NULL ? entry->hashCode : 0)
+                        != NULL) {
                     /* We need to upgrade from a simple lock to a fast lock,
-                     * since the depth is now 2.  Indicate that the hash code
-                     * is still implicitly 0.
+                     * since the depth is now 2.  The fast lock takes over
+                     * the hash code, if the object has one.
                      */
+                    if (entry != NULL) {
+                        removeIdentityHash(entry);
+                    }
 
 #if INCLUDEDEBUGCODE
                     if (tracemonitors) {
@@ -1616,13 +1852,14 @@ monitorEnter(OBJECT object)
 
         case MHC_EXTENDED_LOCK:
             if (OBJECT_MHC_EXTENDED_THREAD(object) == thisThread) {
-                thisThread->extendedLock.depth++;
+                lock = getFastLock(object);
+                lock->depth++;
 
 #if INCLUDEDEBUGCODE
                 if (tracemonitors) {
                     fprintf(stdout, format,
                             (long)thisThread, "fast", (long)object,
-                            (long)thisThread, (long)thisThread->extendedLock.depth);
+                            (long)thisThread, (long)lock->depth);
                 }
 #endif /* INCLUDEDEBUGCODE */
 
@@ -1664,6 +1901,9 @@ monitorEnter(OBJECT object)
     } else {
         /* Add ourselves to the wait queue.  Indicate that when we are
          * woken, the monitor's depth should be set to 1 */
+        RECORD_EVENT(FR_MONITOR_CONTENDED, object->ofClass,
+                     recorderThreadId(monitor->owner))
+        PROBE_MONITOR_CONTENDED(object)
         thisThread->monitor_depth = 1;
         addMonitorWait(monitor, thisThread);
         suspendThread();
@@ -1709,33 +1949,34 @@ monitorExit(OBJECT object, char** exceptionName)
             }
 #endif /* INCLUDEDEBUGCODE */
 
-            SET_OBJECT_HASHCODE(object, 0);
+            SET_OBJECT_HASHCODE(object, takeIdentityHash(object));
             return MonitorStatusRelease;
 
         case MHC_EXTENDED_LOCK:
             if (OBJECT_MHC_EXTENDED_THREAD(object) != thisThread) {
                 break;
             } else {
+                FASTLOCK lock = getFastLock(object);
                 int newDepth;
 
 #if INCLUDEDEBUGCODE
                 if (tracemonitors) {
                     fprintf(stdout, format,
                             (long)thisThread, "fast", (long)object,
-                            (long)thisThread, (long)thisThread->extendedLock.depth);
+                            (long)thisThread, (long)lock->depth);
                 }
 #endif /* INCLUDEDEBUGCODE */
 
-                newDepth = --thisThread->extendedLock.depth;
+                newDepth = --lock->depth;
                 if (newDepth == 0) {
                     /* Release the fast lock.  No one is waiting for it */
-                    SET_OBJECT_HASHCODE(object, thisThread->extendedLock.hashCode);
-                    FREE_EXTENDED_LOCK(thisThread);
+                    SET_OBJECT_HASHCODE(object, lock->hashCode);
+                    FREE_FAST_LOCK(lock);
                     return MonitorStatusRelease;
                 } else {
-                    if (newDepth == 1 && thisThread->extendedLock.hashCode==0){
+                    if (newDepth == 1 && lock->hashCode == 0) {
                         /* Simplify this to a simple lock */
-                        FREE_EXTENDED_LOCK(thisThread);
+                        FREE_FAST_LOCK(lock);
                         SET_OBJECT_SIMPLE_LOCK(object, thisThread);
                     }
                     return MonitorStatusOwn;
@@ -1765,6 +2006,9 @@ monitorExit(OBJECT object, char** exceptionName)
                     && monitor->condvar_waitq == NULL) {
                     /* Remove the monitor from the object */
                     SET_OBJECT_HASHCODE(object, monitor->hashCode);
+#if ENABLEPROFILING
+                    MonitorDeflationCounter++;
+#endif
 
                     /* Use the "owner" slot to keep a list
                      * of available monitors */
@@ -1784,6 +2028,56 @@ monitorExit(OBJECT object, char** exceptionName)
     return MonitorStatusError;
 }
 
+/*=========================================================================
+ * FUNCTION:      deflateObjectMonitor
+ * TYPE:          Monitor handler
+ * OVERVIEW:      Called by the garbage collector for each live object
+ *                that has a real monitor.  If no thread is waiting for
+ *                the monitor or is waiting to be notified, the monitor is
+ *                replaced by the equivalent fast lock, simple lock or
+ *                hash code, so that the collector can reclaim it.
+ * INTERFACE:
+ *   parameters:  object: an object whose mhc tag is MHC_MONITOR
+ *   returns:     TRUE if the monitor has been removed from the object
+ *=======================================================================*/
+
+bool_t
+deflateObjectMonitor(OBJECT object)
+{
+    MONITOR monitor = OBJECT_MHC_MONITOR(object);
+    THREAD owner = monitor->owner;
+    IDENTITYHASH entry;
+
+    if (monitor->monitor_waitq != NULL || monitor->condvar_waitq != NULL) {
+        return FALSE;
+    }
+
+    if (owner == NULL) {
+        SET_OBJECT_HASHCODE(object, monitor->hashCode);
+    } else if (monitor->depth == 1 && monitor->hashCode == 0) {
+        SET_OBJECT_SIMPLE_LOCK(object, owner);
+    } else if (monitor->depth == 1
+               && (entry = allocateIdentityHash(object)) != NULL) {
+        entry->hashCode = monitor->hashCode;
+        SET_OBJECT_SIMPLE_LOCK(object, owner);
+    } else if (allocateFastLock(owner, object,
+                                monitor->depth, monitor->hashCode) == NULL) {
+        return FALSE;
+    }
+
+#if INCLUDEDEBUGCODE
+    if (tracemonitors) {
+        fprintf(stdout, "Deflated monitor %lx of object %lx (owner=%lx)\n",
+                (long)monitor, (long)object, (long)owner);
+    }
+#endif /* INCLUDEDEBUGCODE */
+
+#if ENABLEPROFILING
+    MonitorDeflationCounter++;
+#endif
+    return TRUE;
+}
+
 /*=========================================================================
  * FUNCTION:      monitorWait()
  * TYPE:          Monitor handler
@@ -2001,6 +2295,146 @@ removeFromQueue(THREAD *queue_p, THREAD waiter)
     }
 }
 
+/*=========================================================================
+ * FUNCTION:      addRunnableThread()
+ * TYPE:          private instance-level operation
+ * OVERVIEW:      Add a thread to the queue of runnable threads.  With
+ *                PRIORITY_SCHEDULING the thread is added to the queue
+ *                of its own priority level.
+ * INTERFACE:
+ *   parameters:  thread: thread to add
+ *                where:  AT_START or AT_END
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+static void
+addRunnableThread(THREAD thread, queueWhere where)
+{
+#if PRIORITY_SCHEDULING
+    int level = threadPriority(thread);
+    thread->runLevel = level;
+    addThreadToQueue(&RunQueues[level], thread, where);
+    START_CRITICAL_SECTION
+        RunQueueMask |= (1 << level);
+    END_CRITICAL_SECTION
+#else
+    addThreadToQueue(&RunnableThreads, thread, where);
+#endif
+}
+
+#if ENABLE_JAVA_DEBUGGER
+
+/*=========================================================================
+ * FUNCTION:      removeRunnableThread()
+ * TYPE:          private instance-level operation
+ * OVERVIEW:      Remove a thread from the queue of runnable threads
+ *                (if it is on it)
+ * INTERFACE:
+ *   parameters:  thread: thread to remove
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+static void
+removeRunnableThread(THREAD thread)
+{
+#if PRIORITY_SCHEDULING
+    int level = thread->runLevel;
+    removeFromQueue(&RunQueues[level], thread);
+    START_CRITICAL_SECTION
+        if (RunQueues[level] == NIL) {
+            RunQueueMask &= ~(1 << level);
+        }
+    END_CRITICAL_SECTION
+#else
+    removeFromQueue(&RunnableThreads, thread);
+#endif
+}
+
+#endif /* ENABLE_JAVA_DEBUGGER */
+
+/*=========================================================================
+ * FUNCTION:      isRunnableThreadWaiting()
+ * TYPE:          private instance-level operation
+ * OVERVIEW:      Check if a runnable thread should get the processor
+ *                in place of the given (running) thread once its time
+ *                slice is over.  With PRIORITY_SCHEDULING only threads
+ *                of the same or a higher priority qualify.
+ * INTERFACE:
+ *   parameters:  thread: the running thread
+ *   returns:     TRUE if a thread switch should take place
+ *=======================================================================*/
+
+static bool_t
+isRunnableThreadWaiting(THREAD thread)
+{
+#if PRIORITY_SCHEDULING
+    return (RunQueueMask >> threadPriority(thread)) != 0;
+#else
+    return RunnableThreads != NULL;
+#endif
+}
+
+#if PRIORITY_SCHEDULING
+
+/*=========================================================================
+ * FUNCTION:      highestRunLevel()
+ * TYPE:          private operation
+ * OVERVIEW:      Return the number of the highest bit set in a run
+ *                queue mask, in constant time.
+ * INTERFACE:
+ *   parameters:  mask: a non-zero value of RunQueueMask
+ *   returns:     priority level
+ *=======================================================================*/
+
+static int
+highestRunLevel(int mask)
+{
+    int level = 0;
+    if (mask & 0xFF00) { mask >>= 8; level += 8; }
+    if (mask & 0xF0)   { mask >>= 4; level += 4; }
+    if (mask & 0xC)    { mask >>= 2; level += 2; }
+    if (mask & 0x2)    { level += 1; }
+    return level;
+}
+
+/*=========================================================================
+ * FUNCTION:      ageRunQueues()
+ * TYPE:          private operation
+ * OVERVIEW:      Move the thread that has waited longest at each priority
+ *                level up by one level, so that threads of low priority
+ *                eventually run even if threads of higher priority are
+ *                always runnable.  The levels are visited from the top
+ *                down so that each thread moves at most one level.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+static void
+ageRunQueues(void)
+{
+    int level;
+    for (level = MAX_PRIORITY - 1; level >= MIN_PRIORITY; level--) {
+        if (RunQueueMask & (1 << level)) {
+            THREAD thread = removeQueueStart(&RunQueues[level]);
+            START_CRITICAL_SECTION
+                if (RunQueues[level] == NIL) {
+                    RunQueueMask &= ~(1 << level);
+                }
+            END_CRITICAL_SECTION
+            if (thread != NIL) {
+                thread->runLevel = level + 1;
+                addThreadToQueue(&RunQueues[level + 1], thread, AT_END);
+                START_CRITICAL_SECTION
+                    RunQueueMask |= (1 << (level + 1));
+                END_CRITICAL_SECTION
+            }
+        }
+    }
+}
+
+#endif /* PRIORITY_SCHEDULING */
+
 static int
 queueLength(THREAD queue) {
     if (queue == NULL) {
@@ -2067,7 +2501,7 @@ printMonitor(OBJECT object) {
         case MHC_EXTENDED_LOCK: {
             THREAD thread = OBJECT_MHC_EXTENDED_THREAD(object);
             fprintf(stdout, "Object %lx fast lock on thread %lx, depth=%lx\n",
-                   (long)object, (long)thread, (long)thread->extendedLock.depth);
+                   (long)object, (long)thread, (long)getFastLock(object)->depth);
             break;
         }
 
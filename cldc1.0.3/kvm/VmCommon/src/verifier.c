@@ -74,34 +74,34 @@ struct DoubleWordItem {
 };
 
 /* Global variables holding the type key of well-known classes */
-unsigned short booleanArrayClassKey;
-unsigned short byteArrayClassKey;
-unsigned short charArrayClassKey;
-unsigned short shortArrayClassKey;
-unsigned short intArrayClassKey;
-unsigned short longArrayClassKey;
+ISOLATE_LOCAL unsigned short booleanArrayClassKey;
+ISOLATE_LOCAL unsigned short byteArrayClassKey;
+ISOLATE_LOCAL unsigned short charArrayClassKey;
+ISOLATE_LOCAL unsigned short shortArrayClassKey;
+ISOLATE_LOCAL unsigned short intArrayClassKey;
+ISOLATE_LOCAL unsigned short longArrayClassKey;
 
 #if IMPLEMENTS_FLOAT
-unsigned short floatArrayClassKey;
-unsigned short doubleArrayClassKey;
+ISOLATE_LOCAL unsigned short floatArrayClassKey;
+ISOLATE_LOCAL unsigned short doubleArrayClassKey;
 #endif
 
-unsigned short objectClassKey;
-unsigned short stringClassKey;
-unsigned short throwableClassKey;
-unsigned short objectArrayClassKey;
+ISOLATE_LOCAL unsigned short objectClassKey;
+ISOLATE_LOCAL unsigned short stringClassKey;
+ISOLATE_LOCAL unsigned short throwableClassKey;
+ISOLATE_LOCAL unsigned short objectArrayClassKey;
 
 /* Global variables used by the verifier. Obviously the verifier is
  * not re-entrant.
  */
-unsigned short* vStack;
-unsigned short* vLocals;
-unsigned short vMaxStack;
-unsigned short vFrameSize;
-unsigned short vSP;
-unsigned short lastStackPop;
-struct DoubleWordItem lastStackPop2;
-unsigned short lastLocalGet;
+ISOLATE_LOCAL unsigned short* vStack;
+ISOLATE_LOCAL unsigned short* vLocals;
+ISOLATE_LOCAL unsigned short vMaxStack;
+ISOLATE_LOCAL unsigned short vFrameSize;
+ISOLATE_LOCAL unsigned short vSP;
+ISOLATE_LOCAL unsigned short lastStackPop;
+ISOLATE_LOCAL struct DoubleWordItem lastStackPop2;
+ISOLATE_LOCAL unsigned short lastLocalGet;
 
 /* Flags used to control how to match two stack maps.
  * One of the stack maps is derived as part of the type checking process.
@@ -2351,6 +2351,7 @@ verifyClass(INSTANCE_CLASS thisClass)
 #if USESTATIC
     CONSTANTPOOL cp = thisClass->constPool;
 #endif
+    STARTUP_TRACE_BEGIN_CLASS(STARTUP_VERIFY, thisClass, NULL)
     if (thisClass->methodTable) {
         if (!checkVerifiedClassList(thisClass)) {
             /* Verify all methods */
@@ -2393,7 +2394,13 @@ verifyClass(INSTANCE_CLASS thisClass)
 #endif
             }
         }
+
+        /* Install the superinstructions */
+        if (result == 0) {
+            FUSE_CLASS_CODE(thisClass)
+        }
     }
+    STARTUP_TRACE_END(STARTUP_VERIFY)
     if (result == 0) { 
         thisClass->status = CLASS_VERIFIED;
     }
@@ -124,37 +124,6 @@ long debuggerNotifyList=Dbg_EventKind_NONE;
 
 #if INCLUDEDEBUGCODE
 
-/*========================================================================
- * OP Code Lengths used by isLegalOffset() below. 
- *========================================================================*/
-static const unsigned char opcodeLengths[] = {
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 0 */
-     1, 1, 1, 1, 1, 1, 2, 3, 2, 3, /* 10 */
-     3, 2, 2, 2, 2, 2, 1, 1, 1, 1, /* 20 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 30 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 40 */
-     1, 1, 1, 1, 2, 2, 2, 2, 2, 1, /* 50 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 60 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 70 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 80 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 90 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 100 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 110 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 120 */
-     1, 1, 3, 1, 1, 1, 1, 1, 1, 1, /* 130 */
-     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 140 */
-     1, 1, 1, 3, 3, 3, 3, 3, 3, 3, /* 150 */
-     3, 3, 3, 3, 3, 3, 3, 3, 3, 2, /* 160 */
-     0, 0, 1, 1, 1, 1, 1, 1, 3, 3, /* 170 */
-     3, 3, 3, 3, 3, 5, 0, 3, 2, 3, /* 180 */
-     1, 1, 3, 3, 1, 1, 0, 4, 3, 3, /* 190 */
-     5, 5, 1,                      /* 200 - 202 */
-              3, 3, 3, 3, 3, 3, 3, /* 202 - 209.  Artificial */
-     3, 3, 3, 0, 3, 3, 3, 5, 3, 3, /* 210.        Artifical */
-     4, 3, 3, 1                    /* 220 - 223.  Aritifical */
- };
-
-
 /*========================================================================
  * Function:        isLegalOffset()
  * Overview:        Given a method and an offset, it determines if the 
@@ -204,7 +173,7 @@ static bool_t isLegalOffset(METHOD thisMethod, long offset)
              break;
 
          default:
-             currentCode += opcodeLengths[token];
+             currentCode += byteCodeLengths[token];
              break;
        }
      }
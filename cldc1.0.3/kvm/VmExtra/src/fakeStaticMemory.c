@@ -55,9 +55,9 @@
  * Definitions and variables
  *=======================================================================*/
 
-static char * memoryStart = 0;
-static int memoryOffset;
-static int pageSize;
+static ISOLATE_LOCAL char * memoryStart = 0;
+static ISOLATE_LOCAL int memoryOffset;
+static ISOLATE_LOCAL int pageSize;
 
 #define MEMORY_SIZE 0x20000
 #define MEMORY_SHIBBOLETH 0xCAFEBABE
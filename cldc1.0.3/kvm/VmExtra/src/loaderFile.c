@@ -97,17 +97,17 @@ typedef struct classPathEntryStruct {
  */
 
 /* Remember: This table contains object pointers (= GC root) */
-static POINTERLIST ClassPathTable = NIL;
+static ISOLATE_LOCAL POINTERLIST ClassPathTable = NIL;
 
 /* Set in main() to classpath environment */
-char* UserClassPath = NULL;
+ISOLATE_LOCAL char* UserClassPath = NULL;
 
-static unsigned int MaxClassPathTableLength = 0;
+static ISOLATE_LOCAL unsigned int MaxClassPathTableLength = 0;
 
 #if SVM
-static struct jarPointerStruct* TrustedClassfile;
+static ISOLATE_LOCAL struct jarPointerStruct* TrustedClassfile;
 #if INCLUDEDEBUGCODE
-static INSTANCE_CLASS TrustedClass;
+static ISOLATE_LOCAL INSTANCE_CLASS TrustedClass;
 #endif /* INCLUDEDEBUGCODE */
 #endif /* SVM */
 
@@ -59,6 +59,44 @@ void printHelpText() {
     fprintf(stdout, "  -version\n");
     fprintf(stdout, "  -classpath <filepath>\n");
     fprintf(stdout, "  -heapsize <size> (e.g. 65536 or 128k or 1M)\n");
+#if MULTIPLE_ISOLATES
+    fprintf(stdout, "  -isolates <count> (run the program in several isolates)\n");
+#endif /* MULTIPLE_ISOLATES */
+#if ENABLE_SAMPLING_PROFILER
+    fprintf(stdout, "  -profile <file> (write a sampling profile to file)\n");
+    fprintf(stdout, "  -profilerate <samples per second>\n");
+#endif /* ENABLE_SAMPLING_PROFILER */
+#if ENABLE_FLIGHT_RECORDER
+    fprintf(stdout, "  -record <file> (record VM events, written to file at exit\n");
+    fprintf(stdout, "                  and on SIGUSR2)\n");
+    fprintf(stdout, "  -recordsize <number of events kept>\n");
+#endif /* ENABLE_FLIGHT_RECORDER */
+#if ENABLE_ALLOCATION_PROFILER
+    fprintf(stdout, "  -allocprofile <file> (write an allocation profile to file\n");
+    fprintf(stdout, "                        at exit and on SIGUSR1)\n");
+    fprintf(stdout, "  -allocinterval <bytes between recorded allocations>\n");
+#endif /* ENABLE_ALLOCATION_PROFILER */
+#if ENABLE_HEAP_DUMP
+    fprintf(stdout, "  -heapdump <file> (dump the heap to file on SIGQUIT and\n");
+    fprintf(stdout, "                    when out of memory)\n");
+#endif /* ENABLE_HEAP_DUMP */
+#if ENABLE_GC_STATISTICS
+    fprintf(stdout, "  -verbosegc (print a line per garbage collection)\n");
+    fprintf(stdout, "  -gcstats <file> (write garbage collection statistics\n");
+    fprintf(stdout, "                   to file at exit)\n");
+#endif /* ENABLE_GC_STATISTICS */
+#if ENABLE_EXECUTION_COUNTERS
+    fprintf(stdout, "  -counters <file> (write method execution counters to file\n");
+    fprintf(stdout, "                    at exit)\n");
+    fprintf(stdout, "  -bytecodecounts (count bytecodes and bytecode pairs too)\n");
+#endif /* ENABLE_EXECUTION_COUNTERS */
+#if ENABLE_STARTUP_TRACE
+    fprintf(stdout, "  -startuptrace <file> (print the startup time breakdown and\n");
+    fprintf(stdout, "                        write it to file as trace events)\n");
+#endif /* ENABLE_STARTUP_TRACE */
+#if ENABLE_SUPERINSTRUCTIONS
+    fprintf(stdout, "  -nosuperinstructions (do not fuse frequent bytecode pairs)\n");
+#endif /* ENABLE_SUPERINSTRUCTIONS */
 
 #if ENABLE_JAVA_DEBUGGER
     fprintf(stdout, "  -debugger\n");
@@ -83,6 +121,10 @@ FOR_EACH_TRACE_FLAG(PRINT_TRACE_OPTION)
 int main (int argc, char* argv[]) {
     int result;
 
+#if MULTIPLE_ISOLATES
+    int isolateCount = 1;
+#endif
+
 #if USE_JAM
     char *jamInstalledAppsDir = "./instapps";
 #endif
@@ -157,6 +199,91 @@ int main (int argc, char* argv[]) {
             UserClassPath = argv[2];
             argv+=2; argc -=2;
 
+#if MULTIPLE_ISOLATES
+        } else if ((strcmp(argv[1], "-isolates") == 0) && argc > 2) {
+            isolateCount = atoi(argv[2]);
+            if (isolateCount < 1) {
+                printHelpText();
+                exit(1);
+            }
+            argv+=2; argc -=2;
+#endif /* MULTIPLE_ISOLATES */
+
+#if ENABLE_SAMPLING_PROFILER
+        } else if ((strcmp(argv[1], "-profile") == 0) && argc > 2) {
+            SamplingProfilerFile = argv[2];
+            argv+=2; argc -=2;
+        } else if ((strcmp(argv[1], "-profilerate") == 0) && argc > 2) {
+            SamplingProfilerRate = atoi(argv[2]);
+            if (SamplingProfilerRate < 1) {
+                printHelpText();
+                exit(1);
+            }
+            argv+=2; argc -=2;
+#endif /* ENABLE_SAMPLING_PROFILER */
+
+#if ENABLE_FLIGHT_RECORDER
+        } else if ((strcmp(argv[1], "-record") == 0) && argc > 2) {
+            FlightRecorderFile = argv[2];
+            argv+=2; argc -=2;
+        } else if ((strcmp(argv[1], "-recordsize") == 0) && argc > 2) {
+            FlightRecorderSize = atol(argv[2]);
+            if (FlightRecorderSize < 1) {
+                printHelpText();
+                exit(1);
+            }
+            argv+=2; argc -=2;
+#endif /* ENABLE_FLIGHT_RECORDER */
+
+#if ENABLE_ALLOCATION_PROFILER
+        } else if ((strcmp(argv[1], "-allocprofile") == 0) && argc > 2) {
+            AllocationProfilerFile = argv[2];
+            argv+=2; argc -=2;
+        } else if ((strcmp(argv[1], "-allocinterval") == 0) && argc > 2) {
+            AllocationProfilerInterval = atol(argv[2]);
+            if (AllocationProfilerInterval < 0) {
+                printHelpText();
+                exit(1);
+            }
+            argv+=2; argc -=2;
+#endif /* ENABLE_ALLOCATION_PROFILER */
+
+#if ENABLE_HEAP_DUMP
+        } else if ((strcmp(argv[1], "-heapdump") == 0) && argc > 2) {
+            HeapDumpFile = argv[2];
+            argv+=2; argc -=2;
+#endif /* ENABLE_HEAP_DUMP */
+
+#if ENABLE_GC_STATISTICS
+        } else if (strcmp(argv[1], "-verbosegc") == 0) {
+            VerboseGC = TRUE;
+            argv++; argc--;
+        } else if ((strcmp(argv[1], "-gcstats") == 0) && argc > 2) {
+            GCStatisticsFile = argv[2];
+            argv+=2; argc -=2;
+#endif /* ENABLE_GC_STATISTICS */
+
+#if ENABLE_EXECUTION_COUNTERS
+        } else if ((strcmp(argv[1], "-counters") == 0) && argc > 2) {
+            ExecutionCountersFile = argv[2];
+            argv+=2; argc -=2;
+        } else if (strcmp(argv[1], "-bytecodecounts") == 0) {
+            BytecodeCountersWanted = TRUE;
+            argv++; argc--;
+#endif /* ENABLE_EXECUTION_COUNTERS */
+
+#if ENABLE_STARTUP_TRACE
+        } else if ((strcmp(argv[1], "-startuptrace") == 0) && argc > 2) {
+            StartupTraceFile = argv[2];
+            argv+=2; argc -=2;
+#endif /* ENABLE_STARTUP_TRACE */
+
+#if ENABLE_SUPERINSTRUCTIONS
+        } else if (strcmp(argv[1], "-nosuperinstructions") == 0) {
+            SuperinstructionsEnabled = FALSE;
+            argv++; argc--;
+#endif /* ENABLE_SUPERINSTRUCTIONS */
+
 #if INCLUDEDEBUGCODE
 
 #define CHECK_FOR_OPTION_IN_ARGV(varName, userName)  \
@@ -235,6 +362,28 @@ int main (int argc, char* argv[]) {
 
     {
  
+#if MULTIPLE_ISOLATES
+        if (isolateCount > 1 && argc > 0) {
+            /* Run the same program in several isolates at once */
+            /* and return the first non-zero exit code          */
+            ISOLATE* isolates = (ISOLATE*)malloc(isolateCount * sizeof(ISOLATE));
+            int i;
+            result = 0;
+            for (i = 0; i < isolateCount; i++) {
+                isolates[i] = KVM_StartIsolate(UserClassPath,
+                                               RequestedHeapSize, argc, argv);
+            }
+            for (i = 0; i < isolateCount; i++) {
+                int exitCode = (isolates[i] == NULL)
+                    ? -1 : KVM_JoinIsolate(isolates[i]);
+                if (result == 0) {
+                    result = exitCode;
+                }
+            }
+            free(isolates);
+        } else
+#endif /* MULTIPLE_ISOLATES */
+
         /* Call the portable KVM startup routine */
         result = StartJVM(argc, argv);
 
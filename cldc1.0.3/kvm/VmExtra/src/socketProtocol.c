@@ -51,6 +51,23 @@
 #define NO_SERVER_SOCKETS 0
 #endif
 
+/*
+ * Record the time spent in a socket operation in the flight
+ * recorder.  Without asynchronous native functions the sockets
+ * are non-blocking, so only the operations that would have
+ * blocked (and will be retried) are recorded.
+ */
+#if ASYNCHRONOUS_NATIVE_FUNCTIONS
+#define RECORD_SOCKET_WAIT(start, fd, operation, res) \
+    RECORD_THREAD_EVENT(aiocb->thread, FR_SOCKET_WAIT, start, fd, operation)
+#else
+#define RECORD_SOCKET_WAIT(start, fd, operation, res) \
+    if ((res) == -2) {                                \
+        RECORD_THREAD_EVENT(aiocb->thread, FR_SOCKET_WAIT, \
+                            start, fd, operation)     \
+    }
+#endif /* ASYNCHRONOUS_NATIVE_FUNCTIONS */
+
 #if INCLUDEDEBUGCODE
 #define NDEBUG0(fmt)                         if (tracenetworking) { fprintf(stdout, fmt);                         }
 #define NDEBUG1(fmt, p1)                     if (tracenetworking) { fprintf(stdout, fmt, p1);                     }
@@ -207,6 +224,7 @@ ASYNC_FUNCTION_START(Java_com_sun_cldc_io_j2me_socket_Protocol_open0)
     char            name[MAX_HOST_LENGTH];
     char           *host;
     int             port;
+    DECLARE_RECORDER_START(waitStart)
 
     aiocb->instance = instance; /* Save instance in ASYNCIOCB */
 
@@ -254,6 +272,8 @@ ASYNC_FUNCTION_START(Java_com_sun_cldc_io_j2me_socket_Protocol_open0)
     ASYNC_enableGarbageCollection();
     fd = prim_com_sun_cldc_io_j2me_socket_Protocol_open0(host, port, &exception);
     ASYNC_disableGarbageCollection();
+    RECORD_THREAD_EVENT(aiocb->thread, FR_SOCKET_WAIT, waitStart,
+                        fd, FR_SOCKET_CONNECT)
 
     NDEBUG6("socket::open0 name='%s' host='%s' port=%ld fd = %ld exception = '%s' ne=%ld\n",
              name, host, (long)port, (long)fd,
@@ -295,6 +315,7 @@ ASYNC_FUNCTION_START(Java_com_sun_cldc_io_j2me_socket_Protocol_read0)
     INSTANCE   instance = ASYNC_popStackAsType(INSTANCE);
     long fd;
     int  res;
+    DECLARE_RECORDER_START(waitStart)
     aiocb->instance = instance;
     fd = getSocketHandle(aiocb);
 
@@ -339,6 +360,7 @@ ASYNC_FUNCTION_START(Java_com_sun_cldc_io_j2me_socket_Protocol_read0)
         res = prim_com_sun_cldc_io_j2me_socket_Protocol_read0(fd,
                   (char *)array->bdata + offset, length);
 #endif /* ASYNCHRONOUS_NATIVE_FUNCTIONS */
+        RECORD_SOCKET_WAIT(waitStart, fd, FR_SOCKET_READ, res)
     }
 
     NDEBUG2("socket::read0 res=%ld ne=%ld\n", (long)res, (long)netError());
@@ -383,6 +405,7 @@ ASYNC_FUNCTION_START(Java_com_sun_cldc_io_j2me_socket_Protocol_write0)
     INSTANCE instance = ASYNC_popStackAsType(INSTANCE);
     long fd;
     int  res;
+    DECLARE_RECORDER_START(waitStart)
 
     aiocb->instance = instance;
     fd = getSocketHandle(aiocb);
@@ -423,6 +446,7 @@ ASYNC_FUNCTION_START(Java_com_sun_cldc_io_j2me_socket_Protocol_write0)
         res = prim_com_sun_cldc_io_j2me_socket_Protocol_write0(fd,
                   (char *)array->bdata + offset, length);
 #endif /* ASYNCHRONOUS_NATIVE_FUNCTIONS */
+        RECORD_SOCKET_WAIT(waitStart, fd, FR_SOCKET_WRITE, res)
     }
 
     NDEBUG3("socket::write0 res=%ld l=%ld ne=%ld\n",
@@ -633,6 +657,7 @@ ASYNC_FUNCTION_START(Java_com_sun_cldc_io_j2me_serversocket_Protocol_accept)
     INSTANCE instance = ASYNC_popStackAsType(INSTANCE);
     long fd;
     int  res = 0;
+    DECLARE_RECORDER_START(waitStart)
     aiocb->instance = instance;
     fd = getSocketHandle(aiocb);
 
@@ -641,6 +666,7 @@ ASYNC_FUNCTION_START(Java_com_sun_cldc_io_j2me_serversocket_Protocol_accept)
     ASYNC_enableGarbageCollection();
     res = prim_com_sun_cldc_io_j2me_serversocket_Protocol_accept(fd);
     ASYNC_disableGarbageCollection();
+    RECORD_SOCKET_WAIT(waitStart, fd, FR_SOCKET_ACCEPT, res)
 
     NDEBUG3("serversocket::accept res=%ld fd=%ld ne=%ld\n",
             (long)res, fd, (long)netError());
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * KVM
+ *=========================================================================
+ * SYSTEM:    KVM
+ * SUBSYSTEM: Unix-specific support for multiple isolates
+ * FILE:      isolate_md.c
+ * OVERVIEW:  Runs each isolate (an independent virtual machine) on
+ *            its own POSIX thread.  All VM state is thread-local
+ *            when MULTIPLE_ISOLATES is on (see main.h), including the
+ *            thread-local startup options, so a new isolate starts
+ *            with a copy of the options of the thread that started it.
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <global.h>
+
+#if MULTIPLE_ISOLATES
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+#define DECLARE_TRACE_FLAG_FIELD(varName, userName) int varName;
+#define SAVE_TRACE_FLAG(varName, userName) isolate->varName = varName;
+#define RESTORE_TRACE_FLAG(varName, userName) varName = isolate->varName;
+
+struct isolateStruct {
+    pthread_t thread;
+    int       number;
+    char*     classPath;
+    long      heapSize;
+    int       argc;
+    char**    argv;
+    int       exitCode;
+
+    /* The thread-local options of the starting thread */
+    FOR_EACH_TRACE_FLAG(DECLARE_TRACE_FLAG_FIELD)
+};
+
+/* Number of isolates started so far, protected by isolateLock */
+static int isolateCount = 0;
+static pthread_mutex_t isolateLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*=========================================================================
+ * FUNCTION:      runIsolate
+ * TYPE:          private operation
+ * OVERVIEW:      Body of the native thread of an isolate.  Sets up the
+ *                (thread-local) startup options and runs the VM.
+ * INTERFACE:
+ *   parameters:  the ISOLATE
+ *   returns:     NULL
+ *=======================================================================*/
+
+static void* runIsolate(void* arg) {
+    ISOLATE isolate = (ISOLATE)arg;
+
+    JamEnabled = FALSE;
+    JamRepeat = FALSE;
+    IsolateNumber = isolate->number;
+    RequestedHeapSize = isolate->heapSize;
+    UserClassPath = isolate->classPath;
+    FOR_EACH_TRACE_FLAG(RESTORE_TRACE_FLAG)
+
+    isolate->exitCode = StartJVM(isolate->argc, isolate->argv);
+    return NULL;
+}
+
+/*=========================================================================
+ * FUNCTION:      KVM_StartIsolate
+ * TYPE:          public global operation
+ * OVERVIEW:      Start a new isolate on a new native thread.  Options
+ *                that are not thread-local (e.g., -gcstats or -record)
+ *                apply to every isolate anyway; the thread-local ones
+ *                (the trace flags) are copied from the calling thread.
+ * INTERFACE:
+ *   parameters:  class path, heap size in bytes, command line arguments
+ *                (class name first)
+ *   returns:     the new ISOLATE, or NULL if it could not be started
+ *=======================================================================*/
+
+ISOLATE KVM_StartIsolate(char* classPath, long heapSize,
+                         int argc, char* argv[]) {
+    ISOLATE isolate = (ISOLATE)malloc(sizeof(struct isolateStruct));
+    if (isolate == NULL) {
+        return NULL;
+    }
+    isolate->classPath = classPath;
+    isolate->heapSize  = heapSize;
+    isolate->argc      = argc;
+    isolate->argv      = argv;
+    isolate->exitCode  = 0;
+    FOR_EACH_TRACE_FLAG(SAVE_TRACE_FLAG)
+
+    pthread_mutex_lock(&isolateLock);
+    isolate->number = ++isolateCount;
+    pthread_mutex_unlock(&isolateLock);
+
+    if (pthread_create(&isolate->thread, NULL, runIsolate, isolate) != 0) {
+        free(isolate);
+        return NULL;
+    }
+    return isolate;
+}
+
+/*=========================================================================
+ * FUNCTION:      KVM_JoinIsolate
+ * TYPE:          public global operation
+ * OVERVIEW:      Wait for an isolate to terminate and release it.
+ * INTERFACE:
+ *   parameters:  an ISOLATE returned by KVM_StartIsolate
+ *   returns:     the exit code of the isolate
+ *=======================================================================*/
+
+int KVM_JoinIsolate(ISOLATE isolate) {
+    int exitCode;
+    pthread_join(isolate->thread, NULL);
+    exitCode = isolate->exitCode;
+    free(isolate);
+    return exitCode;
+}
+
+#endif /* MULTIPLE_ISOLATES */
@@ -38,6 +38,10 @@
 #include <signal.h>
 #include <fcntl.h>
 #include <sys/mman.h>
+#if TIMER_RESCHEDULING || ENABLE_FLIGHT_RECORDER || ENABLE_GC_STATISTICS \
+    || ENABLE_STARTUP_TRACE
+#include <time.h>
+#endif
 
 /*=========================================================================
  * Helper variables and methods
@@ -53,7 +57,7 @@
 #define SECOND 13
 #define MILLISECOND 14
 
-static unsigned long date[MAXCALENDARFLDS];
+static ISOLATE_LOCAL unsigned long date[MAXCALENDARFLDS];
 
 /*=========================================================================
  * FUNCTION:      alertUser()
@@ -164,6 +168,233 @@ static void signal_handler(int sig) {
     abort();
 }
 
+#if TIMER_RESCHEDULING
+
+static timer_t rescheduleTimer;
+static bool_t  rescheduleTimerStarted = FALSE;
+
+/*=========================================================================
+ * FUNCTION:      reschedule_handler
+ * TYPE:          thread scheduling
+ * OVERVIEW:      called on every tick of the rescheduling timer. Counts
+ *                down the time slice of the current thread and asks
+ *                the interpreter to switch threads when it runs out.
+ * INTERFACE:
+ *   parameters:  signal
+ *   returns:     none
+ *=======================================================================*/
+
+static void reschedule_handler(int sig) {
+    if (--Timeslice <= 0) {
+        RescheduleRequested = TRUE;
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      StartRescheduleTimer_md
+ * TYPE:          thread scheduling
+ * OVERVIEW:      start a periodic SIGALRM timer with a period of
+ *                TIMER_TICK_MICROSECONDS.
+ * INTERFACE:
+ *   parameters:  none
+ *   returns:     none
+ *=======================================================================*/
+
+void StartRescheduleTimer_md(void) {
+    struct sigaction action;
+    struct sigevent event;
+    struct itimerspec period;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = reschedule_handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    /* Keep the sampling timer (if any) from interrupting this handler */
+    sigaddset(&action.sa_mask, SIGPROF);
+    sigaction(SIGALRM, &action, NULL);
+
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = SIGALRM;
+    if (timer_create(CLOCK_MONOTONIC, &event, &rescheduleTimer) != 0) {
+        fatalError("Cannot create the rescheduling timer");
+    }
+
+    period.it_interval.tv_sec  = TIMER_TICK_MICROSECONDS / 1000000;
+    period.it_interval.tv_nsec = (TIMER_TICK_MICROSECONDS % 1000000) * 1000;
+    period.it_value = period.it_interval;
+    timer_settime(rescheduleTimer, 0, &period, NULL);
+    rescheduleTimerStarted = TRUE;
+}
+
+/*=========================================================================
+ * FUNCTION:      StopRescheduleTimer_md
+ * TYPE:          thread scheduling
+ * OVERVIEW:      stop the timer started by StartRescheduleTimer_md.
+ * INTERFACE:
+ *   parameters:  none
+ *   returns:     none
+ *=======================================================================*/
+
+void StopRescheduleTimer_md(void) {
+    if (rescheduleTimerStarted) {
+        timer_delete(rescheduleTimer);
+        signal(SIGALRM, SIG_DFL);
+        rescheduleTimerStarted = FALSE;
+    }
+}
+
+#endif /* TIMER_RESCHEDULING */
+
+#if ENABLE_SAMPLING_PROFILER
+
+static bool_t samplingTimerStarted = FALSE;
+
+/*=========================================================================
+ * FUNCTION:      sample_handler
+ * TYPE:          profiling
+ * OVERVIEW:      called on every tick of the sampling timer. Asks the
+ *                interpreter to record a sample of the Java stack.
+ * INTERFACE:
+ *   parameters:  signal
+ *   returns:     none
+ *=======================================================================*/
+
+static void sample_handler(int sig) {
+    requestSample();
+}
+
+/*=========================================================================
+ * FUNCTION:      StartSamplingTimer_md
+ * TYPE:          profiling
+ * OVERVIEW:      start a periodic SIGPROF timer that ticks "rate"
+ *                times per second of CPU time used by the process.
+ * INTERFACE:
+ *   parameters:  rate: samples per second
+ *   returns:     none
+ *=======================================================================*/
+
+void StartSamplingTimer_md(int rate) {
+    struct sigaction action;
+    struct itimerval period;
+    long microseconds = 1000000L / rate;
+
+    if (microseconds <= 0) {
+        microseconds = 1;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = sample_handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    /* Keep the rescheduling timer (if any) from interrupting this handler */
+    sigaddset(&action.sa_mask, SIGALRM);
+    sigaction(SIGPROF, &action, NULL);
+
+    period.it_interval.tv_sec  = microseconds / 1000000;
+    period.it_interval.tv_usec = microseconds % 1000000;
+    period.it_value = period.it_interval;
+    if (setitimer(ITIMER_PROF, &period, NULL) != 0) {
+        fatalError("Cannot start the sampling timer");
+    }
+    samplingTimerStarted = TRUE;
+}
+
+/*=========================================================================
+ * FUNCTION:      StopSamplingTimer_md
+ * TYPE:          profiling
+ * OVERVIEW:      stop the timer started by StartSamplingTimer_md.
+ * INTERFACE:
+ *   parameters:  none
+ *   returns:     none
+ *=======================================================================*/
+
+void StopSamplingTimer_md(void) {
+    if (samplingTimerStarted) {
+        struct itimerval period;
+        memset(&period, 0, sizeof(period));
+        setitimer(ITIMER_PROF, &period, NULL);
+        signal(SIGPROF, SIG_DFL);
+        samplingTimerStarted = FALSE;
+    }
+}
+
+#endif /* ENABLE_SAMPLING_PROFILER */
+
+#if ENABLE_FLIGHT_RECORDER
+
+/*=========================================================================
+ * FUNCTION:      dump_handler
+ * TYPE:          profiling
+ * OVERVIEW:      called on SIGUSR2. Asks the VM to write the flight
+ *                recorder buffer at the next reschedule point.
+ * INTERFACE:
+ *   parameters:  signal
+ *   returns:     none
+ *=======================================================================*/
+
+static void dump_handler(int sig) {
+    requestFlightRecorderDump();
+}
+
+#endif /* ENABLE_FLIGHT_RECORDER */
+
+#if ENABLE_FLIGHT_RECORDER || ENABLE_GC_STATISTICS || ENABLE_STARTUP_TRACE
+
+/*=========================================================================
+ * FUNCTION:      MonotonicTime_md()
+ * TYPE:          profiling
+ * OVERVIEW:      Returns a time stamp that never goes backwards, even
+ *                if the wall clock is changed.
+ * INTERFACE:
+ *   parameters:  none
+ *   returns:     time in microseconds from an arbitrary origin
+ *=======================================================================*/
+
+ulong64 MonotonicTime_md(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ulong64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+#endif /* ENABLE_FLIGHT_RECORDER || ENABLE_GC_STATISTICS || ENABLE_STARTUP_TRACE */
+
+#if ENABLE_ALLOCATION_PROFILER
+
+/*=========================================================================
+ * FUNCTION:      snapshot_handler
+ * TYPE:          profiling
+ * OVERVIEW:      called on SIGUSR1. Asks the VM to write an allocation
+ *                profile snapshot at the next reschedule point.
+ * INTERFACE:
+ *   parameters:  signal
+ *   returns:     none
+ *=======================================================================*/
+
+static void snapshot_handler(int sig) {
+    requestAllocationSnapshot();
+}
+
+#endif /* ENABLE_ALLOCATION_PROFILER */
+
+#if ENABLE_HEAP_DUMP
+
+/*=========================================================================
+ * FUNCTION:      heapdump_handler
+ * TYPE:          debugging
+ * OVERVIEW:      called on SIGQUIT. Asks the VM to dump the heap at the
+ *                next reschedule point.
+ * INTERFACE:
+ *   parameters:  signal
+ *   returns:     none
+ *=======================================================================*/
+
+static void heapdump_handler(int sig) {
+    requestHeapDump();
+}
+
+#endif /* ENABLE_HEAP_DUMP */
+
 /*=========================================================================
  * FUNCTION:      InitializeNativeCode
  * TYPE:          initialization
@@ -182,6 +413,24 @@ void InitializeNativeCode() {
     signal(SIGBUS,  signal_handler); 
     signal(SIGSEGV, signal_handler); 
     signal(SIGPIPE, SIG_IGN);
+#if ENABLE_FLIGHT_RECORDER
+    /* "kill -USR2 <pid>" writes the flight recorder buffer */
+    if (FlightRecorderFile != NULL) {
+        signal(SIGUSR2, dump_handler);
+    }
+#endif
+#if ENABLE_ALLOCATION_PROFILER
+    /* "kill -USR1 <pid>" writes an allocation profile snapshot */
+    if (AllocationProfilerFile != NULL) {
+        signal(SIGUSR1, snapshot_handler);
+    }
+#endif
+#if ENABLE_HEAP_DUMP
+    /* "kill -QUIT <pid>" writes a heap dump */
+    if (HeapDumpFile != NULL) {
+        signal(SIGQUIT, heapdump_handler);
+    }
+#endif
 }
 
 /*=========================================================================
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * Allocation and garbage collection benchmark.
+ * <p>
+ * For each live set size, builds a linked list of that many objects
+ * that stays reachable, then allocates short-lived objects and arrays
+ * of a few sizes, so that every collection has to mark the live set.
+ * The time of the allocation loop is printed as
+ * <code>Allocation.live&lt;size&gt;: millis</code>, and the time of ten
+ * explicit collections as <code>Allocation.gc&lt;size&gt;: millis</code>.
+ * The heap must be large enough for the largest live set (each object
+ * takes about 16 bytes); run kvm with <code>-heapsize</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Allocation [iterations]
+ * [liveSetSize ...]</code>
+ */
+public class Allocation {
+
+    Allocation next;
+    int value;
+
+    static void report(String name, long start) {
+        System.out.println("Allocation." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    static Allocation makeList(int size) {
+        Allocation head = null;
+        for (int i = 0; i < size; i++) {
+            Allocation node = new Allocation();
+            node.value = i;
+            node.next = head;
+            head = node;
+        }
+        return head;
+    }
+
+    public static void main(String[] args) {
+        int iterations = 50000;
+        int[] liveSets = { 0, 1000, 10000 };
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+        if (args.length > 1) {
+            liveSets = new int[args.length - 1];
+            for (int i = 1; i < args.length; i++) {
+                liveSets[i - 1] = Integer.parseInt(args[i]);
+            }
+        }
+
+        Object[] recent = new Object[16];
+        int check = 0;
+        for (int l = 0; l < liveSets.length; l++) {
+            int size = liveSets[l];
+            Allocation live = makeList(size);
+            System.gc();
+
+            long start = System.currentTimeMillis();
+            for (int i = 0; i < iterations; i++) {
+                switch (i & 3) {
+                case 0:  recent[i & 15] = new Allocation(); break;
+                case 1:  recent[i & 15] = new int[4];       break;
+                case 2:  recent[i & 15] = new byte[40];     break;
+                default: recent[i & 15] = new Object[8];    break;
+                }
+            }
+            report("live" + size, start);
+
+            start = System.currentTimeMillis();
+            for (int i = 0; i < 10; i++) {
+                System.gc();
+            }
+            report("gc" + size, start);
+
+            for (Allocation a = live; a != null; a = a.next) {
+                check += a.value;
+            }
+        }
+        System.out.println("Allocation.check: " + check);
+    }
+}
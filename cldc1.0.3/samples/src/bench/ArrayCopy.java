@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+import java.util.Vector;
+
+/**
+ * <code>System.arraycopy</code> microbenchmark.
+ * <p>
+ * Times short copies of byte, char and object arrays (including a
+ * copy from a <code>String[]</code> to an <code>Object[]</code>),
+ * plus <code>StringBuffer</code> and <code>Vector</code> growth, which
+ * are dominated by such copies.  Each test prints one line of the form
+ * <code>ArrayCopy.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.ArrayCopy [iterations]</code>
+ */
+public class ArrayCopy {
+
+    static void report(String name, long start) {
+        System.out.println("ArrayCopy." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    public static void main(String[] args) {
+        int iterations = 100000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        byte[] bytes = new byte[64];
+        char[] chars = new char[64];
+        String[] strings = new String[64];
+        Object[] objects = new Object[64];
+        long start;
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            System.arraycopy(bytes, 0, bytes, 32, 8);
+        }
+        report("byte8", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            System.arraycopy(chars, 0, chars, 32, 8);
+        }
+        report("char8", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            System.arraycopy(chars, 1, chars, 0, 63);
+        }
+        report("char63", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            System.arraycopy(objects, 0, objects, 32, 8);
+        }
+        report("object8", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            System.arraycopy(strings, 0, objects, 32, 8);
+        }
+        report("stringToObject8", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations / 100; i++) {
+            StringBuffer sb = new StringBuffer();
+            for (int j = 0; j < 20; j++) {
+                sb.append("abc");
+            }
+        }
+        report("stringBufferGrowth", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations / 100; i++) {
+            Vector v = new Vector(1);
+            for (int j = 0; j < 50; j++) {
+                v.addElement(strings);
+            }
+        }
+        report("vectorGrowth", start);
+    }
+}
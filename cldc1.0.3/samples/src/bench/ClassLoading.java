@@ -0,0 +1,558 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * Class loading benchmark.
+ * <p>
+ * Loads and initializes the classes <code>bench.Loaded00</code> to
+ * <code>bench.Loaded31</code> (defined below) with
+ * <code>Class.forName</code>, or the classes named on the command
+ * line, and prints <code>ClassLoading.load: millis</code> and
+ * <code>ClassLoading.classes: count</code>.  A class is only loaded
+ * once per VM, so the benchmark has to be run in a new VM each time.
+ * Run it with the classes in a directory and in a JAR file on the
+ * class path to compare the two.  On an SVM, naming classes that carry
+ * permits (such as <code>com.ual.MileagePlus</code> of the safeway
+ * sample) times the verification of their permits.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.ClassLoading [className ...]</code>
+ */
+public class ClassLoading {
+
+    public static void main(String[] args) throws ClassNotFoundException {
+        String[] names = args;
+        if (names.length == 0) {
+            names = new String[32];
+            for (int i = 0; i < names.length; i++) {
+                names[i] = "bench.Loaded" + (i < 10 ? "0" : "") + i;
+            }
+        }
+
+        long start = System.currentTimeMillis();
+        for (int i = 0; i < names.length; i++) {
+            Class.forName(names[i]);
+        }
+        System.out.println("ClassLoading.load: "
+                           + (System.currentTimeMillis() - start));
+        System.out.println("ClassLoading.classes: " + names.length);
+    }
+}
+
+class Loaded00 extends Object {
+    static final String NAME = "Loaded00";
+    int count00;
+    long total00;
+
+    int add00(int value) {
+        count00++;
+        total00 += value;
+        return count00;
+    }
+
+    String describe00() {
+        return NAME + ": " + count00 + " values, total " + total00;
+    }
+}
+
+class Loaded01 extends Loaded00 {
+    static final String NAME = "Loaded01";
+    int count01;
+    long total01;
+
+    int add01(int value) {
+        count01++;
+        total01 += value;
+        return count01;
+    }
+
+    String describe01() {
+        return NAME + ": " + count01 + " values, total " + total01;
+    }
+}
+
+class Loaded02 extends Loaded01 {
+    static final String NAME = "Loaded02";
+    int count02;
+    long total02;
+
+    int add02(int value) {
+        count02++;
+        total02 += value;
+        return count02;
+    }
+
+    String describe02() {
+        return NAME + ": " + count02 + " values, total " + total02;
+    }
+}
+
+class Loaded03 extends Loaded02 {
+    static final String NAME = "Loaded03";
+    int count03;
+    long total03;
+
+    int add03(int value) {
+        count03++;
+        total03 += value;
+        return count03;
+    }
+
+    String describe03() {
+        return NAME + ": " + count03 + " values, total " + total03;
+    }
+}
+
+class Loaded04 extends Object {
+    static final String NAME = "Loaded04";
+    int count04;
+    long total04;
+
+    int add04(int value) {
+        count04++;
+        total04 += value;
+        return count04;
+    }
+
+    String describe04() {
+        return NAME + ": " + count04 + " values, total " + total04;
+    }
+}
+
+class Loaded05 extends Loaded04 {
+    static final String NAME = "Loaded05";
+    int count05;
+    long total05;
+
+    int add05(int value) {
+        count05++;
+        total05 += value;
+        return count05;
+    }
+
+    String describe05() {
+        return NAME + ": " + count05 + " values, total " + total05;
+    }
+}
+
+class Loaded06 extends Loaded05 {
+    static final String NAME = "Loaded06";
+    int count06;
+    long total06;
+
+    int add06(int value) {
+        count06++;
+        total06 += value;
+        return count06;
+    }
+
+    String describe06() {
+        return NAME + ": " + count06 + " values, total " + total06;
+    }
+}
+
+class Loaded07 extends Loaded06 {
+    static final String NAME = "Loaded07";
+    int count07;
+    long total07;
+
+    int add07(int value) {
+        count07++;
+        total07 += value;
+        return count07;
+    }
+
+    String describe07() {
+        return NAME + ": " + count07 + " values, total " + total07;
+    }
+}
+
+class Loaded08 extends Object {
+    static final String NAME = "Loaded08";
+    int count08;
+    long total08;
+
+    int add08(int value) {
+        count08++;
+        total08 += value;
+        return count08;
+    }
+
+    String describe08() {
+        return NAME + ": " + count08 + " values, total " + total08;
+    }
+}
+
+class Loaded09 extends Loaded08 {
+    static final String NAME = "Loaded09";
+    int count09;
+    long total09;
+
+    int add09(int value) {
+        count09++;
+        total09 += value;
+        return count09;
+    }
+
+    String describe09() {
+        return NAME + ": " + count09 + " values, total " + total09;
+    }
+}
+
+class Loaded10 extends Loaded09 {
+    static final String NAME = "Loaded10";
+    int count10;
+    long total10;
+
+    int add10(int value) {
+        count10++;
+        total10 += value;
+        return count10;
+    }
+
+    String describe10() {
+        return NAME + ": " + count10 + " values, total " + total10;
+    }
+}
+
+class Loaded11 extends Loaded10 {
+    static final String NAME = "Loaded11";
+    int count11;
+    long total11;
+
+    int add11(int value) {
+        count11++;
+        total11 += value;
+        return count11;
+    }
+
+    String describe11() {
+        return NAME + ": " + count11 + " values, total " + total11;
+    }
+}
+
+class Loaded12 extends Object {
+    static final String NAME = "Loaded12";
+    int count12;
+    long total12;
+
+    int add12(int value) {
+        count12++;
+        total12 += value;
+        return count12;
+    }
+
+    String describe12() {
+        return NAME + ": " + count12 + " values, total " + total12;
+    }
+}
+
+class Loaded13 extends Loaded12 {
+    static final String NAME = "Loaded13";
+    int count13;
+    long total13;
+
+    int add13(int value) {
+        count13++;
+        total13 += value;
+        return count13;
+    }
+
+    String describe13() {
+        return NAME + ": " + count13 + " values, total " + total13;
+    }
+}
+
+class Loaded14 extends Loaded13 {
+    static final String NAME = "Loaded14";
+    int count14;
+    long total14;
+
+    int add14(int value) {
+        count14++;
+        total14 += value;
+        return count14;
+    }
+
+    String describe14() {
+        return NAME + ": " + count14 + " values, total " + total14;
+    }
+}
+
+class Loaded15 extends Loaded14 {
+    static final String NAME = "Loaded15";
+    int count15;
+    long total15;
+
+    int add15(int value) {
+        count15++;
+        total15 += value;
+        return count15;
+    }
+
+    String describe15() {
+        return NAME + ": " + count15 + " values, total " + total15;
+    }
+}
+
+class Loaded16 extends Object {
+    static final String NAME = "Loaded16";
+    int count16;
+    long total16;
+
+    int add16(int value) {
+        count16++;
+        total16 += value;
+        return count16;
+    }
+
+    String describe16() {
+        return NAME + ": " + count16 + " values, total " + total16;
+    }
+}
+
+class Loaded17 extends Loaded16 {
+    static final String NAME = "Loaded17";
+    int count17;
+    long total17;
+
+    int add17(int value) {
+        count17++;
+        total17 += value;
+        return count17;
+    }
+
+    String describe17() {
+        return NAME + ": " + count17 + " values, total " + total17;
+    }
+}
+
+class Loaded18 extends Loaded17 {
+    static final String NAME = "Loaded18";
+    int count18;
+    long total18;
+
+    int add18(int value) {
+        count18++;
+        total18 += value;
+        return count18;
+    }
+
+    String describe18() {
+        return NAME + ": " + count18 + " values, total " + total18;
+    }
+}
+
+class Loaded19 extends Loaded18 {
+    static final String NAME = "Loaded19";
+    int count19;
+    long total19;
+
+    int add19(int value) {
+        count19++;
+        total19 += value;
+        return count19;
+    }
+
+    String describe19() {
+        return NAME + ": " + count19 + " values, total " + total19;
+    }
+}
+
+class Loaded20 extends Object {
+    static final String NAME = "Loaded20";
+    int count20;
+    long total20;
+
+    int add20(int value) {
+        count20++;
+        total20 += value;
+        return count20;
+    }
+
+    String describe20() {
+        return NAME + ": " + count20 + " values, total " + total20;
+    }
+}
+
+class Loaded21 extends Loaded20 {
+    static final String NAME = "Loaded21";
+    int count21;
+    long total21;
+
+    int add21(int value) {
+        count21++;
+        total21 += value;
+        return count21;
+    }
+
+    String describe21() {
+        return NAME + ": " + count21 + " values, total " + total21;
+    }
+}
+
+class Loaded22 extends Loaded21 {
+    static final String NAME = "Loaded22";
+    int count22;
+    long total22;
+
+    int add22(int value) {
+        count22++;
+        total22 += value;
+        return count22;
+    }
+
+    String describe22() {
+        return NAME + ": " + count22 + " values, total " + total22;
+    }
+}
+
+class Loaded23 extends Loaded22 {
+    static final String NAME = "Loaded23";
+    int count23;
+    long total23;
+
+    int add23(int value) {
+        count23++;
+        total23 += value;
+        return count23;
+    }
+
+    String describe23() {
+        return NAME + ": " + count23 + " values, total " + total23;
+    }
+}
+
+class Loaded24 extends Object {
+    static final String NAME = "Loaded24";
+    int count24;
+    long total24;
+
+    int add24(int value) {
+        count24++;
+        total24 += value;
+        return count24;
+    }
+
+    String describe24() {
+        return NAME + ": " + count24 + " values, total " + total24;
+    }
+}
+
+class Loaded25 extends Loaded24 {
+    static final String NAME = "Loaded25";
+    int count25;
+    long total25;
+
+    int add25(int value) {
+        count25++;
+        total25 += value;
+        return count25;
+    }
+
+    String describe25() {
+        return NAME + ": " + count25 + " values, total " + total25;
+    }
+}
+
+class Loaded26 extends Loaded25 {
+    static final String NAME = "Loaded26";
+    int count26;
+    long total26;
+
+    int add26(int value) {
+        count26++;
+        total26 += value;
+        return count26;
+    }
+
+    String describe26() {
+        return NAME + ": " + count26 + " values, total " + total26;
+    }
+}
+
+class Loaded27 extends Loaded26 {
+    static final String NAME = "Loaded27";
+    int count27;
+    long total27;
+
+    int add27(int value) {
+        count27++;
+        total27 += value;
+        return count27;
+    }
+
+    String describe27() {
+        return NAME + ": " + count27 + " values, total " + total27;
+    }
+}
+
+class Loaded28 extends Object {
+    static final String NAME = "Loaded28";
+    int count28;
+    long total28;
+
+    int add28(int value) {
+        count28++;
+        total28 += value;
+        return count28;
+    }
+
+    String describe28() {
+        return NAME + ": " + count28 + " values, total " + total28;
+    }
+}
+
+class Loaded29 extends Loaded28 {
+    static final String NAME = "Loaded29";
+    int count29;
+    long total29;
+
+    int add29(int value) {
+        count29++;
+        total29 += value;
+        return count29;
+    }
+
+    String describe29() {
+        return NAME + ": " + count29 + " values, total " + total29;
+    }
+}
+
+class Loaded30 extends Loaded29 {
+    static final String NAME = "Loaded30";
+    int count30;
+    long total30;
+
+    int add30(int value) {
+        count30++;
+        total30 += value;
+        return count30;
+    }
+
+    String describe30() {
+        return NAME + ": " + count30 + " values, total " + total30;
+    }
+}
+
+class Loaded31 extends Loaded30 {
+    static final String NAME = "Loaded31";
+    int count31;
+    long total31;
+
+    int add31(int value) {
+        count31++;
+        total31 += value;
+        return count31;
+    }
+
+    String describe31() {
+        return NAME + ": " + count31 + " values, total " + total31;
+    }
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * Interpreter dispatch microbenchmark.
+ * <p>
+ * Each test is a loop whose body is dominated by one family of
+ * bytecodes: local variable loads and stores, <code>int</code> and
+ * <code>long</code> arithmetic, constants, stack manipulation, array
+ * loads and stores, conditional branches, <code>tableswitch</code> and
+ * <code>lookupswitch</code>, and conversions.  The work done per
+ * bytecode is small, so the times mostly measure the cost of fetching
+ * and dispatching the bytecodes.  Each test prints one line of the form
+ * <code>Dispatch.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Dispatch [iterations]</code>
+ */
+public class Dispatch {
+
+    static void report(String name, long start) {
+        System.out.println("Dispatch." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    static int locals(int n) {
+        int a = 1, b = 2, c = 3, d = 4, e = 5;
+        for (int i = 0; i < n; i++) {
+            a = b; b = c; c = d; d = e; e = a;
+            a = c; c = e; e = b; b = d; d = a;
+        }
+        return a + b + c + d + e;
+    }
+
+    static int intArithmetic(int n) {
+        int x = 12345;
+        for (int i = 0; i < n; i++) {
+            x = x * 31 + i;
+            x = (x ^ (x >>> 7)) - (i << 2);
+            x = (x & 0x7fffffff) % 1000003 + (x | i) / 7;
+            x = -x + (x >> 3);
+        }
+        return x;
+    }
+
+    static long longArithmetic(int n) {
+        long x = 12345L;
+        for (int i = 0; i < n; i++) {
+            x = x * 31L + i;
+            x = (x ^ (x >>> 7)) - ((long)i << 2);
+            x = (x & 0x7fffffffffffL) % 1000003L + (x | i) / 7L;
+            x = -x + (x >> 3);
+        }
+        return x;
+    }
+
+    static int constants(int n) {
+        int x = 0;
+        for (int i = 0; i < n; i++) {
+            x += 0; x += 1; x += 2; x += 3; x += 4; x += 5;
+            x += 100; x += 1000; x += 100000; x -= 101115;
+        }
+        return x;
+    }
+
+    static int stack(int n) {
+        int[] a = new int[1];
+        int x = 0;
+        for (int i = 0; i < n; i++) {
+            x = a[0] = a[0] + 1;        /* dup_x2 */
+            x += (x = i) + x;           /* dup */
+            x += a[0]++;
+        }
+        return x + a[0];
+    }
+
+    static int arrays(int n) {
+        int[] ints = new int[64];
+        byte[] bytes = new byte[64];
+        char[] chars = new char[64];
+        Object[] objects = new Object[64];
+        int x = 0;
+        for (int i = 0; i < n; i++) {
+            int j = i & 63;
+            ints[j] = i;
+            bytes[j] = (byte)i;
+            chars[j] = (char)i;
+            objects[j] = objects[63 - j];
+            x += ints[63 - j] + bytes[63 - j] + chars[63 - j];
+        }
+        return x;
+    }
+
+    static int branches(int n) {
+        int x = 0;
+        Object o = null;
+        for (int i = 0; i < n; i++) {
+            if (i > 10) x++;
+            if (i < 5) x--;
+            if ((i & 1) == 0) x += 2;
+            if (i != x) x ^= 1;
+            if (o == null) x++;
+            if (x >= i) x -= 3;
+        }
+        return x;
+    }
+
+    static int tableSwitch(int n) {
+        int x = 0;
+        for (int i = 0; i < n; i++) {
+            switch (i & 7) {
+            case 0: x += 1; break;
+            case 1: x += 3; break;
+            case 2: x -= 2; break;
+            case 3: x ^= 5; break;
+            case 4: x += 7; break;
+            case 5: x -= 1; break;
+            case 6: x |= 8; break;
+            default: x &= 0xffff; break;
+            }
+        }
+        return x;
+    }
+
+    static int lookupSwitch(int n) {
+        int x = 0;
+        for (int i = 0; i < n; i++) {
+            switch ((i & 7) * 1000) {
+            case 0:    x += 1; break;
+            case 1000: x += 3; break;
+            case 2000: x -= 2; break;
+            case 3000: x ^= 5; break;
+            case 4000: x += 7; break;
+            case 5000: x -= 1; break;
+            case 6000: x |= 8; break;
+            default:   x &= 0xffff; break;
+            }
+        }
+        return x;
+    }
+
+    static int conversions(int n) {
+        int x = 0;
+        for (int i = 0; i < n; i++) {
+            long l = i;
+            x += (int)(l * 3);
+            x += (byte)x + (char)x + (short)x;
+        }
+        return x;
+    }
+
+    public static void main(String[] args) {
+        int iterations = 200000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        long check = 0;
+        long start;
+
+        start = System.currentTimeMillis();
+        check += locals(iterations);
+        report("locals", start);
+
+        start = System.currentTimeMillis();
+        check += intArithmetic(iterations);
+        report("intArithmetic", start);
+
+        start = System.currentTimeMillis();
+        check += longArithmetic(iterations);
+        report("longArithmetic", start);
+
+        start = System.currentTimeMillis();
+        check += constants(iterations);
+        report("constants", start);
+
+        start = System.currentTimeMillis();
+        check += stack(iterations);
+        report("stack", start);
+
+        start = System.currentTimeMillis();
+        check += arrays(iterations);
+        report("arrays", start);
+
+        start = System.currentTimeMillis();
+        check += branches(iterations);
+        report("branches", start);
+
+        start = System.currentTimeMillis();
+        check += tableSwitch(iterations);
+        report("tableSwitch", start);
+
+        start = System.currentTimeMillis();
+        check += lookupSwitch(iterations);
+        report("lookupSwitch", start);
+
+        start = System.currentTimeMillis();
+        check += conversions(iterations);
+        report("conversions", start);
+
+        System.out.println("Dispatch.check: " + check);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * Exception handling microbenchmark.
+ * <p>
+ * Times throwing a preallocated exception and catching it in the same
+ * method and ten frames up, creating and throwing a new exception, and
+ * the exceptions raised by the VM itself for a null pointer and an
+ * array index out of bounds.  Each test prints one line of the form
+ * <code>Exceptions.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Exceptions [iterations]</code>
+ */
+public class Exceptions {
+
+    static final RuntimeException preallocated = new RuntimeException();
+
+    static void report(String name, long start) {
+        System.out.println("Exceptions." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    static int throwDeep(int depth) {
+        if (depth == 0) {
+            throw preallocated;
+        }
+        return throwDeep(depth - 1) + 1;
+    }
+
+    public static void main(String[] args) {
+        int iterations = 20000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        int check = 0;
+        int[] array = new int[1];
+        Object nothing = null;
+        long start;
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            try {
+                throw preallocated;
+            } catch (RuntimeException e) {
+                check++;
+            }
+        }
+        report("sameFrame", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            try {
+                check += throwDeep(10);
+            } catch (RuntimeException e) {
+                check++;
+            }
+        }
+        report("tenFrames", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            try {
+                throw new IllegalStateException();
+            } catch (IllegalStateException e) {
+                check++;
+            }
+        }
+        report("newException", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            try {
+                check += nothing.hashCode();
+            } catch (NullPointerException e) {
+                check++;
+            }
+        }
+        report("nullPointer", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            try {
+                check += array[i];
+            } catch (ArrayIndexOutOfBoundsException e) {
+                check++;
+            }
+        }
+        report("arrayIndex", start);
+
+        System.out.println("Exceptions.check: " + check);
+    }
+}
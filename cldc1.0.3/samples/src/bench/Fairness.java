@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * Thread fairness and wakeup latency benchmark.
+ * <p>
+ * Two kinds of CPU bound workers compete for the processor: one runs a
+ * tight loop that executes a branch every few bytecodes, the other spends
+ * most of its time inside a native method (<code>System.arraycopy</code>)
+ * and therefore executes very few branches.  Each workload is first run
+ * alone to find its solo throughput, and then all workers are run
+ * together.  The share of wall-clock time a worker received is its
+ * concurrent throughput relative to its solo throughput.
+ * <p>
+ * With the default bytecode-counting scheduler the time slice of a thread
+ * is measured in branches, so the native-heavy worker receives far more
+ * than its fair share.  With a VM built with
+ * <code>TIMER_RESCHEDULING=true</code> time slices are measured in wall
+ * clock time and the shares should be proportional to the priorities.
+ * <p>
+ * While the workers run, a high priority thread repeatedly sleeps for a
+ * short time and records how late it was woken up.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Fairness [millis]</code>
+ */
+public class Fairness implements Runnable {
+
+    static final int SPIN   = 0;
+    static final int NATIVE = 1;
+
+    static final int SLEEP_MILLIS = 2;
+
+    static volatile boolean stop;
+
+    final int kind;
+    int iterations;
+    int checksum;
+
+    Fairness(int kind) {
+        this.kind = kind;
+    }
+
+    public void run() {
+        if (kind == SPIN) {
+            spin();
+        } else {
+            copy();
+        }
+    }
+
+    void spin() {
+        int sum = 0;
+        int n = 0;
+        while (!stop) {
+            for (int i = 0; i < 100; i++) {
+                sum += i ^ n;
+            }
+            n++;
+        }
+        iterations = n;
+        checksum = sum;
+    }
+
+    void copy() {
+        byte[] src = new byte[64 * 1024];
+        byte[] dst = new byte[64 * 1024];
+        int n = 0;
+        while (!stop) {
+            System.arraycopy(src, 0, dst, 0, src.length);
+            n++;
+        }
+        iterations = n;
+        checksum = dst[n & 0xff];
+    }
+
+    /**
+     * Run the given workers for the given time and return when
+     * all of them have stopped.
+     */
+    static void race(Fairness[] workers, int[] priorities, long millis)
+        throws InterruptedException {
+        Thread[] threads = new Thread[workers.length];
+        stop = false;
+        for (int i = 0; i < workers.length; i++) {
+            threads[i] = new Thread(workers[i]);
+            threads[i].setPriority(priorities[i]);
+        }
+        for (int i = 0; i < workers.length; i++) {
+            threads[i].start();
+        }
+        Thread.sleep(millis);
+        stop = true;
+        for (int i = 0; i < workers.length; i++) {
+            threads[i].join();
+        }
+    }
+
+    static int solo(int kind, long millis) throws InterruptedException {
+        Fairness[] one = { new Fairness(kind) };
+        int[] priority = { Thread.NORM_PRIORITY };
+        race(one, priority, millis);
+        return one[0].iterations;
+    }
+
+    public static void main(String[] args) throws InterruptedException {
+        long millis = 2000;
+        if (args.length > 0) {
+            millis = Integer.parseInt(args[0]);
+        }
+        Thread.currentThread().setPriority(Thread.MAX_PRIORITY);
+
+        int soloSpin   = solo(SPIN, millis);
+        int soloNative = solo(NATIVE, millis);
+
+        Fairness[] workers = {
+            new Fairness(SPIN),
+            new Fairness(NATIVE),
+            new Fairness(SPIN),
+            new Fairness(NATIVE),
+        };
+        int[] priorities = {
+            Thread.NORM_PRIORITY,
+            Thread.NORM_PRIORITY,
+            Thread.MIN_PRIORITY + 1,
+            Thread.MIN_PRIORITY + 1,
+        };
+        int totalPriority = 0;
+        for (int i = 0; i < priorities.length; i++) {
+            totalPriority += priorities[i];
+        }
+
+        /* Measure wakeup latency while the workers are running */
+        stop = false;
+        long totalLate = 0;
+        long maxLate = 0;
+        int wakeups = 0;
+        Thread[] threads = new Thread[workers.length];
+        for (int i = 0; i < workers.length; i++) {
+            threads[i] = new Thread(workers[i]);
+            threads[i].setPriority(priorities[i]);
+            threads[i].start();
+        }
+        long end = System.currentTimeMillis() + millis;
+        long now;
+        while ((now = System.currentTimeMillis()) < end) {
+            Thread.sleep(SLEEP_MILLIS);
+            long late = System.currentTimeMillis() - now - SLEEP_MILLIS;
+            totalLate += late;
+            if (late > maxLate) {
+                maxLate = late;
+            }
+            wakeups++;
+        }
+        stop = true;
+        for (int i = 0; i < workers.length; i++) {
+            threads[i].join();
+        }
+
+        System.out.println("Fairness.millis: " + millis);
+        for (int i = 0; i < workers.length; i++) {
+            int soloIterations = workers[i].kind == SPIN ? soloSpin : soloNative;
+            /* Share of the processor in per mille, and the fair share */
+            long share = soloIterations == 0 ? 0 :
+                (long)workers[i].iterations * 1000 / soloIterations;
+            long fair = (long)priorities[i] * 1000 / totalPriority;
+            System.out.println("Fairness.worker" + i
+                               + (workers[i].kind == SPIN ? ".spin" : ".native")
+                               + ".p" + priorities[i]
+                               + ": share " + share + " fair " + fair);
+        }
+        System.out.println("Fairness.wakeups: " + wakeups);
+        System.out.println("Fairness.latency.avg: "
+                           + (wakeups == 0 ? 0 : totalLate / wakeups));
+        System.out.println("Fairness.latency.max: " + maxLate);
+    }
+}
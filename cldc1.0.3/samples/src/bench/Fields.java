@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * Field access microbenchmark.
+ * <p>
+ * Times <code>getfield</code> and <code>putfield</code> of
+ * <code>int</code>, <code>long</code> and reference instance fields,
+ * <code>getstatic</code> and <code>putstatic</code>, and field accesses
+ * through a chain of references.  Each test prints one line of the
+ * form <code>Fields.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Fields [iterations]</code>
+ */
+public class Fields {
+
+    int    intField;
+    long   longField;
+    Fields next;
+
+    static int    staticInt;
+    static long   staticLong;
+    static Object staticObject;
+
+    static void report(String name, long start) {
+        System.out.println("Fields." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    public static void main(String[] args) {
+        int iterations = 200000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        Fields f = new Fields();
+        f.next = new Fields();
+        f.next.next = f;
+        long start;
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            f.intField = f.intField + i;
+        }
+        report("intField", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            f.longField = f.longField + i;
+        }
+        report("longField", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            f.next = f.next.next;
+        }
+        report("referenceField", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            staticInt = staticInt + i;
+        }
+        report("staticInt", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            staticLong = staticLong + i;
+        }
+        report("staticLong", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            staticObject = f;
+            f = (Fields)staticObject;
+        }
+        report("staticObject", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            f.next.next.intField += f.next.intField;
+        }
+        report("chain", start);
+
+        System.out.println("Fields.check: "
+                           + (f.intField + f.longField + staticInt
+                              + staticLong));
+    }
+}
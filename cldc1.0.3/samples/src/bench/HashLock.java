@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+import java.util.Hashtable;
+
+/**
+ * Identity hash code and locking stress benchmark.
+ * <p>
+ * Mixes <code>Object.hashCode()</code> and <code>synchronized</code>
+ * on the same objects: locking objects that already have a hash code,
+ * hashing objects while they are locked (once and recursively), and
+ * using locked objects as <code>Hashtable</code> keys.  None of this
+ * should need a real monitor, so the heap in use afterwards should be
+ * no larger than before.  Each test prints one line of the form
+ * <code>HashLock.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.HashLock [iterations]</code>
+ */
+public class HashLock {
+
+    static void report(String name, long start) {
+        System.out.println("HashLock." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    static long usedMemory() {
+        Runtime runtime = Runtime.getRuntime();
+        runtime.gc();
+        return runtime.totalMemory() - runtime.freeMemory();
+    }
+
+    public static void main(String[] args) {
+        int iterations = 20000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        Object[] objects = new Object[64];
+        for (int i = 0; i < objects.length; i++) {
+            objects[i] = new Object();
+        }
+        Hashtable table = new Hashtable();
+        int hash = 0;
+        long before = usedMemory();
+        long start;
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            Object o = objects[i & 63];
+            hash += o.hashCode();
+            synchronized (o) {
+                hash++;
+            }
+        }
+        report("hashThenLock", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            Object o = new Object();
+            synchronized (o) {
+                hash += o.hashCode();
+            }
+            hash += o.hashCode();
+        }
+        report("lockThenHash", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            Object o = objects[i & 63];
+            synchronized (o) {
+                synchronized (o) {
+                    hash += o.hashCode();
+                }
+                hash += o.hashCode();
+            }
+        }
+        report("nested", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            Object a = objects[i & 63];
+            Object b = objects[(i + 17) & 63];
+            synchronized (a) {
+                synchronized (b) {
+                    table.put(a, b);
+                    if (table.get(b) != null) {
+                        hash++;
+                    }
+                }
+            }
+        }
+        report("lockedKeys", start);
+
+        System.out.println("HashLock.heapGrowth: " + (usedMemory() - before));
+        System.out.println("HashLock.hash: " + hash);
+    }
+}
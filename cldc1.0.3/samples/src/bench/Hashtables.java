@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+import java.util.Enumeration;
+import java.util.Hashtable;
+
+/**
+ * Hashtable microbenchmark with String and Integer keys.
+ * <p>
+ * Fills a <code>Hashtable</code> and then looks up every key, half of
+ * them with a fresh copy of the key (so the lookup has to compute the
+ * hash code of the key and compare the characters) and half of them
+ * with the same key object.  Then it does the same with fresh
+ * <code>Integer</code> keys, removes and re-adds half of the keys, and
+ * enumerates the table.  Each phase prints one line of the form
+ * <code>Hashtables.phase: millis</code>.  Compare a class library
+ * built with and without <code>OPEN_HASHTABLE=true</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Hashtables [keys] [rounds]</code>
+ */
+public class Hashtables {
+
+    public static void main(String[] args) {
+        int keys = 2000;
+        int rounds = 20;
+        if (args.length > 0) {
+            keys = Integer.parseInt(args[0]);
+        }
+        if (args.length > 1) {
+            rounds = Integer.parseInt(args[1]);
+        }
+
+        String[] key = new String[keys];
+        String[] copy = new String[keys];
+        for (int i = 0; i < keys; i++) {
+            key[i] = "com.example.property." + i + ".name";
+            copy[i] = new String(key[i]);
+        }
+
+        Hashtable table = new Hashtable();
+        Integer value = new Integer(1);
+        long start = System.currentTimeMillis();
+        for (int r = 0; r < rounds; r++) {
+            table.clear();
+            for (int i = 0; i < keys; i++) {
+                table.put(key[i], value);
+            }
+        }
+        System.out.println("Hashtables.put: "
+                           + (System.currentTimeMillis() - start));
+
+        int found = 0;
+        start = System.currentTimeMillis();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < keys; i++) {
+                if (table.get(key[i]) != null) {
+                    found++;
+                }
+            }
+        }
+        System.out.println("Hashtables.getSameKey: "
+                           + (System.currentTimeMillis() - start));
+
+        start = System.currentTimeMillis();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < keys; i++) {
+                if (table.get(copy[i]) != null) {
+                    found++;
+                }
+            }
+        }
+        System.out.println("Hashtables.getCopiedKey: "
+                           + (System.currentTimeMillis() - start));
+
+        start = System.currentTimeMillis();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < keys; i++) {
+                if (table.containsKey(key[i] + "x")) {
+                    found++;
+                }
+            }
+        }
+        System.out.println("Hashtables.miss: "
+                           + (System.currentTimeMillis() - start));
+
+        Hashtable numbers = new Hashtable();
+        start = System.currentTimeMillis();
+        for (int r = 0; r < rounds; r++) {
+            numbers.clear();
+            for (int i = 0; i < keys; i++) {
+                numbers.put(new Integer(i * 17), value);
+            }
+            for (int i = 0; i < keys; i++) {
+                if (numbers.get(new Integer(i * 17)) != null) {
+                    found++;
+                }
+            }
+        }
+        System.out.println("Hashtables.integerKeys: "
+                           + (System.currentTimeMillis() - start));
+
+        start = System.currentTimeMillis();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = r & 1; i < keys; i += 2) {
+                table.remove(key[i]);
+            }
+            for (int i = r & 1; i < keys; i += 2) {
+                table.put(copy[i], value);
+            }
+        }
+        System.out.println("Hashtables.removeAndPut: "
+                           + (System.currentTimeMillis() - start));
+
+        start = System.currentTimeMillis();
+        for (int r = 0; r < rounds; r++) {
+            for (Enumeration e = table.keys(); e.hasMoreElements(); ) {
+                if (e.nextElement() != null) {
+                    found++;
+                }
+            }
+        }
+        System.out.println("Hashtables.enumerate: "
+                           + (System.currentTimeMillis() - start));
+        System.out.println("Hashtables.found: " + found);
+    }
+}
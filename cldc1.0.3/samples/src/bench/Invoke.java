@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * Method invocation microbenchmark.
+ * <p>
+ * Times calls of small methods through <code>invokestatic</code>,
+ * <code>invokespecial</code> (a private method),
+ * <code>invokevirtual</code> with one receiver class and with four,
+ * and <code>invokeinterface</code> with one receiver class and with
+ * four.  Each test prints one line of the form
+ * <code>Invoke.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Invoke [iterations]</code>
+ */
+public class Invoke {
+
+    interface Shape {
+        int area(int x);
+    }
+
+    static class Square implements Shape {
+        public int area(int x) { return x * x; }
+    }
+
+    static class Rectangle extends Square {
+        public int area(int x) { return x * 2; }
+    }
+
+    static class Triangle extends Square {
+        public int area(int x) { return x / 2; }
+    }
+
+    static class Circle extends Square {
+        public int area(int x) { return x * 3; }
+    }
+
+    int field;
+
+    static void report(String name, long start) {
+        System.out.println("Invoke." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    static int staticMethod(int x) {
+        return x + 1;
+    }
+
+    private int privateMethod(int x) {
+        return x + field;
+    }
+
+    public static void main(String[] args) {
+        int iterations = 100000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        Square[] squares = { new Square(), new Rectangle(),
+                             new Triangle(), new Circle() };
+        Shape[] shapes = { squares[0], squares[1], squares[2], squares[3] };
+        Square square = squares[0];
+        Shape shape = shapes[0];
+        Invoke invoke = new Invoke();
+        int check = 0;
+        long start;
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check = staticMethod(check);
+        }
+        report("static", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check = invoke.privateMethod(check);
+        }
+        report("special", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check += square.area(i);
+        }
+        report("virtual", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check += squares[i & 3].area(i);
+        }
+        report("virtualPolymorphic", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check += shape.area(i);
+        }
+        report("interface", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check += shapes[i & 3].area(i);
+        }
+        report("interfacePolymorphic", start);
+
+        System.out.println("Invoke.check: " + check);
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * Monitor microbenchmark.
+ * <p>
+ * Times uncontended <code>monitorenter</code> and
+ * <code>monitorexit</code> on one object and on many objects,
+ * recursive locking, synchronized methods, and a
+ * <code>wait</code>/<code>notify</code> hand-off between two threads.
+ * Each test prints one line of the form
+ * <code>Monitors.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Monitors [iterations]</code>
+ */
+public class Monitors implements Runnable {
+
+    int counter;
+    int turn;
+    int handoffs;
+
+    static void report(String name, long start) {
+        System.out.println("Monitors." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    synchronized void increment() {
+        counter++;
+    }
+
+    /* The second thread of the hand-off test */
+    public void run() {
+        pass(1, handoffs);
+    }
+
+    synchronized void pass(int me, int count) {
+        for (int i = 0; i < count; i++) {
+            while (turn != me) {
+                try {
+                    wait();
+                } catch (InterruptedException e) {
+                }
+            }
+            turn = 1 - me;
+            notify();
+        }
+    }
+
+    public static void main(String[] args) throws InterruptedException {
+        int iterations = 100000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        Monitors m = new Monitors();
+        Object[] objects = new Object[256];
+        for (int i = 0; i < objects.length; i++) {
+            objects[i] = new Object();
+        }
+        long start;
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            synchronized (m) {
+                m.counter++;
+            }
+        }
+        report("enterExit", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            synchronized (objects[i & 255]) {
+                m.counter++;
+            }
+        }
+        report("manyObjects", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            synchronized (m) {
+                synchronized (m) {
+                    synchronized (m) {
+                        m.counter++;
+                    }
+                }
+            }
+        }
+        report("recursive", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            m.increment();
+        }
+        report("synchronizedMethod", start);
+
+        m.handoffs = iterations / 100;
+        Thread other = new Thread(m);
+        start = System.currentTimeMillis();
+        other.start();
+        m.pass(0, m.handoffs);
+        other.join();
+        report("waitNotify", start);
+
+        System.out.println("Monitors.check: " + m.counter);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * <code>StringBuffer</code> microbenchmark.
+ * <p>
+ * Times the appenders that string concatenation and hand-written
+ * formatting code use most (<code>char</code>, <code>int</code>,
+ * <code>long</code>, <code>char[]</code> and <code>String</code>),
+ * <code>insert</code>, and reuse of one buffer through
+ * <code>setLength(0)</code> after <code>toString()</code>.  Each test
+ * prints one line of the form <code>StringBuffers.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.StringBuffers [iterations]</code>
+ */
+public class StringBuffers {
+
+    static void report(String name, long start) {
+        System.out.println("StringBuffers." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    public static void main(String[] args) {
+        int iterations = 20000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        char[] chars = "0123456789abcdef".toCharArray();
+        int length = 0;
+        long start;
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            StringBuffer sb = new StringBuffer();
+            for (int j = 0; j < 32; j++) {
+                sb.append((char)('a' + j));
+            }
+            length += sb.length();
+        }
+        report("appendChar", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            length += new StringBuffer().append(i).append(',')
+                .append((long)i * 3).append(',').append(i * 1000000000L)
+                .length();
+        }
+        report("appendNumbers", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            StringBuffer sb = new StringBuffer();
+            sb.append(chars).append(chars, 4, 8).append("key=").append(i);
+            length += sb.toString().length();
+        }
+        report("appendMixed", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            StringBuffer sb = new StringBuffer("0123456789");
+            sb.insert(5, '-').insert(0, "<").insert(sb.length(), ">");
+            length += sb.length();
+        }
+        report("insert", start);
+
+        StringBuffer reused = new StringBuffer();
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            reused.setLength(0);
+            reused.append("line ").append(i);
+            length += reused.toString().length();
+        }
+        report("reuse", start);
+
+        System.out.println("StringBuffers.length: " + length);
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * String comparison and search microbenchmark.
+ * <p>
+ * Times <code>hashCode</code>, <code>equals</code>,
+ * <code>compareTo</code>, <code>startsWith</code>,
+ * <code>regionMatches</code>, <code>indexOf</code> and
+ * <code>lastIndexOf</code> on short and long strings.  Each test
+ * prints one line of the form <code>Strings.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Strings [iterations]</code>
+ */
+public class Strings {
+
+    static int sink;
+
+    static String make(int length, char last) {
+        StringBuffer sb = new StringBuffer(length);
+        for (int i = 0; i < length - 1; i++) {
+            sb.append((char)('a' + (i % 26)));
+        }
+        sb.append(last);
+        return sb.toString();
+    }
+
+    static void report(String name, long start) {
+        System.out.println("Strings." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    static void run(String suffix, int length, int iterations) {
+        String s1 = make(length, 'x');
+        String s2 = make(length, 'y');
+        String s3 = make(length, 'x');
+        String needle = s1.substring(length - 8);
+        int n = 0;
+        long start;
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            /* A new string each time, so the hash code isn't cached */
+            n += new String(s1).hashCode();
+        }
+        report("hashCode" + suffix, start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            n += s1.hashCode();
+        }
+        report("hashCodeCached" + suffix, start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            if (s1.equals(s3)) {
+                n++;
+            }
+        }
+        report("equals" + suffix, start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            n += s1.compareTo(s2);
+        }
+        report("compareTo" + suffix, start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            if (s1.startsWith(s3)) {
+                n++;
+            }
+        }
+        report("startsWith" + suffix, start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            if (s1.regionMatches(false, 1, s3, 1, length - 2)) {
+                n++;
+            }
+        }
+        report("regionMatches" + suffix, start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            n += s1.indexOf('x');
+        }
+        report("indexOfChar" + suffix, start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            n += s1.lastIndexOf('a');
+        }
+        report("lastIndexOf" + suffix, start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            n += s1.indexOf(needle);
+        }
+        report("indexOfString" + suffix, start);
+
+        sink += n;
+    }
+
+    public static void main(String[] args) {
+        int iterations = 20000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+        run(".short", 16, iterations);
+        run(".long", 1024, iterations / 16);
+        System.out.println("Strings.checksum: " + sink);
+    }
+}
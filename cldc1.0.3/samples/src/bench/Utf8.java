@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+import java.io.*;
+
+/**
+ * UTF-8 conversion microbenchmark.
+ * <p>
+ * Times <code>writeUTF</code>/<code>readUTF</code> round trips, and
+ * writing and reading text through an <code>OutputStreamWriter</code>
+ * and <code>InputStreamReader</code> with the UTF-8 encoding, for
+ * ASCII text and for text with some non-ASCII characters.  Each test
+ * prints one line of the form <code>Utf8.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Utf8 [iterations]</code>
+ */
+public class Utf8 {
+
+    static void report(String name, long start) {
+        System.out.println("Utf8." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    static int dataStreams(String text, int iterations) throws IOException {
+        int length = 0;
+        for (int i = 0; i < iterations; i++) {
+            ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+            DataOutputStream out = new DataOutputStream(bytes);
+            out.writeUTF(text);
+            out.close();
+            DataInputStream in = new DataInputStream(
+                new ByteArrayInputStream(bytes.toByteArray()));
+            length += in.readUTF().length();
+        }
+        return length;
+    }
+
+    static int readerWriter(String text, int iterations) throws IOException {
+        char[] chars = new char[text.length()];
+        int length = 0;
+        for (int i = 0; i < iterations; i++) {
+            ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+            Writer out = new OutputStreamWriter(bytes, "UTF-8");
+            out.write(text);
+            out.close();
+            Reader in = new InputStreamReader(
+                new ByteArrayInputStream(bytes.toByteArray()), "UTF-8");
+            for (int n; (n = in.read(chars, 0, chars.length)) > 0; ) {
+                length += n;
+            }
+            in.close();
+        }
+        return length;
+    }
+
+    public static void main(String[] args) throws IOException {
+        int iterations = 2000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        StringBuffer ascii = new StringBuffer();
+        StringBuffer mixed = new StringBuffer();
+        for (int i = 0; i < 40; i++) {
+            ascii.append("line ").append(i).append(" of plain text. ");
+            mixed.append("ligne ").append(i).append(" \u00e9t\u00e9 \u20ac. ");
+        }
+        String asciiText = ascii.toString();
+        String mixedText = mixed.toString();
+        int length = 0;
+        long start;
+
+        start = System.currentTimeMillis();
+        length += dataStreams(asciiText, iterations);
+        report("utfAscii", start);
+
+        start = System.currentTimeMillis();
+        length += dataStreams(mixedText, iterations);
+        report("utfMixed", start);
+
+        start = System.currentTimeMillis();
+        length += readerWriter(asciiText, iterations);
+        report("readerWriterAscii", start);
+
+        start = System.currentTimeMillis();
+        length += readerWriter(mixedText, iterations);
+        report("readerWriterMixed", start);
+
+        System.out.println("Utf8.length: " + length);
+    }
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package tests;
+
+import java.util.Enumeration;
+import java.util.Hashtable;
+import java.util.NoSuchElementException;
+
+/**
+ * Test of <code>java.util.Hashtable</code>, written for the open
+ * addressing version (<code>OPEN_HASHTABLE=true</code> in the api
+ * makefile) but valid for the chained one too.  The keys of most tests
+ * have the same hash code, so that they end up in one run of slots:
+ * <code>Integer</code> keys that are a multiple of the capacity apart
+ * and <code>String</code> keys with equal hash codes, which are looked
+ * up by the native probe, and keys of a class of their own, which are
+ * compared with <code>equals</code>.  The tests remove keys from the
+ * middle and the end of a run, rehash at the load factor boundary,
+ * enumerate after removals, and pass <code>null</code> arguments.
+ * <p>
+ * Usage: <code>kvm -classpath ... tests.HashtableTest</code>
+ */
+public class HashtableTest extends BaseTest {
+
+    /* A key whose hash code is chosen freely */
+    static class Key {
+        int hash;
+        int id;
+
+        Key(int hash, int id) {
+            this.hash = hash;
+            this.id = id;
+        }
+
+        public int hashCode() {
+            return hash;
+        }
+
+        public boolean equals(Object other) {
+            return other instanceof Key && ((Key)other).id == id;
+        }
+
+        public String toString() {
+            return "Key" + id;
+        }
+    }
+
+    /* Counts the calls of rehash */
+    static class CountingHashtable extends Hashtable {
+        int rehashes;
+
+        CountingHashtable(int initialCapacity) {
+            super(initialCapacity);
+        }
+
+        protected void rehash() {
+            rehashes++;
+            super.rehash();
+        }
+    }
+
+    public String testName() {
+        return "HashtableTest";
+    }
+
+    /* Keys that all go to the first slot of a table of 11 slots */
+    static Object[] integerKeys() {
+        return new Object[] {
+            new Integer(0), new Integer(11), new Integer(22), new Integer(33)
+        };
+    }
+
+    /* Strings with the same hash code */
+    static Object[] stringKeys() {
+        return new Object[] { "AaAa", "AaBB", "BBAa", "BBBB" };
+    }
+
+    static Object[] objectKeys() {
+        return new Object[] {
+            new Key(5, 0), new Key(5, 1), new Key(5, 2), new Key(5, 3)
+        };
+    }
+
+    /*
+     * Removes keys from the middle and the end of a run of slots, and
+     * looks up and adds the keys that were probed past them.
+     */
+    static void testRemoveInRun(Object[] k) {
+        Hashtable table = new Hashtable();
+        for (int i = 0; i < k.length; i++) {
+            check(table.put(k[i], "v" + i) == null);
+        }
+        check(table.size() == 4);
+
+        /* Remove from the middle of the run */
+        check("v1".equals(table.remove(k[1])));
+        check(table.remove(k[1]) == null);
+        check(table.size() == 3);
+        check(table.get(k[1]) == null);
+        check(!table.containsKey(k[1]));
+        check("v2".equals(table.get(k[2])));
+        check("v3".equals(table.get(k[3])));
+        check("v3".equals(table.put(k[3], "w3")));
+        check(table.size() == 3);
+        check("w3".equals(table.get(k[3])));
+
+        /* Add the removed key again */
+        check(table.put(k[1], "w1") == null);
+        check(table.size() == 4);
+        check("w1".equals(table.get(k[1])));
+
+        /* Remove from the end of the run, then the keys before it */
+        check("w3".equals(table.remove(k[3])));
+        check("v0".equals(table.get(k[0])));
+        check("v2".equals(table.get(k[2])));
+        check("v0".equals(table.remove(k[0])));
+        check("w1".equals(table.get(k[1])));
+        check("v2".equals(table.get(k[2])));
+        check("v2".equals(table.remove(k[2])));
+        check("w1".equals(table.remove(k[1])));
+        check(table.isEmpty());
+        for (int i = 0; i < k.length; i++) {
+            check(table.get(k[i]) == null);
+        }
+
+        /* The table works as before */
+        for (int i = k.length; i-- > 0; ) {
+            check(table.put(k[i], "x" + i) == null);
+        }
+        for (int i = 0; i < k.length; i++) {
+            check(("x" + i).equals(table.get(k[i])));
+        }
+    }
+
+    /*
+     * Puts and removes many keys, and checks the table against an
+     * array of the expected values after every step.
+     */
+    static void testManyChanges() {
+        Hashtable table = new Hashtable();
+        Integer[] expected = new Integer[300];
+        int size = 0;
+        for (int step = 0; step < 3000; step++) {
+            int n = (step * 7919) % expected.length;
+            Integer key = new Integer(n * 11);
+            if ((step & 3) != 3) {
+                Integer value = new Integer(step);
+                check(table.put(key, value) == expected[n]);
+                if (expected[n] == null) {
+                    size++;
+                }
+                expected[n] = value;
+            } else {
+                check(table.remove(key) == expected[n]);
+                if (expected[n] != null) {
+                    size--;
+                }
+                expected[n] = null;
+            }
+            check(table.size() == size);
+            check(table.get(key) == expected[n]);
+        }
+        for (int n = 0; n < expected.length; n++) {
+            check(table.get(new Integer(n * 11)) == expected[n]);
+        }
+    }
+
+    /*
+     * Rehashes exactly when the number of entries exceeds 75% of the
+     * capacity, and keeps every entry.
+     */
+    static void testRehash() {
+        CountingHashtable table = new CountingHashtable(11);
+        for (int i = 0; i < 8; i++) {
+            table.put(new Integer(i * 11), new Integer(i));
+        }
+        check(table.rehashes == 0);
+        table.put(new Integer(0), new Integer(-1));
+        check(table.rehashes == 0);
+        table.put(new Integer(8 * 11), new Integer(8));
+        check(table.rehashes == 1);
+        check(table.size() == 9);
+        check(table.get(new Integer(0)).equals(new Integer(-1)));
+        for (int i = 1; i < 9; i++) {
+            check(table.get(new Integer(i * 11)).equals(new Integer(i)));
+        }
+
+        /* A table of capacity 0 grows on the first put */
+        table = new CountingHashtable(0);
+        table.put("a", "b");
+        check(table.rehashes == 1);
+        check("b".equals(table.get("a")));
+        check(table.size() == 1);
+    }
+
+    /*
+     * Keys with the same hash code are only found by keys equal to
+     * them, whatever their class, and contains finds the values.
+     */
+    static void testCollisions() {
+        Hashtable table = new Hashtable();
+        table.put("Aa", "first");
+        check(table.containsKey("Aa"));
+        check(!table.containsKey("BB"));
+        check(table.get("BB") == null);
+        /* Same hash code as "Aa" and "BB", but another class */
+        check(!table.containsKey(new Integer(2112)));
+        check(!table.containsKey(new Key(2112, 0)));
+
+        table.put("BB", "second");
+        table.put(new Integer(2112), "third");
+        table.put(new Key(2112, 0), "fourth");
+        check(table.size() == 4);
+        check("first".equals(table.get("Aa")));
+        check("second".equals(table.get("BB")));
+        check("third".equals(table.get(new Integer(2112))));
+        check("fourth".equals(table.get(new Key(2112, 0))));
+        check(!table.containsKey(new Key(2112, 1)));
+        check(table.containsKey(new String(new char[] { 'B', 'B' })));
+
+        check(table.contains("first"));
+        check(table.contains(new String("fourth")));
+        check(!table.contains("fifth"));
+        table.remove("Aa");
+        check(!table.contains("first"));
+        check(!table.containsKey("Aa"));
+        check(table.containsKey("BB"));
+        check(table.contains("second"));
+        check(table.contains("third"));
+    }
+
+    /*
+     * keys() and elements() return each remaining entry once, in the
+     * same order, and nothing that has been removed.
+     */
+    static void testEnumerationsAfterRemove() {
+        Hashtable table = new Hashtable();
+        for (int i = 0; i < 20; i++) {
+            table.put(new Integer(i * 11), new Integer(-i));
+        }
+        for (int i = 0; i < 20; i += 3) {
+            table.remove(new Integer(i * 11));
+        }
+
+        boolean[] seen = new boolean[20];
+        Enumeration keys = table.keys();
+        Enumeration elements = table.elements();
+        int count = 0;
+        while (keys.hasMoreElements()) {
+            check(elements.hasMoreElements());
+            Integer key = (Integer)keys.nextElement();
+            Integer element = (Integer)elements.nextElement();
+            int i = key.intValue() / 11;
+            check(i % 3 != 0);
+            check(!seen[i]);
+            seen[i] = true;
+            check(element.intValue() == -i);
+            count++;
+        }
+        check(!elements.hasMoreElements());
+        check(count == table.size());
+        check(count == 13);
+        try {
+            keys.nextElement();
+            check(false);
+        } catch (NoSuchElementException e) {
+        }
+        try {
+            elements.nextElement();
+            check(false);
+        } catch (NoSuchElementException e) {
+        }
+
+        /* Removing everything leaves empty enumerations */
+        for (int i = 0; i < 20; i++) {
+            table.remove(new Integer(i * 11));
+        }
+        check(table.isEmpty());
+        check(!table.keys().hasMoreElements());
+        check(!table.elements().hasMoreElements());
+    }
+
+    static void testNullArguments() {
+        Hashtable table = new Hashtable();
+        table.put("key", "value");
+        try {
+            table.put(null, "value");
+            check(false);
+        } catch (NullPointerException e) {
+        }
+        try {
+            table.put("key", null);
+            check(false);
+        } catch (NullPointerException e) {
+        }
+        try {
+            table.get(null);
+            check(false);
+        } catch (NullPointerException e) {
+        }
+        try {
+            table.containsKey(null);
+            check(false);
+        } catch (NullPointerException e) {
+        }
+        try {
+            table.contains(null);
+            check(false);
+        } catch (NullPointerException e) {
+        }
+        try {
+            table.remove(null);
+            check(false);
+        } catch (NullPointerException e) {
+        }
+        /* The failed calls changed nothing */
+        check(table.size() == 1);
+        check("value".equals(table.get("key")));
+    }
+
+    public boolean runTest(int n) throws Throwable {
+        switch (n) {
+        case 1:
+            testRemoveInRun(integerKeys());
+            break;
+
+        case 2:
+            testRemoveInRun(stringKeys());
+            break;
+
+        case 3:
+            testRemoveInRun(objectKeys());
+            break;
+
+        case 4:
+            testManyChanges();
+            break;
+
+        case 5:
+            testRehash();
+            break;
+
+        case 6:
+            testCollisions();
+            break;
+
+        case 7:
+            testEnumerationsAfterRemove();
+            break;
+
+        case 8:
+            testNullArguments();
+            break;
+
+        default:
+            return true;
+        }
+        return false;
+    }
+
+    static void check(boolean condition) {
+        if (!condition) {
+            throw new RuntimeException("wrong result");
+        }
+    }
+
+    public static void main(String[] args) {
+        new HashtableTest().run();
+    }
+}
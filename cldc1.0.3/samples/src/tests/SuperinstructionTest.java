@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package tests;
+
+/**
+ * Test of the superinstructions (<code>SUPERINSTRUCTIONS=true</code> in
+ * the Unix makefile).  Each test runs code that javac compiles to one of
+ * the fused pairs: <code>aload_0</code> before <code>getfield</code> (of
+ * an int or an object field) or
+ * <code>invokevirtual</code>, <code>iload</code> before
+ * <code>if_icmp&lt;cond&gt;</code>, and <code>iconst_1</code> before
+ * <code>iadd</code>.  The tests branch to the second instruction of a
+ * pair, leave a pair through both sides of its branch, and throw
+ * exceptions from inside a pair, and check every result.  Run it with
+ * and without <code>-nosuperinstructions</code>: it must pass both ways.
+ * <p>
+ * Usage: <code>kvm -classpath ... tests.SuperinstructionTest</code>
+ */
+public class SuperinstructionTest extends BaseTest {
+
+    int value;
+    SuperinstructionTest next;
+
+    SuperinstructionTest(int value) {
+        this.value = value;
+    }
+
+    public SuperinstructionTest() {
+        this(0);
+    }
+
+    public String testName() {
+        return "SuperinstructionTest";
+    }
+
+    /* aload_0, getfield; local 0 is a parameter, so it can be null */
+    static int getValue(SuperinstructionTest t) {
+        return t.value;
+    }
+
+    /* aload_0, getfield of an object field */
+    static SuperinstructionTest getNext(SuperinstructionTest t) {
+        return t.next;
+    }
+
+    /* aload_0, invokevirtual */
+    static int callValue(SuperinstructionTest t) {
+        return t.value();
+    }
+
+    int value() {
+        if (value < 0) {
+            throw new IllegalArgumentException();
+        }
+        return value;
+    }
+
+    /* aload_0, getfield on this, in a loop */
+    int sumValue(int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += this.value;
+        }
+        return sum;
+    }
+
+    /* iload, if_icmp<cond>; the goto lands on the if_icmpge, and the
+     * branch leaves the pair both ways */
+    static int lessThanEither(int i, boolean flag, int j, int k) {
+        if (i < (flag ? j : k)) {
+            return 1;
+        }
+        return 0;
+    }
+
+    /* iload_<n>, if_icmp<cond> as the condition of loops */
+    static int countBelow(int limit) {
+        int count = 0;
+        for (int i = 0; i < limit; i++) {
+            for (int j = 0; j < i; j++) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /* iload with an index above 3, if_icmp<cond> */
+    static int maxOfSix(int a, int b, int c, int d, int e, int f) {
+        int max = a;
+        int[] rest = { b, c, d, e, f };
+        for (int i = 0; i < rest.length; i++) {
+            int x = rest[i];
+            if (x > max) {
+                max = x;
+            }
+        }
+        return max;
+    }
+
+    /* iconst_1, iadd; the goto lands on the iadd */
+    static int addOneOrTwo(int a, boolean flag) {
+        return a + (flag ? 2 : 1);
+    }
+
+    /* iconst_1, iadd, istore; a + 1 alone would be an iinc */
+    static int tripleAndIncrement(int a) {
+        a = a * 3 + 1;
+        return a;
+    }
+
+    /* iconst_1, iadd, istore with an index above 3 */
+    static int tripleAndIncrementFifth(int a, int b, int c, int d, int e) {
+        e = e * 3 + 1;
+        return e - a;
+    }
+
+    public boolean runTest(int n) throws Throwable {
+        SuperinstructionTest seven = new SuperinstructionTest(7);
+        SuperinstructionTest negative = new SuperinstructionTest(-1);
+
+        switch (n) {
+        case 1:
+            check(getValue(seven) == 7);
+            check(seven.sumValue(10) == 70);
+            try {
+                getValue(null);
+                check(false);
+            } catch (NullPointerException e) {
+            }
+            /* The pair still works after the exception */
+            check(getValue(seven) == 7);
+            seven.next = negative;
+            check(getNext(seven) == negative);
+            check(getNext(negative) == null);
+            try {
+                getNext(null);
+                check(false);
+            } catch (NullPointerException e) {
+            }
+            break;
+
+        case 2:
+            check(callValue(seven) == 7);
+            try {
+                callValue(null);
+                check(false);
+            } catch (NullPointerException e) {
+            }
+            try {
+                callValue(negative);
+                check(false);
+            } catch (IllegalArgumentException e) {
+            }
+            check(callValue(seven) == 7);
+            break;
+
+        case 3:
+            check(lessThanEither(1, true, 2, 0) == 1);
+            check(lessThanEither(1, true, 0, 2) == 0);
+            check(lessThanEither(1, false, 2, 0) == 0);
+            check(lessThanEither(1, false, 0, 2) == 1);
+            check(lessThanEither(Integer.MIN_VALUE, false, 0,
+                                 Integer.MAX_VALUE) == 1);
+            break;
+
+        case 4:
+            check(countBelow(0) == 0);
+            check(countBelow(1) == 0);
+            check(countBelow(10) == 45);
+            check(maxOfSix(1, 2, 3, 4, 5, 6) == 6);
+            check(maxOfSix(6, 5, 4, 3, 2, 1) == 6);
+            check(maxOfSix(-3, -2, -9, -1, -5, -4) == -1);
+            break;
+
+        case 5:
+            check(addOneOrTwo(5, false) == 6);
+            check(addOneOrTwo(5, true) == 7);
+            check(addOneOrTwo(Integer.MAX_VALUE, false) == Integer.MIN_VALUE);
+            check(tripleAndIncrement(41) == 124);
+            check(tripleAndIncrement(-1) == -2);
+            check(tripleAndIncrementFifth(4, 0, 0, 0, 41) == 120);
+            break;
+
+        default:
+            return true;
+        }
+        return false;
+    }
+
+    static void check(boolean condition) {
+        if (!condition) {
+            throw new RuntimeException("wrong result");
+        }
+    }
+
+    public static void main(String[] args) {
+        /* The second run has the fast bytecodes the pairs continue into */
+        for (int i = 0; i < 2; i++) {
+            new SuperinstructionTest().run();
+        }
+    }
+}
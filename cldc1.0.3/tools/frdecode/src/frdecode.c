@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * SYSTEM:    KVM tools
+ * SUBSYSTEM: Flight recorder
+ * FILE:      frdecode.c
+ * OVERVIEW:  Prints a file written by the KVM flight recorder
+ *            (kvm -record <file>) as text, one event per line:
+ *
+ *              time(ms)  thread  event  duration(ms)  details
+ *
+ *            The file format is described in kvm/VmCommon/src/recorder.c.
+ *            Usage: frdecode [-t <type>] <file>
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+#define FR_MAGIC     "KVMR"
+#define FR_VERSION   1
+#define FR_NAME      0
+
+/* These must match enum recordedEventType in recorder.h */
+#define FR_GC_BEGIN           1
+#define FR_GC_END             2
+#define FR_CLASS_LOAD         3
+#define FR_MONITOR_CONTENDED  4
+#define FR_THREAD_SWITCH      5
+#define FR_EXCEPTION_THROWN   6
+#define FR_EXCEPTION_CAUGHT   7
+#define FR_PERMIT_VERIFIED    8
+#define FR_SOCKET_WAIT        9
+#define FR_LAST_EVENT_TYPE    FR_SOCKET_WAIT
+
+static const char* eventNames[FR_LAST_EVENT_TYPE + 1] = {
+    "?",
+    "gc-begin",
+    "gc-end",
+    "class-load",
+    "monitor-contended",
+    "thread-switch",
+    "exception-thrown",
+    "exception-caught",
+    "permit-verified",
+    "socket-wait"
+};
+
+static const char* socketOperations[] = {
+    "?", "connect", "read", "write", "accept"
+};
+
+/* Name records, indexed by id */
+static char** names = NULL;
+static unsigned long nameCount = 0;
+
+static FILE* input;
+static const char* inputName;
+
+/*=========================================================================
+ * Reading
+ *=======================================================================*/
+
+static void truncated(void)
+{
+    fprintf(stderr, "frdecode: %s: unexpected end of file\n", inputName);
+    exit(1);
+}
+
+static unsigned long getU1(void)
+{
+    int c = getc(input);
+    if (c == EOF) {
+        truncated();
+    }
+    return (unsigned long)c;
+}
+
+static unsigned long getU2(void)
+{
+    unsigned long high = getU1();
+    return (high << 8) | getU1();
+}
+
+static unsigned long getU4(void)
+{
+    unsigned long high = getU2();
+    return (high << 16) | getU2();
+}
+
+static double getU8(void)
+{
+    double high = (double)getU4();
+    return high * 4294967296.0 + (double)getU4();
+}
+
+static void readName(void)
+{
+    unsigned long id = getU4();
+    unsigned long length = getU2();
+    char* name = (char*)malloc(length + 1);
+
+    if (name == NULL) {
+        fprintf(stderr, "frdecode: out of memory\n");
+        exit(1);
+    }
+    if (fread(name, 1, length, input) != length) {
+        truncated();
+    }
+    name[length] = '\0';
+
+    if (id >= nameCount) {
+        unsigned long newCount = nameCount == 0 ? 256 : nameCount;
+        while (newCount <= id) {
+            newCount <<= 1;
+        }
+        names = (char**)realloc(names, newCount * sizeof(char*));
+        if (names == NULL) {
+            fprintf(stderr, "frdecode: out of memory\n");
+            exit(1);
+        }
+        memset(names + nameCount, 0, (newCount - nameCount) * sizeof(char*));
+        nameCount = newCount;
+    }
+    names[id] = name;
+}
+
+static const char* getName(unsigned long id)
+{
+    if (id == 0) {
+        return "-";
+    }
+    if (id >= nameCount || names[id] == NULL) {
+        return "?";
+    }
+    return names[id];
+}
+
+/*=========================================================================
+ * Printing
+ *=======================================================================*/
+
+static void printDetails(int type, unsigned long value1,
+                         unsigned long value2)
+{
+    switch (type) {
+    case FR_GC_BEGIN:
+        printf("requested=%lu free=%lu", value1, value2);
+        break;
+    case FR_GC_END:
+        printf("free=%lu", value1);
+        break;
+    case FR_CLASS_LOAD:
+        printf("%s", getName(value1));
+        break;
+    case FR_MONITOR_CONTENDED:
+        printf("%s owner=%lu", getName(value1), value2);
+        break;
+    case FR_THREAD_SWITCH:
+        printf("from=%lu to=%lu", value1, value2);
+        break;
+    case FR_EXCEPTION_THROWN:
+        printf("%s in %s", getName(value1), getName(value2));
+        break;
+    case FR_EXCEPTION_CAUGHT:
+        if (value2 == 0) {
+            printf("%s uncaught", getName(value1));
+        } else {
+            printf("%s in %s", getName(value1), getName(value2));
+        }
+        break;
+    case FR_PERMIT_VERIFIED:
+        printf("grantee=%s grantor=%s", getName(value1), getName(value2));
+        break;
+    case FR_SOCKET_WAIT:
+        printf("%s fd=%ld",
+               value2 <= 4 ? socketOperations[value2] : "?", (long)value1);
+        break;
+    default:
+        printf("%lu %lu", value1, value2);
+        break;
+    }
+}
+
+static int eventType(const char* name)
+{
+    int type;
+    for (type = 1; type <= FR_LAST_EVENT_TYPE; type++) {
+        if (strcmp(name, eventNames[type]) == 0) {
+            return type;
+        }
+    }
+    return -1;
+}
+
+static void usage(void)
+{
+    int type;
+    fprintf(stderr, "Usage: frdecode [-t <event>] <file>\n");
+    fprintf(stderr, "Events:");
+    for (type = 1; type <= FR_LAST_EVENT_TYPE; type++) {
+        fprintf(stderr, " %s", eventNames[type]);
+    }
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+/*=========================================================================
+ * FUNCTION:      main
+ * TYPE:          main program
+ * OVERVIEW:      Prints the header and then every event in the file,
+ *                optionally only the events of one type.
+ *=======================================================================*/
+
+int main(int argc, char** argv)
+{
+    char magic[4];
+    unsigned long count, lost, i;
+    double startMillis;
+    int only = 0;
+
+    if (argc == 4 && strcmp(argv[1], "-t") == 0) {
+        only = eventType(argv[2]);
+        if (only < 0) {
+            usage();
+        }
+        argv += 2; argc -= 2;
+    }
+    if (argc != 2) {
+        usage();
+    }
+
+    inputName = argv[1];
+    input = fopen(inputName, "rb");
+    if (input == NULL) {
+        fprintf(stderr, "frdecode: cannot open %s\n", inputName);
+        return 1;
+    }
+    if (fread(magic, 1, 4, input) != 4 || memcmp(magic, FR_MAGIC, 4) != 0) {
+        fprintf(stderr, "frdecode: %s is not a flight recorder file\n",
+                inputName);
+        return 1;
+    }
+    if (getU2() != FR_VERSION) {
+        fprintf(stderr, "frdecode: %s: unsupported version\n", inputName);
+        return 1;
+    }
+    count = getU4();
+    lost = getU4();
+    startMillis = getU8();
+
+    printf("# %lu events (%lu older events lost), recording started at "
+           "%.0f ms\n", count, lost, startMillis);
+    printf("# %12s %6s  %-18s %10s  %s\n",
+           "time(ms)", "thread", "event", "dur(ms)", "details");
+
+    for (i = 0; i < count; ) {
+        int type = (int)getU1();
+        unsigned long thread, duration, value1, value2;
+        double time;
+
+        if (type == FR_NAME) {
+            readName();
+            continue;
+        }
+        thread = getU2();
+        time = getU8();
+        duration = getU4();
+        value1 = getU4();
+        value2 = getU4();
+        i++;
+
+        if (only != 0 && type != only) {
+            continue;
+        }
+        printf("%14.3f %6lu  %-18s %10.3f  ",
+               time / 1000.0, thread,
+               type <= FR_LAST_EVENT_TYPE ? eventNames[type] : "?",
+               duration / 1000.0);
+        printDetails(type, value1, value2);
+        printf("\n");
+    }
+
+    fclose(input);
+    return 0;
+}
@@ -0,0 +1,882 @@
+/*
+ * Copyright (c) 1998-2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the confidential and proprietary information of Sun
+ * Microsystems, Inc. ("Confidential Information").  You shall not
+ * disclose such Confidential Information and shall use it only in
+ * accordance with the terms of the license agreement you entered into
+ * with Sun.
+ *
+ * SUN MAKES NO REPRESENTATIONS OR WARRANTIES ABOUT THE SUITABILITY OF THE
+ * SOFTWARE, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE, OR NON-INFRINGEMENT. SUN SHALL NOT BE LIABLE FOR ANY DAMAGES
+ * SUFFERED BY LICENSEE AS A RESULT OF USING, MODIFYING OR DISTRIBUTING
+ * THIS SOFTWARE OR ITS DERIVATIVES.
+ *
+ */
+
+/*=========================================================================
+ * SYSTEM:    KVM tools
+ * SUBSYSTEM: Heap dumps
+ * FILE:      heapanalyzer.c
+ * OVERVIEW:  Reads a heap dump written by the KVM (kvm -heapdump <file>)
+ *            and reports where the memory goes.  The object graph is
+ *            built from the references in the dump, with one extra
+ *            node standing for the VM that points to every root.  The
+ *            dominator tree of that graph gives the retained size of
+ *            each object: the memory that would be freed if the object
+ *            became garbage.  The report lists
+ *
+ *              - the reachable and unreachable (not yet collected)
+ *                objects,
+ *              - for each class, the number of instances, their own
+ *                size and the size they retain,
+ *              - the objects with the largest retained size, each with
+ *                the chain of objects that dominate it up to its root.
+ *
+ *            The file format is described in kvm/VmCommon/src/heapdump.c.
+ *            Usage: heapanalyzer [-n <count>] <file>
+ *=======================================================================*/
+
+/*=========================================================================
+ * Include files
+ *=======================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*=========================================================================
+ * Definitions and declarations
+ *=======================================================================*/
+
+#define HD_MAGIC            "KVMH"
+#define HD_VERSION          1
+
+/* These must match the record tags in heapdump.c */
+#define HD_CLASS            1
+#define HD_INSTANCE         2
+#define HD_OBJECT_ARRAY     3
+#define HD_PRIMITIVE_ARRAY  4
+#define HD_VM_OBJECT        5
+#define HD_ROOT             6
+
+#define HD_LAST_ROOT_KIND   8
+
+static const char* rootKinds[HD_LAST_ROOT_KIND + 1] = {
+    "several roots",
+    "global root",
+    "temporary root",
+    "static field",
+    "thread stack",
+    "thread",
+    "lock or hash code",
+    "trusted class",
+    "VM"
+};
+
+/* Names of the GCT_xxx types (GCT_TYPENAMES in garbage.h) */
+static const char* vmObjectNames[] = {
+    "<free>", "<nopointers>", "<instance>", "<array>", "<objectarray>",
+    "<methodtable>", "<pointerlist>", "<execstack>", "<thread>",
+    "<monitor>", "<weakpointerlist>"
+};
+
+#define VM_OBJECT_TYPES (sizeof(vmObjectNames) / sizeof(vmObjectNames[0]))
+
+/* Number of dominators shown for each of the largest objects */
+#define MAX_CHAIN_LENGTH    6
+
+typedef unsigned long objectID;
+
+typedef struct classStruct {
+    objectID id;
+    objectID superId;
+    char* name;
+    long fieldCount;        /* Instance reference fields of this class */
+    unsigned long* fieldOffsets;
+    long refCount;          /* Including the superclasses, -1 until known */
+    unsigned long* refOffsets;
+    /* Totals of the report */
+    unsigned long count;
+    double shallow;
+    double retained;
+    int active;             /* Instances on the current dominator path */
+} CLASSINFO;
+
+typedef struct objectStruct {
+    objectID id;
+    long clazz;             /* Index in classes */
+    unsigned long size;
+    unsigned long firstRef; /* Index in refs */
+    unsigned long refCount;
+    int rootKind;           /* First root that holds the object, or 0 */
+} OBJECTINFO;
+
+static CLASSINFO* classes;
+static long classCount, classCapacity;
+
+static OBJECTINFO* objects;
+static long objectCount, objectCapacity;
+
+/* References of all the objects; ids while reading, then indices */
+static objectID* refs;
+static unsigned long refCount, refCapacity;
+
+/* Roots, as indices in objects */
+static long* roots;
+static long rootCount, rootCapacity;
+
+static FILE* input;
+static const char* inputName;
+static int idSize;
+
+/*=========================================================================
+ * Reading
+ *=======================================================================*/
+
+static void truncated(void)
+{
+    fprintf(stderr, "heapanalyzer: %s: unexpected end of file\n", inputName);
+    exit(1);
+}
+
+static void outOfMemory(void)
+{
+    fprintf(stderr, "heapanalyzer: out of memory\n");
+    exit(1);
+}
+
+static void* grow(void* array, long* capacity, long count, size_t size)
+{
+    if (count >= *capacity) {
+        *capacity = (*capacity == 0) ? 1024 : *capacity * 2;
+        array = realloc(array, *capacity * size);
+        if (array == NULL) {
+            outOfMemory();
+        }
+    }
+    return array;
+}
+
+static void* allocate(size_t size)
+{
+    void* result = calloc(size == 0 ? 1 : size, 1);
+    if (result == NULL) {
+        outOfMemory();
+    }
+    return result;
+}
+
+static unsigned long getU1(void)
+{
+    int c = getc(input);
+    if (c == EOF) {
+        truncated();
+    }
+    return (unsigned long)c;
+}
+
+static unsigned long getU2(void)
+{
+    unsigned long high = getU1();
+    return (high << 8) | getU1();
+}
+
+static unsigned long getU4(void)
+{
+    unsigned long high = getU2();
+    return (high << 16) | getU2();
+}
+
+static objectID getID(void)
+{
+    objectID id = 0;
+    int i;
+    for (i = 0; i < idSize; i++) {
+        id = (id << 8) | getU1();
+    }
+    return id;
+}
+
+static void skip(unsigned long length)
+{
+    while (length-- > 0) {
+        getU1();
+    }
+}
+
+static char* getString(void)
+{
+    unsigned long length = getU2();
+    char* string = (char*)allocate(length + 1);
+    if (length > 0 && fread(string, 1, length, input) != length) {
+        truncated();
+    }
+    string[length] = '\0';
+    return string;
+}
+
+static void addRef(objectID id)
+{
+    long capacity = (long)refCapacity;
+    refs = (objectID*)grow(refs, &capacity, (long)refCount, sizeof(objectID));
+    refCapacity = (unsigned long)capacity;
+    refs[refCount++] = id;
+}
+
+static long findClass(objectID id)
+{
+    long low = 0, high = classCount - 1;
+    while (low <= high) {
+        long middle = (low + high) / 2;
+        if (classes[middle].id == id) {
+            return middle;
+        } else if (classes[middle].id < id) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return -1;
+}
+
+static long findObject(objectID id)
+{
+    long low = 0, high = objectCount - 1;
+    while (low <= high) {
+        long middle = (low + high) / 2;
+        if (objects[middle].id == id) {
+            return middle;
+        } else if (objects[middle].id < id) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return -1;
+}
+
+static int compareClasses(const void* a, const void* b)
+{
+    objectID x = ((const CLASSINFO*)a)->id, y = ((const CLASSINFO*)b)->id;
+    return (x < y) ? -1 : (x > y);
+}
+
+static int compareObjects(const void* a, const void* b)
+{
+    objectID x = ((const OBJECTINFO*)a)->id, y = ((const OBJECTINFO*)b)->id;
+    return (x < y) ? -1 : (x > y);
+}
+
+static void readClass(void)
+{
+    CLASSINFO* clazz;
+    unsigned long fields, i;
+
+    classes = (CLASSINFO*)grow(classes, &classCapacity, classCount,
+                               sizeof(CLASSINFO));
+    clazz = &classes[classCount++];
+    memset(clazz, 0, sizeof(CLASSINFO));
+    clazz->id = getID();
+    clazz->superId = getID();
+    getU4();                                    /* Instance size */
+    clazz->name = getString();
+    clazz->refCount = -1;
+
+    fields = getU2();
+    clazz->fieldOffsets = (unsigned long*)
+        allocate(fields * sizeof(unsigned long));
+    for (i = 0; i < fields; i++) {
+        char* name = getString();
+        char* signature = getString();
+        int isReference = (signature[0] == 'L' || signature[0] == '[');
+        if (getU1()) {
+            /* Static: its values are roots of their own */
+            getID();
+            if (signature[0] == 'J' || signature[0] == 'D') {
+                getID();
+            }
+        } else {
+            unsigned long offset = getU4();
+            if (isReference) {
+                clazz->fieldOffsets[clazz->fieldCount++] = offset;
+            }
+        }
+        free(name);
+        free(signature);
+    }
+    if (getU1()) {
+        /* Trusted class: access flags, domains and permit grantors */
+        unsigned long permits;
+        getU2();
+        getU2();
+        permits = getU2();
+        for (i = 0; i < permits; i++) {
+            getID();
+        }
+    }
+}
+
+/*
+ * Collect the reference fields of a class and its superclasses
+ */
+static void resolveFields(CLASSINFO* clazz)
+{
+    long superClass, i;
+    CLASSINFO* super = NULL;
+
+    if (clazz->refCount >= 0) {
+        return;
+    }
+    clazz->refCount = 0;            /* Stops cycles in a broken dump */
+    superClass = (clazz->superId == 0) ? -1 : findClass(clazz->superId);
+    if (superClass >= 0) {
+        super = &classes[superClass];
+        resolveFields(super);
+    }
+    clazz->refOffsets = (unsigned long*)allocate(
+        (clazz->fieldCount + (super ? super->refCount : 0))
+            * sizeof(unsigned long));
+    for (i = 0; i < clazz->fieldCount; i++) {
+        clazz->refOffsets[clazz->refCount++] = clazz->fieldOffsets[i];
+    }
+    for (i = 0; super != NULL && i < super->refCount; i++) {
+        clazz->refOffsets[clazz->refCount++] = super->refOffsets[i];
+    }
+}
+
+/*
+ * Internal VM objects are counted under a made up class for each
+ * GCT_xxx type, whose id is the type (below any real class address)
+ */
+static void addVMObjectClasses(void)
+{
+    unsigned long type;
+    for (type = 0; type <= VM_OBJECT_TYPES; type++) {
+        CLASSINFO* clazz;
+        classes = (CLASSINFO*)grow(classes, &classCapacity, classCount,
+                                   sizeof(CLASSINFO));
+        clazz = &classes[classCount++];
+        memset(clazz, 0, sizeof(CLASSINFO));
+        clazz->id = (objectID)type;
+        clazz->name = (char*)(type < VM_OBJECT_TYPES
+                                  ? vmObjectNames[type] : "<vm>");
+    }
+}
+
+static long vmObjectClass(unsigned long type)
+{
+    return findClass((objectID)(type < VM_OBJECT_TYPES
+                                    ? type : VM_OBJECT_TYPES));
+}
+
+static void readObject(int tag)
+{
+    OBJECTINFO* object;
+    unsigned long length, i;
+
+    objects = (OBJECTINFO*)grow(objects, &objectCapacity, objectCount,
+                                sizeof(OBJECTINFO));
+    object = &objects[objectCount++];
+    memset(object, 0, sizeof(OBJECTINFO));
+    object->id = getID();
+    object->firstRef = refCount;
+
+    if (tag == HD_VM_OBJECT) {
+        object->clazz = vmObjectClass(getU1());
+        object->size = getU4();
+        length = getU4();
+        for (i = 0; i < length; i++) {
+            addRef(getID());
+        }
+    } else {
+        object->clazz = findClass(getID());
+        object->size = getU4();
+        length = getU4();
+        if (object->clazz < 0) {
+            fprintf(stderr, "heapanalyzer: %s: object 0x%lx of unknown "
+                    "class\n", inputName, object->id);
+            exit(1);
+        }
+        if (tag == HD_INSTANCE) {
+            CLASSINFO* clazz = &classes[object->clazz];
+            objectID* cells = (objectID*)allocate(length * sizeof(objectID));
+            resolveFields(clazz);
+            for (i = 0; i < length; i++) {
+                cells[i] = getID();
+            }
+            for (i = 0; i < (unsigned long)clazz->refCount; i++) {
+                if (clazz->refOffsets[i] < length) {
+                    addRef(cells[clazz->refOffsets[i]]);
+                }
+            }
+            free(cells);
+        } else if (tag == HD_OBJECT_ARRAY) {
+            for (i = 0; i < length; i++) {
+                addRef(getID());
+            }
+        } else {
+            skip(length * getU1());
+        }
+    }
+    object->refCount = refCount - object->firstRef;
+}
+
+static void readRoot(void)
+{
+    int kind = (int)getU1();
+    objectID id = getID();
+    long index;
+
+    getID();                                    /* Holder */
+    index = findObject(id);
+    if (index >= 0) {
+        roots = (long*)grow(roots, &rootCapacity, rootCount, sizeof(long));
+        roots[rootCount++] = index;
+        if (objects[index].rootKind == 0) {
+            objects[index].rootKind = kind;
+        }
+    }
+}
+
+/*
+ * Read the whole file.  Classes come first, then the objects in
+ * address order, then the roots.
+ */
+static void readDump(unsigned long* heapSize, unsigned long* freeSize)
+{
+    char magic[4];
+    int classesSorted = 0, objectsSorted = 0;
+    int tag;
+    unsigned long i;
+
+    if (fread(magic, 1, 4, input) != 4 || memcmp(magic, HD_MAGIC, 4) != 0) {
+        fprintf(stderr, "heapanalyzer: %s is not a KVM heap dump\n",
+                inputName);
+        exit(1);
+    }
+    if (getU2() != HD_VERSION) {
+        fprintf(stderr, "heapanalyzer: %s: unsupported version\n", inputName);
+        exit(1);
+    }
+    idSize = (int)getU1();
+    if (idSize < 1 || idSize > (int)sizeof(objectID)) {
+        fprintf(stderr, "heapanalyzer: %s: %d-byte ids are not supported\n",
+                inputName, idSize);
+        exit(1);
+    }
+    getU1();                                    /* Byte order */
+    getU4();                                    /* Time */
+    getU4();
+    *heapSize = getU4();
+    *freeSize = getU4();
+
+    addVMObjectClasses();
+    while ((tag = getc(input)) != EOF) {
+        switch (tag) {
+        case HD_CLASS:
+            if (classesSorted) {
+                fprintf(stderr, "heapanalyzer: %s: class after objects\n",
+                        inputName);
+                exit(1);
+            }
+            readClass();
+            break;
+        case HD_INSTANCE:
+        case HD_OBJECT_ARRAY:
+        case HD_PRIMITIVE_ARRAY:
+        case HD_VM_OBJECT:
+            if (!classesSorted) {
+                qsort(classes, classCount, sizeof(CLASSINFO), compareClasses);
+                classesSorted = 1;
+            }
+            readObject(tag);
+            break;
+        case HD_ROOT:
+            if (!objectsSorted) {
+                qsort(objects, objectCount, sizeof(OBJECTINFO),
+                      compareObjects);
+                objectsSorted = 1;
+            }
+            readRoot();
+            break;
+        default:
+            fprintf(stderr, "heapanalyzer: %s: bad record tag %d\n",
+                    inputName, tag);
+            exit(1);
+        }
+    }
+    if (!objectsSorted) {
+        qsort(objects, objectCount, sizeof(OBJECTINFO), compareObjects);
+    }
+
+    /* Turn the references into object indices; -1 if not an object */
+    for (i = 0; i < refCount; i++) {
+        long index = (refs[i] == 0) ? -1 : findObject(refs[i]);
+        refs[i] = (objectID)index;
+    }
+}
+
+/*=========================================================================
+ * Dominators
+ *
+ * Node 0 is the VM, whose successors are the roots; node i + 1 is
+ * objects[i].  The dominators are computed with the iterative
+ * algorithm of Cooper, Harvey and Kennedy, in reverse postorder of a
+ * depth first search from node 0.
+ *=======================================================================*/
+
+static long  nodeCount;
+static long* postorder;        /* Node numbers in postorder */
+static long* postNumber;       /* Postorder number of each node, or -1 */
+static long  reachableCount;   /* Including node 0 */
+static long* dominator;        /* Immediate dominator, -1 if unreachable */
+static long* predStart;        /* Predecessors of each node, */
+static long* preds;            /* as preds[predStart[n]..predStart[n+1]) */
+static double* retained;
+
+static long successorCount(long node)
+{
+    return (node == 0) ? rootCount : (long)objects[node - 1].refCount;
+}
+
+static long successor(long node, long i)
+{
+    if (node == 0) {
+        return roots[i] + 1;
+    } else {
+        long index = (long)refs[objects[node - 1].firstRef + i];
+        return (index < 0) ? -1 : index + 1;
+    }
+}
+
+static void depthFirstSearch(void)
+{
+    long* stack = (long*)allocate(nodeCount * sizeof(long));
+    long* next = (long*)allocate(nodeCount * sizeof(long));
+    long depth = 0, count = 0, n;
+
+    for (n = 0; n < nodeCount; n++) {
+        postNumber[n] = -1;
+    }
+    stack[depth++] = 0;
+    postNumber[0] = -2;                         /* Visited */
+    while (depth > 0) {
+        long node = stack[depth - 1];
+        if (next[node] < successorCount(node)) {
+            long child = successor(node, next[node]++);
+            if (child >= 0 && postNumber[child] == -1) {
+                postNumber[child] = -2;
+                stack[depth++] = child;
+            }
+        } else {
+            depth--;
+            postNumber[node] = count;
+            postorder[count++] = node;
+        }
+    }
+    reachableCount = count;
+    free(stack);
+    free(next);
+}
+
+static void buildPredecessors(void)
+{
+    long n, i;
+
+    predStart = (long*)allocate((nodeCount + 1) * sizeof(long));
+    for (n = 0; n < nodeCount; n++) {
+        if (postNumber[n] < 0) {
+            continue;
+        }
+        for (i = 0; i < successorCount(n); i++) {
+            long child = successor(n, i);
+            if (child >= 0) {
+                predStart[child + 1]++;
+            }
+        }
+    }
+    for (n = 0; n < nodeCount; n++) {
+        predStart[n + 1] += predStart[n];
+    }
+    preds = (long*)allocate((predStart[nodeCount] + 1) * sizeof(long));
+    {
+        long* fill = (long*)allocate(nodeCount * sizeof(long));
+        for (n = 0; n < nodeCount; n++) {
+            if (postNumber[n] < 0) {
+                continue;
+            }
+            for (i = 0; i < successorCount(n); i++) {
+                long child = successor(n, i);
+                if (child >= 0) {
+                    preds[predStart[child] + fill[child]++] = n;
+                }
+            }
+        }
+        free(fill);
+    }
+}
+
+static long intersect(long a, long b)
+{
+    while (a != b) {
+        while (postNumber[a] < postNumber[b]) {
+            a = dominator[a];
+        }
+        while (postNumber[b] < postNumber[a]) {
+            b = dominator[b];
+        }
+    }
+    return a;
+}
+
+static void computeDominators(void)
+{
+    int changed = 1;
+    long n, i;
+
+    nodeCount = objectCount + 1;
+    postorder = (long*)allocate(nodeCount * sizeof(long));
+    postNumber = (long*)allocate(nodeCount * sizeof(long));
+    dominator = (long*)allocate(nodeCount * sizeof(long));
+    retained = (double*)allocate(nodeCount * sizeof(double));
+
+    depthFirstSearch();
+    buildPredecessors();
+
+    for (n = 0; n < nodeCount; n++) {
+        dominator[n] = -1;
+    }
+    dominator[0] = 0;
+    while (changed) {
+        changed = 0;
+        /* Reverse postorder, skipping node 0 (the last in postorder) */
+        for (i = reachableCount - 2; i >= 0; i--) {
+            long node = postorder[i];
+            long newDominator = -1;
+            long p;
+            for (p = predStart[node]; p < predStart[node + 1]; p++) {
+                long pred = preds[p];
+                if (dominator[pred] < 0) {
+                    continue;
+                }
+                newDominator = (newDominator < 0)
+                    ? pred : intersect(pred, newDominator);
+            }
+            if (dominator[node] != newDominator) {
+                dominator[node] = newDominator;
+                changed = 1;
+            }
+        }
+    }
+
+    /* A dominator always comes after the nodes it dominates in postorder */
+    for (i = 0; i < reachableCount; i++) {
+        long node = postorder[i];
+        if (node != 0) {
+            retained[node] += objects[node - 1].size;
+            retained[dominator[node]] += retained[node];
+        }
+    }
+}
+
+/*
+ * The retained size of a class is that of its instances, except for
+ * those dominated by another instance of the class (the entries of a
+ * linked list, for instance), which would otherwise be counted twice
+ */
+static void computeClassTotals(void)
+{
+    long* childStart = (long*)allocate((nodeCount + 1) * sizeof(long));
+    long* children = (long*)allocate(nodeCount * sizeof(long));
+    long* fill = (long*)allocate(nodeCount * sizeof(long));
+    long* stack = (long*)allocate(nodeCount * sizeof(long));
+    long* next = (long*)allocate(nodeCount * sizeof(long));
+    long depth = 0, n;
+
+    for (n = 1; n < nodeCount; n++) {
+        CLASSINFO* clazz = &classes[objects[n - 1].clazz];
+        clazz->count++;
+        clazz->shallow += objects[n - 1].size;
+        if (dominator[n] >= 0) {
+            childStart[dominator[n] + 1]++;
+        }
+    }
+    for (n = 0; n < nodeCount; n++) {
+        childStart[n + 1] += childStart[n];
+    }
+    for (n = 1; n < nodeCount; n++) {
+        if (dominator[n] >= 0) {
+            children[childStart[dominator[n]] + fill[dominator[n]]++] = n;
+        }
+    }
+
+    stack[depth++] = 0;
+    while (depth > 0) {
+        long node = stack[depth - 1];
+        if (next[node] == 0 && node != 0) {
+            CLASSINFO* clazz = &classes[objects[node - 1].clazz];
+            if (clazz->active++ == 0) {
+                clazz->retained += retained[node];
+            }
+        }
+        if (next[node] < childStart[node + 1] - childStart[node]) {
+            stack[depth++] = children[childStart[node] + next[node]++];
+        } else {
+            depth--;
+            if (node != 0) {
+                classes[objects[node - 1].clazz].active--;
+            }
+        }
+    }
+    free(childStart);
+    free(children);
+    free(fill);
+    free(stack);
+    free(next);
+}
+
+/*=========================================================================
+ * Report
+ *=======================================================================*/
+
+static int compareClassesByRetained(const void* a, const void* b)
+{
+    double x = (*(CLASSINFO* const*)a)->retained;
+    double y = (*(CLASSINFO* const*)b)->retained;
+    return (x < y) ? 1 : (x > y) ? -1 : 0;
+}
+
+static int compareNodesByRetained(const void* a, const void* b)
+{
+    double x = retained[*(const long*)a];
+    double y = retained[*(const long*)b];
+    return (x < y) ? 1 : (x > y) ? -1 : 0;
+}
+
+static void printObject(long node)
+{
+    OBJECTINFO* object = &objects[node - 1];
+    printf("0x%0*lx %s", idSize * 2, object->id, classes[object->clazz].name);
+}
+
+static void printReport(unsigned long heapSize, unsigned long freeSize,
+                        long top)
+{
+    CLASSINFO** sortedClasses;
+    long* sortedNodes;
+    double totalBytes = 0, unreachableBytes = 0;
+    long unreachable = 0, count, i, n;
+
+    for (n = 1; n < nodeCount; n++) {
+        totalBytes += objects[n - 1].size;
+        if (dominator[n] < 0) {
+            unreachable++;
+            unreachableBytes += objects[n - 1].size;
+        }
+    }
+
+    printf("# Heap dump %s: heap %lu bytes, %lu free\n",
+           inputName, heapSize, freeSize);
+    printf("# %ld objects (%.0f bytes), %ld roots\n",
+           objectCount, totalBytes, rootCount);
+    printf("# %ld reachable (%.0f bytes), %ld unreachable (%.0f bytes)\n",
+           reachableCount - 1, retained[0], unreachable, unreachableBytes);
+
+    sortedClasses = (CLASSINFO**)allocate(classCount * sizeof(CLASSINFO*));
+    for (i = count = 0; i < classCount; i++) {
+        if (classes[i].count > 0) {
+            sortedClasses[count++] = &classes[i];
+        }
+    }
+    qsort(sortedClasses, count, sizeof(CLASSINFO*), compareClassesByRetained);
+    printf("\nClasses by retained size:\n");
+    printf("%10s %12s %12s  %s\n", "count", "shallow", "retained", "class");
+    for (i = 0; i < count && i < top; i++) {
+        printf("%10lu %12.0f %12.0f  %s\n",
+               sortedClasses[i]->count, sortedClasses[i]->shallow,
+               sortedClasses[i]->retained, sortedClasses[i]->name);
+    }
+    free(sortedClasses);
+
+    sortedNodes = (long*)allocate(nodeCount * sizeof(long));
+    for (n = 1, count = 0; n < nodeCount; n++) {
+        if (dominator[n] >= 0) {
+            sortedNodes[count++] = n;
+        }
+    }
+    qsort(sortedNodes, count, sizeof(long), compareNodesByRetained);
+    printf("\nObjects by retained size:\n");
+    printf("%12s %10s  %s\n", "retained", "shallow", "object");
+    for (i = 0; i < count && i < top; i++) {
+        long node = sortedNodes[i];
+        int length = 0;
+        printf("%12.0f %10lu  ", retained[node], objects[node - 1].size);
+        printObject(node);
+        printf("\n%24s", "");
+        for (n = dominator[node]; n != 0 && length < MAX_CHAIN_LENGTH;
+                 n = dominator[n], length++) {
+            printf("<- ");
+            printObject(n);
+            printf(" ");
+        }
+        if (n != 0) {
+            printf("<- ... ");
+        }
+        /* The object right under the VM tells how the chain is held */
+        for (n = node; dominator[n] != 0; n = dominator[n]) {
+        }
+        printf("<- %s\n",
+               objects[n - 1].rootKind <= HD_LAST_ROOT_KIND
+                   ? rootKinds[objects[n - 1].rootKind] : "?");
+    }
+    free(sortedNodes);
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: heapanalyzer [-n <count>] <file>\n");
+    fprintf(stderr, "  -n <count>  number of classes and objects listed "
+            "(default 20)\n");
+    exit(1);
+}
+
+/*=========================================================================
+ * FUNCTION:      main
+ * TYPE:          main program
+ * OVERVIEW:      Reads the dump, computes the dominator tree and prints
+ *                the report.
+ *=======================================================================*/
+
+int main(int argc, char** argv)
+{
+    unsigned long heapSize, freeSize;
+    long top = 20;
+
+    if (argc == 4 && strcmp(argv[1], "-n") == 0) {
+        top = atol(argv[2]);
+        if (top < 1) {
+            usage();
+        }
+        argv += 2; argc -= 2;
+    }
+    if (argc != 2) {
+        usage();
+    }
+
+    inputName = argv[1];
+    input = fopen(inputName, "rb");
+    if (input == NULL) {
+        fprintf(stderr, "heapanalyzer: cannot open %s\n", inputName);
+        return 1;
+    }
+    readDump(&heapSize, &freeSize);
+    fclose(input);
+
+    computeDominators();
+    computeClassTotals();
+    printReport(heapSize, freeSize, top);
+    return 0;
+}
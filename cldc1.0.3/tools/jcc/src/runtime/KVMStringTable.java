@@ -94,6 +94,9 @@ public class KVMStringTable extends vm.StringTable {
 	    commentary(string, out);
 	    out.print("\tKVM_INIT_JAVA_STRING(" + s.unicodeOffset + ", "
 		      + string.length() + ", ");
+	    // The strings are read-only, so the VM can't cache the hash code
+	    out.printHexInt(string.hashCode());
+	    out.print(", ");
 	    if (next == null) {
 		out.print(0);
 	    } else {
@@ -17,6 +17,12 @@ import com.sun.cldc.i18n.*;
  */
 public class ISO8859_1_Writer extends StreamWriter {
 
+    /**
+     * Bytes converted from a character array or string, so that they
+     * reach the output stream in one <code>write</code> call
+     */
+    private byte[] buffer = new byte[128];
+
     /**
      * Write a single character.
      *
@@ -39,8 +45,15 @@ public class ISO8859_1_Writer extends StreamWriter {
      * @exception  IOException  If an I/O error occurs
      */
     synchronized public void write(char cbuf[], int off, int len) throws IOException {
-        while (len-- > 0) {
-            write(cbuf[off++]);
+        while (len > 0) {
+            int n = len < buffer.length ? len : buffer.length;
+            for (int i = 0 ; i < n ; i++) {
+                int c = cbuf[off + i];
+                buffer[i] = (byte)(c > 255 ? '?' : c);
+            }
+            out.write(buffer, 0, n);
+            off += n;
+            len -= n;
         }
     }
 
@@ -54,8 +67,15 @@ public class ISO8859_1_Writer extends StreamWriter {
      * @exception  IOException  If an I/O error occurs
      */
     synchronized public void write(String str, int off, int len) throws IOException {
-        for (int i = 0 ; i < len ; i++) {
-            write(str.charAt(off + i));
+        while (len > 0) {
+            int n = len < buffer.length ? len : buffer.length;
+            for (int i = 0 ; i < n ; i++) {
+                int c = str.charAt(off + i);
+                buffer[i] = (byte)(c > 255 ? '?' : c);
+            }
+            out.write(buffer, 0, n);
+            off += n;
+            len -= n;
         }
     }
 
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 1999-2001 Sun Microsystems, Inc., 901 San Antonio Road,
+ *  Palo Alto, CA 94303, U.S.A.  All Rights Reserved.
+ *
+ *  Sun Microsystems, Inc. has intellectual property rights relating
+ *  to the technology embodied in this software.  In particular, and
+ *  without limitation, these intellectual property rights may include
+ *  one or more U.S. patents, foreign patents, or pending
+ *  applications.  Sun, Sun Microsystems, the Sun logo, Java, KJava,
+ *  and all Sun-based and Java-based marks are trademarks or
+ *  registered trademarks of Sun Microsystems, Inc.  in the United
+ *  States and other countries.
+ *
+ *  This software is distributed under licenses restricting its use,
+ *  copying, distribution, and decompilation.  No part of this
+ *  software may be reproduced in any form by any means without prior
+ *  written authorization of Sun and its licensors, if any.
+ *
+ *  FEDERAL ACQUISITIONS:  Commercial Software -- Government Users
+ *  Subject to Standard License Terms and Conditions
+ */
+
+package com.sun.cldc.io;
+
+import java.io.*;
+
+/**
+ * Output stream behind <code>System.out</code> and <code>System.err</code>.
+ * <p>
+ * The bytes are collected in a buffer inside the VM, which is written
+ * to the console when a line is complete (or, when the VM was started
+ * with <code>-console full</code>, when the buffer fills up), when
+ * output has been pending for a while, when <code>flush</code> is
+ * called and when the VM exits.
+ *
+ * @author  Nik Shaylor
+ * @version 1.0 2/4/2000
+ */
+public class ConsoleOutputStream extends OutputStream {
+
+    /**
+     * Writes the specified byte to this output stream.
+     *
+     * @param      c   the <code>byte</code>.
+     * @exception  IOException  if an I/O error occurs.
+     */
+    synchronized public void write(int c) throws IOException {
+        write((char)c);
+    }
+    private static native void write(char c);
+
+    /**
+     * Writes <code>len</code> bytes from the specified byte array
+     * starting at offset <code>off</code> to this output stream.
+     *
+     * @param      b     the data.
+     * @param      off   the start offset in the data.
+     * @param      len   the number of bytes to write.
+     * @exception  IOException  if an I/O error occurs.
+     */
+    synchronized public void write(byte b[], int off, int len)
+        throws IOException {
+        if (b == null) {
+            throw new NullPointerException();
+        } else if ((off < 0) || (off > b.length) || (len < 0) ||
+                   ((off + len) > b.length) || ((off + len) < 0)) {
+            throw new IndexOutOfBoundsException();
+        } else if (len == 0) {
+            return;
+        }
+        writeBytes(b, off, len);
+    }
+    private static native void writeBytes(byte b[], int off, int len);
+
+    /**
+     * Writes any buffered output bytes to the console.
+     *
+     * @exception  IOException  if an I/O error occurs.
+     */
+    synchronized public void flush() throws IOException {
+        flushConsole();
+    }
+    private static native void flushConsole();
+
+}
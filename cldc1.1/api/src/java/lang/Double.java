@@ -115,7 +115,7 @@ public final class Double {
      * @return  a string representation of the argument.
      */
     public static String toString(double d){
-        return new FloatingDecimal(d).toJavaFormatString();
+        return FloatingDecimal.toJavaFormatString(d);
     }
 
     /**
@@ -155,7 +155,7 @@ public final class Double {
      *               parsable number.
      */
     public static Double valueOf(String s) throws NumberFormatException {
-        return new Double(FloatingDecimal.readJavaFormatString(s).doubleValue());
+        return new Double(FloatingDecimal.parseDouble(s));
     }
 
     /**
@@ -171,7 +171,7 @@ public final class Double {
      * @since      JDK1.2
      */
     public static double parseDouble(String s) throws NumberFormatException {
-        return FloatingDecimal.readJavaFormatString(s).doubleValue();
+        return FloatingDecimal.parseDouble(s);
     }
 
     /**
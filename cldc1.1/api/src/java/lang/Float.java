@@ -116,7 +116,7 @@ public final class Float {
      * @return  a string representation of the argument.
      */
     public static String toString(float f){
-        return new FloatingDecimal(f).toJavaFormatString();
+        return FloatingDecimal.toJavaFormatString(f);
     }
 
     /**
@@ -154,7 +154,7 @@ public final class Float {
      *               parsable number.
      */
     public static Float valueOf(String s) throws NumberFormatException {
-        return new Float(FloatingDecimal.readJavaFormatString(s).floatValue());
+        return new Float(FloatingDecimal.parseFloat(s));
     }
 
     /**
@@ -168,7 +168,7 @@ public final class Float {
      * @since      JDK1.2
      */
     public static float parseFloat(String s) throws NumberFormatException {
-        return FloatingDecimal.readJavaFormatString(s).floatValue();
+        return FloatingDecimal.parseFloat(s);
     }
 
     /**
@@ -28,6 +28,53 @@ class FloatingDecimal{
     this.nDigits = n;
     }
 
+    /*
+     * Conversions used by Double and Float.  The natives give the same
+     * results as the Java code below, and return null (or NaN, which no
+     * string converts to) for the inputs they leave to it, including
+     * those that must throw an exception.
+     */
+    private static native String doubleToString(double d);
+    private static native String floatToString(float f);
+    private static native double stringToDouble(String s);
+    private static native float  stringToFloat(String s);
+
+    static String
+    toJavaFormatString( double d ){
+    String s = doubleToString( d );
+    if ( s == null ){
+        s = new FloatingDecimal( d ).toJavaFormatString();
+    }
+    return s;
+    }
+
+    static String
+    toJavaFormatString( float f ){
+    String s = floatToString( f );
+    if ( s == null ){
+        s = new FloatingDecimal( f ).toJavaFormatString();
+    }
+    return s;
+    }
+
+    static double
+    parseDouble( String s ) throws NumberFormatException {
+    double d = stringToDouble( s );
+    if ( d != d ){
+        d = readJavaFormatString( s ).doubleValue();
+    }
+    return d;
+    }
+
+    static float
+    parseFloat( String s ) throws NumberFormatException {
+    float f = stringToFloat( s );
+    if ( f != f ){
+        f = readJavaFormatString( s ).floatValue();
+    }
+    return f;
+    }
+
     /*
      * Constants of the implementation
      * Most are IEEE-754 related.
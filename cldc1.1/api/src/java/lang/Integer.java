@@ -85,31 +85,34 @@ public final class Integer {
      * @see     java.lang.Character#MAX_RADIX
      * @see     java.lang.Character#MIN_RADIX
      */
-    public static String toString(int i, int radix) {
-
-        if (radix < Character.MIN_RADIX || radix > Character.MAX_RADIX)
-            radix = 10;
-
-        char buf[] = new char[33];
-        boolean negative = (i < 0);
-        int charPos = 32;
-
-        if (!negative) {
-            i = -i;
-        }
-
-        while (i <= -radix) {
-            buf[charPos--] = digits[-(i % radix)];
-            i = i / radix;
-        }
-        buf[charPos] = digits[-i];
-
-        if (negative) {
-            buf[--charPos] = '-';
-        }
-
-        return new String(buf, charPos, (33 - charPos));
-    }
+    public static native String toString(int i, int radix);
+/******
+ *  public static String toString(int i, int radix) {
+ *
+ *      if (radix < Character.MIN_RADIX || radix > Character.MAX_RADIX)
+ *          radix = 10;
+ *
+ *      char buf[] = new char[33];
+ *      boolean negative = (i < 0);
+ *      int charPos = 32;
+ *
+ *      if (!negative) {
+ *          i = -i;
+ *      }
+ *
+ *      while (i <= -radix) {
+ *          buf[charPos--] = digits[-(i % radix)];
+ *          i = i / radix;
+ *      }
+ *      buf[charPos] = digits[-i];
+ *
+ *      if (negative) {
+ *          buf[--charPos] = '-';
+ *      }
+ *
+ *      return new String(buf, charPos, (33 - charPos));
+ *  }
+ ****/
 
     /**
      * Creates a string representation of the integer argument as an
@@ -282,6 +285,11 @@ public final class Integer {
                                             " greater than Character.MAX_RADIX");
         }
 
+        long fast = parse(s, radix);
+        if (fast != Long.MIN_VALUE) {
+            return (int)fast;
+        }
+
         int result = 0;
         boolean negative = false;
         int i = 0, max = s.length();
@@ -335,6 +343,14 @@ public final class Integer {
         }
     }
 
+    /**
+     * Parses ASCII digits natively, returning
+     * <code>Long.MIN_VALUE</code> for anything that
+     * <code>parseInt</code> has to handle itself,
+     * including every string that is not a valid <code>int</code>.
+     */
+    private static native long parse(String s, int radix);
+
     /**
      * Parses the string argument as a signed decimal integer. The
      * characters in the string must all be decimal digits, except that
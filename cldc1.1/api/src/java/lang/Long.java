@@ -70,30 +70,33 @@ public final class Long {
      * @see     java.lang.Character#MAX_RADIX
      * @see     java.lang.Character#MIN_RADIX
      */
-    public static String toString(long i, int radix) {
-        if (radix < Character.MIN_RADIX || radix > Character.MAX_RADIX)
-            radix = 10;
-
-        char[] buf = new char[65];
-        int charPos = 64;
-        boolean negative = (i < 0);
-
-        if (!negative) {
-            i = -i;
-        }
-
-        while (i <= -radix) {
-            buf[charPos--] = Integer.digits[(int)(-(i % radix))];
-            i = i / radix;
-        }
-        buf[charPos] = Integer.digits[(int)(-i)];
-
-        if (negative) {
-            buf[--charPos] = '-';
-        }
-
-        return new String(buf, charPos, (65 - charPos));
-    }
+    public static native String toString(long i, int radix);
+/******
+ *  public static String toString(long i, int radix) {
+ *      if (radix < Character.MIN_RADIX || radix > Character.MAX_RADIX)
+ *          radix = 10;
+ *
+ *      char[] buf = new char[65];
+ *      int charPos = 64;
+ *      boolean negative = (i < 0);
+ *
+ *      if (!negative) {
+ *          i = -i;
+ *      }
+ *
+ *      while (i <= -radix) {
+ *          buf[charPos--] = Integer.digits[(int)(-(i % radix))];
+ *          i = i / radix;
+ *      }
+ *      buf[charPos] = Integer.digits[(int)(-i)];
+ *
+ *      if (negative) {
+ *          buf[--charPos] = '-';
+ *      }
+ *
+ *      return new String(buf, charPos, (65 - charPos));
+ *  }
+ ****/
 
     /**
      * Returns a new String object representing the specified integer.
@@ -176,6 +179,11 @@ public final class Long {
                                           " greater than Character.MAX_RADIX");
       }
 
+      long fast = parse(s, radix);
+      if (fast != Long.MIN_VALUE) {
+          return fast;
+      }
+
       long result = 0;
       boolean negative = false;
       int i = 0, max = s.length();
@@ -229,6 +237,14 @@ public final class Long {
       }
     }
 
+    /**
+     * Parses ASCII digits natively, returning <code>MIN_VALUE</code>
+     * for anything that <code>parseLong</code> has to handle itself,
+     * including every string that is not a valid <code>long</code>
+     * (and <code>"-9223372036854775808"</code>, which is).
+     */
+    private static native long parse(String s, int radix);
+
     /**
      * Parses the string argument as a signed decimal <code>long</code>.
      * The characters in the string must all be decimal digits, except
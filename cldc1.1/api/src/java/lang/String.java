@@ -78,6 +78,18 @@ class String {
     /** The count is the number of characters in the String. */
     private int count;
 
+    /**
+     * If the characters of the String all fit in one byte and
+     * compact strings are enabled, they may be stored here instead,
+     * in which case <code>value</code> is <code>null</code>.
+     */
+    private byte latin1[];
+
+    /** Whether to store Latin-1 strings compactly. */
+    private static final boolean COMPACT = compactStrings();
+
+    private static native boolean compactStrings();
+
     /**
      * Initializes a newly created <code>String</code> object so that it
      * represents an empty character sequence.
@@ -95,8 +107,13 @@ class String {
      */
     public String(String value) {
         count = value.length();
-        this.value = new char[count];
-        value.getChars(0, count, this.value, 0);
+        if (value.latin1 != null) {
+            this.latin1 = new byte[count];
+            System.arraycopy(value.latin1, value.offset, this.latin1, 0, count);
+        } else {
+            this.value = new char[count];
+            value.getChars(0, count, this.value, 0);
+        }
     }
 
     /**
@@ -110,9 +127,7 @@ class String {
      * @throws NullPointerException if <code>value</code> is <code>null</code>.
      */
     public String(char value[]) {
-        this.count = value.length;
-        this.value = new char[count];
-        System.arraycopy(value, 0, this.value, 0, count);
+        init(value, 0, value.length);
     }
 
     /**
@@ -145,8 +160,30 @@ class String {
             throw new StringIndexOutOfBoundsException(offset + count);
         }
 
-        this.value = new char[count];
+        init(value, offset, count);
+    }
+
+    /*
+     * Copies the characters of a subarray into a new string, storing
+     * them compactly if they all fit in one byte.
+     */
+    private void init(char value[], int offset, int count) {
         this.count = count;
+        if (COMPACT) {
+            int i = 0;
+            while (i < count && value[offset + i] <= 0xFF) {
+                i++;
+            }
+            if (i == count) {
+                byte buf[] = new byte[count];
+                for (i = 0; i < count; i++) {
+                    buf[i] = (byte)value[offset + i];
+                }
+                this.latin1 = buf;
+                return;
+            }
+        }
+        this.value = new char[count];
         System.arraycopy(value, offset, this.value, 0, count);
     }
 
@@ -244,6 +281,13 @@ class String {
         this.count = count;
     }
 
+    // Private constructor which shares a compact string's array.
+    private String(int offset, int count, byte latin1[]) {
+        this.latin1 = latin1;
+        this.offset = offset;
+        this.count = count;
+    }
+
     /**
      * Returns the length of this string.
      * The length is equal to the number of 16-bit
@@ -320,8 +364,15 @@ class String {
         if (srcBegin > srcEnd) {
             throw new StringIndexOutOfBoundsException(srcEnd - srcBegin);
         }
-        System.arraycopy(value, offset + srcBegin, dst, dstBegin,
-                         srcEnd - srcBegin);
+        if (value != null) {
+            System.arraycopy(value, offset + srcBegin, dst, dstBegin,
+                             srcEnd - srcBegin);
+        } else {
+            byte v[] = latin1;
+            for (int i = offset + srcBegin; i < offset + srcEnd; i++) {
+                dst[dstBegin++] = (char)(v[i] & 0xFF);
+            }
+        }
     }
 
     /**
@@ -336,6 +387,9 @@ class String {
      * @since      JDK1.1
      */
     public byte[] getBytes(String enc) throws UnsupportedEncodingException {
+        if (value == null) {
+            return Helper.charToByteArray(toCharArray(), 0, count, enc);
+        }
         return Helper.charToByteArray(value, offset, count, enc);
     }
 
@@ -347,6 +401,9 @@ class String {
      * @since   JDK1.1
      */
     public byte[] getBytes() {
+        if (value == null) {
+            return Helper.charToByteArray(toCharArray(), 0, count);
+        }
         return Helper.charToByteArray(value, offset, count);
     }
 
@@ -461,37 +518,40 @@ class String {
      * @exception java.lang.NullPointerException if <code>anotherString</code>
      *          is <code>null</code>.
      */
-    public int compareTo(String anotherString) {
-        int len1 = count;
-        int len2 = anotherString.count;
-        int n = Math.min(len1, len2);
-        char v1[] = value;
-        char v2[] = anotherString.value;
-        int i = offset;
-        int j = anotherString.offset;
-
-        if (i == j) {
-            int k = i;
-            int lim = n + i;
-            while (k < lim) {
-                char c1 = v1[k];
-                char c2 = v2[k];
-                if (c1 != c2) {
-                    return c1 - c2;
-                }
-                k++;
-           }
-        } else {
-            while (n-- != 0) {
-                char c1 = v1[i++];
-                char c2 = v2[j++];
-                if (c1 != c2) {
-                    return c1 - c2;
-                }
-            }
-        }
-        return len1 - len2;
-    }
+    public native int compareTo(String anotherString);
+ /************
+  * public int compareTo(String anotherString) {
+  *     int len1 = count;
+  *     int len2 = anotherString.count;
+  *     int n = Math.min(len1, len2);
+  *     char v1[] = value;
+  *     char v2[] = anotherString.value;
+  *     int i = offset;
+  *     int j = anotherString.offset;
+  *
+  *     if (i == j) {
+  *         int k = i;
+  *         int lim = n + i;
+  *         while (k < lim) {
+  *             char c1 = v1[k];
+  *             char c2 = v2[k];
+  *             if (c1 != c2) {
+  *                 return c1 - c2;
+  *             }
+  *             k++;
+  *        }
+  *     } else {
+  *         while (n-- != 0) {
+  *             char c1 = v1[i++];
+  *             char c2 = v2[j++];
+  *             if (c1 != c2) {
+  *                 return c1 - c2;
+  *             }
+  *         }
+  *     }
+  *     return len1 - len2;
+  * }
+  ********/
 
     /**
      * Tests if two string regions are equal.
@@ -546,43 +606,45 @@ class String {
     public boolean regionMatches(boolean ignoreCase,
                                  int toffset,
                                  String other, int ooffset, int len) {
-        char ta[] = value;
-        int to = offset + toffset;
-        int tlim = offset + count;
-        char pa[] = other.value;
-        int po = other.offset + ooffset;
-
         // Note: toffset, ooffset, or len might be near -1>>>1.
         if ((ooffset < 0) || (toffset < 0) || (toffset > (long)count - len) ||
             (ooffset > (long)other.count - len)) {
             return false;
         }
+        if (!ignoreCase) {
+            return regionMatches(toffset, other, ooffset, len);
+        }
         while (len-- > 0) {
-            char c1 = ta[to++];
-            char c2 = pa[po++];
+            char c1 = charAt(toffset++);
+            char c2 = other.charAt(ooffset++);
             if (c1 == c2)
                 continue;
-            if (ignoreCase) {
-                // If characters don't match but case may be ignored,
-                // try converting both characters to uppercase.
-                // If the results match, then the comparison scan should
-                // continue.
-                char u1 = Character.toUpperCase(c1);
-                char u2 = Character.toUpperCase(c2);
-                if (u1 == u2)
-                    continue;
-                // Unfortunately, conversion to uppercase does not work properly
-                // for the Georgian alphabet, which has strange rules about case
-                // conversion.  So we need to make one last check before
-                // exiting.
-                if (Character.toLowerCase(u1) == Character.toLowerCase(u2))
-                    continue;
-            }
+            // If characters don't match but case may be ignored,
+            // try converting both characters to uppercase.
+            // If the results match, then the comparison scan should
+            // continue.
+            char u1 = Character.toUpperCase(c1);
+            char u2 = Character.toUpperCase(c2);
+            if (u1 == u2)
+                continue;
+            // Unfortunately, conversion to uppercase does not work properly
+            // for the Georgian alphabet, which has strange rules about case
+            // conversion.  So we need to make one last check before
+            // exiting.
+            if (Character.toLowerCase(u1) == Character.toLowerCase(u2))
+                continue;
             return false;
         }
         return true;
     }
 
+    /*
+     * Case-sensitive comparison of two regions that the caller has
+     * checked lie within the strings.
+     */
+    private native boolean regionMatches(int toffset, String other,
+                                         int ooffset, int len);
+
     /**
      * Tests if this string starts with the specified prefix beginning
      * at the specified index.
@@ -602,24 +664,27 @@ class String {
      * @exception java.lang.NullPointerException if <code>prefix</code> is
      *          <code>null</code>.
      */
-    public boolean startsWith(String prefix, int toffset) {
-        char ta[] = value;
-        int to = offset + toffset;
-        int tlim = offset + count;
-        char pa[] = prefix.value;
-        int po = prefix.offset;
-        int pc = prefix.count;
-        // Note: toffset might be near -1>>>1.
-        if ((toffset < 0) || (toffset > count - pc)) {
-            return false;
-        }
-        while (--pc >= 0) {
-            if (ta[to++] != pa[po++]) {
-                return false;
-            }
-        }
-        return true;
-    }
+    public native boolean startsWith(String prefix, int toffset);
+ /************
+  * public boolean startsWith(String prefix, int toffset) {
+  *     char ta[] = value;
+  *     int to = offset + toffset;
+  *     int tlim = offset + count;
+  *     char pa[] = prefix.value;
+  *     int po = prefix.offset;
+  *     int pc = prefix.count;
+  *     // Note: toffset might be near -1>>>1.
+  *     if ((toffset < 0) || (toffset > count - pc)) {
+  *         return false;
+  *     }
+  *     while (--pc >= 0) {
+  *         if (ta[to++] != pa[po++]) {
+  *             return false;
+  *         }
+  *     }
+  *     return true;
+  * }
+  ********/
 
     /**
      * Tests if this string starts with the specified prefix.
@@ -670,17 +735,20 @@ class String {
      *
      * @return  a hash code value for this object.
      */
-    public int hashCode() {
-        int h = 0;
-        int off = offset;
-        char val[] = value;
-        int len = count;
-
-        for (int i = 0; i < len; i++) {
-            h = 31*h + val[off++];
-        }
-        return h;
-    }
+    public native int hashCode();
+ /************
+  * public int hashCode() {
+  *     int h = 0;
+  *     int off = offset;
+  *     char val[] = value;
+  *     int len = count;
+  *
+  *     for (int i = 0; i < len; i++) {
+  *         h = 31*h + val[off++];
+  *     }
+  *     return h;
+  * }
+  ********/
 
     /**
      * Returns the index within this string of the first occurrence of the
@@ -797,17 +865,20 @@ class String {
      *          than or equal to <code>fromIndex</code>, or <code>-1</code>
      *          if the character does not occur before that point.
      */
-    public int lastIndexOf(int ch, int fromIndex) {
-        int min = offset;
-        char v[] = value;
-
-        for (int i = offset + ((fromIndex >= count) ? count - 1 : fromIndex) ; i >= min ; i--) {
-            if (v[i] == ch) {
-                return i - offset;
-            }
-        }
-        return -1;
-    }
+    public native int lastIndexOf(int ch, int fromIndex);
+ /************
+  * public int lastIndexOf(int ch, int fromIndex) {
+  *     int min = offset;
+  *     char v[] = value;
+  *
+  *     for (int i = offset + ((fromIndex >= count) ? count - 1 : fromIndex) ; i >= min ; i--) {
+  *         if (v[i] == ch) {
+  *             return i - offset;
+  *         }
+  *     }
+  *     return -1;
+  * }
+  ********/
 
     /**
      * Returns the index within this string of the first occurrence of the
@@ -856,54 +927,57 @@ class String {
      * @exception java.lang.NullPointerException if <code>str</code> is
      *          <code>null</code>
      */
-    public int indexOf(String str, int fromIndex) {
-        char v1[] = value;
-        char v2[] = str.value;
-        int max = offset + (count - str.count);
-        if (fromIndex >= count) {
-            if (count == 0 && fromIndex == 0 && str.count == 0) {
-                /* There is an empty string at index 0 in an empty string. */
-                return 0;
-            }
-            /* Note: fromIndex might be near -1>>>1 */
-            return -1;
-        }
-        if (fromIndex < 0) {
-            fromIndex = 0;
-        }
-        if (str.count == 0) {
-            return fromIndex;
-        }
-
-        int strOffset = str.offset;
-        char first  = v2[strOffset];
-        int i = offset + fromIndex;
-
-    startSearchForFirstChar:
-        while (true) {
-
-            /* Look for first character. */
-            while (i <= max && v1[i] != first) {
-                i++;
-            }
-            if (i > max) {
-                return -1;
-            }
-
-            /* Found first character, now look at the rest of v2 */
-            int j = i + 1;
-            int end = j + str.count - 1;
-            int k = strOffset + 1;
-            while (j < end) {
-                if (v1[j++] != v2[k++]) {
-                    i++;
-                    /* Look for str's first char again. */
-                    continue startSearchForFirstChar;
-                }
-            }
-            return i - offset;  /* Found whole string. */
-        }
-    }
+    public native int indexOf(String str, int fromIndex);
+ /************
+  * public int indexOf(String str, int fromIndex) {
+  *     char v1[] = value;
+  *     char v2[] = str.value;
+  *     int max = offset + (count - str.count);
+  *     if (fromIndex >= count) {
+  *         if (count == 0 && fromIndex == 0 && str.count == 0) {
+  *             // There is an empty string at index 0 in an empty string.
+  *             return 0;
+  *         }
+  *         // Note: fromIndex might be near -1>>>1
+  *         return -1;
+  *     }
+  *     if (fromIndex < 0) {
+  *         fromIndex = 0;
+  *     }
+  *     if (str.count == 0) {
+  *         return fromIndex;
+  *     }
+  *
+  *     int strOffset = str.offset;
+  *     char first  = v2[strOffset];
+  *     int i = offset + fromIndex;
+  *
+  * startSearchForFirstChar:
+  *     while (true) {
+  *
+  *         // Look for first character.
+  *         while (i <= max && v1[i] != first) {
+  *             i++;
+  *         }
+  *         if (i > max) {
+  *             return -1;
+  *         }
+  *
+  *         // Found first character, now look at the rest of v2
+  *         int j = i + 1;
+  *         int end = j + str.count - 1;
+  *         int k = strOffset + 1;
+  *         while (j < end) {
+  *             if (v1[j++] != v2[k++]) {
+  *                 i++;
+  *                 // Look for str's first char again.
+  *                 continue startSearchForFirstChar;
+  *             }
+  *         }
+  *         return i - offset;  // Found whole string.
+  *     }
+  * }
+  ********/
 
     /**
      * Returns a new string that is a substring of this string. The
@@ -958,8 +1032,12 @@ class String {
         if (beginIndex > endIndex) {
             throw new StringIndexOutOfBoundsException(endIndex - beginIndex);
         }
-        return ((beginIndex == 0) && (endIndex == count)) ? this :
-            new String(offset + beginIndex, endIndex - beginIndex, value);
+        if ((beginIndex == 0) && (endIndex == count)) {
+            return this;
+        }
+        return (value != null) ?
+            new String(offset + beginIndex, endIndex - beginIndex, value) :
+            new String(offset + beginIndex, endIndex - beginIndex, latin1);
     }
 
     /**
@@ -989,10 +1067,24 @@ class String {
         if (otherLen == 0) {
             return this;
         }
+        if (latin1 != null && str.latin1 != null) {
+            byte buf[] = new byte[count + otherLen];
+            System.arraycopy(latin1, offset, buf, 0, count);
+            System.arraycopy(str.latin1, str.offset, buf, count, otherLen);
+            return new String(0, count + otherLen, buf);
+        }
         char buf[] = new char[count + otherLen];
         getChars(0, count, buf, 0);
         str.getChars(0, otherLen, buf, count);
-        return new String(0, count + otherLen, buf);
+        return fromChars(buf);
+    }
+
+    /*
+     * Makes a string of the characters in buf, which the caller gives
+     * up.  They are stored compactly if they can be.
+     */
+    private static String fromChars(char buf[]) {
+        return COMPACT ? new String(buf) : new String(0, buf.length, buf);
     }
 
     /**
@@ -1027,26 +1119,18 @@ class String {
     public String replace(char oldChar, char newChar) {
         if (oldChar != newChar) {
             int len = count;
-            int i = -1;
-            char[] val = value; /* avoid getfield opcode */
-            int off = offset;   /* avoid getfield opcode */
+            int i = indexOf(oldChar);
 
-            while (++i < len) {
-                if (val[off + i] == oldChar) {
-                    break;
-                }
-            }
-            if (i < len) {
+            if (i >= 0) {
                 char buf[] = new char[len];
-                for (int j = 0 ; j < i ; j++) {
-                    buf[j] = val[off+j];
-                }
+                getChars(0, len, buf, 0);
                 while (i < len) {
-                    char c = val[off + i];
-                    buf[i] = (c == oldChar) ? newChar : c;
+                    if (buf[i] == oldChar) {
+                        buf[i] = newChar;
+                    }
                     i++;
                 }
-                return new String(0, len, buf);
+                return fromChars(buf);
             }
         }
         return this;
@@ -1064,7 +1148,8 @@ class String {
 
         scan : {
             for(i = 0 ; i < count ; i++) {
-                char c = value[offset+i];
+                char c = (value != null) ? value[offset+i]
+                                         : (char)(latin1[offset+i] & 0xFF);
                 if (c != Character.toLowerCase(c)) {
                     break scan;
                 }
@@ -1074,12 +1159,12 @@ class String {
 
         char buf[] = new char[count];
 
-        System.arraycopy(value, offset, buf, 0, i);
+        getChars(0, count, buf, 0);
 
         for(; i < count ; i++) {
-            buf[i] = Character.toLowerCase(value[offset+i]);
+            buf[i] = Character.toLowerCase(buf[i]);
         }
-        return new String(0, count, buf);
+        return fromChars(buf);
     }
 
     /**
@@ -1094,7 +1179,8 @@ class String {
 
         scan : {
             for(i = 0 ; i < count ; i++) {
-                char c = value[offset+i];
+                char c = (value != null) ? value[offset+i]
+                                         : (char)(latin1[offset+i] & 0xFF);
                 if (c != Character.toUpperCase(c)) {
                     break scan;
                 }
@@ -1104,12 +1190,12 @@ class String {
 
         char buf[] = new char[count];
 
-        System.arraycopy(value, offset, buf, 0, i);
+        getChars(0, count, buf, 0);
 
         for(; i < count ; i++) {
-            buf[i] = Character.toUpperCase(value[offset+i]);
+            buf[i] = Character.toUpperCase(buf[i]);
         }
-        return new String(0, count, buf);
+        return fromChars(buf);
     }
 
     /**
@@ -1143,13 +1229,11 @@ class String {
     public String trim() {
         int len = count;
         int st = 0;
-        int off = offset;      /* avoid getfield opcode */
-        char[] val = value;    /* avoid getfield opcode */
 
-        while ((st < len) && (val[off + st] <= ' ')) {
+        while ((st < len) && (charAt(st) <= ' ')) {
             st++;
         }
-        while ((st < len) && (val[off + len - 1] <= ' ')) {
+        while ((st < len) && (charAt(len - 1) <= ' ')) {
             len--;
         }
         return ((st > 0) || (len < count)) ? substring(st, len) : this;
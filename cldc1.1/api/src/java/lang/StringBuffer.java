@@ -522,9 +522,12 @@ public final class StringBuffer {
      * @see     java.lang.String#valueOf(long)
      * @see     java.lang.StringBuffer#append(java.lang.String)
      */
-    public StringBuffer append(long l) {
-        return append(String.valueOf(l));
-    }
+    public native StringBuffer append(long l);
+/******
+ *  public StringBuffer append(long l) {
+ *      return append(String.valueOf(l));
+ *  }
+ ****/
 
     /**
      * Appends the string representation of the <code>float</code>
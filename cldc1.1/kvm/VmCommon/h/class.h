@@ -199,9 +199,10 @@ struct instanceStruct {
 struct stringInstanceStruct {
     COMMON_OBJECT_INFO(INSTANCE_CLASS)
 
-    SHORTARRAY array;
+    SHORTARRAY array;           /* NULL if the string is compact */
     cell offset;
     cell length;
+    BYTEARRAY latin1;           /* Characters of a compact string */
 };
 
 /* INTERNED_STRING_INSTANCE */
@@ -211,9 +212,20 @@ struct internedStringInstanceStruct {
     SHORTARRAY array;
     cell offset;
     cell length;
+    BYTEARRAY latin1;
     struct internedStringInstanceStruct *next;
 };
 
+/* The character at a given index of a string instance (of either
+ * kind above), whichever way its characters are stored.  See
+ * COMPACT_STRINGS in main.h.
+ */
+#define STRING_CHAR_AT(string, index)                                     \
+    ((string)->array != NULL                                              \
+        ? (unsigned short)(string)->array->sdata[(string)->offset + (index)] \
+        : (unsigned short)(unsigned char)                                 \
+              (string)->latin1->bdata[(string)->offset + (index)])
+
 struct throwableInstanceStruct { 
     COMMON_OBJECT_INFO(INSTANCE_CLASS)
 
@@ -290,8 +302,8 @@ struct shortArrayStruct {
 #define SIZEOF_POINTERLIST(n)     (StructSizeInCells(pointerListStruct)+((n)-1))
 #define SIZEOF_WEAKPOINTERLIST(n) (StructSizeInCells(weakPointerListStruct)+((n)-1))
 
-#define SIZEOF_STRING_INSTANCE           SIZEOF_INSTANCE(3)
-#define SIZEOF_INTERNED_STRING_INSTANCE  SIZEOF_INSTANCE(4)
+#define SIZEOF_STRING_INSTANCE           SIZEOF_INSTANCE(4)
+#define SIZEOF_INTERNED_STRING_INSTANCE  SIZEOF_INSTANCE(5)
 
 /*=========================================================================
  * Definitions that manipulate the monitorOrHashCode (mhc) field
@@ -446,9 +458,17 @@ STRING_INSTANCE instantiateString(const char* string, int length);
 INTERNED_STRING_INSTANCE instantiateInternedString(const char* string, int length);
 SHORTARRAY createCharArray(const char* utf8stringArg, int utf8length,
                            int* unicodelengthP, bool_t isPermanent);
+#if COMPACT_STRINGS
+BYTEARRAY createLatin1Array(const char* utf8stringArg, int utf8length,
+                            int* unicodelengthP, bool_t isPermanent);
+#else
+#define createLatin1Array(utf8string, utf8length, unicodelengthP, isPermanent) \
+    NULL
+#endif
 
 char*    getStringContents(STRING_INSTANCE string);
 char*    getStringContentsSafely(STRING_INSTANCE string, char *buf, int lth);
+char*    getStringUTF8(STRING_INSTANCE string);
 
 /*=========================================================================
  * Debugging operations
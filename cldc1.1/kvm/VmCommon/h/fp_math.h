@@ -104,3 +104,7 @@ void Java_java_lang_Math_sin(void);
 void Java_java_lang_Math_cos(void);
 void Java_java_lang_Math_tan(void);
 
+void Java_java_lang_FloatingDecimal_doubleToString(void);
+void Java_java_lang_FloatingDecimal_floatToString(void);
+void Java_java_lang_FloatingDecimal_stringToDouble(void);
+void Java_java_lang_FloatingDecimal_stringToFloat(void);
@@ -202,6 +202,9 @@ extern bool_t vmDebugReady;
 extern bool_t JamEnabled;
 extern bool_t JamRepeat;
 
+/* Flush console output at every newline ("-console line") */
+extern bool_t ConsoleLineBuffered;
+
 /*=========================================================================
  * Most frequently called functions are "inlined" here
  *=======================================================================*/
@@ -223,6 +223,45 @@
 #define STRINGBUFFERSIZE  512
 #endif
 
+/* The size (in bytes) of the buffer that collects the output of
+ * System.out and System.err before it is written to the console,
+ * and the time (in milliseconds) that output may stay in that buffer
+ * before the next write or idle period pushes it out.  Whether the
+ * buffer is also flushed at every newline is chosen at startup with
+ * the "-console line|full" option.  See nativeCore.c.
+ */
+#ifndef CONSOLE_BUFFER_SIZE
+#define CONSOLE_BUFFER_SIZE  4096
+#endif
+
+#ifndef CONSOLE_FLUSH_INTERVAL
+#define CONSOLE_FLUSH_INTERVAL  100
+#endif
+
+/* Turning this option on makes the virtual machine store strings
+ * whose characters all fit in one byte (Latin-1) in a byte array
+ * rather than in a char array, halving the space taken by their
+ * characters.  A java.lang.String always has one representation
+ * or the other: either its 'value' (char[]) or its 'latin1'
+ * (byte[]) field is set.  When this option is off, only strings
+ * backed by char arrays are ever created.
+ */
+#ifndef COMPACT_STRINGS
+#define COMPACT_STRINGS 0
+#endif
+
+/* Turning this option on makes Double.toString, Float.toString,
+ * Double.parseDouble and Float.parseFloat use native code (see
+ * fp_math.c) instead of the multiple-precision bytecode in class
+ * java.lang.FloatingDecimal.  The native code gives the same results
+ * bit for bit; inputs it does not handle are left to the bytecode.
+ * Turning the option off is mainly useful for comparing the two.
+ * Requires IMPLEMENTS_FLOAT and COMPILER_SUPPORTS_LONG.
+ */
+#ifndef FAST_DECIMAL_CONVERSION
+#define FAST_DECIMAL_CONVERSION 1
+#endif
+
 /*=========================================================================
  * Garbage collection options
  *=======================================================================*/
@@ -67,6 +67,8 @@ NativeFunctionPtr getNativeFunction(INSTANCE_CLASS clazz,
 
 void  invokeNativeFunction(METHOD thisMethod);
 void  nativeInitialization(int *argc, char **argv);
+void  FlushConsoleOutput(void);
+void  checkConsoleOutput(void);
 
 #if INCLUDEDEBUGCODE
 void printNativeFunctions(void);
@@ -123,12 +125,26 @@ void Java_java_lang_String_equals(void);
 void Java_java_lang_String_indexOf__I(void);
 void Java_java_lang_String_indexOf__II(void);
 void Java_java_lang_String_intern(void);
+void Java_java_lang_String_compareTo(void);
+void Java_java_lang_String_startsWith(void);
+void Java_java_lang_String_regionMatches(void);
+void Java_java_lang_String_hashCode(void);
+void Java_java_lang_String_lastIndexOf(void);
+void Java_java_lang_String_indexOf__Ljava_lang_String_2I(void);
+void Java_java_lang_String_compactStrings(void);
 void Java_java_lang_StringBuffer_append__I(void);
+void Java_java_lang_StringBuffer_append__J(void);
 void Java_java_lang_StringBuffer_append__Ljava_lang_String_2(void);
 void Java_java_lang_StringBuffer_toString(void);
+void Java_java_lang_Integer_toString(void);
+void Java_java_lang_Integer_parse(void);
+void Java_java_lang_Long_toString(void);
+void Java_java_lang_Long_parse(void);
 void Java_java_lang_Math_randomInt(void);
 void Java_java_lang_ref_WeakReference_initializeWeakReference(void);
 void Java_java_util_Calendar_init(void);
 void Java_com_sun_cldc_io_Waiter_waitForIO(void);
 void Java_com_sun_cldc_io_j2me_socket_Protocol_initializeInternal(void);
 void Java_com_sun_cldc_io_ConsoleOutputStream_write(void);
+void Java_com_sun_cldc_io_ConsoleOutputStream_writeBytes(void);
+void Java_com_sun_cldc_io_ConsoleOutputStream_flushConsole(void);
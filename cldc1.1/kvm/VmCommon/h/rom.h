@@ -43,9 +43,25 @@
 
 #define KVM_INIT_JAVA_STRING(offset, length, next) \
     { &AllClassblocks.java_lang_String, { NULL }, \
-      (SHORTARRAY)&stringCharArrayInternal, offset, length, \
+      (SHORTARRAY)&stringCharArrayInternal, offset, length, NULL, \
       (INTERNED_STRING_INSTANCE)next }
 
+/* The layout of a string whose characters are all Latin-1.  Its
+ * characters are in stringByteArrayInternal at latin1Offset if
+ * COMPACT_STRINGS is on, and in stringCharArrayInternal at offset
+ * otherwise.
+ */
+
+#if COMPACT_STRINGS
+#define KVM_INIT_LATIN1_JAVA_STRING(offset, latin1Offset, length, next) \
+    { &AllClassblocks.java_lang_String, { NULL }, \
+      NULL, latin1Offset, length, (BYTEARRAY)&stringByteArrayInternal, \
+      (INTERNED_STRING_INSTANCE)next }
+#else
+#define KVM_INIT_LATIN1_JAVA_STRING(offset, latin1Offset, length, next) \
+    KVM_INIT_JAVA_STRING(offset, length, next)
+#endif
+
 #define CHARARRAY_X(len)              \
     struct {                          \
       COMMON_OBJECT_INFO(ARRAY_CLASS) \
@@ -56,6 +72,16 @@
 #define CHARARRAY_HEADER(len) \
     &AllClassblocks.manufacturedArrayOfChar, { NULL}, len
 
+#define BYTEARRAY_X(len)              \
+    struct {                          \
+      COMMON_OBJECT_INFO(ARRAY_CLASS) \
+      cell  length;                   \
+      signed char bdata[len];         \
+    }
+
+#define BYTEARRAY_HEADER(len) \
+    &AllClassblocks.manufacturedArrayOfByte, { NULL}, len
+
 /* A hashtable of a specific length, and its header */
 
 #define HASHTABLE_X(size)     \
@@ -239,6 +239,7 @@ void KVM_Cleanup()
         clearAllBreakpoints();
     }
 #endif
+    FlushConsoleOutput();
     FinalizeVM();
     FinalizeInlineCaching();
     FinalizeNativeCode();
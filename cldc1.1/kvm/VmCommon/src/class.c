@@ -1519,6 +1519,63 @@ SHORTARRAY createCharArray(const char *utf8stringArg,
     return newArray;
 }
 
+/*=========================================================================
+ * FUNCTION:      createLatin1Array()
+ * TYPE:          constructor (internal use only)
+ * OVERVIEW:      Create the byte array of a compact string from Utf8
+ *                input, provided that every character of the input is
+ *                a Latin-1 character.
+ * INTERFACE:
+ *   parameters:  Utf8 string, its length in bytes, a pointer to where
+ *                the number of characters is stored, and whether to
+ *                allocate the array in permanent space.
+ *   returns:     the new array, or NULL if a character of the string
+ *                does not fit in one byte
+ *=======================================================================*/
+
+#if COMPACT_STRINGS
+
+BYTEARRAY createLatin1Array(const char *utf8stringArg,
+                            int utf8length,
+                            int *unicodelengthP,
+                            bool_t isPermanent)
+{
+    int unicodelength = 0;
+    int i;
+    BYTEARRAY newArray;
+    const char *p, *end;
+    int size, objSize;
+
+    for (p = utf8stringArg, end = p + utf8length;  p < end;  ) {
+        if (utf2unicode(&p) > 0xFF) {
+            return NULL;
+        }
+        unicodelength++;
+    }
+
+    START_TEMPORARY_ROOTS
+        DECLARE_TEMPORARY_ROOT(const char *, utf8string, utf8stringArg);
+        size = (unicodelength + CELL - 1) >> log2CELL;
+        objSize = SIZEOF_ARRAY(size);
+
+        /* Allocate room for the byte array */
+        newArray = isPermanent
+                       ? (BYTEARRAY)callocPermanentObject(objSize)
+                       : (BYTEARRAY)callocObject(objSize, GCT_ARRAY);
+        newArray->ofClass = PrimitiveArrayClasses[T_BYTE];
+        newArray->length  = unicodelength;
+
+        /* Initialize the array with string contents */
+        for (p = utf8string, i = 0; i < unicodelength; i++) {
+            newArray->bdata[i] = (signed char)utf2unicode(&p);
+        }
+        *unicodelengthP = unicodelength;
+    END_TEMPORARY_ROOTS
+    return newArray;
+}
+
+#endif /* COMPACT_STRINGS */
+
 /*=========================================================================
  * FUNCTION:      instantiateString(), instantiateInternedString()
  * TYPE:          constructor
@@ -1539,13 +1596,18 @@ instantiateString(const char *stringArg, int utflength)
     STRING_INSTANCE result;
     START_TEMPORARY_ROOTS
         DECLARE_TEMPORARY_ROOT(const char *, string, stringArg);
-        DECLARE_TEMPORARY_ROOT(SHORTARRAY, chars,
-            createCharArray(string, utflength, &unicodelength, FALSE));
+        DECLARE_TEMPORARY_ROOT(BYTEARRAY, bytes,
+            createLatin1Array(string, utflength, &unicodelength, FALSE));
+        DECLARE_TEMPORARY_ROOT(SHORTARRAY, chars, NULL);
+        if (bytes == NULL) {
+            chars = createCharArray(string, utflength, &unicodelength, FALSE);
+        }
         result = (STRING_INSTANCE)instantiate(JavaLangString);
         /* We can't do any garbage collection, since result isn't protected */
         result->offset = 0;
         result->length = unicodelength;
         result->array = chars;
+        result->latin1 = bytes;
     END_TEMPORARY_ROOTS
     return result;
 }
@@ -1557,7 +1619,9 @@ instantiateInternedString(const char *stringArg, int utflength)
     INTERNED_STRING_INSTANCE result;
     START_TEMPORARY_ROOTS
         DECLARE_TEMPORARY_ROOT(const char *, string, stringArg);
-        SHORTARRAY chars =
+        BYTEARRAY bytes =
+            createLatin1Array(string, utflength, &unicodelength, TRUE);
+        SHORTARRAY chars = (bytes != NULL) ? NULL :
             createCharArray(string, utflength, &unicodelength, TRUE);
         result = (INTERNED_STRING_INSTANCE)
                  callocPermanentObject(SIZEOF_INTERNED_STRING_INSTANCE);
@@ -1566,6 +1630,7 @@ instantiateInternedString(const char *stringArg, int utflength)
         result->offset = 0;
         result->length = unicodelength;
         result->array = chars;
+        result->latin1 = bytes;
     END_TEMPORARY_ROOTS
     return result;
 }
@@ -1602,9 +1667,6 @@ char* getStringContents(STRING_INSTANCE string)
 
 char* getStringContentsSafely(STRING_INSTANCE string, char *buf, int lth)
 {
-    /* Get the internal unicode array containing the string */
-    SHORTARRAY thisArray = string->array;
-    int        offset    = string->offset;
     int        length    = string->length;
     int        i;
 
@@ -1612,9 +1674,9 @@ char* getStringContentsSafely(STRING_INSTANCE string, char *buf, int lth)
         fatalError(KVM_MSG_STRINGBUFFER_OVERFLOW);
     }
 
-    /* Copy contents of the unicode array to the C/C++ string */
+    /* Copy the characters of the string to the C/C++ string */
     for (i = 0; i < length; i++) {
-        buf[i] = (char)thisArray->sdata[offset + i];
+        buf[i] = (char)STRING_CHAR_AT(string, i);
     }
 
     /* Terminate the C/C++ string with zero */
@@ -1622,17 +1684,63 @@ char* getStringContentsSafely(STRING_INSTANCE string, char *buf, int lth)
     return buf;
 }
 
+/*=========================================================================
+ * FUNCTION:      getStringUTF8()
+ * TYPE:          internal operation on string objects
+ * OVERVIEW:      Get the contents of a string object as a
+ *                zero-terminated Utf8 string.
+ * INTERFACE:
+ *   parameters:  String object pointer
+ *   returns:     the Utf8 string, in a new object allocated with
+ *                mallocBytes()
+ * NOTE:          This operation may cause a garbage collection.  The
+ *                caller must protect the result if it allocates.
+ *=======================================================================*/
+
+char* getStringUTF8(STRING_INSTANCE stringArg)
+{
+    char* result;
+    START_TEMPORARY_ROOTS
+        DECLARE_TEMPORARY_ROOT(STRING_INSTANCE, string, stringArg);
+        int length = string->length;
+        int utflength = 1;
+        char* p;
+        int i;
+
+        for (i = 0; i < length; i++) {
+            unsigned short ch = STRING_CHAR_AT(string, i);
+            utflength += ((ch != 0) && (ch <= 0x7F)) ? 1
+                       : (ch <= 0x7FF) ? 2 : 3;
+        }
+        result = mallocBytes(utflength);
+        for (p = result, i = 0; i < length; i++) {
+            unsigned short ch = STRING_CHAR_AT(string, i);
+            if ((ch != 0) && (ch <= 0x7F)) {
+                *p++ = (char)ch;
+            } else if (ch <= 0x7FF) {
+                *p++ = (char)(0xC0 | (ch >> 6));
+                *p++ = (char)(0x80 | (ch & 0x3F));
+            } else {
+                *p++ = (char)(0xE0 | (ch >> 12));
+                *p++ = (char)(0x80 | ((ch >> 6) & 0x3F));
+                *p++ = (char)(0x80 | (ch & 0x3F));
+            }
+        }
+        *p = 0;
+    END_TEMPORARY_ROOTS
+    return result;
+}
+
 #if INCLUDEDEBUGCODE
 void
-printString(INSTANCE string)
+printString(INSTANCE stringArg)
 {
-    SHORTARRAY data = (SHORTARRAY)string->data[0].cellp;
-    int offset = string->data[1].cell;
-    int length = string->data[2].cell;
+    STRING_INSTANCE string = (STRING_INSTANCE)stringArg;
+    int length = string->length;
     int i;
     putchar('"');
     for (i = 0; i < length; i++) {
-        putchar((char)data->sdata[offset + i]);
+        putchar((char)STRING_CHAR_AT(string, i));
     }
     putchar('"');
     putchar('\n');
@@ -212,6 +212,13 @@ void InterpreterHandleEvent(ulong64 wakeupDelta) {
         }
     }
 
+    /* Don't leave console output buffered while the VM is idle */
+    if (areActiveThreads()) {
+        checkConsoleOutput();
+    } else {
+        FlushConsoleOutput();
+    }
+
     if (waitingThread == NULL) {
         /* Nobody waiting for an event */
         /* If active threads then just return */
@@ -136,3 +136,971 @@ void Java_java_lang_Math_tan(void) {
     pushDouble(value);
 }
 
+
+/*=========================================================================
+ * Native functions needed by CLDC 1.1 java.lang.FloatingDecimal class
+ *=======================================================================*/
+
+/*
+ * The conversions below follow the Java code of FloatingDecimal step
+ * by step, including its choice between int, long and multiple-precision
+ * arithmetic and the way Java int and long arithmetic wraps around, so
+ * that they give the same results bit for bit.  Whatever they do not
+ * handle (malformed input and the rare inputs that need the slower
+ * correction loops of doubleValue) is left to the Java code.
+ */
+
+#if FAST_DECIMAL_CONVERSION && IMPLEMENTS_FLOAT && COMPILER_SUPPORTS_LONG
+
+#define FD_EXP_SHIFT         52
+#define FD_EXP_BIAS          1023
+#define FD_FRACT_HOB         ((ulong64)1 << FD_EXP_SHIFT)
+#define FD_FRACT_MASK        (FD_FRACT_HOB - 1)
+#define FD_EXP_ONE           ((ulong64)FD_EXP_BIAS << FD_EXP_SHIFT)
+#define FD_MAX_SMALL_BIN_EXP 62
+#define FD_MIN_SMALL_BIN_EXP (-(63 / 3))
+
+#define FD_SINGLE_EXP_SHIFT  23
+#define FD_SINGLE_FRACT_HOB  (1L << FD_SINGLE_EXP_SHIFT)
+#define FD_SINGLE_EXP_BIAS   127
+
+#define FD_MAX_DIGITS        18      /* Size of FloatingDecimal.digits */
+#define FD_BIG_WORDS         48      /* Enough for 100 * 2^1100 */
+
+static const int fdSmall5pow[] = {
+    1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625,
+    48828125, 244140625, 1220703125
+};
+
+/* n5bits[] of FloatingDecimal, approximately ceil(log2(5^i)) */
+static const int fdN5bits[] = {
+    0, 3, 5, 7, 10, 12, 14, 17, 19, 21, 24, 26, 28, 31, 33, 35, 38, 40,
+    42, 45, 47, 49, 52, 54, 56, 59, 61
+};
+
+#define FD_LONG5POW_LENGTH (sizeof(fdN5bits) / sizeof(fdN5bits[0]))
+
+static const double fdSmall10pow[] = {
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8,
+    1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16,
+    1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+static const float fdSingleSmall10pow[] = {
+    1.0e0f, 1.0e1f, 1.0e2f, 1.0e3f, 1.0e4f, 1.0e5f, 1.0e6f, 1.0e7f,
+    1.0e8f, 1.0e9f, 1.0e10f
+};
+
+#define FD_MAX_SMALL_TEN        22
+#define FD_SINGLE_MAX_SMALL_TEN 10
+
+/* The digits developed so far, as in the fields of a FloatingDecimal */
+typedef struct {
+    char digits[FD_MAX_DIGITS + 2];
+    int  nDigits;
+    int  decExponent;
+} FDDIGITS;
+
+/* A non-negative multiple-precision integer, as FDBigInt */
+typedef struct {
+    int nWords;
+    unsigned int data[FD_BIG_WORDS];    /* data[0] is least significant */
+} FDBIGINT;
+
+static ulong64 fdLong5pow(int p) {
+    ulong64 result = 1;
+    while (--p >= 0) {
+        result *= 5;
+    }
+    return result;
+}
+
+static double fdLongBitsToDouble(ulong64 bits) {
+    Java8 value;
+    value.ul = bits;
+    return value.d;
+}
+
+static ulong64 fdDoubleToLongBits(double d) {
+    Java8 value;
+    value.d = d;
+    return value.ul;
+}
+
+static unsigned int fdFloatToIntBits(float f) {
+    union {
+        float f;
+        unsigned int i;
+    } value;
+    value.f = f;
+    return value.i;
+}
+
+/* Java int and long arithmetic, which wraps around */
+#define FD_INT(x)  ((int)(unsigned int)(x))
+#define FD_LONG(x) ((long64)(ulong64)(x))
+
+/* Number of bits from the highest to the lowest 1 bit, inclusive */
+static int fdCountBits(ulong64 v) {
+    int high = 63, low = 0;
+    if (v == 0) {
+        return 0;
+    }
+    while ((v & ((ulong64)1 << high)) == 0) {
+        high--;
+    }
+    while ((v & ((ulong64)1 << low)) == 0) {
+        low++;
+    }
+    return high - low + 1;
+}
+
+/*=========================================================================
+ * Multiple-precision integers
+ *=======================================================================*/
+
+static void fdBigSet(FDBIGINT *big, ulong64 value) {
+    big->data[0] = (unsigned int)value;
+    big->data[1] = (unsigned int)(value >> 32);
+    big->nWords = (big->data[1] != 0) ? 2 : 1;
+}
+
+static void fdBigMultSmall(FDBIGINT *big, unsigned int factor) {
+    ulong64 p = 0;
+    int i;
+    for (i = 0; i < big->nWords; i++) {
+        p += (ulong64)factor * big->data[i];
+        big->data[i] = (unsigned int)p;
+        p >>= 32;
+    }
+    if (p != 0) {
+        big->data[big->nWords++] = (unsigned int)p;
+    }
+}
+
+static void fdBigMultPow5(FDBIGINT *big, int p5) {
+    for ( ; p5 >= 13; p5 -= 13) {
+        fdBigMultSmall(big, fdSmall5pow[13]);
+    }
+    if (p5 > 0) {
+        fdBigMultSmall(big, fdSmall5pow[p5]);
+    }
+}
+
+static void fdBigShiftLeft(FDBIGINT *big, int count) {
+    int wordCount = count >> 5;
+    int bitCount = count & 0x1f;
+    int i;
+    if (count <= 0) {
+        return;
+    }
+    big->data[big->nWords] = 0;
+    if (bitCount != 0) {
+        for (i = big->nWords; i > 0; i--) {
+            big->data[i] = (big->data[i] << bitCount)
+                         | (big->data[i - 1] >> (32 - bitCount));
+        }
+        big->data[0] <<= bitCount;
+    }
+    big->nWords++;
+    if (wordCount != 0) {
+        for (i = big->nWords - 1; i >= 0; i--) {
+            big->data[i + wordCount] = big->data[i];
+        }
+        for (i = 0; i < wordCount; i++) {
+            big->data[i] = 0;
+        }
+        big->nWords += wordCount;
+    }
+    while (big->nWords > 1 && big->data[big->nWords - 1] == 0) {
+        big->nWords--;
+    }
+}
+
+/* Returns <0, 0 or >0, as FDBigInt.cmp() */
+static int fdBigCompare(const FDBIGINT *a, const FDBIGINT *b) {
+    int i = (a->nWords > b->nWords) ? a->nWords : b->nWords;
+    while (--i >= 0) {
+        unsigned int x = (i < a->nWords) ? a->data[i] : 0;
+        unsigned int y = (i < b->nWords) ? b->data[i] : 0;
+        if (x != y) {
+            return (x > y) ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+static void
+fdBigAdd(FDBIGINT *result, const FDBIGINT *a, const FDBIGINT *b) {
+    int n = (a->nWords > b->nWords) ? a->nWords : b->nWords;
+    ulong64 c = 0;
+    int i;
+    for (i = 0; i < n; i++) {
+        if (i < a->nWords) c += a->data[i];
+        if (i < b->nWords) c += b->data[i];
+        result->data[i] = (unsigned int)c;
+        c >>= 32;
+    }
+    if (c != 0) {
+        result->data[n++] = (unsigned int)c;
+    }
+    result->nWords = n;
+}
+
+/* Shift so that the highest 1 bit is bit 27 of the highest word, as
+ * FDBigInt.normalizeMe() does, and return the shift count.
+ */
+static int fdBigNormalize(FDBIGINT *big) {
+    unsigned int v = big->data[big->nWords - 1];
+    int count = 0;
+    if ((v & 0xf0000000) != 0) {
+        for (count = 32; (v & 0xf0000000) != 0; count--) {
+            v >>= 1;
+        }
+    } else {
+        while (v <= 0x07ffffff) {
+            v <<= 1;
+            count++;
+        }
+    }
+    fdBigShiftLeft(big, count);
+    return count;
+}
+
+/* q = this / S, this = 10 * (this % S), as FDBigInt.quoRemIteration().
+ * Returns 10 (which the caller treats as failure) where the Java code
+ * would throw because the two have different numbers of words.
+ */
+static int fdBigQuoRem(FDBIGINT *big, const FDBIGINT *s) {
+    int n = s->nWords - 1;
+    ulong64 q;
+    long64 diff = 0;
+    ulong64 p = 0;
+    int i;
+
+    if (big->nWords != s->nWords) {
+        return 10;
+    }
+    q = big->data[n] / s->data[n];
+
+    for (i = 0; i <= n; i++) {
+        diff += (long64)big->data[i] - (long64)(q * s->data[i]);
+        big->data[i] = (unsigned int)diff;
+        diff >>= 32;
+    }
+    while (diff < 0) {
+        /* q was too big; add S back in */
+        ulong64 sum = 0;
+        for (i = 0; i <= n; i++) {
+            sum += (ulong64)big->data[i] + s->data[i];
+            big->data[i] = (unsigned int)sum;
+            sum >>= 32;
+        }
+        diff += (long64)sum;
+        q--;
+    }
+    for (i = 0; i <= n; i++) {
+        p += (ulong64)10 * big->data[i];
+        big->data[i] = (unsigned int)p;
+        p >>= 32;
+    }
+    big->nWords = n + 1;
+    return (int)q;
+}
+
+/*=========================================================================
+ * Binary to decimal
+ *=======================================================================*/
+
+/* Add one to the least significant digit, as FloatingDecimal.roundup() */
+static void fdRoundup(FDDIGITS *fd) {
+    int i = fd->nDigits - 1;
+    char q = fd->digits[i];
+    if (q == '9') {
+        while (q == '9' && i > 0) {
+            fd->digits[i] = '0';
+            q = fd->digits[--i];
+        }
+        if (q == '9') {
+            fd->decExponent += 1;
+            fd->digits[0] = '1';
+            return;
+        }
+    }
+    fd->digits[i] = (char)(q + 1);
+}
+
+/* FloatingDecimal.developLongDigits() */
+static void
+fdDevelopLongDigits(FDDIGITS *fd, int decExponent,
+                    long64 lvalue, long64 insignificant) {
+    char digits[20];
+    int ndigits = 20;
+    int digitno = ndigits - 1;
+    int c, i;
+
+    for (i = 0; insignificant >= 10; i++) {
+        insignificant /= 10;
+    }
+    if (i != 0) {
+        long64 pow10 = (long64)(fdLong5pow(i) << i);
+        long64 residue = lvalue % pow10;
+        lvalue /= pow10;
+        decExponent += i;
+        if (residue >= (pow10 >> 1)) {
+            lvalue++;
+        }
+    }
+    c = (int)(lvalue % 10);
+    lvalue /= 10;
+    while (c == 0) {
+        decExponent++;
+        c = (int)(lvalue % 10);
+        lvalue /= 10;
+    }
+    while (lvalue != 0) {
+        digits[digitno--] = (char)(c + '0');
+        decExponent++;
+        c = (int)(lvalue % 10);
+        lvalue /= 10;
+    }
+    digits[digitno] = (char)(c + '0');
+    fd->nDigits = ndigits - digitno;
+    memcpy(fd->digits, &digits[digitno], fd->nDigits);
+    fd->decExponent = decExponent + 1;
+}
+
+/* FloatingDecimal.dtoa().  Returns FALSE where the Java code would
+ * throw an assertion error.
+ */
+static bool_t
+fdDtoa(FDDIGITS *fd, int binExp, ulong64 fractBits, int nSignificantBits) {
+    int nFractBits = fdCountBits(fractBits);
+    int nTinyBits = nFractBits - binExp - 1;
+    int decExp, B2, B5, S2, S5, M2, M5, Bbits, tenSbits, common2factor;
+    int ndigit = 0, q;
+    bool_t low, high;
+    long64 lowDigitDifference;
+    volatile double estimate;
+    char *digits = fd->digits;
+
+    if (nTinyBits < 0) {
+        nTinyBits = 0;
+    }
+    if (binExp <= FD_MAX_SMALL_BIN_EXP && binExp >= FD_MIN_SMALL_BIN_EXP
+        && nTinyBits < FD_LONG5POW_LENGTH
+        && nFractBits + fdN5bits[nTinyBits] < 64 && nTinyBits == 0) {
+        long64 halfULP;
+        if (binExp > nSignificantBits) {
+            halfULP = (long64)1 << (binExp - nSignificantBits - 1);
+        } else {
+            halfULP = 0;
+        }
+        if (binExp >= FD_EXP_SHIFT) {
+            fractBits <<= (binExp - FD_EXP_SHIFT);
+        } else {
+            fractBits >>= (FD_EXP_SHIFT - binExp);
+        }
+        fdDevelopLongDigits(fd, 0, (long64)fractBits, halfULP);
+        return TRUE;
+    }
+
+    /* Estimate the decimal exponent exactly as the Java code does.  The
+     * volatile keeps the compiler from fusing the multiply and add.
+     */
+    estimate = fdLongBitsToDouble(FD_EXP_ONE | (fractBits & ~FD_FRACT_HOB));
+    estimate = (estimate - 1.5) * 0.289529654;
+    estimate = estimate + 0.176091259;
+    estimate = estimate + (double)binExp * 0.301029995663981;
+    decExp = (int)JFP_lib_floor(estimate);
+
+    B5 = (decExp < 0) ? -decExp : 0;
+    B2 = B5 + nTinyBits + binExp;
+    S5 = (decExp > 0) ? decExp : 0;
+    S2 = S5 + nTinyBits;
+    M5 = B5;
+    M2 = B2 - nSignificantBits;
+
+    fractBits >>= (FD_EXP_SHIFT + 1 - nFractBits);
+    B2 -= nFractBits - 1;
+    common2factor = (B2 < S2) ? B2 : S2;
+    B2 -= common2factor;
+    S2 -= common2factor;
+    M2 -= common2factor;
+    if (nFractBits == 1) {
+        M2 -= 1;
+    }
+    if (M2 < 0) {
+        B2 -= M2;
+        S2 -= M2;
+        M2 = 0;
+    }
+
+    Bbits = nFractBits + B2 +
+        ((B5 < FD_LONG5POW_LENGTH) ? fdN5bits[B5] : B5 * 3);
+    tenSbits = S2 + 1 +
+        ((S5 + 1 < FD_LONG5POW_LENGTH) ? fdN5bits[S5 + 1] : (S5 + 1) * 3);
+
+    if (Bbits < 64 && tenSbits < 64) {
+        if (Bbits < 32 && tenSbits < 32) {
+            /* They're all ints */
+            int b = FD_INT((int)fractBits * fdSmall5pow[B5]) << B2;
+            int s = fdSmall5pow[S5] << S2;
+            int m = fdSmall5pow[M5] << M2;
+            int tens = s * 10;
+
+            q = b / s;
+            b = 10 * (b % s);
+            m = FD_INT((unsigned int)m * 10);
+            low  = (b < m);
+            high = (FD_INT((unsigned int)b + (unsigned int)m) > tens);
+            if (q >= 10) {
+                return FALSE;
+            } else if (q == 0 && !high) {
+                decExp--;
+            } else {
+                digits[ndigit++] = (char)('0' + q);
+            }
+            if (decExp <= -3 || decExp >= 8) {
+                high = low = FALSE;
+            }
+            while (!low && !high) {
+                q = b / s;
+                b = 10 * (b % s);
+                m = FD_INT((unsigned int)m * 10);
+                if (q >= 10 || ndigit >= FD_MAX_DIGITS) {
+                    return FALSE;
+                }
+                if (m > 0) {
+                    low  = (b < m);
+                    high = (FD_INT((unsigned int)b + (unsigned int)m) > tens);
+                } else {
+                    low = high = TRUE;
+                }
+                digits[ndigit++] = (char)('0' + q);
+            }
+            lowDigitDifference =
+                FD_INT(((unsigned int)b << 1) - (unsigned int)tens);
+        } else {
+            /* They're all longs */
+            long64 b = (long64)((fractBits * fdLong5pow(B5)) << B2);
+            long64 s = (long64)(fdLong5pow(S5) << S2);
+            long64 m = (long64)(fdLong5pow(M5) << M2);
+            long64 tens = s * 10;
+
+            q = (int)(b / s);
+            b = 10 * (b % s);
+            m = FD_LONG((ulong64)m * 10);
+            low  = (b < m);
+            high = (FD_LONG((ulong64)b + (ulong64)m) > tens);
+            if (q >= 10) {
+                return FALSE;
+            } else if (q == 0 && !high) {
+                decExp--;
+            } else {
+                digits[ndigit++] = (char)('0' + q);
+            }
+            if (decExp <= -3 || decExp >= 8) {
+                high = low = FALSE;
+            }
+            while (!low && !high) {
+                q = (int)(b / s);
+                b = 10 * (b % s);
+                m = FD_LONG((ulong64)m * 10);
+                if (q >= 10 || ndigit >= FD_MAX_DIGITS) {
+                    return FALSE;
+                }
+                if (m > 0) {
+                    low  = (b < m);
+                    high = (FD_LONG((ulong64)b + (ulong64)m) > tens);
+                } else {
+                    low = high = TRUE;
+                }
+                digits[ndigit++] = (char)('0' + q);
+            }
+            lowDigitDifference = FD_LONG(((ulong64)b << 1) - (ulong64)tens);
+        }
+    } else {
+        /* Multiple-precision arithmetic */
+        FDBIGINT Bval, Sval, Mval, tenSval, sum;
+        int shiftBias;
+
+        fdBigSet(&Bval, fractBits);
+        fdBigMultPow5(&Bval, B5);
+        fdBigShiftLeft(&Bval, B2);
+        fdBigSet(&Sval, 1);
+        fdBigMultPow5(&Sval, S5);
+        fdBigShiftLeft(&Sval, S2);
+        fdBigSet(&Mval, 1);
+        fdBigMultPow5(&Mval, M5);
+        fdBigShiftLeft(&Mval, M2);
+
+        shiftBias = fdBigNormalize(&Sval);
+        fdBigShiftLeft(&Bval, shiftBias);
+        fdBigShiftLeft(&Mval, shiftBias);
+        tenSval = Sval;
+        fdBigMultSmall(&tenSval, 10);
+
+        q = fdBigQuoRem(&Bval, &Sval);
+        fdBigMultSmall(&Mval, 10);
+        low = (fdBigCompare(&Bval, &Mval) < 0);
+        fdBigAdd(&sum, &Bval, &Mval);
+        high = (fdBigCompare(&sum, &tenSval) > 0);
+        if (q >= 10) {
+            return FALSE;
+        } else if (q == 0 && !high) {
+            decExp--;
+        } else {
+            digits[ndigit++] = (char)('0' + q);
+        }
+        if (decExp <= -3 || decExp >= 8) {
+            high = low = FALSE;
+        }
+        while (!low && !high) {
+            q = fdBigQuoRem(&Bval, &Sval);
+            fdBigMultSmall(&Mval, 10);
+            if (q >= 10 || ndigit >= FD_MAX_DIGITS) {
+                return FALSE;
+            }
+            low = (fdBigCompare(&Bval, &Mval) < 0);
+            fdBigAdd(&sum, &Bval, &Mval);
+            high = (fdBigCompare(&sum, &tenSval) > 0);
+            digits[ndigit++] = (char)('0' + q);
+        }
+        if (high && low) {
+            fdBigShiftLeft(&Bval, 1);
+            lowDigitDifference = fdBigCompare(&Bval, &tenSval);
+        } else {
+            lowDigitDifference = 0;
+        }
+    }
+    fd->decExponent = decExp + 1;
+    fd->nDigits = ndigit;
+
+    /* Last digit gets rounded based on stopping condition */
+    if (high) {
+        if (low) {
+            if (lowDigitDifference == 0) {
+                if ((digits[ndigit - 1] & 1) != 0) {
+                    fdRoundup(fd);
+                }
+            } else if (lowDigitDifference > 0) {
+                fdRoundup(fd);
+            }
+        } else {
+            fdRoundup(fd);
+        }
+    }
+    return TRUE;
+}
+
+/* FloatingDecimal.toJavaFormatString().  Returns the length. */
+static int fdFormat(const FDDIGITS *fd, bool_t isNegative, char *result) {
+    const char *digits = fd->digits;
+    int nDigits = fd->nDigits;
+    int decExponent = fd->decExponent;
+    int i = 0;
+
+    if (isNegative) {
+        result[i++] = '-';
+    }
+    if (decExponent > 0 && decExponent < 8) {
+        int charLength = (nDigits < decExponent) ? nDigits : decExponent;
+        memcpy(&result[i], digits, charLength);
+        i += charLength;
+        if (charLength < decExponent) {
+            charLength = decExponent - charLength;
+            memset(&result[i], '0', charLength);
+            i += charLength;
+            result[i++] = '.';
+            result[i++] = '0';
+        } else {
+            result[i++] = '.';
+            if (charLength < nDigits) {
+                memcpy(&result[i], &digits[charLength], nDigits - charLength);
+                i += nDigits - charLength;
+            } else {
+                result[i++] = '0';
+            }
+        }
+    } else if (decExponent <= 0 && decExponent > -3) {
+        result[i++] = '0';
+        result[i++] = '.';
+        if (decExponent != 0) {
+            memset(&result[i], '0', -decExponent);
+            i -= decExponent;
+        }
+        memcpy(&result[i], digits, nDigits);
+        i += nDigits;
+    } else {
+        int e;
+        result[i++] = digits[0];
+        result[i++] = '.';
+        if (nDigits > 1) {
+            memcpy(&result[i], &digits[1], nDigits - 1);
+            i += nDigits - 1;
+        } else {
+            result[i++] = '0';
+        }
+        result[i++] = 'E';
+        if (decExponent <= 0) {
+            result[i++] = '-';
+            e = -decExponent + 1;
+        } else {
+            e = decExponent - 1;
+        }
+        if (e > 99) {
+            result[i++] = (char)(e / 100 + '0');
+            e %= 100;
+            result[i++] = (char)(e / 10 + '0');
+        } else if (e > 9) {
+            result[i++] = (char)(e / 10 + '0');
+        }
+        result[i++] = (char)(e % 10 + '0');
+    }
+    return i;
+}
+
+/* Convert a double (or a float widened to a double, if isFloat) to a
+ * String.  Returns NULL if the Java code has to do it.  May GC.
+ */
+static STRING_INSTANCE fdToString(double value, bool_t isFloat) {
+    FDDIGITS fd;
+    char result[FD_MAX_DIGITS + 16];
+    ulong64 dBits = fdDoubleToLongBits(value);
+    bool_t isNegative = (dBits >> 63) != 0;
+    int binExp = (int)((dBits >> FD_EXP_SHIFT) & 0x7ff);
+    ulong64 fractBits = dBits & FD_FRACT_MASK;
+    int nSignificantBits;
+
+    if (binExp == 0x7ff) {
+        if (fractBits == 0) {
+            return instantiateString(isNegative ? "-Infinity" : "Infinity",
+                                     isNegative ? 9 : 8);
+        }
+        return instantiateString("NaN", 3);
+    }
+    if (binExp == 0 && fractBits == 0) {
+        return instantiateString(isNegative ? "-0.0" : "0.0",
+                                 isNegative ? 4 : 3);
+    }
+
+    if (isFloat) {
+        /* Unpack the float again, exactly as FloatingDecimal(float) */
+        unsigned int fBits = fdFloatToIntBits((float)value);
+        long singleFract = fBits & (FD_SINGLE_FRACT_HOB - 1);
+        binExp = (int)((fBits >> FD_SINGLE_EXP_SHIFT) & 0xff);
+        if (binExp == 0) {
+            while ((singleFract & FD_SINGLE_FRACT_HOB) == 0) {
+                singleFract <<= 1;
+                binExp -= 1;
+            }
+            nSignificantBits = FD_SINGLE_EXP_SHIFT + binExp + 1;
+            binExp += 1;
+        } else {
+            singleFract |= FD_SINGLE_FRACT_HOB;
+            nSignificantBits = FD_SINGLE_EXP_SHIFT + 1;
+        }
+        binExp -= FD_SINGLE_EXP_BIAS;
+        fractBits = (ulong64)singleFract << (FD_EXP_SHIFT - FD_SINGLE_EXP_SHIFT);
+    } else {
+        if (binExp == 0) {
+            while ((fractBits & FD_FRACT_HOB) == 0) {
+                fractBits <<= 1;
+                binExp -= 1;
+            }
+            nSignificantBits = FD_EXP_SHIFT + binExp + 1;
+            binExp += 1;
+        } else {
+            fractBits |= FD_FRACT_HOB;
+            nSignificantBits = FD_EXP_SHIFT + 1;
+        }
+        binExp -= FD_EXP_BIAS;
+    }
+
+    if (!fdDtoa(&fd, binExp, fractBits, nSignificantBits)) {
+        return NULL;
+    }
+    return instantiateString(result, fdFormat(&fd, isNegative, result));
+}
+
+/*=========================================================================
+ * Decimal to binary
+ *=======================================================================*/
+
+/* The result of scanning a string as readJavaFormatString() does */
+typedef struct {
+    bool_t isNegative;
+    char digits[16];
+    int  nDigits;
+    int  decExponent;
+} FDSCAN;
+
+/* Scan a string as FloatingDecimal.readJavaFormatString() does.
+ * Returns FALSE if the string is malformed (so that the Java code
+ * throws NumberFormatException) or has too many digits or too large
+ * an exponent for any of the easy cases of doubleValue().
+ */
+static bool_t fdScan(STRING_INSTANCE string, FDSCAN *scan) {
+    int i, l, c = 0;
+    int nLeadZero = 0, nTrailZero = 0, decPt = 0, decExp;
+    bool_t signSeen = FALSE, decSeen = FALSE;
+    int start;
+
+    if (string == NULL) {
+        return FALSE;
+    }
+    /* String.trim() */
+    i = 0;
+    l = string->length;
+    while (i < l && STRING_CHAR_AT(string, i) <= ' ') {
+        i++;
+    }
+    while (i < l && STRING_CHAR_AT(string, l - 1) <= ' ') {
+        l--;
+    }
+    if (i == l) {
+        return FALSE;
+    }
+    start = i;
+
+    scan->isNegative = FALSE;
+    scan->nDigits = 0;
+    c = STRING_CHAR_AT(string, i);
+    if (c == '-' || c == '+') {
+        scan->isNegative = (c == '-');
+        signSeen = TRUE;
+        i++;
+    }
+    for ( ; i < l; i++) {
+        c = STRING_CHAR_AT(string, i);
+        if (c == '0') {
+            if (scan->nDigits > 0) {
+                nTrailZero++;
+            } else {
+                nLeadZero++;
+            }
+        } else if (c >= '1' && c <= '9') {
+            if (scan->nDigits + nTrailZero >= 15) {
+                return FALSE;
+            }
+            while (nTrailZero > 0) {
+                scan->digits[scan->nDigits++] = '0';
+                nTrailZero--;
+            }
+            scan->digits[scan->nDigits++] = (char)c;
+        } else if (c == '.') {
+            if (decSeen) {
+                return FALSE;
+            }
+            decPt = i - start - (signSeen ? 1 : 0);
+            decSeen = TRUE;
+        } else {
+            break;
+        }
+    }
+    if (scan->nDigits == 0) {
+        if (nLeadZero == 0) {
+            return FALSE;
+        }
+        scan->digits[0] = '0';
+        scan->nDigits = 1;
+    }
+    decExp = decSeen ? decPt - nLeadZero : scan->nDigits + nTrailZero;
+
+    if (i < l && (c == 'e' || c == 'E')) {
+        int expSign = 1, expVal = 0, expAt;
+        if (++i == l) {
+            return FALSE;
+        }
+        c = STRING_CHAR_AT(string, i);
+        if (c == '-' || c == '+') {
+            expSign = (c == '-') ? -1 : 1;
+            i++;
+        }
+        for (expAt = i; i < l; i++) {
+            c = STRING_CHAR_AT(string, i);
+            if (c < '0' || c > '9') {
+                break;
+            }
+            expVal = expVal * 10 + (c - '0');
+            if (expVal > 1000) {
+                /* Far out of range of the easy cases */
+                return FALSE;
+            }
+        }
+        if (i == expAt) {
+            return FALSE;
+        }
+        decExp += expSign * expVal;
+    }
+    if (i < l) {
+        c = STRING_CHAR_AT(string, i);
+        if (i != l - 1
+            || (c != 'f' && c != 'F' && c != 'd' && c != 'D')) {
+            return FALSE;
+        }
+    }
+    scan->decExponent = decExp;
+    return TRUE;
+}
+
+/* The easy cases of FloatingDecimal.doubleValue() */
+static bool_t fdDoubleValue(const FDSCAN *scan, double *result) {
+    int kDigits = scan->nDigits;
+    long64 lValue = 0;
+    double dValue, rValue;
+    int exp, i;
+
+    for (i = 0; i < kDigits; i++) {
+        lValue = lValue * 10 + (scan->digits[i] - '0');
+    }
+    dValue = (double)lValue;
+    exp = scan->decExponent - kDigits;
+
+    if (exp == 0 || dValue == 0.0) {
+        rValue = dValue;
+    } else if (exp >= 0) {
+        int slop = 15 - kDigits;
+        if (exp <= FD_MAX_SMALL_TEN) {
+            rValue = dValue * fdSmall10pow[exp];
+        } else if (exp <= FD_MAX_SMALL_TEN + slop) {
+            dValue *= fdSmall10pow[slop];
+            rValue = dValue * fdSmall10pow[exp - slop];
+        } else {
+            return FALSE;
+        }
+    } else if (exp >= -FD_MAX_SMALL_TEN) {
+        rValue = dValue / fdSmall10pow[-exp];
+    } else {
+        return FALSE;
+    }
+    *result = scan->isNegative ? -rValue : rValue;
+    return TRUE;
+}
+
+/* The easy cases of FloatingDecimal.floatValue() */
+static bool_t fdFloatValue(const FDSCAN *scan, float *result) {
+    int nDigits = scan->nDigits;
+    int kDigits = (nDigits < 8) ? nDigits : 8;
+    int decExponent = scan->decExponent;
+    int iValue = 0, exp, i;
+    float fValue;
+
+    for (i = 0; i < kDigits; i++) {
+        iValue = iValue * 10 + (scan->digits[i] - '0');
+    }
+    fValue = (float)iValue;
+    exp = decExponent - kDigits;
+
+    if (nDigits <= 7) {
+        if (exp == 0 || fValue == 0.0f) {
+            /* Small floating integer */
+        } else if (exp >= 0) {
+            int slop = 7 - kDigits;
+            if (exp <= FD_SINGLE_MAX_SMALL_TEN) {
+                fValue = (float)(fValue * fdSingleSmall10pow[exp]);
+            } else if (exp <= FD_SINGLE_MAX_SMALL_TEN + slop) {
+                fValue = (float)(fValue * fdSingleSmall10pow[slop]);
+                fValue = (float)(fValue * fdSingleSmall10pow[exp - slop]);
+            } else {
+                return FALSE;
+            }
+        } else if (exp >= -FD_SINGLE_MAX_SMALL_TEN) {
+            fValue = (float)(fValue / fdSingleSmall10pow[-exp]);
+        } else {
+            return FALSE;
+        }
+    } else if (decExponent >= nDigits && nDigits + decExponent <= 15) {
+        long64 lValue = iValue;
+        double dValue;
+        for (i = kDigits; i < nDigits; i++) {
+            lValue = lValue * 10 + (scan->digits[i] - '0');
+        }
+        dValue = (double)lValue;
+        dValue *= fdSmall10pow[decExponent - nDigits];
+        fValue = (float)dValue;
+    } else {
+        return FALSE;
+    }
+    *result = scan->isNegative ? -fValue : fValue;
+    return TRUE;
+}
+
+#endif /* FAST_DECIMAL_CONVERSION && IMPLEMENTS_FLOAT && COMPILER_SUPPORTS_LONG */
+
+/*=========================================================================
+ * FUNCTIONS:     doubleToString(D)Ljava/lang/String; (STATIC)
+ *                floatToString(F)Ljava/lang/String; (STATIC)
+ * CLASS:         java.lang.FloatingDecimal
+ * TYPE:          static native functions
+ * OVERVIEW:      Convert a floating point number to a String, as
+ *                new FloatingDecimal(value).toJavaFormatString() does.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  value
+ *   returns:     the String, or null if the Java code has to do it
+ *=======================================================================*/
+
+void Java_java_lang_FloatingDecimal_doubleToString(void) {
+    double value;
+
+    popDouble(value);
+#if FAST_DECIMAL_CONVERSION && IMPLEMENTS_FLOAT && COMPILER_SUPPORTS_LONG
+    pushStackAsType(STRING_INSTANCE, fdToString(value, FALSE));
+#else
+    pushStackAsType(STRING_INSTANCE, NULL);
+#endif
+}
+
+void Java_java_lang_FloatingDecimal_floatToString(void) {
+#if FAST_DECIMAL_CONVERSION && IMPLEMENTS_FLOAT && COMPILER_SUPPORTS_LONG
+    float value = *(float *)getSP();
+    topStackAsType(STRING_INSTANCE) = fdToString((double)value, TRUE);
+#else
+    topStackAsType(STRING_INSTANCE) = NULL;
+#endif
+}
+
+/*=========================================================================
+ * FUNCTIONS:     stringToDouble(Ljava/lang/String;)D (STATIC)
+ *                stringToFloat(Ljava/lang/String;)F (STATIC)
+ * CLASS:         java.lang.FloatingDecimal
+ * TYPE:          static native functions
+ * OVERVIEW:      Convert a String to a floating point number, as
+ *                readJavaFormatString(string).doubleValue() (or
+ *                floatValue()) does.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  the String
+ *   returns:     the value, or NaN if the Java code has to do it
+ *=======================================================================*/
+
+void Java_java_lang_FloatingDecimal_stringToDouble(void) {
+#if FAST_DECIMAL_CONVERSION && IMPLEMENTS_FLOAT && COMPILER_SUPPORTS_LONG
+    STRING_INSTANCE string = popStackAsType(STRING_INSTANCE);
+    FDSCAN scan;
+    double result;
+    if (fdScan(string, &scan) && fdDoubleValue(&scan, &result)) {
+        pushDouble(result);
+        return;
+    }
+#else
+    oneLess;
+#endif
+    /* Any NaN will do; no string converts to NaN */
+    oneMore;
+    SET_LONG_FROM_HALVES(getSP(), 0x7FF00000, 1);
+    oneMore;
+}
+
+void Java_java_lang_FloatingDecimal_stringToFloat(void) {
+#if FAST_DECIMAL_CONVERSION && IMPLEMENTS_FLOAT && COMPILER_SUPPORTS_LONG
+    STRING_INSTANCE string = topStackAsType(STRING_INSTANCE);
+    FDSCAN scan;
+    float result;
+    if (fdScan(string, &scan) && fdFloatValue(&scan, &result)) {
+        *(float *)getSP() = result;
+        return;
+    }
+#endif
+    *(long *)getSP() = F_L_POS_NAN;
+}
@@ -843,6 +843,7 @@ void fatalVMError(const char* errorMessage)
 
 void fatalError(const char* errorMessage)
 {
+    FlushConsoleOutput();
     if (INCLUDEDEBUGCODE) {
         printVMstatus();
     }
@@ -1023,6 +1024,8 @@ void fillInStackTrace(THROWABLE_INSTANCE_HANDLE exceptionH) {
 #endif /* PRINT_BACKTRACE */
 
 void printExceptionStackTrace(THROWABLE_INSTANCE_HANDLE exceptionH) { 
+    /* Keep the trace after the buffered "Exception: ..." line */
+    FlushConsoleOutput();
 #if PRINT_BACKTRACE
     START_TEMPORARY_ROOTS 
         DECLARE_TEMPORARY_ROOT(ARRAY, backtrace, unhand(exceptionH)->backtrace);
@@ -48,6 +48,10 @@ bool_t vmDebugReady = FALSE;
 bool_t JamEnabled;
 bool_t JamRepeat;
 
+/* Flush console output at every newline, rather than only */
+/* when the console buffer is full (see nativeCore.c) */
+bool_t ConsoleLineBuffered = TRUE;
+
 /*========================================================================
  * Runtime flags for choosing different tracing/debugging options.
  * All these options make the system very verbose. Turn them all off
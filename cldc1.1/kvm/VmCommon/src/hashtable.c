@@ -257,13 +257,11 @@ internString(const char *utf8string, int length)
     
     for (string = *stringPtr; string != NULL; string = string->next) { 
         if (string->length == utfLength) { 
-            SHORTARRAY chars = string->array;
-            int offset = string->offset;
             const char *p = utf8string;
             unsigned int i;
             for (i = 0; i < utfLength; i++) { 
-                short unichar = utf2unicode(&p);
-                if (unichar != chars->sdata[offset + i]) { 
+                unsigned short unichar = utf2unicode(&p);
+                if (unichar != STRING_CHAR_AT(string, i)) { 
                     /* We want to do "continue  <outerLoop>", but this is C */;
                     goto continueOuterLoop;
                 }
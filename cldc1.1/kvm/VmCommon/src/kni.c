@@ -730,15 +730,11 @@ jsize KNI_GetStringLength(jstring stringHandle) {
 
 void KNI_GetStringRegion(jstring stringHandle, jsize offset, jsize n, jchar* jcharbuf) {
     STRING_INSTANCE string = (STRING_INSTANCE)KNI_UNHAND(stringHandle);
-    SHORTARRAY stringContents;
-    long stroffset;
     long strlength;
     long i;
 
     if (INCLUDEDEBUGCODE && string == 0) return;
 
-    stringContents = string->array;
-    stroffset      = string->offset;
     strlength      = string->length;
     /*
      * Invariants:
@@ -755,7 +751,7 @@ void KNI_GetStringRegion(jstring stringHandle, jsize offset, jsize n, jchar* jch
      */
     if (offset >= 0 && n > 0 && (offset + n) <= strlength) {
         for (i = 0; i < n; i++) {
-            jcharbuf[i] = ((unsigned short*)stringContents->sdata)[i + stroffset + offset];
+            jcharbuf[i] = STRING_CHAR_AT(string, i + offset);
         }
     }
 }
@@ -780,15 +776,33 @@ void KNI_NewString(const jchar* uchars, jsize length, jstring stringHandle) {
     int arraySize = SIZEOF_ARRAY((length * 2 + (CELL - 1)) >> log2CELL);
 
     START_TEMPORARY_ROOTS
-        /*  Allocate a character array */
-        DECLARE_TEMPORARY_ROOT(SHORTARRAY, newArray, 
-            (SHORTARRAY)callocObject(arraySize, GCT_ARRAY));
-        newArray->ofClass = PrimitiveArrayClasses[T_CHAR];
-        newArray->length  = length;
-
-        /*  Initialize the character array with string contents */
-        for (i = 0; i < length; i++) { 
-            newArray->sdata[i] = uchars[i];
+        DECLARE_TEMPORARY_ROOT(SHORTARRAY, newArray, NULL);
+        DECLARE_TEMPORARY_ROOT(BYTEARRAY, newBytes, NULL);
+
+#if COMPACT_STRINGS
+        /*  Store the string in a byte array if every character fits */
+        for (i = 0; i < length && uchars[i] <= 0xFF; i++);
+        if (i == length) {
+            arraySize = SIZEOF_ARRAY((length + (CELL - 1)) >> log2CELL);
+            newBytes = (BYTEARRAY)callocObject(arraySize, GCT_ARRAY);
+            newBytes->ofClass = PrimitiveArrayClasses[T_BYTE];
+            newBytes->length  = length;
+            for (i = 0; i < length; i++) { 
+                newBytes->bdata[i] = (signed char)uchars[i];
+            }
+        }
+#endif
+
+        if (newBytes == NULL) {
+            /*  Allocate a character array */
+            newArray = (SHORTARRAY)callocObject(arraySize, GCT_ARRAY);
+            newArray->ofClass = PrimitiveArrayClasses[T_CHAR];
+            newArray->length  = length;
+
+            /*  Initialize the character array with string contents */
+            for (i = 0; i < length; i++) { 
+                newArray->sdata[i] = uchars[i];
+            }
         }
 
         /* Allocate a new string object (no temporary roots used, */
@@ -797,6 +811,7 @@ void KNI_NewString(const jchar* uchars, jsize length, jstring stringHandle) {
         newString->offset = 0;
         newString->length = length;
         newString->array  = newArray;
+        newString->latin1 = newBytes;
     END_TEMPORARY_ROOTS
 
     KNI_SETHAND(stringHandle, newString);
@@ -947,23 +947,139 @@ void Java_java_lang_ref_WeakReference_initializeWeakReference(void)
  * Native functions in com.sun.cldc.io.*
  *=======================================================================*/
 
+/* Console output is collected here and written to stdout when a line
+ * is complete (if ConsoleLineBuffered is set), when the buffer is
+ * full, when it has been pending for CONSOLE_FLUSH_INTERVAL ms, when
+ * the VM goes idle, on ConsoleOutputStream.flush() and at VM exit.
+ */
+static char consoleBuffer[CONSOLE_BUFFER_SIZE];
+static int consoleBufferCount = 0;
+
+/* Time at which the oldest byte in consoleBuffer was written */
+static ulong64 consoleBufferTime;
+
+/*=========================================================================
+ * FUNCTION:      FlushConsoleOutput()
+ * TYPE:          public global operation
+ * OVERVIEW:      Write any buffered console output to stdout.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void FlushConsoleOutput(void)
+{
+    if (consoleBufferCount > 0) {
+        fwrite(consoleBuffer, 1, consoleBufferCount, stdout);
+#ifdef POCKETPC
+        fprintf(stdout, "%.*s", consoleBufferCount, consoleBuffer);
+#endif
+        consoleBufferCount = 0;
+    }
+    fflush(stdout);
+}
+
+/*=========================================================================
+ * FUNCTION:      checkConsoleOutput()
+ * TYPE:          public global operation
+ * OVERVIEW:      Flush the console output if it has been buffered for
+ *                longer than CONSOLE_FLUSH_INTERVAL.  Called on every
+ *                write and from the scheduler, so that partial lines
+ *                (and fully buffered output) do not linger.
+ * INTERFACE:
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void checkConsoleOutput(void)
+{
+    if (consoleBufferCount > 0) {
+        ulong64 age = CurrentTime_md();
+        ulong64 interval;
+        ll_dec(age, consoleBufferTime);
+        ll_int_to_long(interval, CONSOLE_FLUSH_INTERVAL);
+        if (ll_compare_ge(age, interval)) {
+            FlushConsoleOutput();
+        }
+    }
+}
+
+/* Append bytes to the console buffer, flushing as described above */
+static void writeConsole(const char* bytes, int length)
+{
+    if (consoleBufferCount + length > CONSOLE_BUFFER_SIZE) {
+        FlushConsoleOutput();
+        if (length >= CONSOLE_BUFFER_SIZE) {
+            /* Too big to be worth copying */
+            fwrite(bytes, 1, length, stdout);
+#ifdef POCKETPC
+            fprintf(stdout, "%.*s", length, bytes);
+#endif
+            fflush(stdout);
+            return;
+        }
+    }
+    if (consoleBufferCount == 0) {
+        consoleBufferTime = CurrentTime_md();
+    }
+    memcpy(consoleBuffer + consoleBufferCount, bytes, length);
+    consoleBufferCount += length;
+
+    if (ConsoleLineBuffered && memchr(bytes, '\n', length) != NULL) {
+        FlushConsoleOutput();
+    } else {
+        checkConsoleOutput();
+    }
+}
+
 /*=========================================================================
  * FUNCTION:      write(C)V (STATIC)
- * CLASS:         com/sun/kvm/io/ConsoleOutputStream
+ * CLASS:         com/sun/cldc/io/ConsoleOutputStream
  * TYPE:          static native function
  * OVERVIEW:      Print a byte to the stdout file
  * INTERFACE (operand stack manipulation):
- *   parameters:  <none>
+ *   parameters:  the byte
  *   returns:     <nothing>
  *=======================================================================*/
 
 void Java_com_sun_cldc_io_ConsoleOutputStream_write(void)
 {
-    int c = popStack();
-    putchar(c);
-#ifdef POCKETPC
-    fprintf(stdout, "%c", c);
-#endif
+    char c = (char)popStack();
+    writeConsole(&c, 1);
+}
+
+/*=========================================================================
+ * FUNCTION:      writeBytes([BII)V (STATIC)
+ * CLASS:         com/sun/cldc/io/ConsoleOutputStream
+ * TYPE:          static native function
+ * OVERVIEW:      Print a range of a byte array to the stdout file.
+ *                The bounds have been checked by the caller.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  byte array, offset, length
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void Java_com_sun_cldc_io_ConsoleOutputStream_writeBytes(void)
+{
+    long length = popStack();
+    long offset = popStack();
+    BYTEARRAY array = popStackAsType(BYTEARRAY);
+    writeConsole((const char*)&array->bdata[offset], length);
+}
+
+/*=========================================================================
+ * FUNCTION:      flushConsole()V (STATIC)
+ * CLASS:         com/sun/cldc/io/ConsoleOutputStream
+ * TYPE:          static native function
+ * OVERVIEW:      Write any buffered console output to stdout
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  <none>
+ *   returns:     <nothing>
+ *=======================================================================*/
+
+void Java_com_sun_cldc_io_ConsoleOutputStream_flushConsole(void)
+{
+    FlushConsoleOutput();
 }
 
 /*=========================================================================
@@ -1050,6 +1166,44 @@ void Java_java_lang_Throwable_printStackTrace0() {
  * Native functions of classes java.util.String and StringBuffer
  *=======================================================================*/
 
+/*=========================================================================
+ * FUNCTION:      compareStringRegions
+ * CLASS:         java.lang.String
+ * TYPE:          helper function
+ * OVERVIEW:      finds the first position at which two regions of two
+ *                strings differ.  The strings may be stored differently
+ *                (see COMPACT_STRINGS in main.h).
+ * INTERFACE
+ *   parameters:  first string, start of its region, second string,
+ *                start of its region, length of the regions
+ *   returns:     index of the first differing character relative to
+ *                the start of the regions, or length if they are equal
+ *====================================================================*/
+
+static long compareStringRegions(STRING_INSTANCE s1, long from1,
+                                 STRING_INSTANCE s2, long from2, long length)
+{
+    long i;
+    if (s1->array != NULL && s2->array != NULL) {
+        unsigned short *p1 =
+            (unsigned short *)&s1->array->sdata[s1->offset + from1];
+        unsigned short *p2 =
+            (unsigned short *)&s2->array->sdata[s2->offset + from2];
+        for (i = 0; i < length && p1[i] == p2[i]; i++);
+    } else if (s1->array == NULL && s2->array == NULL) {
+        signed char *p1 = &s1->latin1->bdata[s1->offset + from1];
+        signed char *p2 = &s2->latin1->bdata[s2->offset + from2];
+        for (i = 0; i < length && p1[i] == p2[i]; i++);
+    } else {
+        for (i = 0; i < length; i++) {
+            if (STRING_CHAR_AT(s1, from1 + i) != STRING_CHAR_AT(s2, from2 + i)) {
+                break;
+            }
+        }
+    }
+    return i;
+}
+
 /*=========================================================================
  * FUNCTION:      charAt()
  * CLASS:         java.lang.String
@@ -1068,8 +1222,7 @@ void Java_java_lang_String_charAt() {
     if (index < 0 || index >= length) {
         raiseException(StringIndexOutOfBoundsException);
     } else {
-        long result =
-            ((unsigned short *)(this->array->sdata))[this->offset + index];
+        long result = STRING_CHAR_AT(this, index);
         pushStack(result);
     }
 }
@@ -1093,7 +1246,17 @@ static void string_indexOf(long fromIndex) {
     long result = -1;
     long i;
 
-    if (fromIndex < length) {
+    if (fromIndex < length && this->array == NULL) {
+        /* A compact string can only contain characters up to 0xFF */
+        if (ch >= 0 && ch <= 0xFF) {
+            signed char *start = &this->latin1->bdata[offset];
+            signed char *found = memchr(start + fromIndex, (int)ch,
+                                        length - fromIndex);
+            if (found != NULL) {
+                result = found - start;
+            }
+        }
+    } else if (fromIndex < length) {
         SHORTARRAY array = this->array;
         /* Max is the largest position in the underlying char array */
         long max = offset + length;
@@ -1168,11 +1331,18 @@ void Java_java_lang_String_equals() {
         unsigned long length = this->length;
         if (length == other->length) {
             /* Both objects must have the same length */
-            if (0 == memcmp(&this->array->sdata[this->offset],
-                            &other->array->sdata[other->offset],
-                            length * sizeof(this->array->sdata[0]))) {
-                /* Both objects must have the same characters */
-                result = TRUE;
+            if (this->array != NULL && other->array != NULL) {
+                result = (0 == memcmp(&this->array->sdata[this->offset],
+                                      &other->array->sdata[other->offset],
+                                      length * sizeof(this->array->sdata[0])));
+            } else if (this->array == NULL && other->array == NULL) {
+                result = (0 == memcmp(&this->latin1->bdata[this->offset],
+                                      &other->latin1->bdata[other->offset],
+                                      length));
+            } else {
+                /* One of each kind, so compare character by character */
+                result = (compareStringRegions(this, 0, other, 0, length)
+                              == length);
             }
         }
     }
@@ -1191,19 +1361,342 @@ void Java_java_lang_String_equals() {
 void Java_java_lang_String_intern() {
     STRING_INSTANCE this = popStackAsType(STRING_INSTANCE); /* volatile! */
     INTERNED_STRING_INSTANCE result;
-    int this_offset = this->offset;
-    int this_length = this->length;
     START_TEMPORARY_ROOTS
-      DECLARE_TEMPORARY_ROOT(SHORTARRAY, this_array, this->array);
-      int utflen = unicode2utfstrlen((unsigned short *)&this_array->sdata[this_offset],
-                                     this_length) + 1;
-      DECLARE_TEMPORARY_ROOT(char*, buf, mallocBytes(utflen));
-      unicode2utf((unsigned short *)&this_array->sdata[this_offset], this_length, buf, utflen);
+      DECLARE_TEMPORARY_ROOT(char*, buf, getStringUTF8(this));
       result = internString(buf, strlen(buf));
     END_TEMPORARY_ROOTS
     pushStackAsType(INTERNED_STRING_INSTANCE, result);
 }
 
+/*=========================================================================
+ * FUNCTION:      compareTo(String)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      compares two strings lexicographically
+ *   parameters:  this
+ *                anotherString
+ *   returns:     the difference of the first differing characters, or
+ *                the difference of the lengths
+ *==================================================================== */
+
+void Java_java_lang_String_compareTo(void) {
+    STRING_INSTANCE other = popStackAsType(STRING_INSTANCE);
+    STRING_INSTANCE this = popStackAsType(STRING_INSTANCE);
+
+    if (other == NULL) {
+        raiseException(NullPointerException);
+    } else {
+        long length = (this->length < other->length)
+                          ? this->length : other->length;
+        long i = compareStringRegions(this, 0, other, 0, length);
+        if (i < length) {
+            pushStack((long)STRING_CHAR_AT(this, i) -
+                      (long)STRING_CHAR_AT(other, i));
+        } else {
+            pushStack(this->length - other->length);
+        }
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      startsWith(String, int)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      tests if a string has a prefix at a given position
+ *   parameters:  this
+ *                prefix
+ *                toffset: where to look in this string
+ *   returns:     TRUE if the prefix is found at toffset
+ *==================================================================== */
+
+void Java_java_lang_String_startsWith(void) {
+    long toffset = popStack();
+    STRING_INSTANCE prefix = popStackAsType(STRING_INSTANCE);
+    STRING_INSTANCE this = popStackAsType(STRING_INSTANCE);
+
+    if (prefix == NULL) {
+        raiseException(NullPointerException);
+    } else {
+        long length = prefix->length;
+        /* Note: toffset might be near -1>>>1 */
+        bool_t result = toffset >= 0 && toffset <= this->length - length &&
+            compareStringRegions(this, toffset, prefix, 0, length) == length;
+        pushStack(result);
+    }
+}
+
+/*=========================================================================
+ * FUNCTION:      regionMatches(int, String, int, int)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      tests if two string regions are equal, taking case
+ *                into account.  The caller has checked that the
+ *                regions lie within the strings.
+ *   parameters:  this
+ *                toffset: start of the region in this string
+ *                other
+ *                ooffset: start of the region in the other string
+ *                len: length of the regions
+ *   returns:     TRUE if the regions are equal
+ *==================================================================== */
+
+void Java_java_lang_String_regionMatches(void) {
+    long len = popStack();
+    long ooffset = popStack();
+    STRING_INSTANCE other = popStackAsType(STRING_INSTANCE);
+    long toffset = popStack();
+    STRING_INSTANCE this = popStackAsType(STRING_INSTANCE);
+
+    pushStack(len <= 0 ||
+              compareStringRegions(this, toffset, other, ooffset, len) == len);
+}
+
+/*=========================================================================
+ * FUNCTION:      hashCode()
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      computes the hash code of a string
+ *   parameters:  this
+ *   returns:     s[0]*31^(n-1) + s[1]*31^(n-2) + ... + s[n-1]
+ *==================================================================== */
+
+void Java_java_lang_String_hashCode(void) {
+    STRING_INSTANCE this = popStackAsType(STRING_INSTANCE);
+    long length = this->length;
+    unsigned long h = 0;
+    long i;
+
+    if (this->array != NULL) {
+        unsigned short *p = (unsigned short *)&this->array->sdata[this->offset];
+        for (i = 0; i < length; i++) {
+            h = 31 * h + p[i];
+        }
+    } else {
+        unsigned char *p = (unsigned char *)&this->latin1->bdata[this->offset];
+        for (i = 0; i < length; i++) {
+            h = 31 * h + p[i];
+        }
+    }
+    pushStack(h);
+}
+
+/*=========================================================================
+ * FUNCTION:      lastIndexOf(II)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      returns index of the last occurrence of a character
+ *   parameters:  this
+ *                character
+ *                fromIndex: last location to look for that character
+ *   returns:     index of the last occurrence, or -1
+ *==================================================================== */
+
+void Java_java_lang_String_lastIndexOf(void) {
+    long fromIndex = popStack();
+    long ch = popStack();
+    STRING_INSTANCE this = popStackAsType(STRING_INSTANCE);
+    long i = (fromIndex >= this->length) ? this->length - 1 : fromIndex;
+
+    for ( ; i >= 0; i--) {
+        if (STRING_CHAR_AT(this, i) == ch) {
+            break;
+        }
+    }
+    pushStack(i < 0 ? -1 : i);
+}
+
+/*=========================================================================
+ * FUNCTION:      indexOf(String, int)
+ * CLASS:         java.lang.String
+ * TYPE:          virtual native function
+ * OVERVIEW:      returns index of a substring
+ *   parameters:  this
+ *                str: the substring to look for
+ *                fromIndex: first location to look for it
+ *   returns:     index of the first occurrence, or -1
+ *==================================================================== */
+
+void Java_java_lang_String_indexOf__Ljava_lang_String_2I(void) {
+    long fromIndex = popStack();
+    STRING_INSTANCE str = popStackAsType(STRING_INSTANCE);
+    STRING_INSTANCE this = popStackAsType(STRING_INSTANCE);
+    long count = this->length;
+    long result = -1;
+
+    if (str == NULL) {
+        raiseException(NullPointerException);
+        return;
+    }
+    if (fromIndex >= count) {
+        /* There is an empty string at index 0 in an empty string.
+         * Note: fromIndex might be near -1>>>1
+         */
+        if (count == 0 && fromIndex == 0 && str->length == 0) {
+            result = 0;
+        }
+    } else {
+        long length = str->length;
+        long max = count - length;
+        long i;
+        if (fromIndex < 0) {
+            fromIndex = 0;
+        }
+        if (length == 0) {
+            result = fromIndex;
+        } else {
+            unsigned short first = STRING_CHAR_AT(str, 0);
+            for (i = fromIndex; i <= max; i++) {
+                if (STRING_CHAR_AT(this, i) == first &&
+                    compareStringRegions(this, i + 1, str, 1, length - 1)
+                        == length - 1) {
+                    result = i;
+                    break;
+                }
+            }
+        }
+    }
+    pushStack(result);
+}
+
+/*=========================================================================
+ * FUNCTION:      compactStrings()
+ * CLASS:         java.lang.String
+ * TYPE:          static native function
+ * OVERVIEW:      tells the class library whether to store Latin-1
+ *                strings in byte arrays (see COMPACT_STRINGS in main.h)
+ *   parameters:  <none>
+ *   returns:     TRUE if compact strings are enabled
+ *==================================================================== */
+
+void Java_java_lang_String_compactStrings(void) {
+    pushStack(COMPACT_STRINGS);
+}
+
+/*=========================================================================
+ * Integer and long formatting helpers
+ *=======================================================================*/
+
+/* "00", "01", ... "99", so that decimal numbers can be converted two
+ * digits at a time
+ */
+static const char digitPairs[] =
+    "00010203040506070809" "10111213141516171819"
+    "20212223242526272829" "30313233343536373839"
+    "40414243444546474849" "50515253545556575859"
+    "60616263646566676869" "70717273747576777879"
+    "80818283848586878889" "90919293949596979899";
+
+static const char radixDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/* The longest result of Long.toString(long, radix), with its sign */
+#define MAX_NUMBER_LENGTH 65
+
+/*=========================================================================
+ * FUNCTION:      formatUnsigned
+ * TYPE:          helper function
+ * OVERVIEW:      Convert an unsigned number to digits, writing them
+ *                backwards so that the last one goes just before "end".
+ * INTERFACE
+ *   parameters:  value, radix, end of the buffer
+ *   returns:     the first digit written
+ *=======================================================================*/
+
+static char *formatUnsigned(unsigned long value, int radix, char *end) {
+    char *p = end;
+    if (radix == 10) {
+        while (value >= 100) {
+            unsigned long quotient = value / 100;
+            const char *pair = &digitPairs[(value - quotient * 100) * 2];
+            *--p = pair[1];
+            *--p = pair[0];
+            value = quotient;
+        }
+        if (value >= 10) {
+            *--p = digitPairs[value * 2 + 1];
+            *--p = digitPairs[value * 2];
+        } else {
+            *--p = (char)('0' + value);
+        }
+    } else {
+        do {
+            *--p = radixDigits[value % radix];
+            value /= radix;
+        } while (value != 0);
+    }
+    return p;
+}
+
+/*=========================================================================
+ * FUNCTION:      formatInt, formatLong
+ * TYPE:          helper functions
+ * OVERVIEW:      Convert an int or a long to a string of characters, as
+ *                Integer.toString(int, int) and Long.toString(long, int)
+ *                do, writing them backwards so that the last one goes
+ *                just before "end".  The radix must be valid.
+ * INTERFACE
+ *   parameters:  value, radix, end of the buffer
+ *   returns:     the first character written
+ *=======================================================================*/
+
+static char *formatInt(long value, int radix, char *end) {
+    char *p = formatUnsigned(value < 0 ? 0UL - (unsigned long)value
+                                       : (unsigned long)value, radix, end);
+    if (value < 0) {
+        *--p = '-';
+    }
+    return p;
+}
+
+static char *formatLong(long64 value, int radix, char *end) {
+    bool_t negative = ll_zero_lt(value);
+    unsigned long divisor = radix;
+    int chunkDigits = 1;
+    long64 chunkSize;
+    char *p = end;
+
+    /* Convert the number in chunks of as many digits as fit in an int,
+     * so that there is only one long division for each chunk.
+     */
+    while (divisor <= 0x7FFFFFFF / radix) {
+        divisor *= radix;
+        chunkDigits++;
+    }
+    ll_uint_to_long(chunkSize, divisor);
+
+    /* Work with a negative value, so that MIN_VALUE needs no care */
+    if (!negative) {
+        ll_negate(value);
+    }
+    for (;;) {
+        long64 quotient = ll_div(value, chunkSize);
+        long64 remainder;
+        unsigned long chunk;
+        char *start;
+        if (ll_zero_eq(quotient)) {
+            break;
+        }
+        remainder = ll_rem(value, chunkSize);
+        ll_negate(remainder);
+        ll_long_to_uint(remainder, chunk);
+        start = p - chunkDigits;
+        p = formatUnsigned(chunk, radix, p);
+        while (p > start) {
+            *--p = '0';
+        }
+        value = quotient;
+    }
+    ll_negate(value);
+    {
+        unsigned long last;
+        ll_long_to_uint(value, last);
+        p = formatUnsigned(last, radix, p);
+    }
+    if (negative) {
+        *--p = '-';
+    }
+    return p;
+}
+
 /*=========================================================================
  * FUNCTION:      append(String)
  * CLASS:         java.lang.StringBuffer
@@ -1251,9 +1744,19 @@ void Java_java_lang_StringBuffer_append__Ljava_lang_String_2(void) {
         END_TEMPORARY_ROOTS
     }
     if (newCount <= this->array->length) {
-        memcpy(&this->array->sdata[count],
-               &string->array->sdata[string->offset],
-               stringLength * sizeof(short));
+        if (string->array != NULL) {
+            memcpy(&this->array->sdata[count],
+                   &string->array->sdata[string->offset],
+                   stringLength * sizeof(short));
+        } else {
+            unsigned char *from =
+                (unsigned char *)&string->latin1->bdata[string->offset];
+            unsigned short *to = (unsigned short *)&this->array->sdata[count];
+            unsigned long i;
+            for (i = 0; i < stringLength; i++) {
+                to[i] = from[i];
+            }
+        }
         this->count = newCount;
         pushStackAsType(STRINGBUFFER_INSTANCE, this);
     } else {
@@ -1264,32 +1767,26 @@ void Java_java_lang_StringBuffer_append__Ljava_lang_String_2(void) {
 }
 
 /*=========================================================================
- * FUNCTION:      append(int)
+ * FUNCTION:      append(int), append(long)
  * CLASS:         java.lang.StringBuffer
- * TYPE:          virtual native function
+ * TYPE:          virtual native functions
  * OVERVIEW:      appends an integer to a string buffer
  *   parameters:  this
- *                int
+ *                int or long
  *   returns:     the "this" argument
  *==================================================================== */
 
-void
-Java_java_lang_StringBuffer_append__I(void) {
-    long value = popStack();
-    STRINGBUFFER_INSTANCE this = popStackAsType(STRINGBUFFER_INSTANCE);
-
-    unsigned long count, newCount, stringLength;
-    char buffer[16];            /* 12 is enough, but I'm paranoid */
-    long i;
-
-    /* Put the value into a buffer */
-    sprintf(buffer, "%ld", value);
+static void appendDigits(STRINGBUFFER_INSTANCE this,
+                         const char *digits, unsigned long length) {
+    unsigned long count = this->count;
+    unsigned long newCount = count + length;
+    unsigned short *to;
+    unsigned long i;
 
-    count = this->count;
-    stringLength = strlen(buffer);
-    newCount = count + stringLength;
     if (newCount > this->array->length) {
-        /* Need to expand the string buffer */
+        /* Need to expand the string buffer.  The digits are on the C
+         * stack, so they are not affected by a GC.
+         */
         START_TEMPORARY_ROOTS
             DECLARE_TEMPORARY_ROOT(STRINGBUFFER_INSTANCE, thisX, this);
             expandStringBufferCapacity(&thisX, newCount);
@@ -1297,8 +1794,9 @@ Java_java_lang_StringBuffer_append__I(void) {
         END_TEMPORARY_ROOTS
     }
     if (newCount <= this->array->length) {
-        for (i = stringLength; --i >= 0; ) {
-            this->array->sdata[count + i] = ((unsigned char *)buffer)[i];
+        to = (unsigned short *)&this->array->sdata[count];
+        for (i = 0; i < length; i++) {
+            to[i] = (unsigned char)digits[i];
         }
         this->count = newCount;
         pushStackAsType(STRINGBUFFER_INSTANCE, this);
@@ -1309,6 +1807,29 @@ Java_java_lang_StringBuffer_append__I(void) {
     }
 }
 
+void
+Java_java_lang_StringBuffer_append__I(void) {
+    long value = popStack();
+    STRINGBUFFER_INSTANCE this = popStackAsType(STRINGBUFFER_INSTANCE);
+    char buffer[MAX_NUMBER_LENGTH];
+    char *digits = formatInt(value, 10, &buffer[MAX_NUMBER_LENGTH]);
+
+    appendDigits(this, digits, &buffer[MAX_NUMBER_LENGTH] - digits);
+}
+
+void
+Java_java_lang_StringBuffer_append__J(void) {
+    long64 value;
+    STRINGBUFFER_INSTANCE this;
+    char buffer[MAX_NUMBER_LENGTH];
+    char *digits;
+
+    popLong(value);
+    this = popStackAsType(STRINGBUFFER_INSTANCE);
+    digits = formatLong(value, 10, &buffer[MAX_NUMBER_LENGTH]);
+    appendDigits(this, digits, &buffer[MAX_NUMBER_LENGTH] - digits);
+}
+
 /*=========================================================================
  * FUNCTION:      toString()
  * CLASS:         java.lang.StringBuffer
@@ -1321,13 +1842,47 @@ Java_java_lang_StringBuffer_append__I(void) {
 void Java_java_lang_StringBuffer_toString(void) {
     STRINGBUFFER_INSTANCE this = popStackAsType(STRINGBUFFER_INSTANCE);
     STRING_INSTANCE result;
+    BYTEARRAY bytes = NULL;
     START_TEMPORARY_ROOTS
         DECLARE_TEMPORARY_ROOT(STRINGBUFFER_INSTANCE, thisX, this);
+#if COMPACT_STRINGS
+        /* Copy the characters into a byte array if they all fit,
+         * rather than sharing the buffer's char array.
+         */
+        DECLARE_TEMPORARY_ROOT(BYTEARRAY, latin1, NULL);
+        long count = this->count;
+        long i;
+        for (i = 0; i < count; i++) {
+            if ((unsigned short)this->array->sdata[i] > 0xFF) {
+                break;
+            }
+        }
+        if (i == count) {
+            latin1 = (BYTEARRAY)
+                instantiateArray(PrimitiveArrayClasses[T_BYTE], count);
+            this = thisX;
+            if (latin1 != NULL) {
+                for (i = 0; i < count; i++) {
+                    latin1->bdata[i] = (signed char)this->array->sdata[i];
+                }
+            }
+        }
+        result = (i != count || latin1 != NULL)
+                     ? (STRING_INSTANCE)instantiate(JavaLangString) : NULL;
+        bytes = latin1;
+#else
         result = (STRING_INSTANCE)instantiate(JavaLangString);
+#endif
         this = thisX;
     END_TEMPORARY_ROOTS
 
-    if (result != NULL) {
+    if (result != NULL && bytes != NULL) {
+        result->offset = 0;
+        result->length = this->count;
+        result->latin1 = bytes;
+
+        pushStackAsType(STRING_INSTANCE, result);
+    } else if (result != NULL) {
         this->shared = TRUE;
 
         result->offset = 0;
@@ -1361,3 +1916,190 @@ static void expandStringBufferCapacity(STRINGBUFFER_HANDLE sbH, int newLength)
     }
 }
 
+/*=========================================================================
+ * Native functions of classes java.lang.Integer and Long
+ *=======================================================================*/
+
+/*=========================================================================
+ * FUNCTION:      toString(II)Ljava/lang/String; (STATIC)
+ *                toString(JI)Ljava/lang/String; (STATIC)
+ * CLASS:         java.lang.Integer, java.lang.Long
+ * TYPE:          static native functions
+ * OVERVIEW:      Convert an int or a long to a String in a given radix.
+ *                An invalid radix means radix 10.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  value, radix
+ *   returns:     the String
+ *=======================================================================*/
+
+void Java_java_lang_Integer_toString(void) {
+    long radix = popStack();
+    long value = popStack();
+    char buffer[MAX_NUMBER_LENGTH];
+    char *digits;
+
+    if (radix < 2 || radix > 36) {
+        radix = 10;
+    }
+    digits = formatInt(value, radix, &buffer[MAX_NUMBER_LENGTH]);
+    pushStackAsType(STRING_INSTANCE,
+        instantiateString(digits, &buffer[MAX_NUMBER_LENGTH] - digits));
+}
+
+void Java_java_lang_Long_toString(void) {
+    long radix = popStack();
+    long64 value;
+    char buffer[MAX_NUMBER_LENGTH];
+    char *digits;
+
+    popLong(value);
+    if (radix < 2 || radix > 36) {
+        radix = 10;
+    }
+    digits = formatLong(value, radix, &buffer[MAX_NUMBER_LENGTH]);
+    pushStackAsType(STRING_INSTANCE,
+        instantiateString(digits, &buffer[MAX_NUMBER_LENGTH] - digits));
+}
+
+/*=========================================================================
+ * FUNCTION:      digitValue
+ * TYPE:          helper function
+ * OVERVIEW:      The value of an ASCII digit, as Character.digit()
+ *                would return it.
+ * INTERFACE
+ *   parameters:  character, radix
+ *   returns:     the value, or -1 if the character is not an ASCII
+ *                digit of the radix
+ *=======================================================================*/
+
+static int digitValue(unsigned short c, int radix) {
+    int value;
+    if (c >= '0' && c <= '9') {
+        value = c - '0';
+    } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+        value = (c & 0x1F) + 9;
+    } else {
+        return -1;
+    }
+    return (value < radix) ? value : -1;
+}
+
+/*=========================================================================
+ * FUNCTION:      makeLong
+ * TYPE:          helper function
+ * OVERVIEW:      The long with the given high and low words.
+ * INTERFACE
+ *   parameters:  high, low
+ *   returns:     the long
+ *=======================================================================*/
+
+static long64 makeLong(unsigned long high, unsigned long low) {
+    long64 value;
+#if COMPILER_SUPPORTS_LONG
+    value = (long64)((((ulong64)(unsigned)high) << 32) + (unsigned)low);
+#else
+    value.high = high;
+    value.low = low;
+#endif /* COMPILER_SUPPORTS_LONG */
+    return value;
+}
+
+/*=========================================================================
+ * FUNCTION:      parse(Ljava/lang/String;I)J (STATIC)
+ * CLASS:         java.lang.Integer, java.lang.Long
+ * TYPE:          static native functions
+ * OVERVIEW:      Parse a String as Integer.parseInt(String, int) and
+ *                Long.parseLong(String, int) do.  Anything other than
+ *                an optional minus sign and ASCII digits, and any
+ *                value that does not fit, is left to the Java code,
+ *                which then also throws the exceptions.  The caller has
+ *                checked the string and the radix.
+ * INTERFACE (operand stack manipulation):
+ *   parameters:  string, radix
+ *   returns:     the value, or Long.MIN_VALUE if the Java code has to
+ *                do it
+ *=======================================================================*/
+
+void Java_java_lang_Integer_parse(void) {
+    long radix = popStack();
+    STRING_INSTANCE string = popStackAsType(STRING_INSTANCE);
+    long length = string->length;
+    long limit = -0x7FFFFFFF;
+    long result = 0;
+    long multmin, i = 0;
+    long64 value;
+
+    if (length > 0 && STRING_CHAR_AT(string, 0) == '-') {
+        limit = -0x7FFFFFFF - 1;
+        i++;
+    }
+    multmin = limit / radix;
+    if (i == length) {
+        goto fail;
+    }
+    for ( ; i < length; i++) {
+        /* Accumulating negatively avoids surprises near MAX_VALUE */
+        int digit = digitValue(STRING_CHAR_AT(string, i), radix);
+        if (digit < 0 || result < multmin) {
+            goto fail;
+        }
+        result *= radix;
+        if (result < limit + digit) {
+            goto fail;
+        }
+        result -= digit;
+    }
+    if (limit == -0x7FFFFFFF) {
+        result = -result;
+    }
+    value = makeLong(result < 0 ? -1 : 0, result);
+    pushLong(value);
+    return;
+
+ fail:
+    value = makeLong(0x80000000, 0);
+    pushLong(value);
+}
+
+void Java_java_lang_Long_parse(void) {
+    long radix = popStack();
+    STRING_INSTANCE string = popStackAsType(STRING_INSTANCE);
+    long length = string->length;
+    long64 limit, multmin, result, radixL, digitL, bound;
+    long i = 0;
+
+    limit = makeLong(0x80000000, 1);     /* -Long.MAX_VALUE */
+    if (length > 0 && STRING_CHAR_AT(string, 0) == '-') {
+        limit = makeLong(0x80000000, 0); /* Long.MIN_VALUE */
+        i++;
+    }
+    ll_uint_to_long(radixL, radix);
+    multmin = ll_div(limit, radixL);
+    ll_setZero(result);
+    if (i == length) {
+        goto fail;
+    }
+    for ( ; i < length; i++) {
+        int digit = digitValue(STRING_CHAR_AT(string, i), radix);
+        if (digit < 0 || ll_compare_lt(result, multmin)) {
+            goto fail;
+        }
+        result = ll_mul(result, radixL);
+        ll_uint_to_long(digitL, digit);
+        bound = limit;
+        ll_inc(bound, digitL);
+        if (ll_compare_lt(result, bound)) {
+            goto fail;
+        }
+        ll_dec(result, digitL);
+    }
+    if (length == 0 || STRING_CHAR_AT(string, 0) != '-') {
+        ll_negate(result);
+    }
+    pushLong(result);
+    return;
+
+ fail:
+    result = makeLong(0x80000000, 0);
+    pushLong(result);
+}
@@ -2962,12 +2962,8 @@ StringReference_Value(PACKET_INPUT_STREAM_HANDLE inH,
     START_TEMPORARY_ROOTS 
         DECLARE_TEMPORARY_ROOT(STRING_INSTANCE, string, 
                                (STRING_INSTANCE)inStream_readObject(inH));
-        int buflen = unicode2utfstrlen((unsigned short *)&((SHORTARRAY)string->array)->sdata[string->offset],
-             string->length) + 1;
-        DECLARE_TEMPORARY_ROOT(char *, buf, mallocBytes(buflen));
+        DECLARE_TEMPORARY_ROOT(char *, buf, getStringUTF8(string));
 
-        unicode2utf((unsigned short *)&((SHORTARRAY)string->array)->sdata[string->offset], string->length,  buf,
-            buflen);
         outStream_writeString(outH, (CONST_CHAR_HANDLE)&buf);
 
         TRACE_DEBUGGER(("String", "Value", 
@@ -47,6 +47,8 @@ void printHelpText() {
     fprintf(stdout, "  -version\n");
     fprintf(stdout, "  -classpath <filepath>\n");
     fprintf(stdout, "  -heapsize <size> (e.g. 65536 or 128k or 1M)\n");
+    fprintf(stdout, "  -console line|full (flush output at each newline (default),\n");
+    fprintf(stdout, "                      or only when the buffer fills up)\n");
 
 #if ENABLE_JAVA_DEBUGGER
     fprintf(stdout, "  -debugger\n");
@@ -138,6 +140,16 @@ int main (int argc, char* argv[]) {
            
             argv+=2; argc -=2;
             RequestedHeapSize = heapSize;
+        } else if ((strcmp(argv[1], "-console") == 0) && (argc > 2)) {
+            if (strcmp(argv[2], "line") == 0) {
+                ConsoleLineBuffered = TRUE;
+            } else if (strcmp(argv[2], "full") == 0) {
+                ConsoleLineBuffered = FALSE;
+            } else {
+                printHelpText();
+                exit(1);
+            }
+            argv+=2; argc -=2;
         } else if ((strcmp(argv[1], "-classpath") == 0) && argc > 2) {
             if (JamEnabled) {
                 fprintf(stderr, KVM_MSG_CANT_COMBINE_CLASSPATH_OPTION_WITH_JAM_OPTION);
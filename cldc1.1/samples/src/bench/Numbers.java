@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * Integer conversion microbenchmark.
+ * <p>
+ * Times the conversions that logging and protocol code does most:
+ * <code>Integer.toString</code>, <code>Integer.parseInt</code>,
+ * <code>Long.toString</code>, <code>Long.parseLong</code> and
+ * <code>StringBuffer.append</code> of <code>int</code> and
+ * <code>long</code> values, plus a hexadecimal round trip.  Each test
+ * prints one line of the form <code>Numbers.test: millis</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.Numbers [iterations]</code>
+ */
+public class Numbers {
+
+    static void report(String name, long start) {
+        System.out.println("Numbers." + name + ": "
+                           + (System.currentTimeMillis() - start));
+    }
+
+    public static void main(String[] args) {
+        int iterations = 20000;
+        if (args.length > 0) {
+            iterations = Integer.parseInt(args[0]);
+        }
+
+        int check = 0;
+        long start;
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check += Integer.toString(i * 7919).length();
+        }
+        report("intToString", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check += Integer.parseInt(Integer.toString(i - iterations / 2));
+        }
+        report("parseInt", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check += Long.toString(i * 1000000007L).length();
+        }
+        report("longToString", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check += (int)Long.parseLong(Long.toString(i * -1000000007L));
+        }
+        report("parseLong", start);
+
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            check += Integer.parseInt(Integer.toHexString(i), 16);
+        }
+        report("hex", start);
+
+        StringBuffer sb = new StringBuffer();
+        start = System.currentTimeMillis();
+        for (int i = 0; i < iterations; i++) {
+            sb.setLength(0);
+            sb.append(i).append(' ').append(System.currentTimeMillis());
+            check += sb.length();
+        }
+        report("append", start);
+
+        System.out.println("Numbers.check: " + check);
+    }
+}
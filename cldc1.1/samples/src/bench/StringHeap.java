@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2001 Sun Microsystems, Inc. All Rights Reserved.
+ *
+ * This software is the proprietary information of Sun Microsystems, Inc.
+ * Use is subject to license terms.
+ *
+ */
+
+package bench;
+
+/**
+ * String heap occupancy benchmark.
+ * <p>
+ * Keeps a large number of short ASCII strings alive, built the ways
+ * applications usually build them (<code>StringBuffer</code>,
+ * <code>char[]</code>, <code>concat</code> and <code>substring</code>),
+ * and prints how much heap they take.  Run it on a VM built with and
+ * without compact strings (<code>COMPACT_STRINGS=true</code> in the
+ * Unix makefile) to see the saving.  Prints lines of the form
+ * <code>StringHeap.item: value</code>.
+ * <p>
+ * Usage: <code>kvm -classpath ... bench.StringHeap [strings]</code>
+ */
+public class StringHeap {
+
+    static long usedMemory() {
+        Runtime runtime = Runtime.getRuntime();
+        runtime.gc();
+        return runtime.totalMemory() - runtime.freeMemory();
+    }
+
+    public static void main(String[] args) {
+        int strings = 2000;
+        if (args.length > 0) {
+            strings = Integer.parseInt(args[0]);
+        }
+
+        String[] keep = new String[strings];
+        char[] chars = "abcdefghijklmnopqrstuvwxyz".toCharArray();
+        long before = usedMemory();
+        long start = System.currentTimeMillis();
+        for (int i = 0; i < strings; i++) {
+            switch (i % 4) {
+            case 0:
+                keep[i] = new StringBuffer("key.").append(i).toString();
+                break;
+            case 1:
+                keep[i] = new String(chars, i % 10, 16);
+                break;
+            case 2:
+                keep[i] = "value-".concat(String.valueOf(i));
+                break;
+            default:
+                keep[i] = ("prefix/" + i + "/suffix").substring(7);
+                break;
+            }
+        }
+        long elapsed = System.currentTimeMillis() - start;
+        long used = usedMemory() - before;
+
+        int characters = 0;
+        for (int i = 0; i < strings; i++) {
+            characters += keep[i].length();
+        }
+        System.out.println("StringHeap.create: " + elapsed);
+        System.out.println("StringHeap.characters: " + characters);
+        System.out.println("StringHeap.bytes: " + used);
+        System.out.println("StringHeap.bytesPerString: " + used / strings);
+    }
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright  2003 Sun Microsystems, Inc. All rights reserved.
+ * SUN PROPRIETARY/CONFIDENTIAL. Use is subject to license terms.
+ *
+ */
+
+package java.lang;
+
+/**
+ * Test access to the Java code of the conversions between floating
+ * point numbers and strings.  <code>Double</code> and <code>Float</code>
+ * try the natives in the VM first; these methods always run the Java
+ * code in <code>FloatingDecimal</code>, so that a test can compare the
+ * two in one run.  Only for tests; it is not part of the CLDC classes.
+ */
+public class FloatingDecimalCheck {
+
+    public static String toString(double d) {
+        return new FloatingDecimal(d).toJavaFormatString();
+    }
+
+    public static String toString(float f) {
+        return new FloatingDecimal(f).toJavaFormatString();
+    }
+
+    public static double parseDouble(String s) {
+        return FloatingDecimal.readJavaFormatString(s).doubleValue();
+    }
+
+    public static float parseFloat(String s) {
+        return FloatingDecimal.readJavaFormatString(s).floatValue();
+    }
+}
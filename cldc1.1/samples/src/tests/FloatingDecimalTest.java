@@ -0,0 +1,266 @@
+/*
+ * Copyright  2003 Sun Microsystems, Inc. All rights reserved.
+ * SUN PROPRIETARY/CONFIDENTIAL. Use is subject to license terms.
+ *
+ */
+
+package tests;
+
+import java.lang.FloatingDecimalCheck;
+import java.util.Random;
+
+/**
+ * Conformance test for the conversions between floating point numbers
+ * and strings.
+ * <p>
+ * Converts a fixed set of edge cases and a seeded random sample of
+ * <code>double</code> and <code>float</code> values to strings and back,
+ * checks the results against a few known strings and for round trips,
+ * and prints a checksum of every string and every parsed value.  Every
+ * result is also compared with that of the Java code in
+ * <code>FloatingDecimal</code>, which the VM's native conversions must
+ * match.  Run it on a VM built with and without native decimal
+ * conversion (<code>FAST_DECIMAL_CONVERSION=false</code> in the Unix
+ * makefile): the output must be identical.
+ * <p>
+ * Usage: <code>kvm -classpath ... tests.FloatingDecimalTest
+ * [count [-verbose]]</code>
+ */
+public class FloatingDecimalTest {
+
+    static boolean verbose;
+    static int checksum;
+    static int conversions;
+    static int failures;
+
+    static final double[] knownDoubles = {
+        0.0, -0.0, 1.0, 0.1, -0.5, 100.0, 1.0E7, 0.001, 123456.789,
+        1.0E-5, Double.MIN_VALUE, Double.MAX_VALUE
+    };
+
+    static final String[] knownDoubleStrings = {
+        "0.0", "-0.0", "1.0", "0.1", "-0.5", "100.0", "1.0E7", "0.0010",
+        "123456.789", "1.0E-5", "4.9E-324", "1.7976931348623157E308"
+    };
+
+    static final float[] knownFloats = {
+        0.1f, 1.0E10f, Float.MAX_VALUE, Float.MIN_VALUE, 16777216.0f
+    };
+
+    static final String[] knownFloatStrings = {
+        "0.1", "1.0E10", "3.4028235E38", "1.4E-45", "1.6777216E7"
+    };
+
+    static final String[] parseStrings = {
+        "0", "-0", "+1", "  3.25  ", ".5", "5.", "00012.3400", "1e10",
+        "1E-5", "-1.5e-22", "1e22", "1e23", "12e21", "123456789012345",
+        "1234567890123456", "9007199254740993", "1.0f", "2.5D",
+        "4.9e-324", "2e-324", "1.7976931348623157e308", "1e309",
+        "3.4028235e38", "1.4e-45", "0.1e-45",
+        /* Either side of the largest exponents of the easy cases */
+        "1e16", "1e17", "12e35", "12e36", "1234567e10", "1234567e11"
+    };
+
+    static final String[] badStrings = {
+        "", " ", "-", ".", "e5", "1e", "1e+", "1.2.3", "1.0x", "0x10",
+        "NaN", "Infinity", "1 2"
+    };
+
+    static void fail(String message) {
+        failures++;
+        System.out.println("FAILED: " + message);
+    }
+
+    static void add(String s) {
+        checksum = checksum * 31 + s.hashCode();
+        conversions++;
+        if (verbose) {
+            System.out.println(s);
+        }
+    }
+
+    static void add(long bits) {
+        checksum = checksum * 31 + (int)(bits ^ (bits >>> 32));
+        conversions++;
+    }
+
+    static void compare(String s, String bytecode) {
+        if (!s.equals(bytecode)) {
+            fail(s + " should be " + bytecode + " as in the Java code");
+        }
+    }
+
+    static void compareDouble(String s, double d) {
+        long bytecode = Double.doubleToLongBits(
+            FloatingDecimalCheck.parseDouble(s));
+        if (Double.doubleToLongBits(d) != bytecode) {
+            fail("\"" + s + "\" reads as " + Double.toString(d)
+                 + " rather than " + Double.toString(
+                     Double.longBitsToDouble(bytecode)));
+        }
+    }
+
+    static void compareFloat(String s, float f) {
+        int bytecode = Float.floatToIntBits(
+            FloatingDecimalCheck.parseFloat(s));
+        if (Float.floatToIntBits(f) != bytecode) {
+            fail("\"" + s + "\" reads as " + Float.toString(f)
+                 + " rather than " + Float.toString(
+                     Float.intBitsToFloat(bytecode)));
+        }
+    }
+
+    static void testDouble(double d) {
+        String s = Double.toString(d);
+        add(s);
+        compare(s, FloatingDecimalCheck.toString(d));
+        if (Double.isInfinite(d)) {
+            /* Not a number to parseDouble */
+            return;
+        }
+        double e = Double.parseDouble(s);
+        compareDouble(s, e);
+        long bits = Double.doubleToLongBits(d);
+        long parsed = Double.doubleToLongBits(e);
+        add(parsed);
+        if (parsed != bits) {
+            fail(s + " reads back as " + Double.toString(e));
+        }
+    }
+
+    static void testFloat(float f) {
+        String s = Float.toString(f);
+        add(s);
+        compare(s, FloatingDecimalCheck.toString(f));
+        if (Float.isInfinite(f)) {
+            /* Not a number to parseFloat */
+            return;
+        }
+        float g = Float.parseFloat(s);
+        compareFloat(s, g);
+        int bits = Float.floatToIntBits(f);
+        int parsed = Float.floatToIntBits(g);
+        add(parsed);
+        if (parsed != bits) {
+            fail(s + " reads back as " + Float.toString(g));
+        }
+    }
+
+    static void testParse(String s) {
+        double d = Double.parseDouble(s);
+        float f = Float.parseFloat(s);
+        compareDouble(s, d);
+        compareFloat(s, f);
+        add(Double.doubleToLongBits(d));
+        add(Float.floatToIntBits(f));
+    }
+
+    public static void main(String[] args) {
+        int count = 20000;
+        if (args.length > 0) {
+            count = Integer.parseInt(args[0]);
+        }
+        verbose = args.length > 1 && args[1].equals("-verbose");
+
+        for (int i = 0; i < knownDoubles.length; i++) {
+            String s = Double.toString(knownDoubles[i]);
+            if (!s.equals(knownDoubleStrings[i])) {
+                fail(s + " should be " + knownDoubleStrings[i]);
+            }
+        }
+        for (int i = 0; i < knownFloats.length; i++) {
+            String s = Float.toString(knownFloats[i]);
+            if (!s.equals(knownFloatStrings[i])) {
+                fail(s + " should be " + knownFloatStrings[i]);
+            }
+        }
+        add(Double.toString(Double.NaN));
+        add(Double.toString(Double.POSITIVE_INFINITY));
+        add(Double.toString(Double.NEGATIVE_INFINITY));
+        add(Float.toString(Float.NaN));
+        add(Float.toString(Float.NEGATIVE_INFINITY));
+
+        /* Powers of two and ten, and their neighbours */
+        for (int e = -1074; e <= 1023; e++) {
+            long bits = Double.doubleToLongBits(twoTo(e));
+            testDouble(Double.longBitsToDouble(bits));
+            testDouble(Double.longBitsToDouble(bits + 1));
+            testDouble(Double.longBitsToDouble(bits - 1));
+        }
+        double ten = 1.0;
+        for (int e = 0; e <= 308; e++, ten *= 10.0) {
+            testDouble(ten);
+            testDouble(1.0 / ten);
+            testFloat((float)ten);
+            testFloat((float)(1.0 / ten));
+        }
+        for (int e = 0; e < 255; e++) {
+            testFloat(Float.intBitsToFloat(e << 23));
+            testFloat(Float.intBitsToFloat((e << 23) | 1));
+            testFloat(Float.intBitsToFloat((e << 23) | 0x7fffff));
+        }
+
+        for (int i = 0; i < parseStrings.length; i++) {
+            testParse(parseStrings[i]);
+        }
+        for (int i = 0; i < badStrings.length; i++) {
+            try {
+                Double.parseDouble(badStrings[i]);
+                fail("\"" + badStrings[i] + "\" was accepted");
+            } catch (NumberFormatException e) {
+                add(1);
+            }
+            try {
+                Float.parseFloat(badStrings[i]);
+                fail("\"" + badStrings[i] + "\" was accepted");
+            } catch (NumberFormatException e) {
+                add(2);
+            }
+        }
+        try {
+            Double.parseDouble(null);
+            fail("null was accepted");
+        } catch (NullPointerException e) {
+            add(3);
+        }
+
+        /* Random bit patterns, and short decimals */
+        Random random = new Random(1234);
+        for (int i = 0; i < count; i++) {
+            double d = Double.longBitsToDouble(random.nextLong());
+            if (d == d) {
+                testDouble(d);
+            }
+            float f = Float.intBitsToFloat(random.nextInt());
+            if (f == f) {
+                testFloat(f);
+            }
+            int digits = random.nextInt();
+            int exponent = random.nextInt(40) - 20;
+            testParse(digits + "e" + exponent);
+            testParse("0." + (digits & 0xffff));
+            testDouble((digits >> 8) / 1000.0);
+            testFloat((float)((digits >> 16) / 100.0));
+        }
+
+        System.out.println("FloatingDecimalTest.conversions: " + conversions);
+        System.out.println("FloatingDecimalTest.checksum: "
+                           + Integer.toHexString(checksum));
+        System.out.println("FloatingDecimalTest.failures: " + failures);
+    }
+
+    static double twoTo(int e) {
+        double d = 1.0;
+        if (e >= 0) {
+            while (e-- > 0) {
+                d *= 2.0;
+            }
+        } else {
+            /* Stay exact down to the smallest denormal */
+            while (e++ < 0) {
+                d /= 2.0;
+            }
+        }
+        return d;
+    }
+}
@@ -0,0 +1,351 @@
+/*
+ * Copyright  2003 Sun Microsystems, Inc. All rights reserved.
+ * SUN PROPRIETARY/CONFIDENTIAL. Use is subject to license terms.
+ *
+ */
+
+package tests;
+
+/**
+ * Conformance test for the native <code>String</code> methods
+ * <code>compareTo</code>, <code>startsWith</code>,
+ * <code>regionMatches</code>, <code>hashCode</code>,
+ * <code>lastIndexOf</code> and <code>indexOf(String, int)</code>.
+ * <p>
+ * Checks a few known results, then calls each method on every pair of
+ * a set of sample strings, at offsets before, inside and past the end
+ * of the strings, and compares the results with those of plain Java
+ * code working on the characters of the strings.  The samples include
+ * empty strings, characters above 0x7f, and substrings that share the
+ * storage of a longer string at an offset, stored both as Latin-1 bytes
+ * and as characters.  Run it on a VM built with and without compact
+ * strings (<code>COMPACT_STRINGS=true</code> in the Unix makefile): it
+ * must report no failures either way.
+ * <p>
+ * Usage: <code>kvm -classpath ... tests.StringTest</code>
+ */
+public class StringTest {
+
+    static int checks;
+    static int failures;
+
+    static void fail(String message) {
+        failures++;
+        System.out.println("FAILED: " + message);
+    }
+
+    static void check(boolean condition, String message) {
+        checks++;
+        if (!condition) {
+            fail(message);
+        }
+    }
+
+    /*
+     * Count a check of a result against the reference result.  The
+     * caller only builds the failure message if they differ.
+     */
+    static boolean differ(int result, int expected) {
+        checks++;
+        return result != expected;
+    }
+
+    static boolean differ(boolean result, boolean expected) {
+        checks++;
+        return result != expected;
+    }
+
+    static void check(int result, int expected, String message) {
+        check(result == expected,
+              message + " is " + result + ", should be " + expected);
+    }
+
+    static void check(boolean result, boolean expected, String message) {
+        check(result == expected,
+              message + " is " + result + ", should be " + expected);
+    }
+
+    /* Shows a sample string in a failure message */
+    static String show(String s) {
+        StringBuffer buffer = new StringBuffer("\"");
+        for (int i = 0; i < s.length(); i++) {
+            char c = s.charAt(i);
+            if (c >= 0x20 && c < 0x7f) {
+                buffer.append(c);
+            } else {
+                buffer.append("\\u").append(Integer.toHexString(c));
+            }
+        }
+        return buffer.append('"').toString();
+    }
+
+    static String[] samples() {
+        String wide = "\u4e2d\u6587abcabc\u00e9\u4e2d";
+        return new String[] {
+            "",
+            new String(),
+            "abc".substring(1, 1),
+            "a",
+            "abc",
+            "abd",
+            "ABC",
+            "abcabc",
+            "hello, world",
+            "caf\u00e9",
+            "\u00ff\u0100",
+            "\u0101bc",
+            wide,
+            /* Latin-1 substrings at an offset */
+            "xxhello, worldyy".substring(2, 14),
+            "xxabcabcyy".substring(2, 8),
+            "caf\u00e9s".substring(1),
+            /* Latin-1 characters in the storage of a wide string */
+            wide.substring(2, 5),
+            wide.substring(2, 8),
+            wide.substring(5, 9),
+            /* Wide substrings at an offset */
+            wide.substring(1, 3),
+            "x\u0101bcx".substring(1, 4),
+            /* Strings built from characters */
+            new String(new char[] { 'a', 'b', 'c' }),
+            new String(new char[] { 'c', 'a', 'f', '\u00e9' }),
+            new StringBuffer("abc").append('\u0101').toString()
+        };
+    }
+
+    /* Offsets to try for a string of the given length */
+    static int[] offsets(int length) {
+        return new int[] {
+            Integer.MIN_VALUE, -2, -1, 0, 1, length - 1, length, length + 1,
+            Integer.MAX_VALUE
+        };
+    }
+
+    /*
+     * Reference implementations, after the Java code the natives
+     * replace.
+     */
+
+    static int compareTo(char[] s, char[] t) {
+        int n = Math.min(s.length, t.length);
+        for (int i = 0; i < n; i++) {
+            if (s[i] != t[i]) {
+                return s[i] - t[i];
+            }
+        }
+        return s.length - t.length;
+    }
+
+    static boolean startsWith(char[] s, char[] prefix, int toffset) {
+        if (toffset < 0 || toffset > s.length - prefix.length) {
+            return false;
+        }
+        for (int i = 0; i < prefix.length; i++) {
+            if (s[toffset + i] != prefix[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static boolean regionMatches(char[] s, int toffset,
+                                 char[] t, int ooffset, int len) {
+        if (ooffset < 0 || toffset < 0 || toffset > (long)s.length - len ||
+            ooffset > (long)t.length - len) {
+            return false;
+        }
+        for (int i = 0; i < len; i++) {
+            if (s[toffset + i] != t[ooffset + i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static int hashCode(char[] s) {
+        int h = 0;
+        for (int i = 0; i < s.length; i++) {
+            h = 31 * h + s[i];
+        }
+        return h;
+    }
+
+    static int lastIndexOf(char[] s, int ch, int fromIndex) {
+        int i = (fromIndex >= s.length) ? s.length - 1 : fromIndex;
+        for ( ; i >= 0; i--) {
+            if (s[i] == ch) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static int indexOf(char[] s, char[] str, int fromIndex) {
+        if (fromIndex >= s.length) {
+            /* There is an empty string at index 0 in an empty string */
+            return (s.length == 0 && fromIndex == 0 && str.length == 0)
+                ? 0 : -1;
+        }
+        if (fromIndex < 0) {
+            fromIndex = 0;
+        }
+        for (int i = fromIndex; i <= s.length - str.length; i++) {
+            if (startsWith(s, str, i)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static void testKnownResults() {
+        check("".compareTo(""), 0, "\"\".compareTo(\"\")");
+        check("abc".compareTo("abd"), -1, "\"abc\".compareTo(\"abd\")");
+        check("a".compareTo("abc"), -2, "\"a\".compareTo(\"abc\")");
+        check("\u00e9".compareTo("e"), 0xe9 - 'e', "\"\\u00e9\".compareTo(\"e\")");
+        check("\u0100".compareTo("\u00ff"), 1, "\"\\u0100\".compareTo(\"\\u00ff\")");
+
+        check("".hashCode(), 0, "\"\".hashCode()");
+        check("abc".hashCode(), 96354, "\"abc\".hashCode()");
+        check("caf\u00e9".hashCode(), 3045921, "\"caf\\u00e9\".hashCode()");
+        check("xcaf\u00e9".substring(1).hashCode(), 3045921,
+              "\"xcaf\\u00e9\".substring(1).hashCode()");
+
+        check("abc".startsWith("", 3), true, "\"abc\".startsWith(\"\", 3)");
+        check("abc".startsWith("", 4), false, "\"abc\".startsWith(\"\", 4)");
+        check("abc".startsWith("", -1), false, "\"abc\".startsWith(\"\", -1)");
+        check("abc".startsWith("bc", 1), true, "\"abc\".startsWith(\"bc\", 1)");
+        check("abc".startsWith("bcd", 1), false, "\"abc\".startsWith(\"bcd\", 1)");
+
+        check("abc".regionMatches(false, 0, "xyz", 0, -1), true,
+              "\"abc\".regionMatches(false, 0, \"xyz\", 0, -1)");
+        check("abc".regionMatches(false, 4, "abc", 0, 0), false,
+              "\"abc\".regionMatches(false, 4, \"abc\", 0, 0)");
+        check("abc".regionMatches(false, 1, "xbc", 1, 2), true,
+              "\"abc\".regionMatches(false, 1, \"xbc\", 1, 2)");
+        check("abc".regionMatches(false, 1, "xbc", 1, 3), false,
+              "\"abc\".regionMatches(false, 1, \"xbc\", 1, 3)");
+
+        check("abc".lastIndexOf('c', 100), 2, "\"abc\".lastIndexOf('c', 100)");
+        check("abc".lastIndexOf('a', -1), -1, "\"abc\".lastIndexOf('a', -1)");
+        check("abc".lastIndexOf('a', Integer.MIN_VALUE), -1,
+              "\"abc\".lastIndexOf('a', Integer.MIN_VALUE)");
+        check("abcabc".lastIndexOf('a'), 3, "\"abcabc\".lastIndexOf('a')");
+        check("abc".lastIndexOf('a' + 0x10000), -1,
+              "\"abc\".lastIndexOf('a' + 0x10000)");
+
+        check("".indexOf("", 0), 0, "\"\".indexOf(\"\", 0)");
+        check("".indexOf("", 1), -1, "\"\".indexOf(\"\", 1)");
+        check("abc".indexOf("", -5), 0, "\"abc\".indexOf(\"\", -5)");
+        check("abc".indexOf("", 3), -1, "\"abc\".indexOf(\"\", 3)");
+        check("abcabc".indexOf("bc", -1), 1, "\"abcabc\".indexOf(\"bc\", -1)");
+        check("abcabc".indexOf("bc", 2), 4, "\"abcabc\".indexOf(\"bc\", 2)");
+        check("abcabc".indexOf("bc", Integer.MAX_VALUE), -1,
+              "\"abcabc\".indexOf(\"bc\", Integer.MAX_VALUE)");
+        check("abcab".indexOf("abc", 1), -1, "\"abcab\".indexOf(\"abc\", 1)");
+    }
+
+    static void testNullArguments() {
+        try {
+            "abc".compareTo(null);
+            fail("compareTo(null) returned");
+        } catch (NullPointerException e) {
+        }
+        try {
+            "abc".startsWith(null, 0);
+            fail("startsWith(null, 0) returned");
+        } catch (NullPointerException e) {
+        }
+        try {
+            "abc".indexOf(null, 0);
+            fail("indexOf(null, 0) returned");
+        } catch (NullPointerException e) {
+        }
+    }
+
+    static void testString(String s) {
+        char[] sc = s.toCharArray();
+        int[] offsets = offsets(sc.length);
+
+        if (differ(s.hashCode(), hashCode(sc))) {
+            fail(show(s) + ".hashCode()");
+        }
+
+        /* Characters that occur in the string, and some that do not */
+        int[] chars = new int[sc.length + 4];
+        for (int i = 0; i < sc.length; i++) {
+            chars[i] = sc[i];
+        }
+        chars[sc.length] = 'z';
+        chars[sc.length + 1] = -1;
+        chars[sc.length + 2] = 0xe9 - 0x100;
+        chars[sc.length + 3] = 'a' + 0x10000;
+        for (int i = 0; i < chars.length; i++) {
+            int ch = chars[i];
+            if (differ(s.lastIndexOf(ch), lastIndexOf(sc, ch, sc.length - 1))) {
+                fail(show(s) + ".lastIndexOf(" + ch + ")");
+            }
+            for (int j = 0; j < offsets.length; j++) {
+                int k = offsets[j];
+                if (differ(s.lastIndexOf(ch, k), lastIndexOf(sc, ch, k))) {
+                    fail(show(s) + ".lastIndexOf(" + ch + ", " + k + ")");
+                }
+            }
+        }
+    }
+
+    static void testPair(String s, String t) {
+        char[] sc = s.toCharArray();
+        char[] tc = t.toCharArray();
+        int[] offsets = offsets(sc.length);
+
+        if (differ(s.compareTo(t), compareTo(sc, tc))) {
+            fail(show(s) + ".compareTo(" + show(t) + ")");
+        }
+        if (differ(s.startsWith(t), startsWith(sc, tc, 0))) {
+            fail(show(s) + ".startsWith(" + show(t) + ")");
+        }
+        if (differ(s.endsWith(t), startsWith(sc, tc, sc.length - tc.length))) {
+            fail(show(s) + ".endsWith(" + show(t) + ")");
+        }
+
+        for (int i = 0; i < offsets.length; i++) {
+            int k = offsets[i];
+            if (differ(s.startsWith(t, k), startsWith(sc, tc, k))) {
+                fail(show(s) + ".startsWith(" + show(t) + ", " + k + ")");
+            }
+            if (differ(s.indexOf(t, k), indexOf(sc, tc, k))) {
+                fail(show(s) + ".indexOf(" + show(t) + ", " + k + ")");
+            }
+        }
+
+        int[] lengths = { -1, 0, 1, 2, tc.length, Integer.MAX_VALUE };
+        for (int i = -1; i <= sc.length + 1; i++) {
+            for (int j = -1; j <= tc.length + 1; j++) {
+                for (int k = 0; k < lengths.length; k++) {
+                    int len = lengths[k];
+                    if (differ(s.regionMatches(false, i, t, j, len),
+                               regionMatches(sc, i, tc, j, len))) {
+                        fail(show(s) + ".regionMatches(false, " + i + ", " +
+                             show(t) + ", " + j + ", " + len + ")");
+                    }
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        String[] samples = samples();
+
+        testKnownResults();
+        testNullArguments();
+        for (int i = 0; i < samples.length; i++) {
+            testString(samples[i]);
+            for (int j = 0; j < samples.length; j++) {
+                testPair(samples[i], samples[j]);
+            }
+        }
+
+        System.out.println("StringTest.checks: " + checks);
+        System.out.println("StringTest.failures: " + failures);
+    }
+}
@@ -14,6 +14,10 @@ import vm.*;
 public class KVMStringTable extends vm.StringTable {
     static final public String charArrayName =  "stringCharArrayInternal";
     static final public String stringArrayName = "stringArrayInternal";
+    static final public String byteArrayName =  "stringByteArrayInternal";
+
+    // Offset of the first Latin-1 string in the character data
+    private int latin1Start;
     
     StringHashTable stringHashTable = new StringHashTable();
 
@@ -33,16 +37,31 @@ public class KVMStringTable extends vm.StringTable {
     final char v[] = new char[n];
     data.getChars( 0, n, v, 0 );
 
+    // With COMPACT_STRINGS, the Latin-1 strings (which come last)
+    // are written to a byte array instead.
+    out.println("#if COMPACT_STRINGS");
+    writeCharacterArray(writer, v, latin1Start);
+    writeByteArray(writer, v, latin1Start);
+    out.println("#else");
+    writeCharacterArray(writer, v, n);
+    out.println("#endif\n");
+    return true;
+    }
+
+    private void writeCharacterArray(KVMWriter writer, 
+                     final char v[], int n) {
+    final CCodeWriter out = writer.out;
+
     // First, typedef the header we're about to create
-    out.print("static CONST CHARARRAY_X(" + n + ") " 
+    out.print("static CONST CHARARRAY_X(" + Math.max(n, 1) + ") " 
           + charArrayName + " = {\n");
     
-    out.println("\tCHARARRAY_HEADER(" + v.length + "),");
+    out.println("\tCHARARRAY_HEADER(" + n + "),");
     out.println("\t{");
-    writer.writeArray(v.length, 10, "\t\t", 
+    writer.writeArray(Math.max(n, 1), 10, "\t\t", 
               new KVMWriter.ArrayPrinter() { 
                               public void print(int index) { 
-                  char c = v[index];
+                  char c = (index < v.length) ? v[index] : 0;
                   if (c == '\\') {
                       out.print("'\\\\'");
                   } else if (c == '\'') {
@@ -56,6 +75,65 @@ public class KVMStringTable extends vm.StringTable {
                       });
     out.println("\t}");
     out.println("};\n");
+    }
+
+    private void writeByteArray(KVMWriter writer, 
+                final char v[], final int start) {
+    final CCodeWriter out = writer.out;
+    int n = v.length - start;
+
+    out.print("static CONST BYTEARRAY_X(" + Math.max(n, 1) + ") " 
+          + byteArrayName + " = {\n");
+    
+    out.println("\tBYTEARRAY_HEADER(" + n + "),");
+    out.println("\t{");
+    writer.writeArray(Math.max(n, 1), 10, "\t\t", 
+              new KVMWriter.ArrayPrinter() { 
+                              public void print(int index) { 
+                  index += start;
+                  char c = (index < v.length) ? v[index] : 0;
+                  if (c >= 0x80) { 
+                      // bdata is signed
+                      out.print("(signed char)");
+                  }
+                  out.printHexInt(c);
+                  }
+                      });
+    out.println("\t}");
+    out.println("};\n");
+    }
+
+    /*
+     * Like vm.StringTable.arrangeStringData, but puts the strings
+     * whose characters are all Latin-1 after all the others, so that
+     * a compact ROM image can keep them in a byte array instead.
+     */
+    public int arrangeStringData() { 
+    data = new StringBuffer();
+    int curOffset = 0;
+    for (int pass = 0; pass < 2; pass++) { 
+        if (pass == 1) { 
+            latin1Start = curOffset;
+        }
+        Enumeration s = allStrings();
+        while ( s.hasMoreElements() ){
+            StringConstant t = (StringConstant)s.nextElement();
+            if (isLatin1(t.str.string) == (pass == 1)) { 
+                t.unicodeOffset = curOffset;
+                data.append( t.str.string );
+                curOffset += t.str.string.length();
+            }
+        }
+    }
+    return curOffset;
+    }
+
+    static boolean isLatin1(String string) { 
+    for (int i = 0; i < string.length(); i++) { 
+        if (string.charAt(i) > 0xFF) { 
+            return false;
+        }
+    }
     return true;
     }
 
@@ -79,8 +157,14 @@ public class KVMStringTable extends vm.StringTable {
            (StringConstant)stringHashTable.getNext(s);
 
         commentary(string, out);
+        if (isLatin1(string)) { 
+        out.print("\tKVM_INIT_LATIN1_JAVA_STRING(" + s.unicodeOffset + ", "
+              + (s.unicodeOffset - latin1Start) + ", "
+              + string.length() + ", ");
+        } else { 
         out.print("\tKVM_INIT_JAVA_STRING(" + s.unicodeOffset + ", "
               + string.length() + ", ");
+        }
         if (next == null) { 
         out.print(0);
         } else { 
@@ -1290,6 +1290,10 @@ public class KVMWriter implements CoreImageWriter, Const, EVMConst {
         "bool_t isROMString(void *x) { ",
         "    if (x == (void *)(&stringCharArrayInternal.ofClass)) { ", 
         "        return TRUE;", 
+        "#if COMPACT_STRINGS",
+        "    } else if (x == (void *)(&stringByteArrayInternal.ofClass)) { ", 
+        "        return TRUE;", 
+        "#endif",
         "    } else { ", 
         "        void *start = (void *)&stringArrayInternal[0];", 
         "        void *end = (void *)((char *)start + sizeof(stringArrayInternal));", 